@@ -0,0 +1,802 @@
+/******************************************************************************
+* File Name:   app_bt_adv.c
+*
+* Description: This is the source code for the advertising control of the
+*              Peripheral_Privacy Example for ModusToolbox. All advertising goes
+*              through app_bt_adv_start() so that the interval scheduler can step the
+*              advertising interval through a curve based on the time since the last
+*              disconnect and on whether bonded peers exist.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_stack.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_log.h"
+#include "app_event.h"
+#include "app_bt_cfg.h"
+#include "app_bt_bonding.h"
+#include "app_bt_adv.h"
+#include "app_bt_adv_payload.h"
+#ifdef ENABLE_EXT_ADV
+#include "app_bt_ext_adv.h"
+#include "peripheral_privacy.h"
+#endif
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Scheduler only mode: bonded peers reconnect through the filter accept list */
+#define ADV_SCHED_MODE_ACCEPT_LIST          ((wiced_bt_ble_advert_mode_t)0xFF)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Bonded peers are expected back soon: advertise fast first, then back off */
+adv_sched_curve_t adv_sched_curve_bonded =
+{
+    .steps =
+    {
+        { 0,        ADV_SCHED_MS_TO_SLOTS(30)   },
+        { 30000,    ADV_SCHED_MS_TO_SLOTS(100)  },
+        { 120000,   ADV_SCHED_MS_TO_SLOTS(500)  },
+        { 600000,   ADV_SCHED_MS_TO_SLOTS(1280) },
+    },
+    .num_steps = 4,
+};
+
+/* Same behavior as the generated configuration: 30 ms for 60 s, then 1.28 s */
+adv_sched_curve_t adv_sched_curve_unbonded =
+{
+    .steps =
+    {
+        { 0,        ADV_SCHED_MS_TO_SLOTS(30)   },
+        { 60000,    ADV_SCHED_MS_TO_SLOTS(1280) },
+    },
+    .num_steps = 2,
+};
+
+/* Scheduler state */
+static struct
+{
+    wiced_bt_ble_advert_mode_t      mode;       /* Requested mode, OFF when not advertising */
+    wiced_bt_ble_address_type_t     addr_type;  /* Peer address type for directed advertising */
+    wiced_bt_device_address_t       bd_addr;    /* Peer address for directed advertising */
+    const adv_sched_curve_t         *p_curve;   /* Curve in use */
+    uint8_t                         step;       /* Current step in the curve */
+    cy_time_t                       ref_time;   /* Time of the last disconnect or of the boot */
+    uint32_t                        generation; /* Bumped on every start and stop, drops stale steps */
+} adv_sched;
+
+static cy_timer_t                   adv_sched_timer;
+
+/* Kinds of advertising transitions, timed separately */
+typedef enum
+{
+    ADV_TRANSITION_OFF,
+    ADV_TRANSITION_DIRECTED,
+    ADV_TRANSITION_UNDIRECTED,
+    ADV_TRANSITION_ACCEPT_LIST,
+    ADV_TRANSITION_STEP,            /* Interval change of the running advertising */
+    ADV_TRANSITION_MAX
+} adv_transition_t;
+
+/* Duration of the transitions, from the request until the controller command returned */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    swaps;              /* Transitions that had to send a payload */
+    uint32_t    last_us;
+    uint32_t    min_us;
+    uint32_t    max_us;
+    uint64_t    total_us;
+} adv_transition_stats_t;
+
+static adv_transition_stats_t       adv_transition_stats[ADV_TRANSITION_MAX];
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void             adv_sched_timer_cb      (cy_timer_callback_arg_t arg);
+static wiced_result_t   adv_sched_apply         (wiced_bool_t restart);
+static uint32_t         adv_sched_elapsed_ms    (void);
+static void             adv_sched_select_step   (void);
+static void             adv_transition_record   (adv_transition_t kind,
+                                                 uint32_t start_us,
+                                                 uint32_t start_swaps);
+#ifdef ENABLE_EXT_ADV
+static wiced_result_t   adv_sched_apply_ext     (wiced_bool_t restart, uint16_t interval);
+#endif
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_bt_adv_init
+*
+* Function Description:
+* @brief   This function initializes the advertising interval scheduler. The
+*          stack advertising timeouts are disabled since the scheduler owns the
+*          progression through the interval curve.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_init(void)
+{
+    cy_rslt_t rslt;
+
+    app_bt_cfg_ble_advert.high_duty_duration = 0;
+    app_bt_cfg_ble_advert.low_duty_duration = 0;
+    app_bt_cfg_ble_advert.low_duty_directed_duration = 0;
+
+    adv_sched.mode = BTM_BLE_ADVERT_OFF;
+    cy_rtos_get_time(&adv_sched.ref_time);
+
+    memset(adv_transition_stats, 0, sizeof(adv_transition_stats));
+    for (uint8_t i = 0; i < ADV_TRANSITION_MAX; i++)
+    {
+        adv_transition_stats[i].min_us = UINT32_MAX;
+    }
+
+    /* Build all the advertising payloads once */
+    app_bt_adv_payload_init();
+#ifdef ENABLE_EXT_ADV
+    app_bt_ext_adv_init();
+#endif
+
+    rslt = cy_rtos_timer_init(&adv_sched_timer, CY_TIMER_TYPE_ONCE, adv_sched_timer_cb, NULL);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to create the advertising scheduler timer!\n");
+        CY_ASSERT(0);
+    }
+}
+
+/**
+* Function Name:
+* app_bt_adv_start
+*
+* Function Description:
+* @brief   This function starts advertising in the given mode. The interval is
+*          taken from the curve matching the bond state, at the step for the
+*          time elapsed since the last disconnect.
+*          With extended advertising, directed modes go to the bonded set and
+*          undirected modes to the bond mode set, the other set keeps running.
+*
+* @param   mode: Advertising mode, BTM_BLE_ADVERT_OFF stops advertising
+* @param   addr_type: Peer address type, used for directed advertising only
+* @param   bd_addr: Peer address, used for directed advertising only
+*
+* @return  wiced_result_t: Result of starting the advertising
+*/
+wiced_result_t app_bt_adv_start(wiced_bt_ble_advert_mode_t mode,
+                                wiced_bt_ble_address_type_t addr_type,
+                                wiced_bt_device_address_ptr_t bd_addr)
+{
+    uint32_t start_us = app_timestamp_us();
+    uint32_t start_swaps = app_bt_adv_payload_swaps();
+    adv_transition_t kind;
+    wiced_result_t result;
+
+    cy_rtos_timer_stop(&adv_sched_timer);
+
+    adv_sched.generation++;
+    adv_sched.mode = mode;
+    if (BTM_BLE_ADVERT_OFF == mode)
+    {
+#ifdef ENABLE_EXT_ADV
+        app_bt_ext_adv_stop_all();
+        led_task_communicator(BTM_BLE_ADVERT_OFF);
+        result = WICED_BT_SUCCESS;
+#else
+        result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF, 0, NULL);
+#endif
+        adv_transition_record(ADV_TRANSITION_OFF, start_us, start_swaps);
+        return result;
+    }
+
+    adv_sched.addr_type = addr_type;
+    if (NULL != bd_addr)
+    {
+        memcpy(adv_sched.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t));
+    }
+    adv_sched_select_step();
+
+    result = adv_sched_apply(WICED_FALSE);
+
+    if ((BTM_BLE_ADVERT_DIRECTED_HIGH == mode) || (BTM_BLE_ADVERT_DIRECTED_LOW == mode))
+    {
+        kind = ADV_TRANSITION_DIRECTED;
+    }
+    else if (ADV_SCHED_MODE_ACCEPT_LIST == mode)
+    {
+        kind = ADV_TRANSITION_ACCEPT_LIST;
+    }
+    else
+    {
+        kind = ADV_TRANSITION_UNDIRECTED;
+    }
+    adv_transition_record(kind, start_us, start_swaps);
+
+    return result;
+}
+
+/**
+* Function Name:
+* app_bt_adv_start_accept_list
+*
+* Function Description:
+* @brief   This function lets all bonded peers reconnect without selecting one
+*          of them first, by advertising with the filter accept list. Only
+*          available with extended advertising.
+*
+* @param   None
+*
+* @return  wiced_result_t: WICED_BT_UNSUPPORTED with legacy advertising
+*/
+wiced_result_t app_bt_adv_start_accept_list(void)
+{
+#ifdef ENABLE_EXT_ADV
+    if (0 == bondinfo.slot_data[NUM_BONDED])
+    {
+        return WICED_BT_ERROR;
+    }
+    return app_bt_adv_start(ADV_SCHED_MODE_ACCEPT_LIST, 0, NULL);
+#else
+    return WICED_BT_UNSUPPORTED;
+#endif
+}
+
+/**
+* Function Name:
+* app_bt_adv_exit_bond_mode
+*
+* Function Description:
+* @brief   This function stops advertising to new peers when bond mode is
+*          left. With legacy advertising the single advertising train keeps
+*          running and new peers are refused at the security request.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_exit_bond_mode(void)
+{
+#ifdef ENABLE_EXT_ADV
+    app_bt_ext_adv_set(EXT_ADV_SET_BOND_MODE, EXT_ADV_OFF, 0, 0, NULL);
+    if (EXT_ADV_OFF == app_bt_ext_adv_get_mode(EXT_ADV_SET_BONDED))
+    {
+        cy_rtos_timer_stop(&adv_sched_timer);
+        adv_sched.generation++;
+        adv_sched.mode = BTM_BLE_ADVERT_OFF;
+        led_task_communicator(BTM_BLE_ADVERT_OFF);
+    }
+#endif
+}
+
+/**
+* Function Name:
+* app_bt_adv_get_mode
+*
+* Function Description:
+* @brief   This function returns the advertising mode. With extended
+*          advertising a directed mode is returned whenever the bonded set is
+*          directed, even if the bond mode set is advertising as well.
+*
+* @param   None
+*
+* @return  wiced_bt_ble_advert_mode_t: Current mode, BTM_BLE_ADVERT_OFF if idle
+*/
+wiced_bt_ble_advert_mode_t app_bt_adv_get_mode(void)
+{
+#ifdef ENABLE_EXT_ADV
+    if (EXT_ADV_DIRECTED == app_bt_ext_adv_get_mode(EXT_ADV_SET_BONDED))
+    {
+        return BTM_BLE_ADVERT_DIRECTED_LOW;
+    }
+    if (ADV_SCHED_MODE_ACCEPT_LIST == adv_sched.mode)
+    {
+        return BTM_BLE_ADVERT_UNDIRECTED_LOW;
+    }
+#endif
+    return adv_sched.mode;
+}
+
+/**
+* Function Name:
+* app_bt_adv_on_connect
+*
+* Function Description:
+* @brief   This function stops the scheduler when a peer connects, the stack
+*          stops advertising by itself. Extended advertising sets that did not
+*          get the connection are disabled here. A step already posted to the
+*          event loop is dropped since the generation changed.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_on_connect(void)
+{
+    cy_rtos_timer_stop(&adv_sched_timer);
+    adv_sched.generation++;
+    adv_sched.mode = BTM_BLE_ADVERT_OFF;
+#ifdef ENABLE_EXT_ADV
+    app_bt_ext_adv_stop_all();
+#endif
+}
+
+/**
+* Function Name:
+* app_bt_adv_on_disconnect
+*
+* Function Description:
+* @brief   This function restarts the interval curve from its first step. It
+*          must be called on disconnection before advertising is restarted.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_on_disconnect(void)
+{
+    cy_rtos_get_time(&adv_sched.ref_time);
+}
+
+/**
+* Function Name:
+* app_bt_adv_set_curve
+*
+* Function Description:
+* @brief   This function replaces one of the advertising interval curves. It
+*          takes effect the next time advertising is started.
+*
+* @param   bonded: WICED_TRUE for the curve used while bonded peers exist
+* @param   p_steps: Steps of the curve, sorted by elapsed_ms, the first at 0
+* @param   num_steps: Number of steps, up to ADV_SCHED_MAX_STEPS
+*
+* @return  wiced_bool_t: WICED_TRUE if the curve was valid and got applied
+*/
+wiced_bool_t app_bt_adv_set_curve(wiced_bool_t bonded,
+                                  const adv_sched_step_t *p_steps,
+                                  uint8_t num_steps)
+{
+    adv_sched_curve_t *p_curve = bonded ? &adv_sched_curve_bonded : &adv_sched_curve_unbonded;
+
+    if ((0 == num_steps) || (ADV_SCHED_MAX_STEPS < num_steps) || (0 != p_steps[0].elapsed_ms))
+    {
+        return WICED_FALSE;
+    }
+    for (uint8_t i = 1; i < num_steps; i++)
+    {
+        if (p_steps[i].elapsed_ms <= p_steps[i - 1].elapsed_ms)
+        {
+            return WICED_FALSE;
+        }
+    }
+
+    memcpy(p_curve->steps, p_steps, num_steps * sizeof(adv_sched_step_t));
+    p_curve->num_steps = num_steps;
+
+    return WICED_TRUE;
+}
+
+/**
+* Function Name:
+* app_bt_adv_print_sched
+*
+* Function Description:
+* @brief   This function prints the advertising interval curves and the current
+*          step of the scheduler
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_print_sched(void)
+{
+    const adv_sched_curve_t *curves[] = { &adv_sched_curve_unbonded, &adv_sched_curve_bonded };
+    const char *names[] = { "No bond", "Bonded" };
+
+    for (uint8_t c = 0; c < 2; c++)
+    {
+        printf("%s advertising curve: ", names[c]);
+        for (uint8_t i = 0; i < curves[c]->num_steps; i++)
+        {
+            printf("%" PRIu32 " s: %" PRIu32 " ms  ", curves[c]->steps[i].elapsed_ms / 1000,
+                   ((uint32_t)curves[c]->steps[i].interval * 5) / 8);
+        }
+        printf("\r\n");
+    }
+
+    if (BTM_BLE_ADVERT_OFF == adv_sched.mode)
+    {
+        printf("Advertising scheduler idle\r\n");
+    }
+    else
+    {
+        printf("Advertising scheduler at step %d, %" PRIu32 " s since last disconnect\r\n",
+               adv_sched.step + 1, adv_sched_elapsed_ms() / 1000);
+    }
+}
+
+/**
+* Function Name:
+* app_bt_adv_print_transitions
+*
+* Function Description:
+* @brief   This function prints how long the advertising transitions took,
+*          from the request until the controller accepted the last command
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_print_transitions(void)
+{
+    const char *names[ADV_TRANSITION_MAX] = { "Off", "Directed", "Undirected", "Accept list", "Interval step" };
+
+    printf("Advertising transitions (us)   count  payload    last     min     max    mean\r\n");
+    for (uint8_t i = 0; i < ADV_TRANSITION_MAX; i++)
+    {
+        adv_transition_stats_t *p_stats = &adv_transition_stats[i];
+
+        if (0 == p_stats->count)
+        {
+            continue;
+        }
+        printf("  %-28s %6" PRIu32 " %8" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 "\r\n",
+               names[i], p_stats->count, p_stats->swaps, p_stats->last_us, p_stats->min_us,
+               p_stats->max_us, (uint32_t)(p_stats->total_us / p_stats->count));
+    }
+    printf("Advertising payloads sent to the controller: %" PRIu32 "\r\n", app_bt_adv_payload_swaps());
+}
+
+/**
+* Function Name:
+* adv_sched_elapsed_ms
+*
+* Function Description:
+* @brief   This function returns the time since the last disconnect
+*
+* @param   None
+*
+* @return  uint32_t: Time since the last disconnect (or boot) in ms
+*/
+static uint32_t adv_sched_elapsed_ms(void)
+{
+    cy_time_t now;
+
+    cy_rtos_get_time(&now);
+    return (uint32_t)(now - adv_sched.ref_time);
+}
+
+/**
+* Function Name:
+* adv_sched_apply
+*
+* Function Description:
+* @brief   This function writes the interval of the current step to the
+*          advertising configuration, (re)starts advertising and arms the timer
+*          for the next step. Directed advertising starts with the high duty
+*          burst on the first step only; later steps use low duty directed
+*          advertising at the step interval.
+*
+* @param   restart: WICED_TRUE to stop the running advertising first
+*
+* @return  wiced_result_t: Result of starting the advertising
+*/
+static wiced_result_t adv_sched_apply(wiced_bool_t restart)
+{
+    const adv_sched_step_t *p_step = &adv_sched.p_curve->steps[adv_sched.step];
+    wiced_bt_ble_advert_mode_t mode = adv_sched.mode;
+    wiced_bool_t directed = (BTM_BLE_ADVERT_DIRECTED_HIGH == mode) || (BTM_BLE_ADVERT_DIRECTED_LOW == mode);
+    wiced_result_t result;
+
+#ifdef ENABLE_EXT_ADV
+    (void) directed;
+    if (0 == p_step->interval)
+    {
+        app_bt_ext_adv_stop_all();
+        led_task_communicator(BTM_BLE_ADVERT_OFF);
+        APP_LOG0(LOG_ADV_SCHEDULE_STOP);
+        adv_sched.mode = BTM_BLE_ADVERT_OFF;
+        return WICED_BT_SUCCESS;
+    }
+
+    result = adv_sched_apply_ext(restart, p_step->interval);
+#else
+    if (restart)
+    {
+        wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF, 0, NULL);
+    }
+
+    if (0 == p_step->interval)
+    {
+        APP_LOG0(LOG_ADV_SCHEDULE_STOP);
+        adv_sched.mode = BTM_BLE_ADVERT_OFF;
+        return WICED_BT_SUCCESS;
+    }
+
+    if (directed)
+    {
+        app_bt_cfg_ble_advert.low_duty_directed_min_interval = p_step->interval;
+        app_bt_cfg_ble_advert.low_duty_directed_max_interval = p_step->interval;
+        if (0 < adv_sched.step)
+        {
+            mode = BTM_BLE_ADVERT_DIRECTED_LOW;
+        }
+    }
+    else
+    {
+        app_bt_cfg_ble_advert.high_duty_min_interval = p_step->interval;
+        app_bt_cfg_ble_advert.high_duty_max_interval = p_step->interval;
+        app_bt_cfg_ble_advert.low_duty_min_interval = p_step->interval;
+        app_bt_cfg_ble_advert.low_duty_max_interval = p_step->interval;
+    }
+
+    /* Only sends data if the payload of the mode is not the loaded one */
+    if (!restart)
+    {
+        result = app_bt_adv_payload_load(directed ? ADV_PAYLOAD_DIRECTED : ADV_PAYLOAD_DISCOVERABLE);
+        if (WICED_BT_SUCCESS != result)
+        {
+            adv_sched.mode = BTM_BLE_ADVERT_OFF;
+            return result;
+        }
+    }
+
+    result = wiced_bt_start_advertisements(mode, adv_sched.addr_type, directed ? adv_sched.bd_addr : NULL);
+#endif
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_ADV_START_FAILED, result);
+        adv_sched.mode = BTM_BLE_ADVERT_OFF;
+        return result;
+    }
+
+    if (restart)
+    {
+        APP_LOG(LOG_ADV_STEP, adv_sched.step + 1, ((uint32_t)p_step->interval * 5) / 8);
+    }
+
+    /* Arm the timer for the next step */
+    if ((adv_sched.step + 1) < adv_sched.p_curve->num_steps)
+    {
+        uint32_t elapsed = adv_sched_elapsed_ms();
+        uint32_t next = adv_sched.p_curve->steps[adv_sched.step + 1].elapsed_ms;
+
+        cy_rtos_timer_start(&adv_sched_timer, (next > elapsed) ? (next - elapsed) : 1);
+    }
+
+    return result;
+}
+
+/**
+* Function Name:
+* adv_sched_select_step
+*
+* Function Description:
+* @brief   This function selects the curve matching the bond state and the
+*          step of the curve matching the time since the last disconnect
+*
+* @param   None
+*
+* @return  None
+*/
+static void adv_sched_select_step(void)
+{
+    uint32_t elapsed = adv_sched_elapsed_ms();
+
+    adv_sched.p_curve = (0 < bondinfo.slot_data[NUM_BONDED]) ? &adv_sched_curve_bonded :
+                                                                &adv_sched_curve_unbonded;
+    adv_sched.step = 0;
+    while (((adv_sched.step + 1) < adv_sched.p_curve->num_steps) &&
+           (adv_sched.p_curve->steps[adv_sched.step + 1].elapsed_ms <= elapsed))
+    {
+        adv_sched.step++;
+    }
+}
+
+#ifdef ENABLE_EXT_ADV
+/**
+* Function Name:
+* adv_sched_apply_ext
+*
+* Function Description:
+* @brief   This function maps the requested mode on the extended advertising
+*          sets. Directed requests only touch the bonded set. Undirected
+*          requests enable the bond mode set and, if it is idle, put the
+*          bonded set on the filter accept list so bonded peers can still
+*          reconnect. Extended advertising reports no advertising state
+*          events, the LED is updated from here instead.
+*
+* @param   restart: WICED_TRUE to only move the running sets to the interval
+* @param   interval: Advertising interval in 0.625 ms slots
+*
+* @return  wiced_result_t: WICED_BT_SUCCESS if the sets are running
+*/
+static wiced_result_t adv_sched_apply_ext(wiced_bool_t restart, uint16_t interval)
+{
+    wiced_bt_ble_advert_mode_t mode = adv_sched.mode;
+    wiced_result_t result;
+
+    if (restart)
+    {
+        return app_bt_ext_adv_set_interval(interval);
+    }
+
+    switch (mode)
+    {
+    case BTM_BLE_ADVERT_DIRECTED_HIGH:
+    case BTM_BLE_ADVERT_DIRECTED_LOW:
+        result = app_bt_ext_adv_set(EXT_ADV_SET_BONDED, EXT_ADV_DIRECTED, interval,
+                                    adv_sched.addr_type, adv_sched.bd_addr);
+        mode = BTM_BLE_ADVERT_DIRECTED_LOW;
+        break;
+
+    case ADV_SCHED_MODE_ACCEPT_LIST:
+        result = app_bt_ext_adv_set(EXT_ADV_SET_BONDED, EXT_ADV_ACCEPT_LIST, interval, 0, NULL);
+        mode = BTM_BLE_ADVERT_UNDIRECTED_LOW;
+        break;
+
+    default:
+        result = app_bt_ext_adv_set(EXT_ADV_SET_BOND_MODE, EXT_ADV_UNDIRECTED, interval, 0, NULL);
+        if (0 == bondinfo.slot_data[NUM_BONDED])
+        {
+            app_bt_ext_adv_set(EXT_ADV_SET_BONDED, EXT_ADV_OFF, 0, 0, NULL);
+        }
+        else if (EXT_ADV_OFF == app_bt_ext_adv_get_mode(EXT_ADV_SET_BONDED))
+        {
+            app_bt_ext_adv_set(EXT_ADV_SET_BONDED, EXT_ADV_ACCEPT_LIST, interval, 0, NULL);
+        }
+        /* Directed advertising still running, keep the LED showing it */
+        if (EXT_ADV_DIRECTED == app_bt_ext_adv_get_mode(EXT_ADV_SET_BONDED))
+        {
+            mode = BTM_BLE_ADVERT_DIRECTED_LOW;
+        }
+        break;
+    }
+
+    if (WICED_BT_SUCCESS == result)
+    {
+        led_task_communicator(mode);
+    }
+
+    return result;
+}
+#endif
+
+/**
+* Function Name:
+* app_bt_adv_event_handler
+*
+* Function Description:
+* @brief   This function moves the scheduler to the next step of the curve. It
+*          runs in the event loop, like the starts of the advertising, so the
+*          scheduler state is never changed from two tasks at once. The step is
+*          dropped if the scheduler was started or stopped since it was posted.
+*
+* @param   data: Scheduler generation when the timer expired
+*
+* @return  None
+*/
+void app_bt_adv_event_handler(uint32_t data)
+{
+    uint32_t start_us;
+    uint32_t start_swaps;
+
+    if ((data != adv_sched.generation) ||
+        (BTM_BLE_ADVERT_OFF == adv_sched.mode) ||
+        ((adv_sched.step + 1) >= adv_sched.p_curve->num_steps))
+    {
+        return;
+    }
+
+    start_us = app_timestamp_us();
+    start_swaps = app_bt_adv_payload_swaps();
+
+    adv_sched.step++;
+    adv_sched_apply(WICED_TRUE);
+    adv_transition_record(ADV_TRANSITION_STEP, start_us, start_swaps);
+}
+
+/**
+* Function Name:
+* adv_sched_timer_cb
+*
+* Function Description:
+* @brief   This function posts the next step of the curve to the event loop.
+*          It runs on the timer thread and does not call the stack.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void adv_sched_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void) arg;
+
+    app_event_post(APP_EVT_ADV_STEP, adv_sched.generation);
+}
+
+/**
+* Function Name:
+* adv_transition_record
+*
+* Function Description:
+* @brief   This function adds the duration of an advertising transition to its
+*          statistics
+*
+* @param   kind: Kind of transition
+* @param   start_us: Timestamp taken when the transition was requested
+* @param   start_swaps: Payload swap count when the transition was requested
+*
+* @return  None
+*/
+static void adv_transition_record(adv_transition_t kind, uint32_t start_us, uint32_t start_swaps)
+{
+    adv_transition_stats_t *p_stats = &adv_transition_stats[kind];
+    uint32_t duration = app_timestamp_us() - start_us;
+
+    p_stats->count++;
+    if (app_bt_adv_payload_swaps() != start_swaps)
+    {
+        p_stats->swaps++;
+    }
+    p_stats->last_us = duration;
+    p_stats->total_us += duration;
+    if (duration < p_stats->min_us)
+    {
+        p_stats->min_us = duration;
+    }
+    if (duration > p_stats->max_us)
+    {
+        p_stats->max_us = duration;
+    }
+}
+
+/* [] END OF FILE */
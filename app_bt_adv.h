@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   app_bt_adv.h
+*
+* Description: This is the header file for the advertising control and the
+*              adaptive advertising interval scheduler of the Peripheral_Privacy
+*              Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BT_ADV_H_
+#define __APP_BT_ADV_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Max number of steps of an advertising interval curve */
+#define ADV_SCHED_MAX_STEPS                 (8)
+
+/* Convert milliseconds to advertising interval slots of 0.625 ms */
+#define ADV_SCHED_MS_TO_SLOTS(ms)           ((uint16_t)(((ms) * 8) / 5))
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* One step of an advertising interval curve */
+typedef struct
+{
+    uint32_t    elapsed_ms;     /* Step applies from this time since the last disconnect */
+    uint16_t    interval;       /* Advertising interval in 0.625 ms slots, 0 stops advertising */
+} adv_sched_step_t;
+
+/* Advertising interval curve, steps sorted by elapsed_ms, first step at 0 */
+typedef struct
+{
+    adv_sched_step_t    steps[ADV_SCHED_MAX_STEPS];
+    uint8_t             num_steps;
+} adv_sched_curve_t;
+
+/*******************************************************************************
+ * Variable Definitions
+ ******************************************************************************/
+/* Curve used while bonded peers exist */
+extern adv_sched_curve_t    adv_sched_curve_bonded;
+
+/* Curve used while no peer is bonded */
+extern adv_sched_curve_t    adv_sched_curve_unbonded;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_bt_adv_init(void);
+wiced_result_t  app_bt_adv_start(wiced_bt_ble_advert_mode_t mode,
+                                 wiced_bt_ble_address_type_t addr_type,
+                                 wiced_bt_device_address_ptr_t bd_addr);
+wiced_result_t  app_bt_adv_start_accept_list(void);
+void            app_bt_adv_exit_bond_mode(void);
+wiced_bt_ble_advert_mode_t app_bt_adv_get_mode(void);
+void            app_bt_adv_on_connect(void);
+void            app_bt_adv_on_disconnect(void);
+wiced_bool_t    app_bt_adv_set_curve(wiced_bool_t bonded,
+                                     const adv_sched_step_t *p_steps,
+                                     uint8_t num_steps);
+void            app_bt_adv_print_sched(void);
+void            app_bt_adv_print_transitions(void);
+void            app_bt_adv_event_handler(uint32_t data);
+
+#endif // __APP_BT_ADV_H_
+
+/* [] END OF FILE */
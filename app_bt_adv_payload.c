@@ -0,0 +1,334 @@
+/******************************************************************************
+* File Name:   app_bt_adv_payload.c
+*
+* Description: This file contains the advertising payload bank of the
+*              Peripheral_Privacy Example for ModusToolbox. All advertising and scan
+*              response payloads are built and serialized once at startup; switching
+*              the advertising mode only selects another entry of the bank and sends
+*              the data to the controller if it differs from what is loaded.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_stack.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "cycfg_gap.h"
+#include "app_bt_adv_payload.h"
+#include "app_log.h"
+#ifdef ENABLE_EXT_ADV
+#include "app_bt_ext_adv.h"
+#endif
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* LE only, not discoverable: only peers that know the device look for it */
+static uint8_t adv_payload_flags_reconnect[] = { BTM_BLE_BREDR_NOT_SUPPORTED };
+
+static wiced_bt_ble_advert_elem_t adv_payload_reconnect_adv[] =
+{
+    {
+        .p_data = adv_payload_flags_reconnect,
+        .len = sizeof(adv_payload_flags_reconnect),
+        .advert_type = BTM_BLE_ADVERT_TYPE_FLAG,
+    },
+};
+
+/* Device name, copied from the generated advertising data at init */
+static wiced_bt_ble_advert_elem_t adv_payload_reconnect_scan_rsp[1];
+
+static adv_payload_t        adv_payload_bank[ADV_PAYLOAD_MAX];
+
+/* Payloads loaded in the controller for legacy advertising */
+static const adv_payload_t  *adv_payload_active_adv;
+static const adv_payload_t  *adv_payload_active_scan_rsp;
+
+#ifdef ENABLE_EXT_ADV
+/* Payload loaded in each extended advertising set */
+static const adv_payload_t  *adv_payload_set_active[EXT_ADV_NUM_SETS];
+#endif
+
+/* Number of payloads sent to the controller */
+static uint32_t             adv_payload_num_swaps;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint8_t  adv_payload_serialize   (wiced_bt_ble_advert_elem_t *p_elems,
+                                         uint8_t *p_num_elems,
+                                         uint8_t *p_buf);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_bt_adv_payload_init
+*
+* Function Description:
+* @brief   This function builds all the payloads of the bank. The discoverable
+*          payload uses the advertising data generated from design.cybt, with
+*          no scan response, as before the bank.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_adv_payload_init(void)
+{
+    adv_payload_t *p_payload;
+    uint8_t num_name = 0;
+
+    for (uint8_t i = 0; i < CY_BT_ADV_PACKET_DATA_SIZE; i++)
+    {
+        if (BTM_BLE_ADVERT_TYPE_NAME_COMPLETE == cy_bt_adv_packet_data[i].advert_type)
+        {
+            adv_payload_reconnect_scan_rsp[0] = cy_bt_adv_packet_data[i];
+            num_name = 1;
+        }
+    }
+
+    memset(adv_payload_bank, 0, sizeof(adv_payload_bank));
+
+    p_payload = &adv_payload_bank[ADV_PAYLOAD_DISCOVERABLE];
+    p_payload->p_adv_elems = cy_bt_adv_packet_data;
+    p_payload->num_adv_elems = CY_BT_ADV_PACKET_DATA_SIZE;
+
+    p_payload = &adv_payload_bank[ADV_PAYLOAD_RECONNECT];
+    p_payload->p_adv_elems = adv_payload_reconnect_adv;
+    p_payload->num_adv_elems = sizeof(adv_payload_reconnect_adv) / sizeof(wiced_bt_ble_advert_elem_t);
+    p_payload->p_scan_rsp_elems = adv_payload_reconnect_scan_rsp;
+    p_payload->num_scan_rsp_elems = num_name;
+
+    for (uint8_t id = 0; id < ADV_PAYLOAD_MAX; id++)
+    {
+        p_payload = &adv_payload_bank[id];
+        p_payload->adv_len = adv_payload_serialize(p_payload->p_adv_elems, &p_payload->num_adv_elems,
+                                                   p_payload->adv_data);
+        p_payload->scan_rsp_len = adv_payload_serialize(p_payload->p_scan_rsp_elems,
+                                                        &p_payload->num_scan_rsp_elems,
+                                                        p_payload->scan_rsp_data);
+    }
+
+    adv_payload_active_adv = NULL;
+    adv_payload_active_scan_rsp = NULL;
+#ifdef ENABLE_EXT_ADV
+    /* A new set holds no data, same as the directed payload */
+    for (uint8_t i = 0; i < EXT_ADV_NUM_SETS; i++)
+    {
+        adv_payload_set_active[i] = &adv_payload_bank[ADV_PAYLOAD_DIRECTED];
+    }
+#endif
+    adv_payload_num_swaps = 0;
+}
+
+/**
+* Function Name:
+* app_bt_adv_payload_get
+*
+* Function Description:
+* @brief   This function returns one payload of the bank
+*
+* @param   id: Payload to return
+*
+* @return  const adv_payload_t *: Payload, NULL if id is out of range
+*/
+const adv_payload_t *app_bt_adv_payload_get(adv_payload_id_t id)
+{
+    return (ADV_PAYLOAD_MAX > id) ? &adv_payload_bank[id] : NULL;
+}
+
+/**
+* Function Name:
+* app_bt_adv_payload_load
+*
+* Function Description:
+* @brief   This function selects the payload used by legacy advertising. Data
+*          is only sent to the controller if it is not the loaded one, and is
+*          left untouched for directed advertising which sends none.
+*
+* @param   id: Payload to use
+*
+* @return  wiced_result_t: WICED_BT_SUCCESS if the payload is loaded
+*/
+wiced_result_t app_bt_adv_payload_load(adv_payload_id_t id)
+{
+    const adv_payload_t *p_payload = app_bt_adv_payload_get(id);
+    wiced_result_t result;
+
+    if ((NULL == p_payload) || (ADV_PAYLOAD_DIRECTED == id))
+    {
+        return WICED_BT_SUCCESS;
+    }
+
+    if (p_payload != adv_payload_active_adv)
+    {
+        result = wiced_bt_ble_set_raw_advertisement_data(p_payload->num_adv_elems, p_payload->p_adv_elems);
+        if (WICED_BT_SUCCESS != result)
+        {
+            APP_LOG(LOG_ADV_DATA_FAILED, result);
+            adv_payload_active_adv = NULL;
+            return result;
+        }
+        adv_payload_active_adv = p_payload;
+        adv_payload_num_swaps++;
+    }
+
+    if (p_payload != adv_payload_active_scan_rsp)
+    {
+        result = wiced_bt_ble_set_raw_scan_response_data(p_payload->num_scan_rsp_elems,
+                                                         p_payload->p_scan_rsp_elems);
+        if (WICED_BT_SUCCESS != result)
+        {
+            APP_LOG(LOG_SCAN_RSP_FAILED, result);
+            adv_payload_active_scan_rsp = NULL;
+            return result;
+        }
+        adv_payload_active_scan_rsp = p_payload;
+        adv_payload_num_swaps++;
+    }
+
+    return WICED_BT_SUCCESS;
+}
+
+#ifdef ENABLE_EXT_ADV
+/**
+* Function Name:
+* app_bt_adv_payload_load_set
+*
+* Function Description:
+* @brief   This function loads a payload in an extended advertising set if it
+*          holds another one. The set must be disabled. Loading the directed
+*          payload clears the set data, which must be done before the set is
+*          switched to directed advertising.
+*
+* @param   adv_handle: Handle of the advertising set
+* @param   id: Payload to load
+*
+* @return  wiced_result_t: WICED_BT_SUCCESS if the payload is loaded
+*/
+wiced_result_t app_bt_adv_payload_load_set(uint8_t adv_handle, adv_payload_id_t id)
+{
+    const adv_payload_t *p_payload = app_bt_adv_payload_get(id);
+    wiced_result_t result;
+
+    if ((NULL == p_payload) || (adv_handle < 1) || (EXT_ADV_NUM_SETS < adv_handle))
+    {
+        return WICED_BT_BADARG;
+    }
+    if (p_payload == adv_payload_set_active[adv_handle - 1])
+    {
+        return WICED_BT_SUCCESS;
+    }
+
+    result = wiced_bt_ble_set_ext_adv_data(adv_handle, p_payload->adv_len, (uint8_t *)p_payload->adv_data);
+    if (WICED_BT_SUCCESS == result)
+    {
+        result = wiced_bt_ble_set_ext_scan_rsp_data(adv_handle, p_payload->scan_rsp_len,
+                                                    (uint8_t *)p_payload->scan_rsp_data);
+    }
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_ADV_SET_DATA_FAILED, adv_handle, result);
+        return result;
+    }
+
+    adv_payload_set_active[adv_handle - 1] = p_payload;
+    adv_payload_num_swaps++;
+
+    return WICED_BT_SUCCESS;
+}
+#endif
+
+/**
+* Function Name:
+* app_bt_adv_payload_swaps
+*
+* Function Description:
+* @brief   This function returns how many payloads were sent to the controller
+*
+* @param   None
+*
+* @return  uint32_t: Number of payloads sent since init
+*/
+uint32_t app_bt_adv_payload_swaps(void)
+{
+    return adv_payload_num_swaps;
+}
+
+/**
+* Function Name:
+* adv_payload_serialize
+*
+* Function Description:
+* @brief   This function serializes advertising elements as length, type and
+*          data fields. Elements that do not fit are dropped from the payload.
+*
+* @param   p_elems: Elements to serialize
+* @param   p_num_elems: Number of elements, updated if some are dropped
+* @param   p_buf: Output buffer of ADV_PAYLOAD_MAX_LEN bytes
+*
+* @return  uint8_t: Serialized length
+*/
+static uint8_t adv_payload_serialize(wiced_bt_ble_advert_elem_t *p_elems,
+                                     uint8_t *p_num_elems,
+                                     uint8_t *p_buf)
+{
+    uint8_t len = 0;
+
+    for (uint8_t i = 0; i < *p_num_elems; i++)
+    {
+        if ((len + 2 + p_elems[i].len) > ADV_PAYLOAD_MAX_LEN)
+        {
+            APP_LOG(LOG_ADV_ELEM_DROPPED, p_elems[i].advert_type);
+            *p_num_elems = i;
+            break;
+        }
+        p_buf[len++] = (uint8_t)(p_elems[i].len + 1);
+        p_buf[len++] = p_elems[i].advert_type;
+        memcpy(&p_buf[len], p_elems[i].p_data, p_elems[i].len);
+        len += p_elems[i].len;
+    }
+
+    return len;
+}
+
+/* [] END OF FILE */
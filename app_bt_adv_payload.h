@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name:   app_bt_adv_payload.h
+*
+* Description: This is the header file for the advertising payload bank of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BT_ADV_PAYLOAD_H_
+#define __APP_BT_ADV_PAYLOAD_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Max size of a legacy advertising or scan response payload */
+#define ADV_PAYLOAD_MAX_LEN                 (31)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Payloads of the bank, one per kind of advertising */
+typedef enum
+{
+    ADV_PAYLOAD_DISCOVERABLE,   /* Bond mode: generated advertising data, no scan response */
+    ADV_PAYLOAD_RECONNECT,      /* Bonded peers only: not discoverable, name in the scan response */
+    ADV_PAYLOAD_DIRECTED,       /* Directed advertising carries no data */
+    ADV_PAYLOAD_MAX
+} adv_payload_id_t;
+
+/* Advertising and scan response data, as elements for the legacy API and
+ * serialized for the extended advertising API */
+typedef struct
+{
+    wiced_bt_ble_advert_elem_t  *p_adv_elems;
+    uint8_t                     num_adv_elems;
+    wiced_bt_ble_advert_elem_t  *p_scan_rsp_elems;
+    uint8_t                     num_scan_rsp_elems;
+    uint8_t                     adv_data[ADV_PAYLOAD_MAX_LEN];
+    uint8_t                     adv_len;
+    uint8_t                     scan_rsp_data[ADV_PAYLOAD_MAX_LEN];
+    uint8_t                     scan_rsp_len;
+} adv_payload_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void                    app_bt_adv_payload_init     (void);
+const adv_payload_t    *app_bt_adv_payload_get      (adv_payload_id_t id);
+wiced_result_t          app_bt_adv_payload_load     (adv_payload_id_t id);
+#ifdef ENABLE_EXT_ADV
+wiced_result_t          app_bt_adv_payload_load_set (uint8_t adv_handle, adv_payload_id_t id);
+#endif
+uint32_t                app_bt_adv_payload_swaps    (void);
+
+#endif // __APP_BT_ADV_PAYLOAD_H_
+
+/* [] END OF FILE */
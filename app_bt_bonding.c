@@ -53,6 +53,11 @@
 #include "app_bt_bonding.h"
 #include "mtb_kvstore_cat5.h"
 #include "app_utils.h"
+#include "app_log.h"
+#include "app_trace.h"
+#include "app_power.h"
+#include "app_metrics.h"
+#include "app_bt_privacy.h"
 #include "app_bt_bonding.h"
 #include "stdlib.h"
 #include <inttypes.h>
@@ -101,6 +106,62 @@ void app_kv_store_init(void)
     }
 }
 
+/**
+* Function Name:
+* app_bt_kv_read
+*
+* Function Description:
+* @brief   This function reads a key from the kv-store and traces the access.
+*          Pass a NULL buffer to check if the key exists.
+*
+* @param   key: Key to read
+* @param   p_data: Buffer for the value, or NULL
+* @param   p_size: Size of the buffer, updated with the size read, or NULL
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the key was read
+*/
+cy_rslt_t app_bt_kv_read(uint16_t key, uint8_t *p_data, uint32_t *p_size)
+{
+    cy_rslt_t rslt;
+
+    APP_TRACE(APP_TRACE_KV_READ_START, 0, key);
+    app_power_lock();
+    rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, key, p_data, p_size);
+    app_power_unlock();
+    APP_TRACE(APP_TRACE_KV_READ_END, (CY_RSLT_SUCCESS != rslt), key);
+    return rslt;
+}
+
+/**
+* Function Name:
+* app_bt_kv_write
+*
+* Function Description:
+* @brief   This function writes a key to the kv-store, replacing its value, and
+*          traces and counts the access.
+*
+* @param   key: Key to write
+* @param   p_data: Value
+* @param   size: Size of the value
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the key was written
+*/
+cy_rslt_t app_bt_kv_write(uint16_t key, const uint8_t *p_data, uint32_t size)
+{
+    cy_rslt_t rslt;
+
+    APP_TRACE(APP_TRACE_KV_WRITE_START, 0, key);
+    app_power_lock();
+    rslt = mtb_kvstore_write_numeric_key(&kvstore_obj, key, p_data, size, true);
+    app_power_unlock();
+    APP_TRACE(APP_TRACE_KV_WRITE_END, (CY_RSLT_SUCCESS != rslt), key);
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        app_metrics_on_kv_write(size);
+    }
+    return rslt;
+}
+
 /**
 * Function Name:
 * print_device_selection_menu
@@ -116,8 +177,7 @@ void print_device_selection_menu(void)
 {
     for (uint8_t i = 0; i < bondinfo.slot_data[NUM_BONDED]; i++)
     {
-        printf("Host %d: ", i + 1);
-        print_bd_address(bondinfo.link_keys[i].bd_addr);
+        APP_LOG(LOG_HOST, i + 1, APP_LOG_BDA(bondinfo.link_keys[i].bd_addr));
     }
 }
 
@@ -138,14 +198,14 @@ cy_rslt_t app_bt_restore_bond_data(void)
 {
     /* Read and restore contents of Serial flash */
     uint32_t data_size = sizeof(bondinfo);
-    cy_rslt_t rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, bond_data, NULL, NULL);
+    cy_rslt_t rslt = app_bt_kv_read(bond_data, NULL, NULL);
     if (rslt != CY_RSLT_SUCCESS)
     {
-        printf("Bond data not present in the flash!\n");
+        APP_LOG0(LOG_NO_BOND_DATA);
     }
     else
     {
-        rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, bond_data, (uint8_t *)&bondinfo, &data_size);
+        rslt = app_bt_kv_read(bond_data, (uint8_t *)&bondinfo, &data_size);
     }
 
     return rslt;
@@ -195,8 +255,8 @@ cy_rslt_t app_bt_update_cccd(uint16_t cccd, uint8_t index)
 {
         cy_rslt_t rslt = CY_RSLT_TYPE_ERROR;
         peer_cccd_data[index]= cccd;
-        printf("Updating CCCD Value to: %d \r\n",cccd);
-        rslt = mtb_kvstore_write_numeric_key(&kvstore_obj, cccd_data, (uint8_t *)&peer_cccd_data, sizeof(peer_cccd_data),true);
+        APP_LOG(LOG_CCCD_UPDATE, cccd);
+        rslt = app_bt_kv_write(cccd_data, (uint8_t *)&peer_cccd_data, sizeof(peer_cccd_data));
         return rslt;
 }
 
@@ -217,7 +277,7 @@ cy_rslt_t app_bt_restore_cccd(void)
 {
     cy_rslt_t rslt = CY_RSLT_TYPE_ERROR;
     uint32_t data_size = sizeof(peer_cccd_data);
-    rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, cccd_data, (uint8_t *)peer_cccd_data, &data_size);
+    rslt = app_bt_kv_read(cccd_data, (uint8_t *)peer_cccd_data, &data_size);
     return rslt;
 }
 
@@ -237,10 +297,10 @@ cy_rslt_t app_bt_restore_cccd(void)
 cy_rslt_t app_bt_update_bond_data(void)
 {
     cy_rslt_t rslt = CY_RSLT_TYPE_ERROR;
-    rslt = mtb_kvstore_write_numeric_key(&kvstore_obj, bond_data, (uint8_t *)&bondinfo, sizeof(bondinfo),true);
+    rslt = app_bt_kv_write(bond_data, (uint8_t *)&bondinfo, sizeof(bondinfo));
     if (CY_RSLT_SUCCESS != rslt)
     {
-        printf("Flash Write Error,Error code: %" PRIu32 "\r\n", rslt );
+        APP_LOG(LOG_FLASH_WRITE_ERROR_CODE, rslt);
     }
 
     return rslt;
@@ -313,6 +373,7 @@ wiced_result_t app_bt_delete_device_info(uint8_t index)
     }
 
     /* Remove bonding information in RAM */
+    app_bt_privacy_on_delete(index);
     peer_cccd_data[index]=0;
     bondinfo.privacy_mode[index]=0;
     memset(&bondinfo.link_keys[index], 0, sizeof(wiced_bt_device_link_keys_t));
@@ -320,6 +381,88 @@ wiced_result_t app_bt_delete_device_info(uint8_t index)
     return result;
 }
 
+/**
+* Function Name:
+* app_bt_delete_oldest_device
+*
+* Function Description:
+* @brief  This function frees a bond slot when all of them are in use, by
+*         removing the device bonded the longest ago, the one in the next free
+*         slot.
+*
+* @param  None
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the bond data was updated in the flash,
+*              an error code otherwise.
+*
+*/
+cy_rslt_t app_bt_delete_oldest_device(void)
+{
+    cy_rslt_t rslt;
+
+    APP_LOG0(LOG_BOND_SLOTS_FULL);
+
+    /* Remove oldest device from the bonded device list */
+    wiced_result_t result = app_bt_delete_device_info(bondinfo.slot_data[NEXT_FREE_INDEX]);
+    app_metrics_on_eviction();
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_BOND_DELETE_FAILED, result);
+    }
+    /* Reduce number of bonded devices by one */
+    bondinfo.slot_data[NUM_BONDED]--;
+
+    /*Update bond information in Flash*/
+    rslt = app_bt_update_bond_data();
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        APP_LOG(LOG_HOST_REMOVED, APP_LOG_BDA(bondinfo.link_keys[bondinfo.slot_data[NEXT_FREE_INDEX]].bd_addr));
+    }
+    else
+    {
+        APP_LOG0(LOG_HOST_REMOVE_FAILED);
+    }
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* app_bt_reset_kvstore
+*
+* Function Description:
+* @brief  This function erases the kv-store, the bond data and the local keys,
+*         and clears the bond data in RAM. New local keys are generated at the
+*         next reset.
+*
+* @param  None
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the kv-store was erased,
+*              an error code otherwise.
+*
+*/
+cy_rslt_t app_bt_reset_kvstore(void)
+{
+    cy_rslt_t rslt;
+
+    /*Reset Kv-store library, this will clear the flash*/
+    app_power_lock();
+    rslt = mtb_kvstore_reset(&kvstore_obj);
+    app_power_unlock();
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        APP_LOG0(LOG_KVSTORE_RESET);
+    }
+    else
+    {
+        APP_LOG(LOG_KVSTORE_RESET_FAILED, rslt);
+    }
+    /*Clear bondinfo structure*/
+    memset(&bondinfo, 0, sizeof(bondinfo));
+
+    return rslt;
+}
+
 /**
 * Function Name:
 * app_bt_save_device_link_keys
@@ -339,10 +482,10 @@ cy_rslt_t app_bt_save_device_link_keys(wiced_bt_device_link_keys_t *link_key)
     memcpy(&bondinfo.link_keys[bondinfo.slot_data[NEXT_FREE_INDEX]],
            (uint8_t *)(link_key), sizeof(wiced_bt_device_link_keys_t));
 
-    rslt = mtb_kvstore_write_numeric_key(&kvstore_obj, bond_data, (uint8_t *)&bondinfo, sizeof(bondinfo),true);
+    rslt = app_bt_kv_write(bond_data, (uint8_t *)&bondinfo, sizeof(bondinfo));
     if (CY_RSLT_SUCCESS != rslt)
     {
-        printf("Flash Write Error,Error code: %" PRIu32 "\r\n", rslt );
+        APP_LOG(LOG_FLASH_WRITE_ERROR_CODE, rslt);
     }
     return rslt;
 }
@@ -367,7 +510,7 @@ uint8_t app_bt_find_device_in_flash(uint8_t *bd_addr)
     {
         if (0 == memcmp(&(bondinfo.link_keys[count].bd_addr), bd_addr, sizeof(wiced_bt_device_address_t)))
         {
-            printf("Found device in the flash!\n");
+            APP_LOG0(LOG_DEVICE_FOUND);
             index = count;
             break; /* Exit the loop since we found what we want */
         }
@@ -391,16 +534,16 @@ uint8_t app_bt_find_device_in_flash(uint8_t *bd_addr)
 cy_rslt_t app_bt_read_local_identity_keys(void)
 {
     uint32_t data_size = sizeof(identity_keys);
-    cy_rslt_t rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, local_irk, NULL, NULL);
+    cy_rslt_t rslt = app_bt_kv_read(local_irk, NULL, NULL);
     if (rslt != CY_RSLT_SUCCESS)
     {
-        printf("Error Reading Keys! New Keys need to be generated! \r\n");
+        APP_LOG0(LOG_KEYS_READ_ERROR);
     }
     else
     {
-        printf("Identity keys are available in the database.\r\n");
-        rslt = mtb_kvstore_read_numeric_key(&kvstore_obj, local_irk, (uint8_t *)&identity_keys, &data_size);
-        printf("Local identity keys read from Flash: \r\n");
+        APP_LOG0(LOG_KEYS_AVAILABLE);
+        rslt = app_bt_kv_read(local_irk, (uint8_t *)&identity_keys, &data_size);
+        APP_LOG0(LOG_KEYS_READ);
     }
     return rslt;
 }
@@ -420,14 +563,14 @@ cy_rslt_t app_bt_read_local_identity_keys(void)
 cy_rslt_t app_bt_save_local_identity_key(wiced_bt_local_identity_keys_t id_key)
 {
     memcpy(&identity_keys, (uint8_t *)&(id_key), sizeof(wiced_bt_local_identity_keys_t));
-    cy_rslt_t rslt = mtb_kvstore_write_numeric_key(&kvstore_obj, local_irk, (uint8_t *)&identity_keys, sizeof(wiced_bt_local_identity_keys_t),true);
+    cy_rslt_t rslt = app_bt_kv_write(local_irk, (uint8_t *)&identity_keys, sizeof(wiced_bt_local_identity_keys_t));
     if (CY_RSLT_SUCCESS == rslt)
     {
-        printf("Local identity Keys saved to Flash \r\n");
+        APP_LOG0(LOG_KEYS_SAVED);
     }
     else
     {
-        printf("Flash Write Error,Error code: %" PRIu32 "\r\n", rslt );
+        APP_LOG(LOG_FLASH_WRITE_ERROR_CODE, rslt);
     }
 
     return rslt;
@@ -454,12 +597,11 @@ void app_bt_add_devices_to_address_resolution_db(void)
         wiced_result_t result = wiced_bt_dev_add_device_to_address_resolution_db(&bondinfo.link_keys[i]);
         if (WICED_BT_SUCCESS == result)
         {
-            printf("Device added to address resolution database: ");
-            print_bd_address((uint8_t *)&bondinfo.link_keys[i].bd_addr);
+            APP_LOG(LOG_RESOLVING_LIST_ADDED, APP_LOG_BDA(bondinfo.link_keys[i].bd_addr));
         }
         else
         {
-            printf("Error adding device to address resolution database, Error Code %d \n", result);
+            APP_LOG(LOG_RESOLVING_LIST_ERROR, result);
         }
     }
 }
@@ -480,11 +622,7 @@ void print_bond_data()
 {
     for (uint8_t i = 0; i < bondinfo.slot_data[NUM_BONDED] && i< BOND_INDEX_MAX; i++)
     {
-        printf("Slot: %d",i+1);
-        printf("Device Bluetooth Address: ");
-        print_bd_address(bondinfo.link_keys[i].bd_addr);
-        printf("Device Keys: \n");
-        print_array(&(bondinfo.link_keys[i].key_data), sizeof(wiced_bt_device_sec_keys_t));
-        printf("\n");
+        APP_LOG(LOG_BOND_DATA_SLOT, i + 1, APP_LOG_BDA(bondinfo.link_keys[i].bd_addr));
+        APP_LOG_HEXDUMP(&(bondinfo.link_keys[i].key_data), sizeof(wiced_bt_device_sec_keys_t));
     }
 }
@@ -55,8 +55,11 @@
 /*******************************************************************************
 *        Macro Definitions
 *******************************************************************************/
-/* Max number of bonded devices */
+/* Max number of bonded devices, at most 255. Set with BOND_INDEX_MAX in the
+ * make file. */
+#ifndef BOND_INDEX_MAX
 #define  BOND_INDEX_MAX                      (4)
+#endif
 /* LE Key Size */
 #define  KEY_SIZE_MAX                        (0x10)
 
@@ -102,10 +105,14 @@ extern wiced_bt_local_identity_keys_t identity_keys;
  * Function Prototypes
  ******************************************************************/
 void                 app_kv_store_init(void);
+cy_rslt_t             app_bt_kv_read(uint16_t key, uint8_t *p_data, uint32_t *p_size);
+cy_rslt_t             app_bt_kv_write(uint16_t key, const uint8_t *p_data, uint32_t size);
 cy_rslt_t             app_bt_restore_bond_data(void);
 cy_rslt_t             app_bt_update_bond_data(void);
 cy_rslt_t             app_bt_delete_bond_info(void);
 wiced_result_t         app_bt_delete_device_info(uint8_t index);
+cy_rslt_t             app_bt_delete_oldest_device(void);
+cy_rslt_t             app_bt_reset_kvstore(void);
 cy_rslt_t             app_bt_update_slot_data(void);
 cy_rslt_t             app_bt_save_device_link_keys(wiced_bt_device_link_keys_t *link_key);
 cy_rslt_t             app_bt_save_local_identity_key(wiced_bt_local_identity_keys_t id_key);
@@ -0,0 +1,335 @@
+/******************************************************************************
+* File Name:   app_bt_ext_adv.c
+*
+* Description: This file contains the extended advertising sets of the
+*              Peripheral_Privacy Example for ModusToolbox. Bonded peers and new
+*              peers get their own advertising set, so both can advertise at the
+*              same time and one set can be changed without stopping the other.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_stack.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_bt_cfg.h"
+#include "app_bt_bonding.h"
+#include "app_bt_adv_payload.h"
+#include "app_bt_ext_adv.h"
+#include "app_log.h"
+
+#ifdef ENABLE_EXT_ADV
+
+#if (BOND_INDEX_MAX > EXT_ADV_ACCEPT_LIST_SIZE)
+#error "BOND_INDEX_MAX is larger than the filter accept list, raise FilterAcceptListSize in design.cybt and EXT_ADV_ACCEPT_LIST_SIZE"
+#endif
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* State of one advertising set */
+typedef struct
+{
+    ext_adv_set_mode_t              mode;
+    uint16_t                        interval;       /* Advertising interval in 0.625 ms slots */
+    wiced_bt_ble_address_type_t     addr_type;      /* Peer address type when directed */
+    wiced_bt_device_address_t       bd_addr;        /* Peer address when directed */
+} ext_adv_set_t;
+
+static ext_adv_set_t    ext_adv_sets[EXT_ADV_NUM_SETS];
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static wiced_result_t   ext_adv_enable              (uint8_t adv_handle, wiced_bool_t enable);
+static void             ext_adv_update_accept_list  (void);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_bt_ext_adv_init
+*
+* Function Description:
+* @brief   This function resets the state of the advertising sets. Their
+*          payloads come from the advertising payload bank.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_ext_adv_init(void)
+{
+    memset(ext_adv_sets, 0, sizeof(ext_adv_sets));
+}
+
+/**
+* Function Name:
+* app_bt_ext_adv_set
+*
+* Function Description:
+* @brief   This function (re)configures one advertising set. Only this set is
+*          stopped while its parameters change, the other set keeps
+*          advertising. Directed sets are legacy ADV_DIRECT_IND at the given
+*          interval, the other modes are legacy ADV_IND.
+*
+* @param   adv_handle: EXT_ADV_SET_BONDED or EXT_ADV_SET_BOND_MODE
+* @param   mode: New mode of the set, EXT_ADV_OFF disables it
+* @param   interval: Advertising interval in 0.625 ms slots
+* @param   addr_type: Peer address type, used for directed advertising only
+* @param   bd_addr: Peer address, used for directed advertising only
+*
+* @return  wiced_result_t: WICED_BT_SUCCESS if the set is running in the new mode
+*/
+wiced_result_t app_bt_ext_adv_set(uint8_t adv_handle,
+                                  ext_adv_set_mode_t mode,
+                                  uint16_t interval,
+                                  wiced_bt_ble_address_type_t addr_type,
+                                  wiced_bt_device_address_ptr_t bd_addr)
+{
+    ext_adv_set_t *p_set;
+    wiced_bt_ble_ext_adv_event_property_t properties;
+    wiced_bt_ble_advert_filter_policy_t policy = BTM_BLE_ADV_POLICY_ACCEPT_CONN_AND_SCAN;
+    wiced_result_t result;
+
+    if ((adv_handle < 1) || (EXT_ADV_NUM_SETS < adv_handle))
+    {
+        return WICED_BT_BADARG;
+    }
+    p_set = &ext_adv_sets[adv_handle - 1];
+
+    if (EXT_ADV_OFF != p_set->mode)
+    {
+        ext_adv_enable(adv_handle, WICED_FALSE);
+    }
+    p_set->mode = EXT_ADV_OFF;
+    if (EXT_ADV_OFF == mode)
+    {
+        return WICED_BT_SUCCESS;
+    }
+
+    if (EXT_ADV_DIRECTED == mode)
+    {
+        properties = WICED_BT_BLE_EXT_ADV_EVENT_LEGACY_ADV | WICED_BT_BLE_EXT_ADV_EVENT_CONNECTABLE_ADV |
+                     WICED_BT_BLE_EXT_ADV_EVENT_DIRECTED_ADV;
+        p_set->addr_type = addr_type;
+        memcpy(p_set->bd_addr, bd_addr, sizeof(wiced_bt_device_address_t));
+
+        /* ADV_DIRECT_IND carries no data, the controller refuses it while data is set */
+        app_bt_adv_payload_load_set(adv_handle, ADV_PAYLOAD_DIRECTED);
+    }
+    else
+    {
+        properties = WICED_BT_BLE_EXT_ADV_EVENT_LEGACY_ADV | WICED_BT_BLE_EXT_ADV_EVENT_CONNECTABLE_ADV |
+                     WICED_BT_BLE_EXT_ADV_EVENT_SCANNABLE_ADV;
+        if (EXT_ADV_ACCEPT_LIST == mode)
+        {
+            /* The list can only change while no set filtering on it is enabled */
+            ext_adv_update_accept_list();
+            policy = BTM_BLE_ADV_POLICY_FILTER_CONN_FILTER_SCAN;
+        }
+    }
+
+    result = wiced_bt_ble_set_ext_adv_parameters(adv_handle, properties, interval, interval,
+                                                 app_bt_cfg_ble_advert.channel_map, BLE_ADDR_RANDOM,
+                                                 p_set->addr_type, p_set->bd_addr, policy, 0,
+                                                 WICED_BT_BLE_EXT_ADV_PHY_1M, 0, WICED_BT_BLE_EXT_ADV_PHY_1M,
+                                                 adv_handle, WICED_BT_BLE_EXT_ADV_SCAN_REQ_NOTIFY_DISABLE);
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_ADV_SET_PARAM_FAILED, adv_handle, result);
+        return result;
+    }
+
+    if (EXT_ADV_DIRECTED != mode)
+    {
+        result = app_bt_adv_payload_load_set(adv_handle, (EXT_ADV_ACCEPT_LIST == mode) ?
+                                             ADV_PAYLOAD_RECONNECT : ADV_PAYLOAD_DISCOVERABLE);
+        if (WICED_BT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    result = ext_adv_enable(adv_handle, WICED_TRUE);
+    if (WICED_BT_SUCCESS == result)
+    {
+        p_set->mode = mode;
+        p_set->interval = interval;
+    }
+
+    return result;
+}
+
+/**
+* Function Name:
+* app_bt_ext_adv_set_interval
+*
+* Function Description:
+* @brief   This function moves all running advertising sets to a new interval,
+*          keeping their mode and peer
+*
+* @param   interval: Advertising interval in 0.625 ms slots
+*
+* @return  wiced_result_t: WICED_BT_SUCCESS if all sets were updated
+*/
+wiced_result_t app_bt_ext_adv_set_interval(uint16_t interval)
+{
+    wiced_result_t result = WICED_BT_SUCCESS;
+
+    for (uint8_t handle = 1; handle <= EXT_ADV_NUM_SETS; handle++)
+    {
+        ext_adv_set_t *p_set = &ext_adv_sets[handle - 1];
+
+        if ((EXT_ADV_OFF != p_set->mode) && (interval != p_set->interval))
+        {
+            wiced_result_t rslt = app_bt_ext_adv_set(handle, p_set->mode, interval,
+                                                     p_set->addr_type, p_set->bd_addr);
+            if (WICED_BT_SUCCESS != rslt)
+            {
+                result = rslt;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+* Function Name:
+* app_bt_ext_adv_stop_all
+*
+* Function Description:
+* @brief   This function disables all advertising sets. Called on connection
+*          too: the controller only terminates the set that got connected and
+*          the device supports a single link.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_ext_adv_stop_all(void)
+{
+    for (uint8_t handle = 1; handle <= EXT_ADV_NUM_SETS; handle++)
+    {
+        app_bt_ext_adv_set(handle, EXT_ADV_OFF, 0, 0, NULL);
+    }
+}
+
+/**
+* Function Name:
+* app_bt_ext_adv_get_mode
+*
+* Function Description:
+* @brief   This function returns what an advertising set is doing
+*
+* @param   adv_handle: EXT_ADV_SET_BONDED or EXT_ADV_SET_BOND_MODE
+*
+* @return  ext_adv_set_mode_t: Mode of the set
+*/
+ext_adv_set_mode_t app_bt_ext_adv_get_mode(uint8_t adv_handle)
+{
+    if ((adv_handle < 1) || (EXT_ADV_NUM_SETS < adv_handle))
+    {
+        return EXT_ADV_OFF;
+    }
+    return ext_adv_sets[adv_handle - 1].mode;
+}
+
+/**
+* Function Name:
+* ext_adv_enable
+*
+* Function Description:
+* @brief   This function enables or disables a single advertising set
+*
+* @param   adv_handle: Handle of the advertising set
+* @param   enable: WICED_TRUE to enable the set
+*
+* @return  wiced_result_t: Result of wiced_bt_ble_start_ext_adv()
+*/
+static wiced_result_t ext_adv_enable(uint8_t adv_handle, wiced_bool_t enable)
+{
+    /* No duration and no event limit, the advertising scheduler decides when to stop */
+    wiced_bt_ble_ext_adv_duration_config_t duration = { .adv_handle = adv_handle,
+                                                        .adv_duration = 0,
+                                                        .max_ext_adv_events = 0 };
+    wiced_result_t result;
+
+    result = wiced_bt_ble_start_ext_adv(enable, 1, &duration);
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_ADV_SET_ENABLE_FAILED, APP_LOG_STR(enable ? "enable" : "disable"), adv_handle, result);
+    }
+
+    return result;
+}
+
+/**
+* Function Name:
+* ext_adv_update_accept_list
+*
+* Function Description:
+* @brief   This function loads the identity addresses of all bonded peers in
+*          the filter accept list. The controller resolves the peer RPAs with
+*          the address resolution list before checking the accept list.
+*
+* @param   None
+*
+* @return  None
+*/
+static void ext_adv_update_accept_list(void)
+{
+    wiced_bt_ble_clear_filter_accept_list();
+    for (uint8_t i = 0; (i < bondinfo.slot_data[NUM_BONDED]) && (i < BOND_INDEX_MAX); i++)
+    {
+        if (WICED_BT_SUCCESS != wiced_bt_ble_update_advertising_filter_accept_list(WICED_TRUE,
+                                         bondinfo.link_keys[i].key_data.ble_addr_type,
+                                         bondinfo.link_keys[i].bd_addr))
+        {
+            APP_LOG(LOG_ACCEPT_LIST_FAILED, i + 1);
+        }
+    }
+}
+
+#endif /* ENABLE_EXT_ADV */
+
+/* [] END OF FILE */
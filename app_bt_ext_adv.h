@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   app_bt_ext_adv.h
+*
+* Description: This is the header file for the extended advertising sets of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BT_EXT_ADV_H_
+#define __APP_BT_EXT_ADV_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Advertising set used to reconnect bonded peers */
+#define EXT_ADV_SET_BONDED                  (1)
+
+/* Advertising set used to let new peers bond, enabled in bond mode only */
+#define EXT_ADV_SET_BOND_MODE               (2)
+
+#define EXT_ADV_NUM_SETS                    (2)
+
+/* Devices the filter accept list of the controller holds, FilterAcceptListSize
+ * of design.cybt. Every bonded peer must fit to reconnect through it. */
+#define EXT_ADV_ACCEPT_LIST_SIZE            (4)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* What an advertising set is currently doing */
+typedef enum
+{
+    EXT_ADV_OFF,            /* Set disabled */
+    EXT_ADV_DIRECTED,       /* Connectable directed to one peer */
+    EXT_ADV_ACCEPT_LIST,    /* Connectable, only peers of the filter accept list can connect */
+    EXT_ADV_UNDIRECTED,     /* Connectable undirected, anybody can connect */
+} ext_adv_set_mode_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void                app_bt_ext_adv_init         (void);
+wiced_result_t      app_bt_ext_adv_set          (uint8_t adv_handle,
+                                                 ext_adv_set_mode_t mode,
+                                                 uint16_t interval,
+                                                 wiced_bt_ble_address_type_t addr_type,
+                                                 wiced_bt_device_address_ptr_t bd_addr);
+wiced_result_t      app_bt_ext_adv_set_interval (uint16_t interval);
+void                app_bt_ext_adv_stop_all     (void);
+ext_adv_set_mode_t  app_bt_ext_adv_get_mode     (uint8_t adv_handle);
+
+#endif // __APP_BT_EXT_ADV_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,295 @@
+/******************************************************************************
+* File Name:   app_bt_link_loss.c
+*
+* Description: This is the source code for the link-loss fast recovery path
+*              of the Peripheral_Privacy Example for ModusToolbox. On a supervision
+*              timeout the peer that dropped is re-advertised to immediately and its
+*              connection context is kept in RAM for the resumed session.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_stack.h"
+#include "wiced_bt_l2c.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_bt_bonding.h"
+#include "app_bt_link_loss.h"
+#include "app_bt_adv.h"
+#include "app_log.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Connection context of the current or last dropped peer */
+link_loss_ctx_t     link_loss_ctx;
+
+/* Link-loss-to-resume statistics */
+link_loss_stats_t   link_loss_stats = { .min_ms = UINT32_MAX };
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_bt_link_loss_update_conn_params
+*
+* Function Description:
+* @brief  This function records the connection parameters in use on the current
+*         connection so they can be requested again after a link loss
+*
+* @param  conn_interval: Connection interval in 1.25 ms units
+* @param  conn_latency: Peripheral latency in connection events
+* @param  supervision_timeout: Supervision timeout in 10 ms units
+*
+* @return None
+*/
+void app_bt_link_loss_update_conn_params(uint16_t conn_interval,
+                                         uint16_t conn_latency,
+                                         uint16_t supervision_timeout)
+{
+    link_loss_ctx.conn_interval = conn_interval;
+    link_loss_ctx.conn_latency = conn_latency;
+    link_loss_ctx.supervision_timeout = supervision_timeout;
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_is_link_loss
+*
+* Function Description:
+* @brief  This function checks if a disconnection reason is a link loss, i.e. the
+*         peer went out of range rather than closing the connection
+*
+* @param  reason: GATT disconnection reason
+*
+* @return wiced_bool_t: WICED_TRUE for a supervision or LMP timeout
+*/
+wiced_bool_t app_bt_link_loss_is_link_loss(wiced_bt_gatt_disconn_reason_t reason)
+{
+    return ((GATT_CONN_TIMEOUT == reason) || (GATT_CONN_LMP_TIMEOUT == reason));
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_start
+*
+* Function Description:
+* @brief  This function enters link-loss mode. It starts high duty directed
+*         advertising to the bonded peer that just dropped and freezes its
+*         connection context. It is called by the event loop, from the action
+*         of the disconnected transition, like every advertising start: the
+*         directed advertising starts after the wait of the disconnection
+*         event in the urgent queue, logged with the transition, instead of
+*         in the disconnection callback. The loss time is taken here, the
+*         resume time leaves that wait out.
+*
+* @param  bond_index: Index of the peer in the bond data
+* @param  cccd: CCCD value of the button characteristic at the time of the loss
+*
+* @return wiced_bool_t: WICED_TRUE if directed advertising was started
+*/
+wiced_bool_t app_bt_link_loss_start(uint8_t bond_index, uint16_t cccd)
+{
+    wiced_result_t result;
+
+    if (bond_index >= bondinfo.slot_data[NUM_BONDED])
+    {
+        return WICED_FALSE;
+    }
+
+    link_loss_ctx.bond_index = bond_index;
+    link_loss_ctx.cccd = cccd;
+    link_loss_ctx.connect_time = 0;
+    memcpy(link_loss_ctx.bd_addr, bondinfo.link_keys[bond_index].bd_addr, sizeof(wiced_bt_device_address_t));
+    cy_rtos_get_time(&link_loss_ctx.loss_time);
+
+    result = app_bt_adv_start(BTM_BLE_ADVERT_DIRECTED_HIGH,
+                              bondinfo.link_keys[bond_index].key_data.ble_addr_type,
+                              bondinfo.link_keys[bond_index].bd_addr);
+    if (WICED_BT_SUCCESS != result)
+    {
+        APP_LOG(LOG_LINK_LOSS_ADV_FAILED, result);
+        link_loss_ctx.active = WICED_FALSE;
+        return WICED_FALSE;
+    }
+
+    link_loss_ctx.active = WICED_TRUE;
+    APP_LOG(LOG_LINK_LOSS_ADV, APP_LOG_BDA(link_loss_ctx.bd_addr));
+
+    return WICED_TRUE;
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_on_connect
+*
+* Function Description:
+* @brief  This function is called on every connection. If the peer is the one
+*         being recovered, the caller can resume from link_loss_ctx without
+*         waiting for the bond data to be read back from flash. Otherwise the
+*         recovery is dropped and the context is reset for the new connection.
+*
+* @param  bd_addr: Address of the connected peer
+*
+* @return wiced_bool_t: WICED_TRUE if the dropped peer has reconnected
+*/
+wiced_bool_t app_bt_link_loss_on_connect(uint8_t *bd_addr)
+{
+    cy_time_t now;
+
+    if ((WICED_TRUE == link_loss_ctx.active) &&
+        (0 == memcmp(link_loss_ctx.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t))))
+    {
+        cy_rtos_get_time(&now);
+        link_loss_ctx.connect_time = now;
+        APP_LOG(LOG_LINK_LOSS_RECONNECTED, now - link_loss_ctx.loss_time);
+
+        /* Ask for the connection parameters the peer had settled on before the loss */
+        if (0 != link_loss_ctx.conn_interval)
+        {
+            wiced_bt_l2cap_update_ble_conn_params(bd_addr,
+                                                  link_loss_ctx.conn_interval,
+                                                  link_loss_ctx.conn_interval,
+                                                  link_loss_ctx.conn_latency,
+                                                  link_loss_ctx.supervision_timeout);
+        }
+        return WICED_TRUE;
+    }
+
+    /* A different peer connected, start over with a fresh context */
+    memset(&link_loss_ctx, 0, sizeof(link_loss_ctx));
+
+    return WICED_FALSE;
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_on_encrypted
+*
+* Function Description:
+* @brief  This function completes a link-loss recovery once the link to the
+*         dropped peer is encrypted again and records the link-loss-to-resume time.
+*
+* @param  bd_addr: Address of the peer whose link got encrypted
+*
+* @return wiced_bool_t: WICED_TRUE if this completed a link-loss recovery
+*/
+wiced_bool_t app_bt_link_loss_on_encrypted(uint8_t *bd_addr)
+{
+    cy_time_t now;
+    uint32_t  resume_ms;
+
+    if ((WICED_TRUE != link_loss_ctx.active) || (0 == link_loss_ctx.connect_time) ||
+        (0 != memcmp(link_loss_ctx.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t))))
+    {
+        return WICED_FALSE;
+    }
+
+    cy_rtos_get_time(&now);
+    resume_ms = (uint32_t)(now - link_loss_ctx.loss_time);
+    link_loss_ctx.active = WICED_FALSE;
+
+    link_loss_stats.count++;
+    link_loss_stats.last_ms = resume_ms;
+    link_loss_stats.total_ms += resume_ms;
+    if (resume_ms < link_loss_stats.min_ms)
+    {
+        link_loss_stats.min_ms = resume_ms;
+    }
+    if (resume_ms > link_loss_stats.max_ms)
+    {
+        link_loss_stats.max_ms = resume_ms;
+    }
+
+    APP_LOG(LOG_LINK_LOSS_RESUMED, resume_ms, link_loss_ctx.cccd);
+
+    return WICED_TRUE;
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_cancel
+*
+* Function Description:
+* @brief  This function abandons an ongoing link-loss recovery, e.g. when the
+*         user selects another advertising mode
+*
+* @param  None
+*
+* @return None
+*/
+void app_bt_link_loss_cancel(void)
+{
+    if (WICED_TRUE == link_loss_ctx.active)
+    {
+        link_loss_ctx.active = WICED_FALSE;
+        APP_LOG0(LOG_LINK_LOSS_CANCELLED);
+    }
+}
+
+/**
+* Function Name:
+* app_bt_link_loss_print_stats
+*
+* Function Description:
+* @brief  This function prints the link-loss-to-resume statistics
+*
+* @param  None
+*
+* @return None
+*/
+void app_bt_link_loss_print_stats(void)
+{
+    if (0 == link_loss_stats.count)
+    {
+        printf("Link-loss recoveries: 0\r\n");
+        return;
+    }
+
+    printf("Link-loss recoveries: %" PRIu32 ", resume time last: %" PRIu32 " ms, min: %" PRIu32
+           " ms, max: %" PRIu32 " ms, avg: %" PRIu32 " ms\r\n",
+           link_loss_stats.count, link_loss_stats.last_ms, link_loss_stats.min_ms,
+           link_loss_stats.max_ms, link_loss_stats.total_ms / link_loss_stats.count);
+}
+
+/* [] END OF FILE */
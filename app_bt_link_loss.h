@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   app_bt_link_loss.h
+*
+* Description: This is the header file for the link-loss fast recovery path
+*              of the Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BT_LINK_LOSS_H_
+#define __APP_BT_LINK_LOSS_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Connection context of the bonded peer, kept warm across a link loss so the
+ * resumed session does not have to be rebuilt from flash */
+typedef struct
+{
+    wiced_bool_t                active;              /* Link-loss recovery in progress */
+    uint8_t                     bond_index;          /* Slot of the peer in bondinfo */
+    wiced_bt_device_address_t   bd_addr;             /* Identity address of the peer */
+    uint16_t                    cccd;                /* Button characteristic CCCD */
+    uint16_t                    conn_interval;       /* In 1.25 ms units */
+    uint16_t                    conn_latency;        /* In connection events */
+    uint16_t                    supervision_timeout; /* In 10 ms units */
+    cy_time_t                   loss_time;           /* Time the link was lost (ms) */
+    cy_time_t                   connect_time;        /* Time the peer reconnected (ms) */
+} link_loss_ctx_t;
+
+/* Link-loss-to-resume statistics, all times in ms */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    last_ms;
+    uint32_t    min_ms;
+    uint32_t    max_ms;
+    uint32_t    total_ms;
+} link_loss_stats_t;
+
+/*******************************************************************************
+ * Variable Definitions
+ ******************************************************************************/
+extern link_loss_ctx_t      link_loss_ctx;
+extern link_loss_stats_t    link_loss_stats;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_bt_link_loss_update_conn_params(uint16_t conn_interval,
+                                                    uint16_t conn_latency,
+                                                    uint16_t supervision_timeout);
+wiced_bool_t    app_bt_link_loss_is_link_loss(wiced_bt_gatt_disconn_reason_t reason);
+wiced_bool_t    app_bt_link_loss_start(uint8_t bond_index, uint16_t cccd);
+wiced_bool_t    app_bt_link_loss_on_connect(uint8_t *bd_addr);
+wiced_bool_t    app_bt_link_loss_on_encrypted(uint8_t *bd_addr);
+void            app_bt_link_loss_cancel(void);
+void            app_bt_link_loss_print_stats(void);
+
+#endif // __APP_BT_LINK_LOSS_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,255 @@
+/******************************************************************************
+* File Name:   app_bt_privacy.c
+*
+* Description: This file contains the privacy settings of the Peripheral_Privacy
+*              Example for ModusToolbox: restore of the per-peer privacy modes and
+*              the reconnection statistics.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_stack.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_bt_cfg.h"
+#include "app_bt_bonding.h"
+#include "app_bt_privacy.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+privacy_stats_t     privacy_stats;
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_bt_privacy_init
+*
+* Function Description:
+* @brief   This function resets the reconnection statistics. The RPA timeout
+*          is the one of design.cybt the stack was initialized with: the stack
+*          has no call to change it once it runs, and the kv-store can only be
+*          read once the stack is running, too late to change it before
+*          wiced_bt_stack_init().
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_privacy_init(void)
+{
+    memset(&privacy_stats, 0, sizeof(privacy_stats));
+    for (uint8_t i = 0; i < BOND_INDEX_MAX; i++)
+    {
+        privacy_stats.disconnect_time[i] = PRIVACY_NO_DISCONNECT;
+    }
+}
+
+/**
+* Function Name:
+* app_bt_privacy_restore_modes
+*
+* Function Description:
+* @brief   This function applies the stored privacy mode of every bonded peer.
+*          The controller resets them to network privacy when the resolving
+*          list is loaded, so it must be called after
+*          app_bt_add_devices_to_address_resolution_db().
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_privacy_restore_modes(void)
+{
+    uint8_t num_device = 0;
+
+    for (uint8_t i = 0; (i < bondinfo.slot_data[NUM_BONDED]) && (i < BOND_INDEX_MAX); i++)
+    {
+        if (BTM_BLE_PRIVACY_MODE_NETWORK == bondinfo.privacy_mode[i])
+        {
+            continue;
+        }
+        if (WICED_BT_SUCCESS != wiced_bt_ble_set_privacy_mode(bondinfo.link_keys[i].bd_addr,
+                                                               bondinfo.link_keys[i].key_data.ble_addr_type,
+                                                               bondinfo.privacy_mode[i]))
+        {
+            printf("Failed to restore the privacy mode of device %d\r\n", i + 1);
+            continue;
+        }
+        num_device++;
+    }
+    printf("Device privacy mode restored for %d device(s)\r\n", num_device);
+}
+
+/**
+* Function Name:
+* app_bt_privacy_toggle_mode
+*
+* Function Description:
+* @brief   This function toggles the privacy mode of a bonded peer between
+*          network and device privacy, saves it and applies it
+*
+* @param   index: Bond slot of the peer, starting at 0
+*
+* @return  None
+*/
+void app_bt_privacy_toggle_mode(uint8_t index)
+{
+    cy_rslt_t rslt;
+
+    if (BOND_INDEX_MAX <= index)
+    {
+        return;
+    }
+
+    bondinfo.privacy_mode[index] ^= 1;
+    printf("Privacy Mode for device %d changed to (0 for Network, 1 for Device) :  %d \r\n", index + 1,
+           bondinfo.privacy_mode[index]);
+    rslt = app_bt_update_bond_data();
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to update privacy mode in flash\r\n");
+    }
+    wiced_bt_ble_set_privacy_mode(bondinfo.link_keys[index].bd_addr,
+                                  bondinfo.link_keys[index].key_data.ble_addr_type,
+                                  bondinfo.privacy_mode[index]);
+}
+
+/**
+* Function Name:
+* app_bt_privacy_on_disconnect
+*
+* Function Description:
+* @brief   This function remembers when a bonded peer disconnects, to know on
+*          reconnection if our address changed while it was away
+*
+* @param   index: Bond slot of the peer
+*
+* @return  None
+*/
+void app_bt_privacy_on_disconnect(uint8_t index)
+{
+    cy_time_t now;
+
+    if (BOND_INDEX_MAX > index)
+    {
+        cy_rtos_get_time(&now);
+        privacy_stats.disconnect_time[index] = now;
+    }
+}
+
+/**
+* Function Name:
+* app_bt_privacy_on_delete
+*
+* Function Description:
+* @brief   This function forgets the disconnection of a peer whose bond data
+*          is deleted, so that the next peer bonded in its slot is not counted
+*          as a reconnection.
+*
+* @param   index: Bond slot of the peer
+*
+* @return  None
+*/
+void app_bt_privacy_on_delete(uint8_t index)
+{
+    if (BOND_INDEX_MAX > index)
+    {
+        privacy_stats.disconnect_time[index] = PRIVACY_NO_DISCONNECT;
+    }
+}
+
+/**
+* Function Name:
+* app_bt_privacy_on_reconnect
+*
+* Function Description:
+* @brief   This function counts a reconnection of a bonded peer, and whether
+*          the peer surely had to resolve a new local RPA to find us: it was
+*          away for longer than the RPA timeout, so at least one rotation
+*          happened whatever the phase of the stack timer.
+*          Shorter absences may have seen a rotation too and are not counted.
+*          Only peers that disconnected since boot are counted, not the first
+*          connection after pairing or after a reset.
+*
+* @param   index: Bond slot of the peer
+*
+* @return  None
+*/
+void app_bt_privacy_on_reconnect(uint8_t index)
+{
+    cy_time_t now;
+
+    if ((BOND_INDEX_MAX <= index) || (PRIVACY_NO_DISCONNECT == privacy_stats.disconnect_time[index]))
+    {
+        return;
+    }
+
+    cy_rtos_get_time(&now);
+    privacy_stats.reconnects++;
+    if ((uint32_t)(now - privacy_stats.disconnect_time[index]) >= (uint32_t)app_bt_cfg_ble.rpa_refresh_timeout * 1000)
+    {
+        privacy_stats.reconnects_rotated++;
+    }
+    privacy_stats.disconnect_time[index] = PRIVACY_NO_DISCONNECT;
+}
+
+/**
+* Function Name:
+* app_bt_privacy_print_stats
+*
+* Function Description:
+* @brief   This function prints the RPA timeout and the reconnection counters.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_bt_privacy_print_stats(void)
+{
+    printf("RPA timeout: %d s\r\n", app_bt_cfg_ble.rpa_refresh_timeout);
+    printf("Bonded reconnections: %" PRIu32 ", away longer than the RPA timeout: %" PRIu32 "\r\n",
+           privacy_stats.reconnects, privacy_stats.reconnects_rotated);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   app_bt_privacy.h
+*
+* Description: This is the header file for the privacy settings of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BT_PRIVACY_H_
+#define __APP_BT_PRIVACY_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "cy_result.h"
+#include "app_bt_bonding.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* disconnect_time value of a peer that did not disconnect since boot */
+#define PRIVACY_NO_DISCONNECT               (UINT32_MAX)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Reconnection counters. The stack does not report address rotations, a
+ * reconnection is only counted as rotated when the peer was away for longer
+ * than the RPA timeout of design.cybt. */
+typedef struct
+{
+    uint32_t    reconnects;                         /* Reconnections of bonded peers */
+    uint32_t    reconnects_rotated;                 /* ... that surely saw a new local RPA */
+    cy_time_t   disconnect_time[BOND_INDEX_MAX];    /* RTOS time of the last disconnection */
+} privacy_stats_t;
+
+/*******************************************************************************
+ * Variable Definitions
+ ******************************************************************************/
+extern privacy_stats_t  privacy_stats;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_bt_privacy_init             (void);
+void            app_bt_privacy_restore_modes    (void);
+void            app_bt_privacy_toggle_mode      (uint8_t index);
+void            app_bt_privacy_on_disconnect    (uint8_t index);
+void            app_bt_privacy_on_reconnect     (uint8_t index);
+void            app_bt_privacy_on_delete        (uint8_t index);
+void            app_bt_privacy_print_stats      (void);
+
+#endif // __APP_BT_PRIVACY_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,274 @@
+/******************************************************************************
+* File Name:   app_button.c
+*
+* Description: This file debounces and timestamps the user button presses
+*              of the Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "cyhal.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_trace.h"
+#include "app_button.h"
+#include "app_power.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define BUTTON_QUEUE_MASK                   (APP_BUTTON_QUEUE_SIZE - 1)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static cyhal_gpio_callback_data_t   button_cb_struct;
+
+/* Timestamps of the presses waiting for the event loop. The interrupt moves
+ * the head, the event loop moves the tail. */
+static uint32_t             button_queue[APP_BUTTON_QUEUE_SIZE];
+static volatile uint32_t    button_head;
+static volatile uint32_t    button_tail;
+
+/* Time of the last edge, press or release, for the debouncing */
+static uint32_t             button_last_edge_us;
+static bool                 button_edge_seen;
+
+static app_button_stats_t   button_stats;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void button_isr  (void *handler_arg, cyhal_gpio_event_t event);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_button_init
+*
+* Function Description:
+* @brief This function configures the button for the interrupts.
+*
+* @param None
+*
+* @return None
+*
+*/
+void app_button_init(void)
+{
+    /* Initialize GPIO for button interrupt*/
+    cy_rslt_t rslt = cyhal_gpio_init(CYBSP_USER_BTN, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF);
+    /* GPIO init failed. Stop program execution */
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Button GPIO init failed! \n");
+        CY_ASSERT(0);
+    }
+
+    memset(&button_stats, 0, sizeof(button_stats));
+    button_stats.min_us = UINT32_MAX;
+
+    /* Initialize the structure with values. Add these lines just before initializing button */
+    button_cb_struct.callback = button_isr;
+    button_cb_struct.callback_arg = NULL;
+    button_cb_struct.pin = NC;
+    button_cb_struct.next = NULL;
+
+    /* Configure GPIO interrupt. Releases are needed too, their bounce restarts
+     * the debounce window. */
+    cyhal_gpio_register_callback(CYBSP_USER_BTN, &button_cb_struct);
+    cyhal_gpio_enable_event(CYBSP_USER_BTN, CYHAL_GPIO_IRQ_BOTH, BUTTON_INTERRUPT_PRIORITY, true);
+}
+
+/**
+* Function Name:
+* app_button_get_press
+*
+* Function Description:
+* @brief   This function takes the oldest press waiting to be handled.
+*
+* @param   p_timestamp_us: Set to the time of the interrupt of the press
+*
+* @return  bool: true if a press was waiting
+*/
+bool app_button_get_press(uint32_t *p_timestamp_us)
+{
+    uint32_t tail = button_tail;
+
+    if (tail == button_head)
+    {
+        return false;
+    }
+    *p_timestamp_us = button_queue[tail & BUTTON_QUEUE_MASK];
+    button_tail = tail + 1;
+    return true;
+}
+
+/**
+* Function Name:
+* app_button_notified
+*
+* Function Description:
+* @brief   This function records the latency of a press sent as a notification.
+*
+* @param   timestamp_us: Time of the interrupt of the press
+*
+* @return  None
+*/
+void app_button_notified(uint32_t timestamp_us)
+{
+    uint32_t latency_us = app_timestamp_us() - timestamp_us;
+
+    button_stats.notified++;
+    button_stats.last_us = latency_us;
+    button_stats.total_us += latency_us;
+    if (latency_us < button_stats.min_us)
+    {
+        button_stats.min_us = latency_us;
+    }
+    if (latency_us > button_stats.max_us)
+    {
+        button_stats.max_us = latency_us;
+    }
+}
+
+/**
+* Function Name:
+* app_button_get_stats
+*
+* Function Description:
+* @brief   This function returns the button statistics.
+*
+* @param   None
+*
+* @return  const app_button_stats_t *: Statistics
+*/
+const app_button_stats_t *app_button_get_stats(void)
+{
+    return &button_stats;
+}
+
+/**
+* Function Name:
+* app_button_print_stats
+*
+* Function Description:
+* @brief   This function prints the button statistics.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_button_print_stats(void)
+{
+    printf("Button: %" PRIu32 " presses, %" PRIu32 " bounces rejected, %" PRIu32 " lost\r\n",
+           button_stats.presses, button_stats.bounces, button_stats.lost);
+    if (0 == button_stats.notified)
+    {
+        printf("Button to notification: no notification sent\r\n");
+        return;
+    }
+    printf("Button to notification (us): %" PRIu32 " sent, last: %" PRIu32 ", min: %" PRIu32
+           ", max: %" PRIu32 ", mean: %" PRIu32 "\r\n",
+           button_stats.notified, button_stats.last_us, button_stats.min_us, button_stats.max_us,
+           (uint32_t)(button_stats.total_us / button_stats.notified));
+}
+
+/**
+* Function Name:
+* button_isr
+*
+* Function Description:
+* @brief   This interrupt handler timestamps a press and queues it for the
+*          event loop on its fast path. Every edge, press or release, restarts
+*          the debounce window. A press is accepted only if the pin reads
+*          pressed and the button was at rest for the whole window before;
+*          other presses are contact bounce, from the press or the release,
+*          and are only counted.
+*
+* @param   handler_arg: Not used
+* @param   event: Not used
+*
+* @return  None
+*/
+static void button_isr(void *handler_arg, cyhal_gpio_event_t event)
+{
+    uint32_t now = app_timestamp_us();
+    uint32_t head = button_head;
+    bool at_rest = (!button_edge_seen) || ((now - button_last_edge_us) >= APP_BUTTON_DEBOUNCE_US);
+
+    (void) handler_arg;
+    (void) event;
+
+    app_power_wake_source(APP_POWER_WAKE_BUTTON);
+
+    button_last_edge_us = now;
+    button_edge_seen = true;
+
+    /* Releases only restart the window */
+    if (CYBSP_BTN_PRESSED != cyhal_gpio_read(CYBSP_USER_BTN))
+    {
+        return;
+    }
+    if (!at_rest)
+    {
+        button_stats.bounces++;
+        return;
+    }
+    button_stats.presses++;
+
+    if ((head - button_tail) >= APP_BUTTON_QUEUE_SIZE)
+    {
+        button_stats.lost++;
+        return;
+    }
+    button_queue[head & BUTTON_QUEUE_MASK] = now;
+    button_head = head + 1;
+    APP_TRACE(APP_TRACE_BUTTON, 0, 0);
+
+    app_event_post_urgent(APP_EVT_BUTTON);
+}
+
+/* [] END OF FILE */
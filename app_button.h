@@ -0,0 +1,90 @@
+/******************************************************************************
+* File Name:   app_button.h
+*
+* Description: This is the header file for the user button of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_BUTTON_H_
+#define __APP_BUTTON_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Interrupt priority for the button */
+#define BUTTON_INTERRUPT_PRIORITY           (3u)
+
+/* A press is only accepted after this long without any edge, press or release */
+#define APP_BUTTON_DEBOUNCE_US              (50000u)
+
+/* Presses waiting to be handled, must be a power of 2 */
+#define APP_BUTTON_QUEUE_SIZE               (8)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Button statistics. Latency is from the interrupt to the notification
+ * handed to the stack. */
+typedef struct
+{
+    uint32_t    presses;        /* Accepted presses */
+    uint32_t    bounces;        /* Press edges rejected by the debouncing */
+    uint32_t    lost;           /* Presses lost because the queue was full */
+    uint32_t    notified;       /* Presses sent as a notification */
+    uint32_t    last_us;
+    uint32_t    min_us;
+    uint32_t    max_us;
+    uint64_t    total_us;
+} app_button_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void                        app_button_init         (void);
+bool                        app_button_get_press    (uint32_t *p_timestamp_us);
+void                        app_button_notified     (uint32_t timestamp_us);
+const app_button_stats_t   *app_button_get_stats    (void);
+void                        app_button_print_stats  (void);
+
+#endif // __APP_BUTTON_H_
+
+/* [] END OF FILE */
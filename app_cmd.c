@@ -0,0 +1,262 @@
+/******************************************************************************
+* File Name:   app_cmd.c
+*
+* Description: This file assembles the bytes received on the debug UART into
+*              command lines and parses them for the Peripheral_Privacy Example
+*              for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "stdio.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include "peripheral_privacy.h"
+#include "app_uart_rx.h"
+#include "app_ctrl.h"
+#include "app_cmd.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define CMD_CHAR_BACKSPACE                  (0x08)
+#define CMD_CHAR_DELETE                     (0x7F)
+
+/* Bytes read from the receive ring at a time */
+#define CMD_RX_CHUNK                        (16)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static char     cmd_line[APP_CMD_LINE_MAX + 1];
+static uint8_t  cmd_line_len;
+
+/* Set when the line got longer than APP_CMD_LINE_MAX, the rest of it is
+ * ignored */
+static bool     cmd_line_overflow;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void     cmd_echo    (const char *p_str);
+static void     cmd_parse   (char *p_line);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_cmd_event_handler
+*
+* Function Description:
+* @brief   This function handles the UART receive event in the event loop. It
+*          reads all the bytes waiting in the receive ring.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_cmd_event_handler(uint32_t data)
+{
+    uint8_t buf[CMD_RX_CHUNK];
+    uint32_t len;
+
+    (void) data;
+
+    while (0 < (len = app_uart_rx_read(buf, sizeof(buf))))
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            app_cmd_input(buf[i]);
+        }
+    }
+}
+
+/**
+* Function Name:
+* app_cmd_input
+*
+* Function Description:
+* @brief   This function adds one received byte to the command line, with
+*          echo and backspace. The line is parsed and run when CR or LF is
+*          received; empty lines are ignored so CR LF endings work.
+*
+* @param   byte: Received byte
+*
+* @return  None
+*/
+void app_cmd_input(uint8_t byte)
+{
+    char echo[2] = { (char)byte, '\0' };
+
+    /* Binary control frames share the UART with the terminal */
+    if (app_ctrl_input(byte))
+    {
+        return;
+    }
+
+    if (('\r' == byte) || ('\n' == byte))
+    {
+        if (cmd_line_overflow)
+        {
+            printf("\r\nCommand too long\r\n");
+        }
+        else if (0 < cmd_line_len)
+        {
+            cmd_echo("\r\n");
+            cmd_line[cmd_line_len] = '\0';
+            cmd_parse(cmd_line);
+        }
+        cmd_line_len = 0;
+        cmd_line_overflow = false;
+        return;
+    }
+
+    if ((CMD_CHAR_BACKSPACE == byte) || (CMD_CHAR_DELETE == byte))
+    {
+        if ((0 < cmd_line_len) && !cmd_line_overflow)
+        {
+            cmd_line_len--;
+            cmd_echo("\b \b");
+        }
+        return;
+    }
+
+    if (!isprint(byte))
+    {
+        return;
+    }
+
+    if (APP_CMD_LINE_MAX <= cmd_line_len)
+    {
+        cmd_line_overflow = true;
+        return;
+    }
+
+    cmd_line[cmd_line_len++] = (char)byte;
+    cmd_echo(echo);
+}
+
+/**
+* Function Name:
+* cmd_echo
+*
+* Function Description:
+* @brief   This function echoes input back to the terminal.
+*
+* @param   p_str: Characters to echo
+*
+* @return  None
+*/
+static void cmd_echo(const char *p_str)
+{
+    while ('\0' != *p_str)
+    {
+        cyhal_uart_putc(&cy_retarget_io_uart_obj, (uint8_t)*p_str++);
+    }
+}
+
+/**
+* Function Name:
+* cmd_parse
+*
+* Function Description:
+* @brief   This function splits a command line into a command and its decimal
+*          arguments, and passes it to app_command_handler(). A line starting
+*          with a number selects a bond slot.
+*
+* @param   p_line: Command line, modified in place
+*
+* @return  None
+*/
+static void cmd_parse(char *p_line)
+{
+    app_cmd_t cmd;
+    char *p_token;
+    char *p_end;
+    char *p_save = NULL;
+
+    memset(&cmd, 0, sizeof(cmd));
+
+    p_token = strtok_r(p_line, " \t", &p_save);
+    if (NULL == p_token)
+    {
+        return;
+    }
+
+    if (isdigit((unsigned char)p_token[0]))
+    {
+        /* Slot number, the token is parsed as the first argument below */
+        cmd.cmd = APP_CMD_SLOT;
+    }
+    else if ('\0' == p_token[1])
+    {
+        cmd.cmd = p_token[0];
+        p_token = strtok_r(NULL, " \t", &p_save);
+    }
+    else
+    {
+        printf("Invalid Input\r\n");
+        return;
+    }
+
+    for (; NULL != p_token; p_token = strtok_r(NULL, " \t", &p_save))
+    {
+        if (APP_CMD_MAX_ARGS <= cmd.argc)
+        {
+            printf("Too many arguments\r\n");
+            return;
+        }
+        cmd.argv[cmd.argc] = strtoul(p_token, &p_end, 10);
+        if (('\0' != *p_end) || !isdigit((unsigned char)p_token[0]))
+        {
+            printf("Invalid argument: %s\r\n", p_token);
+            return;
+        }
+        cmd.argc++;
+    }
+
+    app_command_handler(&cmd);
+}
+
+/* [] END OF FILE */
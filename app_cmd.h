@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name:   app_cmd.h
+*
+* Description: This is the header file for the terminal command line parser of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_CMD_H_
+#define __APP_CMD_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Longest command line, without the line ending */
+#define APP_CMD_LINE_MAX                    (32)
+
+/* Most numeric arguments after the command */
+#define APP_CMD_MAX_ARGS                    (2)
+
+/* Command code of a line starting with a number: slot number in argv[0] */
+#define APP_CMD_SLOT                        ('#')
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Parsed command line: one letter command followed by numeric arguments */
+typedef struct
+{
+    char        cmd;
+    uint8_t     argc;
+    uint32_t    argv[APP_CMD_MAX_ARGS];
+} app_cmd_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void    app_cmd_event_handler   (uint32_t data);
+void    app_cmd_input           (uint8_t byte);
+
+#endif // __APP_CMD_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,732 @@
+/******************************************************************************
+* File Name:   app_ctrl.c
+*
+* Description: This file implements the binary control protocol of the
+*              Peripheral_Privacy Example for ModusToolbox. Framed requests received
+*              on the debug UART run the same actions as the terminal commands, and
+*              get a structured response; Bluetooth events are sent as event frames.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "cy_retarget_io.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "peripheral_privacy.h"
+#include "app_bt_bonding.h"
+#include "app_bt_adv.h"
+#include "app_utils.h"
+#include "app_button.h"
+#include "app_event.h"
+#include "app_ctrl.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define CTRL_FRAME_MAX                      (CTRL_HEADER_LEN + CTRL_PAYLOAD_MAX + CTRL_CRC_LEN)
+
+/* Offsets in a frame */
+#define CTRL_OFFSET_LEN                     (1)
+#define CTRL_OFFSET_OPCODE                  (2)
+#define CTRL_OFFSET_SEQ                     (3)
+#define CTRL_OFFSET_PAYLOAD                 (4)
+
+/* Size of one entry of the list response */
+#define CTRL_LIST_ENTRY_LEN                 (3 + BD_ADDR_LEN)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Receive statistics */
+typedef struct
+{
+    uint32_t    requests;
+    uint32_t    crc_errors;
+    uint32_t    timeouts;       /* Frames not completed in time */
+    uint32_t    bad_lengths;
+    uint32_t    repeats;        /* Requests answered with the cached response */
+    uint32_t    events;
+    uint32_t    events_dropped; /* Events lost because the queue was full */
+} ctrl_stats_t;
+
+/* Event of a Bluetooth stack callback, sent by the event loop */
+typedef struct
+{
+    uint8_t     event;
+    uint8_t     len;
+    uint8_t     data[CTRL_EVT_DATA_MAX];
+} ctrl_event_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static uint8_t      ctrl_rx_frame[CTRL_FRAME_MAX];
+static uint16_t     ctrl_rx_len;            /* 0 when waiting for a start of frame */
+static uint32_t     ctrl_rx_last_us;
+
+/* Frames are sent from the event loop and from the log task, never from the
+ * Bluetooth stack thread */
+static cy_mutex_t   ctrl_tx_mutex;
+static uint8_t      ctrl_tx_frame[CTRL_FRAME_MAX];
+static uint8_t      ctrl_event_seq;
+
+static cy_queue_t   ctrl_event_queue;
+
+/* Set by the first ping of a rig, no event frame is written to the terminal
+ * before. Binary log builds own the UART from boot. */
+#ifdef APP_LOG_BINARY
+static volatile bool ctrl_session = true;
+#else
+static volatile bool ctrl_session;
+#endif
+
+static ctrl_stats_t ctrl_stats;
+
+/* Response to the last request that changes the device, sent again when the
+ * rig repeats that request with the same sequence number. ctrl_last_opcode is
+ * 0 while there is none. */
+static uint8_t      ctrl_last_opcode;
+static uint8_t      ctrl_last_seq;
+static uint8_t      ctrl_last_rsp[CTRL_PAYLOAD_MAX];
+static uint8_t      ctrl_last_rsp_len;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint16_t     ctrl_crc16          (const uint8_t *p_data, uint16_t len);
+static void         ctrl_send_frame     (uint8_t opcode, uint8_t seq, const uint8_t *p_data, uint8_t len);
+static void         ctrl_post_event     (uint8_t event, const uint8_t *p_data, uint8_t len);
+static void         ctrl_dispatch       (uint8_t opcode, uint8_t seq, const uint8_t *p_data, uint8_t len);
+static uint8_t      ctrl_list           (const uint8_t *p_data, uint8_t len, uint8_t *p_rsp);
+static uint8_t      ctrl_button_stats   (uint8_t *p_rsp);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_ctrl_init
+*
+* Function Description:
+* @brief   This function creates the lock of the frame transmitter and the
+*          queue of the events of the Bluetooth stack callbacks. It must be
+*          called before the Bluetooth stack is started.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_ctrl_init(void)
+{
+    if ((CY_RSLT_SUCCESS != cy_rtos_mutex_init(&ctrl_tx_mutex, false)) ||
+        (CY_RSLT_SUCCESS != cy_rtos_queue_init(&ctrl_event_queue, CTRL_EVT_QUEUE_SIZE, sizeof(ctrl_event_t))))
+    {
+        printf("Failed to create the control protocol mutex and queue!!");
+        CY_ASSERT(0);
+    }
+}
+
+/**
+* Function Name:
+* app_ctrl_input
+*
+* Function Description:
+* @brief   This function passes one received byte to the frame receiver. A
+*          frame starts with CTRL_SOF, which never appears in terminal
+*          commands, and is run once complete and its CRC checked. A frame not
+*          completed within CTRL_FRAME_TIMEOUT_US is dropped.
+*
+* @param   byte: Received byte
+*
+* @return  bool: true if the byte belongs to a frame, false if it is terminal
+*          input
+*/
+bool app_ctrl_input(uint8_t byte)
+{
+    uint32_t now_us = app_timestamp_us();
+    uint16_t frame_len;
+
+    if ((0 < ctrl_rx_len) && (CTRL_FRAME_TIMEOUT_US < (now_us - ctrl_rx_last_us)))
+    {
+        ctrl_stats.timeouts++;
+        ctrl_rx_len = 0;
+    }
+    ctrl_rx_last_us = now_us;
+
+    if (0 == ctrl_rx_len)
+    {
+        if (CTRL_SOF != byte)
+        {
+            return false;
+        }
+        ctrl_rx_frame[ctrl_rx_len++] = byte;
+        return true;
+    }
+
+    ctrl_rx_frame[ctrl_rx_len++] = byte;
+
+    if ((CTRL_OFFSET_LEN + 1 == ctrl_rx_len) && (CTRL_PAYLOAD_MAX < byte))
+    {
+        ctrl_stats.bad_lengths++;
+        ctrl_rx_len = 0;
+        return true;
+    }
+
+    frame_len = CTRL_HEADER_LEN + ctrl_rx_frame[CTRL_OFFSET_LEN] + CTRL_CRC_LEN;
+    if ((CTRL_HEADER_LEN > ctrl_rx_len) || (frame_len > ctrl_rx_len))
+    {
+        return true;
+    }
+
+    ctrl_rx_len = 0;
+    if (ctrl_crc16(&ctrl_rx_frame[CTRL_OFFSET_LEN], frame_len - CTRL_CRC_LEN - 1) !=
+        (ctrl_rx_frame[frame_len - 2] | (ctrl_rx_frame[frame_len - 1] << 8)))
+    {
+        ctrl_stats.crc_errors++;
+        return true;
+    }
+
+    ctrl_stats.requests++;
+    ctrl_dispatch(ctrl_rx_frame[CTRL_OFFSET_OPCODE], ctrl_rx_frame[CTRL_OFFSET_SEQ],
+                  &ctrl_rx_frame[CTRL_OFFSET_PAYLOAD], ctrl_rx_frame[CTRL_OFFSET_LEN]);
+
+    return true;
+}
+
+/**
+* Function Name:
+* app_ctrl_send_event
+*
+* Function Description:
+* @brief   This function sends an asynchronous event frame if a session is
+*          open. It blocks on the UART: it must not be called from the
+*          Bluetooth stack thread, whose events go through ctrl_post_event().
+*
+* @param   event: CTRL_EVT_* code
+* @param   p_data: Payload of the event
+* @param   len: Payload length
+*
+* @return  None
+*/
+void app_ctrl_send_event(uint8_t event, const uint8_t *p_data, uint8_t len)
+{
+    if (ctrl_session)
+    {
+        ctrl_send_frame(event, 0, p_data, len);
+    }
+}
+
+/**
+* Function Name:
+* app_ctrl_event_handler
+*
+* Function Description:
+* @brief   This function sends the events queued by the Bluetooth stack
+*          callbacks, from the event loop.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_ctrl_event_handler(uint32_t data)
+{
+    ctrl_event_t evt;
+
+    (void) data;
+
+    while (CY_RSLT_SUCCESS == cy_rtos_queue_get(&ctrl_event_queue, &evt, 0))
+    {
+        app_ctrl_send_event(evt.event, evt.data, evt.len);
+    }
+}
+
+/**
+* Function Name:
+* app_ctrl_tx_lock
+*
+* Function Description:
+* @brief   This function takes the lock of the frame transmitter, for a task
+*          that writes text to the debug UART and must not split a frame.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_ctrl_tx_lock(void)
+{
+    cy_rtos_mutex_get(&ctrl_tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+}
+
+/**
+* Function Name:
+* app_ctrl_tx_unlock
+*
+* Function Description:
+* @brief   This function releases the lock taken by app_ctrl_tx_lock().
+*
+* @param   None
+*
+* @return  None
+*/
+void app_ctrl_tx_unlock(void)
+{
+    cy_rtos_mutex_set(&ctrl_tx_mutex);
+}
+
+/**
+* Function Name:
+* app_ctrl_event_connection
+*
+* Function Description:
+* @brief   This function queues the connection or disconnection of a peer.
+*
+* @param   connected: true on connection, false on disconnection
+* @param   reason: Disconnection reason, 0 on connection
+* @param   conn_id: Connection ID
+* @param   bd_addr: Address of the peer
+*
+* @return  None
+*/
+void app_ctrl_event_connection(bool connected, uint8_t reason, uint16_t conn_id,
+                               const wiced_bt_device_address_t bd_addr)
+{
+    uint8_t data[4 + BD_ADDR_LEN] = { connected, reason, (uint8_t)conn_id, (uint8_t)(conn_id >> 8) };
+
+    memcpy(&data[4], bd_addr, BD_ADDR_LEN);
+    ctrl_post_event(CTRL_EVT_CONNECTION, data, sizeof(data));
+}
+
+/**
+* Function Name:
+* app_ctrl_event_pairing
+*
+* Function Description:
+* @brief   This function queues the result of a pairing.
+*
+* @param   status: SMP status of the pairing, 0 on success
+* @param   bd_addr: Address of the peer
+*
+* @return  None
+*/
+void app_ctrl_event_pairing(uint8_t status, const wiced_bt_device_address_t bd_addr)
+{
+    uint8_t data[1 + BD_ADDR_LEN] = { status };
+
+    memcpy(&data[1], bd_addr, BD_ADDR_LEN);
+    ctrl_post_event(CTRL_EVT_PAIRING, data, sizeof(data));
+}
+
+/**
+* Function Name:
+* app_ctrl_event_encryption
+*
+* Function Description:
+* @brief   This function queues the encryption status of a link.
+*
+* @param   result: Encryption result, 0 on success
+* @param   slot: Bond slot of the peer starting at 1, 0 if it is not bonded
+* @param   bd_addr: Address of the peer
+*
+* @return  None
+*/
+void app_ctrl_event_encryption(uint8_t result, uint8_t slot, const wiced_bt_device_address_t bd_addr)
+{
+    uint8_t data[2 + BD_ADDR_LEN] = { result, slot };
+
+    memcpy(&data[2], bd_addr, BD_ADDR_LEN);
+    ctrl_post_event(CTRL_EVT_ENCRYPTION, data, sizeof(data));
+}
+
+/**
+* Function Name:
+* app_ctrl_event_numeric
+*
+* Function Description:
+* @brief   This function queues the value to compare for a numeric comparison
+*          pairing, answered with CTRL_OP_NUMERIC_REPLY.
+*
+* @param   value: Value shown to the user
+* @param   bd_addr: Address of the peer
+*
+* @return  None
+*/
+void app_ctrl_event_numeric(uint32_t value, const wiced_bt_device_address_t bd_addr)
+{
+    uint8_t data[4 + BD_ADDR_LEN] = { (uint8_t)value, (uint8_t)(value >> 8),
+                                      (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+
+    memcpy(&data[4], bd_addr, BD_ADDR_LEN);
+    ctrl_post_event(CTRL_EVT_NUMERIC_COMPARE, data, sizeof(data));
+}
+
+/**
+* Function Name:
+* app_ctrl_print_stats
+*
+* Function Description:
+* @brief   This function prints the statistics of the control protocol.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_ctrl_print_stats(void)
+{
+    printf("Control: session %s, %" PRIu32 " requests (%" PRIu32 " repeated), %" PRIu32 " events (%" PRIu32
+           " dropped), %" PRIu32 " CRC errors, %" PRIu32 " timeouts, %" PRIu32 " bad lengths\r\n",
+           ctrl_session ? "open" : "closed", ctrl_stats.requests, ctrl_stats.repeats, ctrl_stats.events,
+           ctrl_stats.events_dropped, ctrl_stats.crc_errors, ctrl_stats.timeouts, ctrl_stats.bad_lengths);
+}
+
+/**
+* Function Name:
+* ctrl_crc16
+*
+* Function Description:
+* @brief   This function computes the CRC16-CCITT (polynomial 0x1021, initial
+*          value 0xFFFF) of a buffer.
+*
+* @param   p_data: Data
+* @param   len: Length of the data
+*
+* @return  uint16_t: CRC
+*/
+static uint16_t ctrl_crc16(const uint8_t *p_data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (len--)
+    {
+        crc ^= (uint16_t)(*p_data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+* Function Name:
+* ctrl_post_event
+*
+* Function Description:
+* @brief   This function queues an event of a Bluetooth stack callback for the
+*          event loop, so the stack thread never waits for the UART. Events
+*          are dropped while no session is open.
+*
+* @param   event: CTRL_EVT_* code
+* @param   p_data: Payload of the event
+* @param   len: Payload length, at most CTRL_EVT_DATA_MAX
+*
+* @return  None
+*/
+static void ctrl_post_event(uint8_t event, const uint8_t *p_data, uint8_t len)
+{
+    ctrl_event_t evt = { .event = event, .len = len };
+
+    if ((!ctrl_session) || (CTRL_EVT_DATA_MAX < len))
+    {
+        return;
+    }
+
+    memcpy(evt.data, p_data, len);
+    if (CY_RSLT_SUCCESS != cy_rtos_queue_put(&ctrl_event_queue, &evt, 0))
+    {
+        ctrl_stats.events_dropped++;
+        return;
+    }
+    app_event_post(APP_EVT_CTRL, 0);
+}
+
+/**
+* Function Name:
+* ctrl_send_frame
+*
+* Function Description:
+* @brief   This function frames a payload and writes it to the debug UART in
+*          one piece. Event frames get the next event sequence number under
+*          the lock, responses the sequence number of their request.
+*
+* @param   opcode: Opcode of the frame
+* @param   seq: Sequence number of the request, ignored for events
+* @param   p_data: Payload
+* @param   len: Payload length, at most CTRL_PAYLOAD_MAX
+*
+* @return  None
+*/
+static void ctrl_send_frame(uint8_t opcode, uint8_t seq, const uint8_t *p_data, uint8_t len)
+{
+    size_t frame_len = CTRL_HEADER_LEN + len + CTRL_CRC_LEN;
+    uint16_t crc;
+
+    if (CTRL_PAYLOAD_MAX < len)
+    {
+        return;
+    }
+
+    cy_rtos_mutex_get(&ctrl_tx_mutex, CY_RTOS_NEVER_TIMEOUT);
+
+    if (0 == (opcode & CTRL_RESPONSE_FLAG))
+    {
+        seq = ctrl_event_seq++;
+        ctrl_stats.events++;
+    }
+
+    ctrl_tx_frame[0] = CTRL_SOF;
+    ctrl_tx_frame[CTRL_OFFSET_LEN] = len;
+    ctrl_tx_frame[CTRL_OFFSET_OPCODE] = opcode;
+    ctrl_tx_frame[CTRL_OFFSET_SEQ] = seq;
+    memcpy(&ctrl_tx_frame[CTRL_OFFSET_PAYLOAD], p_data, len);
+    crc = ctrl_crc16(&ctrl_tx_frame[CTRL_OFFSET_LEN], CTRL_HEADER_LEN - 1 + len);
+    ctrl_tx_frame[CTRL_HEADER_LEN + len] = (uint8_t)crc;
+    ctrl_tx_frame[CTRL_HEADER_LEN + len + 1] = (uint8_t)(crc >> 8);
+
+    cyhal_uart_write(&cy_retarget_io_uart_obj, ctrl_tx_frame, &frame_len);
+
+    cy_rtos_mutex_set(&ctrl_tx_mutex);
+}
+
+/**
+* Function Name:
+* ctrl_dispatch
+*
+* Function Description:
+* @brief   This function runs a request and sends its response. A request
+*          that changes the device is run once: repeated with the same
+*          sequence number, because its response was lost, it gets the cached
+*          response of the first run.
+*
+* @param   opcode: Opcode of the request
+* @param   seq: Sequence number of the request
+* @param   p_data: Payload of the request
+* @param   len: Payload length
+*
+* @return  None
+*/
+static void ctrl_dispatch(uint8_t opcode, uint8_t seq, const uint8_t *p_data, uint8_t len)
+{
+    uint8_t rsp[CTRL_PAYLOAD_MAX];
+    uint8_t rsp_len = 1;
+    uint8_t status = CTRL_STATUS_BAD_LENGTH;
+    bool cache = true;
+    wiced_bool_t bond_mode;
+
+    if ((0 != ctrl_last_opcode) && (opcode == ctrl_last_opcode) && (seq == ctrl_last_seq))
+    {
+        ctrl_stats.repeats++;
+        ctrl_send_frame(opcode | CTRL_RESPONSE_FLAG, seq, ctrl_last_rsp, ctrl_last_rsp_len);
+        return;
+    }
+
+    switch (opcode)
+    {
+    case CTRL_OP_PING:
+        /* A rig is listening, events can be sent from now on. Its sequence
+         * numbers start over, the cached response is not its own. */
+        ctrl_session = true;
+        ctrl_last_opcode = 0;
+        cache = false;
+        status = APP_ACTION_SUCCESS;
+        rsp[rsp_len++] = CTRL_PROTOCOL_VERSION;
+        rsp[rsp_len++] = BOND_INDEX_MAX;
+        break;
+
+    case CTRL_OP_GET_STATUS:
+        cache = false;
+        status = APP_ACTION_SUCCESS;
+        app_action_get_status(&rsp[rsp_len++], &bond_mode);
+        rsp[rsp_len++] = (uint8_t)bond_mode;
+        rsp[rsp_len++] = (uint8_t)app_bt_adv_get_mode();
+        rsp[rsp_len++] = bondinfo.slot_data[NUM_BONDED];
+        rsp[rsp_len++] = bondinfo.slot_data[NEXT_FREE_INDEX] + 1;
+        break;
+
+    case CTRL_OP_LIST:
+        cache = false;
+        if (1 >= len)
+        {
+            status = APP_ACTION_SUCCESS;
+            rsp_len += ctrl_list(p_data, len, &rsp[rsp_len]);
+        }
+        break;
+
+    case CTRL_OP_DELETE_BONDS:
+        status = app_action_delete_bonds();
+        break;
+
+    case CTRL_OP_BOND_MODE:
+        if (1 == len)
+        {
+            status = app_action_bond_mode(p_data[0] ? WICED_TRUE : WICED_FALSE);
+        }
+        break;
+
+    case CTRL_OP_DIRECTED_ADV:
+        if (1 == len)
+        {
+            status = app_action_directed_adv(p_data[0]);
+        }
+        break;
+
+    case CTRL_OP_PRIVACY_TOGGLE:
+        if (1 == len)
+        {
+            status = app_action_privacy_toggle(p_data[0]);
+        }
+        break;
+
+    case CTRL_OP_KVSTORE_RESET:
+        status = app_action_kvstore_reset();
+        break;
+
+    case CTRL_OP_NUMERIC_REPLY:
+        if (1 == len)
+        {
+            status = app_action_numeric_reply(p_data[0] ? WICED_TRUE : WICED_FALSE);
+        }
+        break;
+
+    case CTRL_OP_BUTTON_STATS:
+        cache = false;
+        status = APP_ACTION_SUCCESS;
+        rsp_len += ctrl_button_stats(&rsp[rsp_len]);
+        break;
+
+    default:
+        cache = false;
+        status = CTRL_STATUS_UNKNOWN_OPCODE;
+        break;
+    }
+
+    rsp[0] = status;
+    if (cache)
+    {
+        ctrl_last_opcode = opcode;
+        ctrl_last_seq = seq;
+        ctrl_last_rsp_len = rsp_len;
+        memcpy(ctrl_last_rsp, rsp, rsp_len);
+    }
+    ctrl_send_frame(opcode | CTRL_RESPONSE_FLAG, seq, rsp, rsp_len);
+}
+
+/**
+* Function Name:
+* ctrl_list
+*
+* Function Description:
+* @brief   This function fills the list response with as many bonded peers as
+*          fit in a frame, from the requested slot on. Larger bond tables are
+*          read with several requests.
+*
+* @param   p_data: Payload of the request, optional first slot starting at 1
+* @param   len: Payload length
+* @param   p_rsp: Response payload after the status byte
+*
+* @return  uint8_t: Length written to p_rsp
+*/
+static uint8_t ctrl_list(const uint8_t *p_data, uint8_t len, uint8_t *p_rsp)
+{
+    uint8_t first = (1 == len && 0 < p_data[0]) ? p_data[0] - 1 : 0;
+    uint8_t *p_count = &p_rsp[1];
+    uint8_t *p_entry = &p_rsp[2];
+
+    p_rsp[0] = bondinfo.slot_data[NUM_BONDED];
+    *p_count = 0;
+
+    for (uint8_t i = first; i < bondinfo.slot_data[NUM_BONDED]; i++)
+    {
+        if ((CTRL_PAYLOAD_MAX - 1) < (p_entry - p_rsp) + CTRL_LIST_ENTRY_LEN)
+        {
+            break;
+        }
+        p_entry[0] = i + 1;
+        p_entry[1] = bondinfo.link_keys[i].key_data.ble_addr_type;
+        p_entry[2] = bondinfo.privacy_mode[i];
+        memcpy(&p_entry[3], bondinfo.link_keys[i].bd_addr, BD_ADDR_LEN);
+        p_entry += CTRL_LIST_ENTRY_LEN;
+        (*p_count)++;
+    }
+
+    return (uint8_t)(p_entry - p_rsp);
+}
+
+/**
+* Function Name:
+* ctrl_button_stats
+*
+* Function Description:
+* @brief   This function fills the button statistics response, 32-bit little
+*          endian values.
+*
+* @param   p_rsp: Response payload after the status byte
+*
+* @return  uint8_t: Length written to p_rsp
+*/
+static uint8_t ctrl_button_stats(uint8_t *p_rsp)
+{
+    const app_button_stats_t *p_stats = app_button_get_stats();
+    uint32_t values[] =
+    {
+        p_stats->presses,
+        p_stats->bounces,
+        p_stats->lost,
+        p_stats->notified,
+        p_stats->last_us,
+        p_stats->notified ? p_stats->min_us : 0,
+        p_stats->max_us,
+        p_stats->notified ? (uint32_t)(p_stats->total_us / p_stats->notified) : 0,
+    };
+    uint8_t len = 0;
+
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        p_rsp[len++] = (uint8_t)values[i];
+        p_rsp[len++] = (uint8_t)(values[i] >> 8);
+        p_rsp[len++] = (uint8_t)(values[i] >> 16);
+        p_rsp[len++] = (uint8_t)(values[i] >> 24);
+    }
+    return len;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name:   app_ctrl.h
+*
+* Description: This is the header file for the binary control protocol of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_CTRL_H_
+#define __APP_CTRL_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Frame layout, CRC16-CCITT (0x1021, init 0xFFFF) over LEN to the payload:
+ *   SOF | LEN | OPCODE | SEQ | PAYLOAD[LEN] | CRC16 (little endian) */
+#define CTRL_SOF                            (0xA5)
+#define CTRL_HEADER_LEN                     (4)
+#define CTRL_CRC_LEN                        (2)
+#define CTRL_PAYLOAD_MAX                    (64)
+#define CTRL_PROTOCOL_VERSION               (1)
+
+/* A frame must be received completely within this time */
+#define CTRL_FRAME_TIMEOUT_US               (100000)
+
+/* Events of the Bluetooth stack callbacks waiting for the event loop, and the
+ * largest payload of those events */
+#define CTRL_EVT_QUEUE_SIZE                 (8)
+#define CTRL_EVT_DATA_MAX                   (4 + BD_ADDR_LEN)
+
+/* Responses echo the opcode with this bit set and the sequence number of the
+ * request; their first payload byte is the status */
+#define CTRL_RESPONSE_FLAG                  (0x80)
+
+/* Requests. Those that read are retried by the rig with a new sequence
+ * number. The others are repeated with the same sequence number, and the last
+ * of them is answered with its cached response instead of running again. */
+#define CTRL_OP_PING                        (0x01)  /* -> version, BOND_INDEX_MAX */
+#define CTRL_OP_GET_STATUS                  (0x02)  /* -> state, bond mode, adv mode, bonded, next free slot */
+#define CTRL_OP_LIST                        (0x03)  /* first slot -> bonded, count, {slot, addr type, privacy, addr[6]} */
+#define CTRL_OP_DELETE_BONDS                (0x04)
+#define CTRL_OP_BOND_MODE                   (0x05)  /* enter (0/1) */
+#define CTRL_OP_DIRECTED_ADV                (0x06)  /* slot */
+#define CTRL_OP_PRIVACY_TOGGLE              (0x07)  /* slot */
+#define CTRL_OP_KVSTORE_RESET               (0x08)
+#define CTRL_OP_NUMERIC_REPLY               (0x09)  /* match (0/1) */
+#define CTRL_OP_BUTTON_STATS                (0x0A)  /* -> presses, bounces, lost, notified, last, min, max, mean (us)[4] */
+
+/* Asynchronous events, only sent once a rig opened a session with
+ * CTRL_OP_PING; their sequence number counts the events sent, so a rig sees a
+ * lost event as a gap */
+#define CTRL_EVT_CONNECTION                 (0x40)  /* connected, reason, conn id[2], addr[6] */
+#define CTRL_EVT_PAIRING                    (0x41)  /* status, addr[6] */
+#define CTRL_EVT_ENCRYPTION                 (0x42)  /* result, slot (0 if not bonded), addr[6] */
+#define CTRL_EVT_NUMERIC_COMPARE            (0x43)  /* value[4], addr[6] */
+#define CTRL_EVT_ADV_STATE                  (0x44)  /* advertising mode */
+#define CTRL_EVT_LOG                        (0x45)  /* app_log_record_t with the used arguments only */
+
+/* Status of a response, app_action_status_t values or one of these */
+#define CTRL_STATUS_UNKNOWN_OPCODE          (0x10)
+#define CTRL_STATUS_BAD_LENGTH              (0x11)
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void    app_ctrl_init               (void);
+bool    app_ctrl_input              (uint8_t byte);
+void    app_ctrl_send_event         (uint8_t event, const uint8_t *p_data, uint8_t len);
+void    app_ctrl_event_connection   (bool connected, uint8_t reason, uint16_t conn_id,
+                                     const wiced_bt_device_address_t bd_addr);
+void    app_ctrl_event_pairing      (uint8_t status, const wiced_bt_device_address_t bd_addr);
+void    app_ctrl_event_encryption   (uint8_t result, uint8_t slot, const wiced_bt_device_address_t bd_addr);
+void    app_ctrl_event_numeric      (uint32_t value, const wiced_bt_device_address_t bd_addr);
+void    app_ctrl_print_stats        (void);
+void    app_ctrl_event_handler      (uint32_t data);
+void    app_ctrl_tx_lock            (void);
+void    app_ctrl_tx_unlock          (void);
+
+#endif // __APP_CTRL_H_
+
+/* [] END OF FILE */
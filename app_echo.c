@@ -0,0 +1,264 @@
+/******************************************************************************
+* File Name:   app_echo.c
+*
+* Description: This file implements the Echo GATT service. The client writes a payload
+*              with a write request and gets it back in a notification, stamped with the
+*              time the request reached the application and the time the reply was handed
+*              to the stack, so that the client can split the round trip into the
+*              processing time of the application and the time spent in the stacks and
+*              on the air.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "cycfg_gatt_db.h"
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_metrics.h"
+#include "app_echo.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static app_echo_stats_t echo_stats;
+
+/* Connection of the replies, 0 when disconnected */
+static uint16_t         echo_conn_id;
+
+/* Request waiting for its reply in the event loop, one at a time: the client
+ * waits for the reply before the next request */
+static volatile wiced_bool_t echo_pending;
+static uint32_t         echo_rx_us;
+static uint16_t         echo_len;
+static uint8_t          echo_payload[APP_ECHO_PAYLOAD_MAX];
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint8_t  *echo_put               (uint8_t *p_data, uint32_t value);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_echo_on_connect
+*
+* Function Description:
+* @brief   This function keeps the connection the replies go to. Called by
+*          the Bluetooth stack thread.
+*
+* @param   conn_id: Connection ID
+*
+* @return  None
+*/
+void app_echo_on_connect(uint16_t conn_id)
+{
+    echo_conn_id = conn_id;
+}
+
+/**
+* Function Name:
+* app_echo_on_disconnect
+*
+* Function Description:
+* @brief   This function drops the request waiting for its reply and clears
+*          the Echo CCCD. Called by the Bluetooth stack thread.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_echo_on_disconnect(void)
+{
+    echo_conn_id = 0;
+    echo_pending = WICED_FALSE;
+    app_echo_echo_client_char_config[0] = 0;
+    app_echo_echo_client_char_config[1] = 0;
+}
+
+/**
+* Function Name:
+* app_echo_on_write
+*
+* Function Description:
+* @brief   This function takes a request written to the Echo characteristic
+*          and hands its reply to the event loop, the path of the button
+*          notifications. Called by the Bluetooth stack thread.
+*
+* @param   p_val: Payload
+* @param   len: Length of the payload
+* @param   rx_us: Time the request reached the application, app_timestamp_us()
+*
+* @return  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS,
+*          WICED_BT_GATT_INVALID_ATTR_LEN if the payload is longer than
+*          APP_ECHO_PAYLOAD_MAX, or WICED_BT_GATT_CCC_CFG_ERR if the client
+*          did not enable the notifications the reply needs
+*/
+wiced_bt_gatt_status_t app_echo_on_write(const uint8_t *p_val, uint16_t len, uint32_t rx_us)
+{
+    if (APP_ECHO_PAYLOAD_MAX < len)
+    {
+        return WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    if (!(app_echo_echo_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION))
+    {
+        return WICED_BT_GATT_CCC_CFG_ERR;
+    }
+
+    echo_stats.requests++;
+    if (WICED_TRUE == echo_pending)
+    {
+        echo_stats.overruns++;
+    }
+    echo_len = len;
+    memcpy(echo_payload, p_val, echo_len);
+    echo_rx_us = rx_us;
+    echo_pending = WICED_TRUE;
+    app_event_post(APP_EVT_ECHO, 0);
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+* Function Name:
+* app_echo_event_handler
+*
+* Function Description:
+* @brief   This function sends the reply of the request waiting: the receive
+*          time, the transmit time taken right before the reply is handed to
+*          the stack (4 bytes each, little endian, in microseconds of
+*          app_timestamp_us()), then the payload of the request.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_echo_event_handler(uint32_t data)
+{
+    wiced_bt_gatt_status_t status;
+    uint32_t tx_us;
+    uint8_t *p_reply;
+    uint8_t *p;
+
+    (void) data;
+
+    if ((WICED_TRUE != echo_pending) || (0 == echo_conn_id))
+    {
+        return;
+    }
+    echo_pending = WICED_FALSE;
+
+    p_reply = app_alloc_buffer(APP_ECHO_HEADER_LEN + echo_len);
+    if (NULL == p_reply)
+    {
+        return;
+    }
+    p = echo_put(p_reply, echo_rx_us);
+    memcpy(p + 4, echo_payload, echo_len);
+
+    tx_us = app_timestamp_us();
+    echo_put(p, tx_us);
+    status = wiced_bt_gatt_server_send_notification(echo_conn_id, HDLC_ECHO_ECHO_VALUE,
+                                                    APP_ECHO_HEADER_LEN + echo_len, p_reply,
+                                                    (void *)app_free_buffer);
+    app_metrics_on_notification(status);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        app_free_buffer(p_reply);
+        return;
+    }
+
+    echo_stats.replies++;
+    echo_stats.total_us += tx_us - echo_rx_us;
+    if ((tx_us - echo_rx_us) > echo_stats.max_us)
+    {
+        echo_stats.max_us = tx_us - echo_rx_us;
+    }
+}
+
+/**
+* Function Name:
+* app_echo_print_stats
+*
+* Function Description:
+* @brief   This function prints the Echo statistics.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_echo_print_stats(void)
+{
+    printf("Echo: %" PRIu32 " requests, %" PRIu32 " replies, %" PRIu32 " overrun\r\n",
+           echo_stats.requests, echo_stats.replies, echo_stats.overruns);
+    if (0 != echo_stats.replies)
+    {
+        printf("Echo request to reply (us): max: %" PRIu32 ", mean: %" PRIu32 "\r\n",
+               echo_stats.max_us, (uint32_t)(echo_stats.total_us / echo_stats.replies));
+    }
+}
+
+/**
+* Function Name:
+* echo_put
+*
+* Function Description:
+* @brief   This function writes a 4-byte value little endian.
+*
+* @param   p_data: Where to write
+* @param   value: Value
+*
+* @return  uint8_t*: Byte after the value
+*/
+static uint8_t *echo_put(uint8_t *p_data, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        *p_data++ = (uint8_t)(value >> (8 * i));
+    }
+    return p_data;
+}
+
+/* [] END OF FILE */
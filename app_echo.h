@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   app_echo.h
+*
+* Description: This is the header file of the Echo GATT service, which measures the
+*              round trip of a write request and its notification.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_ECHO_H_
+#define __APP_ECHO_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* The reply starts with the receive and transmit times, 4 bytes each */
+#define APP_ECHO_HEADER_LEN                 (8u)
+
+/* Largest payload, the reply fits the default ATT MTU */
+#define APP_ECHO_PAYLOAD_MAX                (GATT_DEF_BLE_MTU_SIZE - 3u - APP_ECHO_HEADER_LEN)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    requests;
+    uint32_t    replies;            /* Handed to the stack */
+    uint32_t    overruns;           /* Requests replaced by the next one before their reply */
+    uint32_t    max_us;             /* Slowest reply, from the request to the transmission */
+    uint64_t    total_us;
+} app_echo_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_echo_on_connect             (uint16_t conn_id);
+void            app_echo_on_disconnect          (void);
+wiced_bt_gatt_status_t app_echo_on_write        (const uint8_t *p_val, uint16_t len, uint32_t rx_us);
+void            app_echo_event_handler          (uint32_t data);
+void            app_echo_print_stats            (void);
+
+#endif // __APP_ECHO_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,359 @@
+/******************************************************************************
+* File Name:   app_event.c
+*
+* Description: This file contains the application event loop of the
+*              Peripheral_Privacy Example for ModusToolbox. The button ISR, the UART
+*              ISR and the Bluetooth callbacks post typed events to a single queue,
+*              and one task dispatches them to the handler of their source.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "peripheral_privacy.h"
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_stack_mon.h"
+#include "app_cmd.h"
+#include "app_power.h"
+#include "app_state.h"
+#include "app_metrics.h"
+#include "app_throughput.h"
+#include "app_echo.h"
+#include "app_bt_adv.h"
+#include "app_ctrl.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Handler of each event type, called from the event loop task */
+typedef void (*app_event_handler_t)(uint32_t data);
+
+static const app_event_handler_t app_event_handlers[APP_EVT_MAX] =
+{
+    [APP_EVT_BUTTON]       = app_button_event_handler,
+    [APP_EVT_UART_RX]      = app_cmd_event_handler,
+    [APP_EVT_LED]          = app_led_event_handler,
+    [APP_EVT_STACK_REPORT] = app_stack_mon_event_handler,
+    [APP_EVT_HEAP_TREND]   = app_heap_event_handler,
+    [APP_EVT_METRICS]      = app_metrics_event_handler,
+    [APP_EVT_THROUGHPUT]   = app_throughput_event_handler,
+    [APP_EVT_ECHO]         = app_echo_event_handler,
+    [APP_EVT_ADV_STEP]     = app_bt_adv_event_handler,
+    [APP_EVT_CTRL]         = app_ctrl_event_handler,
+    [APP_EVT_STATE]        = app_state_event_handler,
+};
+
+static const char *app_event_names[APP_EVT_MAX] =
+{
+    [APP_EVT_BUTTON]       = "Button",
+    [APP_EVT_UART_RX]      = "UART",
+    [APP_EVT_LED]          = "LED",
+    [APP_EVT_STACK_REPORT] = "Stack",
+    [APP_EVT_HEAP_TREND]   = "Heap",
+    [APP_EVT_METRICS]      = "Metrics",
+    [APP_EVT_THROUGHPUT]   = "Throughput",
+    [APP_EVT_ECHO]         = "Echo",
+    [APP_EVT_ADV_STEP]     = "Adv",
+    [APP_EVT_CTRL]         = "Control",
+    [APP_EVT_STATE]        = "State",
+    [APP_EVT_WAKE]         = "Wake",
+};
+
+static cy_queue_t           app_event_queue;
+
+static app_event_stats_t    app_event_stats[APP_EVT_MAX];
+
+/* Urgent events, one bit per type, and the time each one was posted */
+static volatile uint32_t    app_event_urgent;
+static uint32_t             app_event_urgent_us[APP_EVT_MAX];
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void app_event_dispatch      (app_event_type_t type, uint32_t data, uint32_t posted_us);
+static void app_event_run_urgent    (void);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_event_init
+*
+* Function Description:
+* @brief   This function creates the event queue. It must be called before
+*          the interrupts and the Bluetooth stack can post events.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_event_init(void)
+{
+    cy_rslt_t rslt;
+
+    memset(app_event_stats, 0, sizeof(app_event_stats));
+
+    rslt = cy_rtos_queue_init(&app_event_queue, APP_EVENT_QUEUE_SIZE, sizeof(app_event_t));
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to create the application event queue!!");
+        CY_ASSERT(0);
+    }
+}
+
+/**
+* Function Name:
+* app_event_post
+*
+* Function Description:
+* @brief   This function posts an event to the event loop. It never blocks and
+*          can be called from interrupts; the event is dropped and counted if
+*          the queue is full.
+*
+* @param   type: Type of the event
+* @param   data: Data of the event
+*
+* @return  cy_rslt_t: Result of cy_rtos_queue_put()
+*/
+cy_rslt_t app_event_post(app_event_type_t type, uint32_t data)
+{
+    app_event_t event = { .type = type, .data = data, .timestamp_us = app_timestamp_us() };
+    cy_rslt_t rslt;
+
+    rslt = cy_rtos_queue_put(&app_event_queue, &event, 0);
+    if ((CY_RSLT_SUCCESS != rslt) && (APP_EVT_MAX > type))
+    {
+        app_event_stats[type].dropped++;
+    }
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* app_event_post_urgent
+*
+* Function Description:
+* @brief   This function posts an urgent event. It is handled before the
+*          events already queued, right after the handler running now. An
+*          urgent event posted again before it is handled is only handled
+*          once, so its source must keep its own data. Can be called from
+*          interrupts.
+*
+* @param   type: Type of the event, handled with no data
+*
+* @return  None
+*/
+void app_event_post_urgent(app_event_type_t type)
+{
+    app_event_t wake = { .type = APP_EVT_WAKE, .data = 0, .timestamp_us = 0 };
+    uint32_t state;
+    bool first;
+
+    state = cyhal_system_critical_section_enter();
+    first = (0 == (app_event_urgent & (1u << type)));
+    if (first)
+    {
+        app_event_urgent |= (1u << type);
+        app_event_urgent_us[type] = app_timestamp_us();
+    }
+    cyhal_system_critical_section_exit(state);
+
+    /* Wake the loop up. If the queue is full the loop is busy and handles
+     * the urgent event after the current handler anyway. */
+    if (first)
+    {
+        (void) cy_rtos_queue_put(&app_event_queue, &wake, 0);
+    }
+}
+
+/**
+* Function Name:
+* app_event_loop
+*
+* Function Description:
+* @brief   This task waits for events and calls the handler of their source,
+*          urgent events first.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+void app_event_loop(cy_thread_arg_t arg)
+{
+    app_event_t event;
+
+    (void) arg;
+
+    /* Handlers own the peripherals they drive */
+    app_led_init();
+
+    for (;;)
+    {
+        if (CY_RSLT_SUCCESS != cy_rtos_queue_get(&app_event_queue, &event, portMAX_DELAY))
+        {
+            continue;
+        }
+
+        app_event_run_urgent();
+
+        if ((APP_EVT_MAX <= event.type) || (NULL == app_event_handlers[event.type]))
+        {
+            continue;
+        }
+
+        app_event_dispatch(event.type, event.data, event.timestamp_us);
+    }
+}
+
+/**
+* Function Name:
+* app_event_dispatch
+*
+* Function Description:
+* @brief   This function calls the handler of an event and records the time
+*          spent waiting and in the handler.
+*
+* @param   type: Type of the event
+* @param   data: Data of the event
+* @param   posted_us: Time the event was posted
+*
+* @return  None
+*/
+static void app_event_dispatch(app_event_type_t type, uint32_t data, uint32_t posted_us)
+{
+    app_event_stats_t *p_stats = &app_event_stats[type];
+    uint32_t start_us;
+    uint32_t wait_us;
+    uint32_t run_us;
+
+    app_power_wake_handled();
+
+    start_us = app_timestamp_us();
+    app_event_handlers[type](data);
+    run_us = app_timestamp_us() - start_us;
+    wait_us = start_us - posted_us;
+
+    p_stats->count++;
+    p_stats->total_wait_us += wait_us;
+    p_stats->total_run_us += run_us;
+    if (wait_us > p_stats->max_wait_us)
+    {
+        p_stats->max_wait_us = wait_us;
+    }
+    if (run_us > p_stats->max_run_us)
+    {
+        p_stats->max_run_us = run_us;
+    }
+}
+
+/**
+* Function Name:
+* app_event_run_urgent
+*
+* Function Description:
+* @brief   This function handles the pending urgent events.
+*
+* @param   None
+*
+* @return  None
+*/
+static void app_event_run_urgent(void)
+{
+    uint32_t state;
+    uint32_t pending;
+    uint32_t posted_us;
+
+    while (0 != app_event_urgent)
+    {
+        for (uint8_t type = 0; type < APP_EVT_MAX; type++)
+        {
+            state = cyhal_system_critical_section_enter();
+            pending = app_event_urgent & (1u << type);
+            app_event_urgent &= ~(1u << type);
+            posted_us = app_event_urgent_us[type];
+            cyhal_system_critical_section_exit(state);
+
+            if ((0 != pending) && (NULL != app_event_handlers[type]))
+            {
+                app_event_dispatch((app_event_type_t)type, 0, posted_us);
+            }
+        }
+    }
+}
+
+/**
+* Function Name:
+* app_event_print_stats
+*
+* Function Description:
+* @brief   This function prints the handling statistics of each event type.
+*          The statistics of the UART event printing them are not included.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_event_print_stats(void)
+{
+    printf("Events (us)   count  dropped  mean wait  max wait  mean run   max run\r\n");
+    for (uint8_t i = 0; i < APP_EVT_MAX; i++)
+    {
+        app_event_stats_t *p_stats = &app_event_stats[i];
+
+        if (NULL == app_event_handlers[i])
+        {
+            continue;
+        }
+
+        printf("  %-10s %6" PRIu32 " %8" PRIu32 " %10" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 "\r\n",
+               app_event_names[i], p_stats->count, p_stats->dropped,
+               p_stats->count ? (uint32_t)(p_stats->total_wait_us / p_stats->count) : 0, p_stats->max_wait_us,
+               p_stats->count ? (uint32_t)(p_stats->total_run_us / p_stats->count) : 0, p_stats->max_run_us);
+    }
+}
+
+/* [] END OF FILE */
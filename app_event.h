@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name:   app_event.h
+*
+* Description: This is the header file for the application event loop of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_EVENT_H_
+#define __APP_EVENT_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Number of events the queue holds before new ones are dropped */
+#define APP_EVENT_QUEUE_SIZE                (16)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Event sources, each one has its handler in the event loop */
+typedef enum
+{
+    APP_EVT_BUTTON,         /* User button pressed, urgent, see app_button.c */
+    APP_EVT_UART_RX,        /* Bytes waiting in the UART receive ring, no data */
+    APP_EVT_LED,            /* Advertising state to show on the LED */
+    APP_EVT_STACK_REPORT,   /* Periodic stack usage report, no data */
+    APP_EVT_HEAP_TREND,     /* Periodic heap trend sample, no data */
+    APP_EVT_METRICS,        /* Metrics notification batch due, no data */
+    APP_EVT_THROUGHPUT,     /* Throughput source can send, no data */
+    APP_EVT_ECHO,           /* Echo reply to send, no data */
+    APP_EVT_ADV_STEP,       /* Next advertising interval step due, scheduler generation */
+    APP_EVT_CTRL,           /* Control protocol events queued, no data, see app_ctrl.c */
+    APP_EVT_STATE,          /* State machine events waiting, urgent, see app_state.c */
+    APP_EVT_WAKE,           /* Urgent event pending, no handler */
+    APP_EVT_MAX
+} app_event_type_t;
+
+/* Event posted to the event loop */
+typedef struct
+{
+    app_event_type_t    type;
+    uint32_t            data;           /* Data of the event, depends on the type */
+    uint32_t            timestamp_us;   /* Time the event was posted */
+} app_event_t;
+
+/* Handling statistics of one event type */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    dropped;        /* Events lost because the queue was full */
+    uint32_t    max_wait_us;    /* Time spent in the queue */
+    uint64_t    total_wait_us;
+    uint32_t    max_run_us;     /* Time spent in the handler */
+    uint64_t    total_run_us;
+} app_event_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void        app_event_init          (void);
+cy_rslt_t   app_event_post          (app_event_type_t type, uint32_t data);
+void        app_event_post_urgent   (app_event_type_t type);
+void        app_event_loop          (cy_thread_arg_t arg);
+void        app_event_print_stats   (void);
+
+#endif // __APP_EVENT_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,512 @@
+/******************************************************************************
+* File Name:   app_heap.c
+*
+* Description: This file counts the bytes allocated with app_alloc_buffer()
+*              and their high-water mark, and records the buffers when built
+*              with HEAP_TRACE=1: the outstanding buffers by call site and
+*              age, the peak use and the trend of the free heap and its
+*              fragmentation, printed with 'm' to find slow leaks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <stdlib.h>
+#include <malloc.h>
+#include <string.h>
+#include <inttypes.h>
+#include "app_event.h"
+#include "app_heap.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Outstanding buffer */
+typedef struct
+{
+    void        *p_buf;             /* NULL for a free entry */
+    uint32_t    len;
+    const char  *p_func;            /* Call site */
+    uint16_t    line;
+    cy_time_t   time_ms;            /* Time of the allocation */
+} heap_buffer_t;
+
+/* Counts since boot */
+typedef struct
+{
+    uint32_t    allocs;
+    uint32_t    frees;
+    uint32_t    failures;           /* malloc() returned NULL */
+    uint32_t    untracked;          /* Outstanding buffers not in the table, it was full */
+    uint32_t    unknown_frees;      /* Buffers freed that were not allocated here */
+    uint32_t    in_use;             /* Bytes outstanding, tracked buffers only */
+    uint16_t    buffers;            /* Buffers outstanding, tracked buffers only */
+    uint32_t    peak_in_use;
+    uint16_t    peak_buffers;
+    uint32_t    max_len;            /* Largest buffer asked for */
+} heap_stats_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Bytes outstanding as malloc() sized them, counted in every build */
+static uint32_t             heap_in_use;
+static uint32_t             heap_high_water;
+
+#ifdef APP_HEAP_TRACE
+static heap_buffer_t        heap_buffers[APP_HEAP_TRACE_MAX_BUFFERS];
+static heap_stats_t         heap_stats;
+
+/* Highest use since the last sample, for the trend */
+static uint32_t             heap_period_in_use;
+static uint16_t             heap_period_buffers;
+
+static app_heap_sample_t    heap_trend[APP_HEAP_TREND_SIZE];
+static uint32_t             heap_trend_count;
+static uint32_t             heap_trend_ticks;       /* Timer periods since the last sample */
+static uint32_t             heap_trend_period;      /* Timer periods between two samples */
+
+static cy_timer_t           heap_timer;
+#endif
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+#ifdef APP_HEAP_TRACE
+static void         heap_free_stats     (app_heap_sample_t *p_sample);
+static void         heap_sample         (void);
+static void         heap_timer_cb       (cy_timer_callback_arg_t arg);
+#endif
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_heap_alloc
+*
+* Function Description:
+* @brief   This function allocates a buffer and records it with its call site,
+*          the caller of app_alloc_buffer(). It can be called from any thread.
+*
+* @param   len: Length to allocate
+* @param   p_func: Function allocating
+* @param   line: Line of the allocation
+*
+* @return  void*: Buffer, NULL if the heap is exhausted
+*/
+void *app_heap_alloc(int len, const char *p_func, uint16_t line)
+{
+    void *p_buf = malloc(len);
+    uint32_t state;
+#ifdef APP_HEAP_TRACE
+    cy_time_t now;
+    uint32_t i;
+
+    cy_rtos_get_time(&now);
+#endif
+
+    state = cyhal_system_critical_section_enter();
+    if (NULL != p_buf)
+    {
+        heap_in_use += (uint32_t)malloc_usable_size(p_buf);
+        if (heap_in_use > heap_high_water)
+        {
+            heap_high_water = heap_in_use;
+        }
+    }
+#ifdef APP_HEAP_TRACE
+    heap_stats.allocs++;
+    heap_stats.max_len = ((uint32_t)len > heap_stats.max_len) ? (uint32_t)len : heap_stats.max_len;
+    if (NULL == p_buf)
+    {
+        heap_stats.failures++;
+        cyhal_system_critical_section_exit(state);
+        return NULL;
+    }
+
+    for (i = 0; (i < APP_HEAP_TRACE_MAX_BUFFERS) && (NULL != heap_buffers[i].p_buf); i++)
+    {
+    }
+    if (APP_HEAP_TRACE_MAX_BUFFERS == i)
+    {
+        heap_stats.untracked++;
+    }
+    else
+    {
+        heap_buffers[i].p_buf = p_buf;
+        heap_buffers[i].len = (uint32_t)len;
+        heap_buffers[i].p_func = p_func;
+        heap_buffers[i].line = line;
+        heap_buffers[i].time_ms = now;
+        heap_stats.in_use += (uint32_t)len;
+        heap_stats.buffers++;
+        if (heap_stats.in_use > heap_stats.peak_in_use)
+        {
+            heap_stats.peak_in_use = heap_stats.in_use;
+        }
+        if (heap_stats.buffers > heap_stats.peak_buffers)
+        {
+            heap_stats.peak_buffers = heap_stats.buffers;
+        }
+        if (heap_stats.in_use > heap_period_in_use)
+        {
+            heap_period_in_use = heap_stats.in_use;
+        }
+        if (heap_stats.buffers > heap_period_buffers)
+        {
+            heap_period_buffers = heap_stats.buffers;
+        }
+    }
+#else
+    (void)p_func;
+    (void)line;
+#endif
+    cyhal_system_critical_section_exit(state);
+
+    return p_buf;
+}
+
+/**
+* Function Name:
+* app_heap_free
+*
+* Function Description:
+* @brief   This function frees a buffer and drops its record. It can be called
+*          from any thread.
+*
+* @param   p_buf: Buffer from app_heap_alloc(), NULL is ignored
+*
+* @return  None
+*/
+void app_heap_free(void *p_buf)
+{
+    uint32_t state;
+#ifdef APP_HEAP_TRACE
+    uint32_t i;
+#endif
+
+    if (NULL == p_buf)
+    {
+        return;
+    }
+
+    state = cyhal_system_critical_section_enter();
+    heap_in_use -= (uint32_t)malloc_usable_size(p_buf);
+#ifdef APP_HEAP_TRACE
+    heap_stats.frees++;
+    for (i = 0; (i < APP_HEAP_TRACE_MAX_BUFFERS) && (p_buf != heap_buffers[i].p_buf); i++)
+    {
+    }
+    if (APP_HEAP_TRACE_MAX_BUFFERS != i)
+    {
+        heap_stats.in_use -= heap_buffers[i].len;
+        heap_stats.buffers--;
+        heap_buffers[i].p_buf = NULL;
+    }
+    else if (0 < heap_stats.untracked)
+    {
+        /* Most likely one of the buffers that did not fit in the table */
+        heap_stats.untracked--;
+    }
+    else
+    {
+        heap_stats.unknown_frees++;
+    }
+#endif
+    cyhal_system_critical_section_exit(state);
+
+    free(p_buf);
+}
+
+/**
+* Function Name:
+* app_heap_init
+*
+* Function Description:
+* @brief   This function takes the first sample of the heap trend and starts
+*          the periodic samples. Does nothing unless built with HEAP_TRACE=1.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_heap_init(void)
+{
+#ifdef APP_HEAP_TRACE
+    cy_rslt_t rslt;
+
+    heap_trend_period = 1;
+    heap_sample();
+
+    rslt = cy_rtos_timer_init(&heap_timer, CY_TIMER_TYPE_PERIODIC, heap_timer_cb, NULL);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to create the heap trend timer!\n");
+        return;
+    }
+    cy_rtos_timer_start(&heap_timer, APP_HEAP_TREND_PERIOD_MS);
+#endif
+}
+
+/**
+* Function Name:
+* app_heap_get_usage
+*
+* Function Description:
+* @brief   This function returns the bytes of the buffers outstanding and the
+*          most ever outstanding, as sized by malloc(). Counted in every build.
+*
+* @param   p_high_water: Most bytes outstanding since boot, can be NULL
+*
+* @return  uint32_t: Bytes outstanding
+*/
+uint32_t app_heap_get_usage(uint32_t *p_high_water)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    uint32_t in_use = heap_in_use;
+
+    if (NULL != p_high_water)
+    {
+        *p_high_water = heap_high_water;
+    }
+    cyhal_system_critical_section_exit(state);
+
+    return in_use;
+}
+
+/**
+* Function Name:
+* app_heap_dump
+*
+* Function Description:
+* @brief   This function prints the heap counts, the outstanding buffers
+*          grouped by call site with the age of the oldest one, and the trend.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_heap_dump(void)
+{
+#ifdef APP_HEAP_TRACE
+    heap_buffer_t buffers[APP_HEAP_TRACE_MAX_BUFFERS];
+    heap_stats_t stats;
+    cy_time_t now;
+    uint32_t state;
+
+    cy_rtos_get_time(&now);
+    state = cyhal_system_critical_section_enter();
+    memcpy(buffers, heap_buffers, sizeof(buffers));
+    stats = heap_stats;
+    cyhal_system_critical_section_exit(state);
+
+    printf("Heap: %" PRIu32 " allocations, %" PRIu32 " frees, %" PRIu32 " failed, largest asked %" PRIu32 " bytes\r\n",
+           stats.allocs, stats.frees, stats.failures, stats.max_len);
+    printf("  outstanding %u buffers, %" PRIu32 " bytes (peak %u buffers, %" PRIu32 " bytes), "
+           "%" PRIu32 " untracked, %" PRIu32 " unknown frees\r\n",
+           stats.buffers, stats.in_use, stats.peak_buffers, stats.peak_in_use, stats.untracked, stats.unknown_frees);
+
+    /* Group by call site, each site is printed at its first buffer */
+    for (uint32_t i = 0; i < APP_HEAP_TRACE_MAX_BUFFERS; i++)
+    {
+        uint32_t count = 0;
+        uint32_t bytes = 0;
+        uint32_t oldest_ms = 0;
+
+        if (NULL == buffers[i].p_buf)
+        {
+            continue;
+        }
+        for (uint32_t j = i; j < APP_HEAP_TRACE_MAX_BUFFERS; j++)
+        {
+            if ((NULL != buffers[j].p_buf) && (buffers[j].p_func == buffers[i].p_func) &&
+                (buffers[j].line == buffers[i].line))
+            {
+                uint32_t age_ms = (uint32_t)(now - buffers[j].time_ms);
+
+                count++;
+                bytes += buffers[j].len;
+                oldest_ms = (age_ms > oldest_ms) ? age_ms : oldest_ms;
+                if (j != i)
+                {
+                    buffers[j].p_buf = NULL;
+                }
+            }
+        }
+        printf("  %s:%u %" PRIu32 " buffers, %" PRIu32 " bytes, oldest %" PRIu32 ".%03" PRIu32 " s\r\n",
+               buffers[i].p_func, buffers[i].line, count, bytes, oldest_ms / 1000u, oldest_ms % 1000u);
+    }
+
+    printf("Heap trend, every %" PRIu32 " min: uptime s, bytes and buffers outstanding, free and arena bytes\r\n",
+           (heap_trend_period * APP_HEAP_TREND_PERIOD_MS) / 60000u);
+    for (uint32_t i = 0; i < heap_trend_count; i++)
+    {
+        printf("  %10" PRIu32 " %8" PRIu32 " %4u %8" PRIu32 " %8" PRIu32 "\r\n", heap_trend[i].time_s,
+               heap_trend[i].in_use, heap_trend[i].buffers, heap_trend[i].free_bytes, heap_trend[i].arena);
+    }
+#else
+    printf("Heap trace not built, build with HEAP_TRACE=1\r\n");
+#endif
+}
+
+/**
+* Function Name:
+* app_heap_event_handler
+*
+* Function Description:
+* @brief   This function handles the periodic heap event in the event loop:
+*          a sample of the trend is due every heap_trend_period events.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_heap_event_handler(uint32_t data)
+{
+    (void) data;
+
+#ifdef APP_HEAP_TRACE
+    heap_trend_ticks++;
+    if (heap_trend_ticks >= heap_trend_period)
+    {
+        heap_sample();
+    }
+#endif
+}
+
+#ifdef APP_HEAP_TRACE
+/**
+* Function Name:
+* heap_free_stats
+*
+* Function Description:
+* @brief   This function reads the free bytes of the malloc() arena and the
+*          size of the arena from the statistics of the allocator, which takes
+*          its own lock and allocates nothing. newlib-nano only fills these
+*          two: the free bytes are the sum of the free chunks, not the largest
+*          one, and the heap region the arena has not claimed yet is not
+*          counted. An arena that keeps growing while the bytes outstanding do
+*          not shows fragmentation.
+*
+* @param   p_sample: Sample to fill
+*
+* @return  None
+*/
+static void heap_free_stats(app_heap_sample_t *p_sample)
+{
+    struct mallinfo info = mallinfo();
+
+    p_sample->free_bytes = (uint32_t)info.fordblks;
+    p_sample->arena = (uint32_t)info.arena;
+}
+
+/**
+* Function Name:
+* heap_sample
+*
+* Function Description:
+* @brief   This function adds a sample to the heap trend. A full trend is
+*          halved first, merging pairs of samples, and its period doubled.
+*
+* @param   None
+*
+* @return  None
+*/
+static void heap_sample(void)
+{
+    app_heap_sample_t *p_sample;
+    cy_time_t now;
+    uint32_t state;
+
+    if (APP_HEAP_TREND_SIZE == heap_trend_count)
+    {
+        for (uint32_t i = 0; i < (APP_HEAP_TREND_SIZE / 2); i++)
+        {
+            const app_heap_sample_t *p_first = &heap_trend[2 * i];
+            const app_heap_sample_t *p_second = &heap_trend[(2 * i) + 1];
+
+            heap_trend[i].time_s = p_second->time_s;
+            heap_trend[i].in_use = (p_first->in_use > p_second->in_use) ? p_first->in_use : p_second->in_use;
+            heap_trend[i].buffers = (p_first->buffers > p_second->buffers) ? p_first->buffers : p_second->buffers;
+            heap_trend[i].free_bytes = (p_first->free_bytes < p_second->free_bytes) ?
+                                       p_first->free_bytes : p_second->free_bytes;
+            heap_trend[i].arena = (p_first->arena > p_second->arena) ? p_first->arena : p_second->arena;
+        }
+        heap_trend_count = APP_HEAP_TREND_SIZE / 2;
+        heap_trend_period *= 2;
+    }
+
+    cy_rtos_get_time(&now);
+    p_sample = &heap_trend[heap_trend_count++];
+    p_sample->time_s = (uint32_t)(now / 1000u);
+    heap_free_stats(p_sample);
+
+    state = cyhal_system_critical_section_enter();
+    p_sample->in_use = heap_period_in_use;
+    p_sample->buffers = heap_period_buffers;
+    heap_period_in_use = heap_stats.in_use;
+    heap_period_buffers = heap_stats.buffers;
+    cyhal_system_critical_section_exit(state);
+    heap_trend_ticks = 0;
+}
+
+/**
+* Function Name:
+* heap_timer_cb
+*
+* Function Description:
+* @brief   This callback asks the event loop for the heap trend; reading the
+*          allocator statistics takes its lock, left out of the timer context.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void heap_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void) arg;
+
+    app_event_post(APP_EVT_HEAP_TREND, 0);
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name:   app_heap.h
+*
+* Description: This is the header file for the heap instrumentation of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_HEAP_H_
+#define __APP_HEAP_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Outstanding buffers tracked, the ones beyond are only counted */
+#define APP_HEAP_TRACE_MAX_BUFFERS          (32)
+
+/* Samples of the heap trend. When they are all used, pairs of samples are
+ * merged and the period doubles, so the trend always covers the uptime. */
+#define APP_HEAP_TREND_SIZE                 (48)
+#define APP_HEAP_TREND_PERIOD_MS            (10 * 60 * 1000)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Heap state at one point of the trend */
+typedef struct
+{
+    uint32_t    time_s;             /* Uptime */
+    uint32_t    in_use;             /* Bytes outstanding, the most in the period */
+    uint16_t    buffers;            /* Buffers outstanding, the most in the period */
+    uint32_t    free_bytes;         /* Free bytes of the malloc() arena, the least in the period */
+    uint32_t    arena;              /* Bytes the malloc() arena claimed, the most in the period */
+} app_heap_sample_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void        *app_heap_alloc         (int len, const char *p_func, uint16_t line);
+void        app_heap_free           (void *p_buf);
+void        app_heap_init           (void);
+uint32_t    app_heap_get_usage      (uint32_t *p_high_water);
+void        app_heap_dump           (void);
+void        app_heap_event_handler  (uint32_t data);
+
+#endif // __APP_HEAP_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,426 @@
+/******************************************************************************
+* File Name:   app_log.c
+*
+* Description: This file implements the deferred logger of the Peripheral_Privacy
+*              Example for ModusToolbox. Callers store compact binary records in a
+*              RAM ring without waiting, and a low priority task formats and prints
+*              them, or sends them to the host to decode with tools/log_decode.py.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_log.h"
+#include "app_ctrl.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define LOG_RING_MASK                       (APP_LOG_RING_SIZE - 1)
+
+/* Longest formatted message */
+#define LOG_LINE_MAX                        (160)
+
+/* Size of a record sent to the host without its unused arguments */
+#define LOG_RECORD_HEADER_LEN               (offsetof(app_log_record_t, args))
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+#ifndef APP_LOG_BINARY
+/* Format strings, only of the messages compiled in. The host formats the
+ * records in binary mode, so the device needs none. */
+#define APP_LOG_STRING(id, module, level, fmt)      APP_LOG_ON_##id ? fmt : NULL,
+
+static const char *const log_formats[APP_LOG_FMT_MAX] =
+{
+    APP_LOG_FORMATS(APP_LOG_STRING)
+};
+#endif
+
+/* Ring of records. Any thread or interrupt can write: a slot is reserved by
+ * moving the head with a compare-and-swap, then marked ready once written.
+ * The drain task is the only reader and moves the tail. */
+static app_log_record_t log_ring[APP_LOG_RING_SIZE];
+static uint8_t          log_ready[APP_LOG_RING_SIZE];
+static uint32_t         log_head;
+static uint32_t         log_tail;
+
+/* Records lost because the ring was full, in total and already reported */
+static uint32_t         log_dropped;
+static uint32_t         log_dropped_reported;
+
+static uint32_t         log_written;
+static uint32_t         log_max_fill;
+
+/* Set while the drain task waits for a notification, so that it does not
+ * poll and the device can stay in deep sleep while nothing is logged */
+static bool             log_waiting;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static bool     log_drain_one   (void);
+static void     log_emit        (const app_log_record_t *p_rec);
+#ifndef APP_LOG_BINARY
+static void     log_format      (const app_log_record_t *p_rec, char *p_buf, size_t size);
+#endif
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_log_write
+*
+* Function Description:
+* @brief   This function stores a log record. It never blocks and can be
+*          called from any thread or interrupt; the record is dropped and
+*          counted if the ring is full.
+*
+* @param   fmt: Message id
+* @param   nargs: Number of arguments
+* @param   p_args: Arguments
+*
+* @return  None
+*/
+void app_log_write(app_log_fmt_t fmt, uint8_t nargs, const uint32_t *p_args)
+{
+    app_log_record_t *p_rec;
+    uint32_t head = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+
+    do
+    {
+        if (APP_LOG_RING_SIZE <= (head - __atomic_load_n(&log_tail, __ATOMIC_ACQUIRE)))
+        {
+            __atomic_fetch_add(&log_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&log_head, &head, head + 1, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if (APP_LOG_MAX_ARGS < nargs)
+    {
+        nargs = APP_LOG_MAX_ARGS;
+    }
+
+    p_rec = &log_ring[head & LOG_RING_MASK];
+    p_rec->timestamp_us = app_timestamp_us();
+    p_rec->fmt = (uint16_t)fmt;
+    p_rec->nargs = nargs;
+    p_rec->reserved = 0;
+    if (0 < nargs)
+    {
+        memcpy(p_rec->args, p_args, nargs * sizeof(uint32_t));
+    }
+
+    /* Hand the slot over to the drain task */
+    __atomic_store_n(&log_ready[head & LOG_RING_MASK], 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_exchange_n(&log_waiting, false, __ATOMIC_SEQ_CST))
+    {
+        cy_rtos_thread_set_notification(&app_log_task_pointer);
+    }
+}
+
+/**
+* Function Name:
+* app_log_hexdump
+*
+* Function Description:
+* @brief   This function logs a buffer in lines of 16 bytes.
+*
+* @param   p_data: Buffer
+* @param   len: Length of the buffer
+*
+* @return  None
+*/
+void app_log_hexdump(const void *p_data, uint16_t len)
+{
+    const uint8_t *p_bytes = (const uint8_t *)p_data;
+    uint32_t words[4];
+
+    for (uint16_t offset = 0; offset < len; offset += 16)
+    {
+        memset(words, 0, sizeof(words));
+        for (uint16_t i = 0; (i < 16) && (offset + i < len); i++)
+        {
+            words[i / 4] |= (uint32_t)p_bytes[offset + i] << (24 - 8 * (i % 4));
+        }
+        APP_LOG(LOG_HEXDUMP, offset, words[0], words[1], words[2], words[3]);
+    }
+}
+
+/**
+* Function Name:
+* app_log_drain_task
+*
+* Function Description:
+* @brief   This task emits the logged records, oldest first. It runs at low
+*          priority so printing never delays the Bluetooth stack, and sleeps
+*          until a record is written to an empty ring.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+void app_log_drain_task(cy_thread_arg_t arg)
+{
+    (void) arg;
+
+    for (;;)
+    {
+        while (log_drain_one())
+        {
+        }
+
+        /* Announce the wait before checking the ring, so a record written
+         * in between is either seen here or notified */
+        __atomic_store_n(&log_waiting, true, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&log_head, __ATOMIC_SEQ_CST) == log_tail)
+        {
+            cy_rtos_thread_wait_notification(CY_RTOS_NEVER_TIMEOUT);
+        }
+        else
+        {
+            /* A writer is still filling the oldest record */
+            __atomic_store_n(&log_waiting, false, __ATOMIC_RELAXED);
+            cy_rtos_delay_milliseconds(APP_LOG_DRAIN_PERIOD_MS);
+        }
+    }
+}
+
+/**
+* Function Name:
+* app_log_print_stats
+*
+* Function Description:
+* @brief   This function prints the statistics of the logger.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_log_print_stats(void)
+{
+    printf("Log: %" PRIu32 " records, %" PRIu32 " dropped, max fill %" PRIu32 "/%d\r\n",
+           log_written, __atomic_load_n(&log_dropped, __ATOMIC_RELAXED), log_max_fill, APP_LOG_RING_SIZE);
+}
+
+/**
+* Function Name:
+* log_drain_one
+*
+* Function Description:
+* @brief   This function emits the oldest record if it is complete, preceded
+*          by the number of records dropped since the last one.
+*
+* @param   None
+*
+* @return  bool: true if a record was emitted
+*/
+static bool log_drain_one(void)
+{
+    app_log_record_t rec;
+    uint32_t tail = log_tail;
+    uint32_t fill = __atomic_load_n(&log_head, __ATOMIC_ACQUIRE) - tail;
+    uint32_t dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+
+    if (fill > log_max_fill)
+    {
+        log_max_fill = fill;
+    }
+
+    if (dropped != log_dropped_reported)
+    {
+        memset(&rec, 0, sizeof(rec));
+        rec.timestamp_us = app_timestamp_us();
+        rec.fmt = LOG_DROPPED;
+        rec.nargs = 1;
+        rec.args[0] = dropped - log_dropped_reported;
+        log_dropped_reported = dropped;
+        log_emit(&rec);
+    }
+
+    /* A writer may still be filling the oldest slot */
+    if (!__atomic_load_n(&log_ready[tail & LOG_RING_MASK], __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    rec = log_ring[tail & LOG_RING_MASK];
+    __atomic_store_n(&log_ready[tail & LOG_RING_MASK], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&log_tail, tail + 1, __ATOMIC_RELEASE);
+    log_written++;
+
+    log_emit(&rec);
+
+    return true;
+}
+
+/**
+* Function Name:
+* log_emit
+*
+* Function Description:
+* @brief   This function prints a record, or sends it to the host as a
+*          control protocol event with the APP_LOG_BINARY build option.
+*
+* @param   p_rec: Record
+*
+* @return  None
+*/
+static void log_emit(const app_log_record_t *p_rec)
+{
+#ifdef APP_LOG_BINARY
+    app_ctrl_send_event(CTRL_EVT_LOG, (const uint8_t *)p_rec,
+                        (uint8_t)(LOG_RECORD_HEADER_LEN + p_rec->nargs * sizeof(uint32_t)));
+#else
+    char line[LOG_LINE_MAX];
+
+    log_format(p_rec, line, sizeof(line));
+    /* Control frames sent meanwhile are not split by the line */
+    app_ctrl_tx_lock();
+    printf("%s\n", line);
+    app_ctrl_tx_unlock();
+#endif
+}
+
+#ifndef APP_LOG_BINARY
+/**
+* Function Name:
+* log_format
+*
+* Function Description:
+* @brief   This function formats a record with its message format. Each
+*          conversion is printed with its own argument, B conversions take
+*          two arguments holding a Bluetooth address.
+*
+* @param   p_rec: Record
+* @param   p_buf: Buffer for the text
+* @param   size: Size of the buffer
+*
+* @return  None
+*/
+static void log_format(const app_log_record_t *p_rec, char *p_buf, size_t size)
+{
+    const char *p_fmt = (APP_LOG_FMT_MAX > p_rec->fmt) ? log_formats[p_rec->fmt] : NULL;
+    char spec[12];
+    size_t len = 0;
+    size_t spec_len;
+    uint8_t arg = 0;
+    uint32_t val;
+    uint32_t val2;
+    int out;
+
+    if (NULL == p_fmt)
+    {
+        p_fmt = "unknown log message";
+    }
+
+    while (('\0' != *p_fmt) && (len < size - 1))
+    {
+        if ('%' != *p_fmt)
+        {
+            p_buf[len++] = *p_fmt++;
+            continue;
+        }
+
+        /* Copy the conversion: %, flags and width, conversion character */
+        spec_len = 0;
+        spec[spec_len++] = *p_fmt++;
+        while (('\0' != *p_fmt) && (NULL != strchr("-+ #0123456789", *p_fmt)) && (spec_len < sizeof(spec) - 2))
+        {
+            spec[spec_len++] = *p_fmt++;
+        }
+        spec[spec_len++] = *p_fmt;
+        spec[spec_len] = '\0';
+
+        val = (arg < p_rec->nargs) ? p_rec->args[arg] : 0;
+        switch (*p_fmt)
+        {
+        case '%':
+            out = snprintf(&p_buf[len], size - len, "%%");
+            break;
+
+        case 'B':
+            val2 = (arg + 1 < p_rec->nargs) ? p_rec->args[arg + 1] : 0;
+            out = snprintf(&p_buf[len], size - len, "%02X:%02X:%02X:%02X:%02X:%02X",
+                           (unsigned int)(val >> 24), (unsigned int)((val >> 16) & 0xFF),
+                           (unsigned int)((val >> 8) & 0xFF), (unsigned int)(val & 0xFF),
+                           (unsigned int)((val2 >> 8) & 0xFF), (unsigned int)(val2 & 0xFF));
+            arg += 2;
+            break;
+
+        case 's':
+            out = snprintf(&p_buf[len], size - len, spec, (NULL != (const char *)(uintptr_t)val) ? (const char *)(uintptr_t)val : "");
+            arg++;
+            break;
+
+        case '\0':
+            out = 0;
+            break;
+
+        default:
+            out = snprintf(&p_buf[len], size - len, spec, (unsigned int)val);
+            arg++;
+            break;
+        }
+
+        if ('\0' != *p_fmt)
+        {
+            p_fmt++;
+        }
+        if (0 < out)
+        {
+            len += ((size_t)out < size - len) ? (size_t)out : (size - len - 1);
+        }
+    }
+
+    p_buf[len] = '\0';
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,167 @@
+/******************************************************************************
+* File Name:   app_log.h
+*
+* Description: This is the header file for the deferred logger of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_LOG_H_
+#define __APP_LOG_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "cyabs_rtos.h"
+#include "app_log_fmt.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Number of records the ring holds, must be a power of 2 */
+#define APP_LOG_RING_SIZE                   (64)
+
+/* Most arguments of one record */
+#define APP_LOG_MAX_ARGS                    (6)
+
+/* Time the drain task waits for a writer still filling the oldest record */
+#define APP_LOG_DRAIN_PERIOD_MS             (1)
+
+/* Log levels */
+#define APP_LOG_NONE                        (0)
+#define APP_LOG_ERROR                       (1)
+#define APP_LOG_WARN                        (2)
+#define APP_LOG_INFO                        (3)
+#define APP_LOG_DEBUG                       (4)
+
+/* Log level of the application, set by LOG_LEVEL in the Makefile. Each
+ * module can be given its own level with LOG_LEVEL_<module>. */
+#ifndef APP_LOG_LEVEL
+#define APP_LOG_LEVEL                       APP_LOG_INFO
+#endif
+
+/* Bonding, pairing and keys */
+#ifndef APP_LOG_LEVEL_BOND
+#define APP_LOG_LEVEL_BOND                  APP_LOG_LEVEL
+#endif
+
+/* Bluetooth stack, connections and GATT server */
+#ifndef APP_LOG_LEVEL_GATT
+#define APP_LOG_LEVEL_GATT                  APP_LOG_LEVEL
+#endif
+
+/* Advertising */
+#ifndef APP_LOG_LEVEL_ADV
+#define APP_LOG_LEVEL_ADV                   APP_LOG_LEVEL
+#endif
+
+/* Prompts of the terminal user interface */
+#ifndef APP_LOG_LEVEL_UI
+#define APP_LOG_LEVEL_UI                    APP_LOG_LEVEL
+#endif
+
+/* Messages of the logger itself */
+#define APP_LOG_LEVEL_CORE                  APP_LOG_ERROR
+
+/* Log a message without / with arguments. Arguments are stored as 32-bit
+ * values, see app_log_fmt.h for the conversions allowed. A message above the
+ * level of its module compiles to nothing, its arguments are not evaluated. */
+#define APP_LOG0(id)                        do { if (APP_LOG_ON_##id) { \
+                                                app_log_write((id), 0, NULL); } } while (0)
+#define APP_LOG(id, ...)                    do { if (APP_LOG_ON_##id) { \
+                                                app_log_write((id), APP_LOG_NARGS(__VA_ARGS__), \
+                                                              (const uint32_t[]){ __VA_ARGS__ }); } } while (0)
+
+/* Log a buffer, at the level of LOG_HEXDUMP */
+#define APP_LOG_HEXDUMP(p_data, len)        do { if (APP_LOG_ON_LOG_HEXDUMP) { \
+                                                app_log_hexdump((p_data), (len)); } } while (0)
+
+/* Arguments for the B (Bluetooth address) and s conversions */
+#define APP_LOG_BDA(bda)                    (((uint32_t)(bda)[0] << 24) | ((uint32_t)(bda)[1] << 16) | \
+                                             ((uint32_t)(bda)[2] << 8) | (uint32_t)(bda)[3]), \
+                                            (((uint32_t)(bda)[4] << 8) | (uint32_t)(bda)[5])
+#define APP_LOG_STR(str)                    ((uint32_t)(uintptr_t)(str))
+
+#define APP_LOG_NARGS(...)                  APP_LOG_NARGS_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define APP_LOG_NARGS_(a1, a2, a3, a4, a5, a6, n, ...)  n
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+#define APP_LOG_ENUM(id, module, level, fmt)        id,
+#define APP_LOG_ON_ENUM(id, module, level, fmt)     APP_LOG_ON_##id = (APP_LOG_##level <= APP_LOG_LEVEL_##module),
+
+/* Message ids, from the format table */
+typedef enum
+{
+    APP_LOG_FORMATS(APP_LOG_ENUM)
+    APP_LOG_FMT_MAX
+} app_log_fmt_t;
+
+/* APP_LOG_ON_<id> is 1 if the message is compiled in */
+enum
+{
+    APP_LOG_FORMATS(APP_LOG_ON_ENUM)
+};
+
+/* Log record, 32 bytes. The same layout is sent to the host in binary mode,
+ * with only the used arguments. */
+typedef struct
+{
+    uint32_t    timestamp_us;
+    uint16_t    fmt;
+    uint8_t     nargs;
+    uint8_t     reserved;
+    uint32_t    args[APP_LOG_MAX_ARGS];
+} app_log_record_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Drain task, woken by the writers when the ring was empty */
+extern cy_thread_t app_log_task_pointer;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void    app_log_write           (app_log_fmt_t fmt, uint8_t nargs, const uint32_t *p_args);
+void    app_log_hexdump         (const void *p_data, uint16_t len);
+void    app_log_drain_task      (cy_thread_arg_t arg);
+void    app_log_print_stats     (void);
+
+#endif // __APP_LOG_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,155 @@
+/******************************************************************************
+* File Name:   app_log_fmt.h
+*
+* Description: This file lists the log messages of the Peripheral_Privacy Example
+*              for ModusToolbox. tools/log_decode.py reads it to decode binary logs.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_LOG_FMT_H_
+#define __APP_LOG_FMT_H_
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* X(id, module, level, format) for every log message, the position in the
+ * list is the id stored in the log records, so only append to keep old logs
+ * decodable. Messages above the log level of their module (BOND, GATT, ADV or
+ * UI, see app_log.h) are compiled out along with their format string.
+ * Arguments are 32-bit: formats use d, u, x, X and c conversions with flags
+ * and width but no length modifier, s for string literals only (the pointer
+ * is stored), and B for a Bluetooth address passed with APP_LOG_BDA(). */
+#define APP_LOG_FORMATS(X) \
+    X(LOG_DROPPED,                CORE, ERROR, "*** %u log records dropped ***") \
+    X(LOG_HEXDUMP,                BOND, DEBUG, "  %04x: %08X %08X %08X %08X") \
+    X(LOG_LOCAL_ADDR,             ADV,  INFO,  "Local Bluetooth Address: %B") \
+    X(LOG_BT_DISABLED,            GATT, ERROR, "Bluetooth Disabled") \
+    X(LOG_NUMERIC_COMPARE,        UI,   INFO,  "* NUMERIC = %u *") \
+    X(LOG_NUMERIC_PROMPT,         UI,   INFO,  "Press 'y' if the numeric values match on both devices or press 'n' if they do not.") \
+    X(LOG_PASSKEY,                UI,   INFO,  "PassKey: %u") \
+    X(LOG_SECURITY_GRANTED,       BOND, INFO,  "Security Request Granted") \
+    X(LOG_SECURITY_DENIED,        BOND, WARN,  "Security Request Denied - not in bonding mode") \
+    X(LOG_IO_CAP_REQUEST,         BOND, DEBUG, "BLE Pairing IO Capabilities Request") \
+    X(LOG_CONN_PARAM_UPDATE,      GATT, INFO,  "Connection parameter update status:%d, Connection Interval: %d, Connection Latency: %d, Connection Timeout: %d") \
+    X(LOG_PAIRING_STATUS,         BOND, INFO,  "Pairing Status %s") \
+    X(LOG_SLOT_DATA_SAVED,        BOND, INFO,  "Slot Data saved to Flash") \
+    X(LOG_BONDED_TO,              BOND, INFO,  "Successfully Bonded to: %B") \
+    X(LOG_FLASH_WRITE_ERROR,      BOND, ERROR, "Flash Write Error") \
+    X(LOG_BOND_COUNT,             BOND, INFO,  "Number of bonded devices: %d, Next free slot: %d, Number of slots free: %d") \
+    X(LOG_BONDING_FAILED,         BOND, ERROR, "Bonding failed!") \
+    X(LOG_ENCRYPTION_STATUS,      BOND, INFO,  "Encryption Status event for: %B result: %d") \
+    X(LOG_BOND_INFO_PRESENT,      BOND, DEBUG, "Bond info present in Flash for device: %B") \
+    X(LOG_BOND_INFO_ABSENT,       BOND, WARN,  "No Bond info present in Flash for device: %B") \
+    X(LOG_KEY_UPDATE,             BOND, DEBUG, "Paired Device Key Update") \
+    X(LOG_BOND_FAILED,            BOND, ERROR, "Failed to bond!") \
+    X(LOG_KEY_REQUEST,            BOND, DEBUG, "Paired Device Link keys Request Event for device %B") \
+    X(LOG_KEY_NOT_FOUND,          BOND, WARN,  "Device Link Keys not found in the database!") \
+    X(LOG_LOCAL_KEY_UPDATE,       BOND, DEBUG, "Local Identity Key Update") \
+    X(LOG_LOCAL_KEY_REQUEST,      BOND, DEBUG, "Local Identity Key Request") \
+    X(LOG_ADV_STATE,              ADV,  INFO,  "Advertisement State Change: %d") \
+    X(LOG_UNHANDLED_BTM_EVENT,    GATT, DEBUG, "Unhandled Bluetooth Management Event: 0x%x %s") \
+    X(LOG_BOND_RESTORED,          BOND, INFO,  "Bond data successfully restored from flash!") \
+    X(LOG_NO_BONDED_DEVICE,       ADV,  INFO,  "No bonded Device Found,Starting Undirected Advertisement") \
+    X(LOG_BOND_DATA_HEADER,       BOND, DEBUG, "printing Bonded Device information:") \
+    X(LOG_BOND_DATA_SLOT,         BOND, DEBUG, "Slot: %d Device Bluetooth Address: %B Device Keys:") \
+    X(LOG_ONE_DEVICE,             ADV,  INFO,  "Only 1 Device Found,Starting directed Advertisement to: %B (connection address %B)") \
+    X(LOG_PROMPT_BOND_MODE,       UI,   INFO,  "Enter e for Starting undirected Advertisement to add new device") \
+    X(LOG_PROMPT_SELECT_DIRECTED, UI,   INFO,  "Select the bonded Devices Found in below list to Start Directed Advertisement") \
+    X(LOG_PROMPT_SLOT,            UI,   INFO,  "Enter slot number to start directed advertisement for that device") \
+    X(LOG_NOTE_SLOTS_FULL,        UI,   INFO,  "NOTE: once the slots are full the oldest device data will be overwritten for new device") \
+    X(LOG_ACCEPT_LIST,            UI,   INFO,  "Bonded devices can reconnect without selection") \
+    X(LOG_CONNECTED,              GATT, INFO,  "Connected : BD Addr: %B Connection ID '%d'") \
+    X(LOG_DISCONNECTED,           GATT, INFO,  "Disconnected : BD Addr: %B Connection ID '%d', Reason '%s'") \
+    X(LOG_NOTIFICATION_CONFIRMED, GATT, DEBUG, "Client received our notification") \
+    X(LOG_UNHANDLED_OPCODE,       GATT, DEBUG, "Unhandled Event opcode:%d") \
+    X(LOG_SET_ATTR_STATUS,        GATT, WARN,  "WARNING: GATT set attr status 0x%x") \
+    X(LOG_CCCD_SAVE_FAILED,       GATT, ERROR, "Failed to update CCCD Value in Flash!") \
+    X(LOG_CCCD_SAVED,             GATT, DEBUG, "CCCD value updated in Flash!") \
+    X(LOG_WRITE_NOT_SUPPORTED,    GATT, WARN,  "Write is not supported") \
+    X(LOG_WRITE_INVALID_HANDLE,   GATT, WARN,  "Write Request to Invalid Handle: 0x%x") \
+    X(LOG_NO_MEMORY,              GATT, ERROR, "No memory, len_requested: %d!!") \
+    X(LOG_TYPE_NO_ATTRIBUTE,      GATT, WARN,  "found type but no attribute for %d") \
+    X(LOG_ATTR_NOT_FOUND,         GATT, DEBUG, "attr not found  start_handle: 0x%04x  end_handle: 0x%04x  Type: 0x%04x") \
+    X(LOG_HOST,                   UI,   INFO,  "Host %d: %B") \
+    X(LOG_NO_BOND_DATA,           BOND, INFO,  "Bond data not present in the flash!") \
+    X(LOG_CCCD_UPDATE,            GATT, DEBUG, "Updating CCCD Value to: %d") \
+    X(LOG_FLASH_WRITE_ERROR_CODE, BOND, ERROR, "Flash Write Error,Error code: %u") \
+    X(LOG_DEVICE_FOUND,           BOND, DEBUG, "Found device in the flash!") \
+    X(LOG_KEYS_READ_ERROR,        BOND, WARN,  "Error Reading Keys! New Keys need to be generated!") \
+    X(LOG_KEYS_AVAILABLE,         BOND, DEBUG, "Identity keys are available in the database.") \
+    X(LOG_KEYS_READ,              BOND, DEBUG, "Local identity keys read from Flash:") \
+    X(LOG_KEYS_SAVED,             BOND, INFO,  "Local identity Keys saved to Flash") \
+    X(LOG_RESOLVING_LIST_ADDED,   BOND, INFO,  "Device added to address resolution database: %B") \
+    X(LOG_RESOLVING_LIST_ERROR,   BOND, ERROR, "Error adding device to address resolution database, Error Code %d") \
+    X(LOG_PROMPT_SELECT_PRIVACY,  UI,   INFO,  "Select the bonded Devices Found in below list to toggle current privacy mode") \
+    X(LOG_PROMPT_PRIVACY_SLOT,    UI,   INFO,  "Enter the slot number of the device to change privacy mode:") \
+    X(LOG_ADV_START_FAILED,       ADV,  ERROR, "Failed to start advertisement, Error Code %u") \
+    X(LOG_ADV_STEP,               ADV,  INFO,  "Advertising interval step %d: %u ms") \
+    X(LOG_ADV_SCHEDULE_STOP,      ADV,  INFO,  "Advertising stopped by the advertising schedule") \
+    X(LOG_ADV_DATA_FAILED,        ADV,  ERROR, "Failed to set advertising data, Error Code %u") \
+    X(LOG_SCAN_RSP_FAILED,        ADV,  ERROR, "Failed to set scan response data, Error Code %u") \
+    X(LOG_ADV_SET_DATA_FAILED,    ADV,  ERROR, "Failed to set data of advertising set %d, Error Code %u") \
+    X(LOG_ADV_ELEM_DROPPED,       ADV,  WARN,  "Advertising element type 0x%02x does not fit, dropped") \
+    X(LOG_ADV_SET_PARAM_FAILED,   ADV,  ERROR, "Failed to set parameters of advertising set %d, Error Code %u") \
+    X(LOG_ADV_SET_ENABLE_FAILED,  ADV,  ERROR, "Failed to %s advertising set %d, Error Code %u") \
+    X(LOG_ACCEPT_LIST_FAILED,     ADV,  ERROR, "Failed to add bonded device %d to the filter accept list") \
+    X(LOG_LINK_LOSS_ADV_FAILED,   ADV,  ERROR, "Failed to start link-loss directed advertisement, Error Code %u") \
+    X(LOG_LINK_LOSS_ADV,          ADV,  INFO,  "Link lost, starting directed advertisement to: %B") \
+    X(LOG_LINK_LOSS_RECONNECTED,  GATT, INFO,  "Link-loss peer reconnected after %u ms") \
+    X(LOG_LINK_LOSS_RESUMED,      GATT, INFO,  "Link-loss session resumed in %u ms (CCCD 0x%04X)") \
+    X(LOG_LINK_LOSS_CANCELLED,    ADV,  INFO,  "Link-loss recovery cancelled") \
+    X(LOG_STATE_TRANSITION,       GATT, INFO,  "State %s -> %s on %s, queued %u us, action %u us") \
+    X(LOG_STATE_REJECTED,         GATT, WARN,  "State %s: %s not allowed") \
+    X(LOG_STATE_LOST,             GATT, ERROR, "State machine queue full, %s lost") \
+    X(LOG_NOTIFICATION_SENT,      GATT, DEBUG, "Send Notification: sending Button value, status %d") \
+    X(LOG_NOTIFICATIONS_DISABLED, GATT, DEBUG, "Notifications are Disabled") \
+    X(LOG_NOT_CONNECTED,          GATT, DEBUG, "Connection is not Up") \
+    X(LOG_BOND_MODE_ENTERED,      UI,   INFO,  "Bonding Mode Entered") \
+    X(LOG_BOND_MODE_EXITED,       UI,   INFO,  "Bonding Mode Exited") \
+    X(LOG_RESOLVING_LIST_CLEARED, BOND, INFO,  "Address resolution list cleared successfully") \
+    X(LOG_RESOLVING_CLEAR_FAILED, BOND, ERROR, "Failed to clear address resolution list") \
+    X(LOG_BONDS_ERASED,           BOND, INFO,  "Erased Flash!") \
+    X(LOG_DIRECTED_ADV,           ADV,  INFO,  "Starting directed Advertisement for %B") \
+    X(LOG_DIRECTED_ADV_FAILED,    ADV,  ERROR, "failed to start directed advertisement!") \
+    X(LOG_BOND_SLOTS_FULL,        BOND, INFO,  "Bonding slots full removing the oldest device") \
+    X(LOG_BOND_DELETE_FAILED,     BOND, ERROR, "error deleting device bond data! Error code: %u") \
+    X(LOG_HOST_REMOVED,           BOND, INFO,  "Removed host: %B") \
+    X(LOG_HOST_REMOVE_FAILED,     BOND, ERROR, "Flash Write Error, Cannot delete device!") \
+    X(LOG_KVSTORE_RESET,          BOND, INFO,  "successfully reset kv-store library, Please reset the device to generate new Keys!") \
+    X(LOG_KVSTORE_RESET_FAILED,   BOND, ERROR, "failed to reset kv-store library, Error code: %u")
+
+#endif // __APP_LOG_FMT_H_
+
+/* [] END OF FILE */
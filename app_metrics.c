@@ -0,0 +1,541 @@
+/******************************************************************************
+* File Name:   app_metrics.c
+*
+* Description: This file keeps the counters of the Metrics GATT service: connections,
+*              reconnect latency, bonds, flash writes, notifications, congestion, heap
+*              and stack buffer pools. Gateways read the three characteristics with one
+*              Read Multiple request, or subscribe to a periodic notification batch.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include "wiced_memory.h"
+#include "cycfg_gatt_db.h"
+#include "app_bt_bonding.h"
+#include "app_event.h"
+#include "app_heap.h"
+#include "app_metrics.h"
+#include "app_utils.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static app_metrics_t    metrics;
+
+static const uint32_t   metrics_latency_bounds[APP_METRICS_LATENCY_BUCKETS - 1] = APP_METRICS_LATENCY_BOUNDS_MS;
+
+/* Connection the notification batch goes to, 0 when disconnected */
+static uint16_t         metrics_conn_id;
+
+/* The link is congested, the batch waits for it to clear */
+static wiced_bool_t     metrics_congested;
+static wiced_bool_t     metrics_batch_pending;
+
+/* Time of the last disconnection, the start of the reconnect latency */
+static wiced_bool_t     metrics_disconnected;
+static cy_time_t        metrics_disconnect_time;
+
+static cy_timer_t       metrics_timer;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void     metrics_build           (uint8_t *p_counters, uint8_t *p_latency, uint8_t *p_resources);
+static uint8_t  *metrics_put            (uint8_t *p_data, uint32_t value, uint8_t size);
+static void     metrics_notify          (uint16_t handle, uint8_t *p_val, uint16_t len);
+static void     metrics_timer_cb        (cy_timer_callback_arg_t arg);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_metrics_init
+*
+* Function Description:
+* @brief   This function creates the timer of the notification batch. It is
+*          started when a client enables the Counters notifications.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_metrics_init(void)
+{
+    if (CY_RSLT_SUCCESS != cy_rtos_timer_init(&metrics_timer, CY_TIMER_TYPE_PERIODIC, metrics_timer_cb, NULL))
+    {
+        printf("Failed to create the metrics timer!\n");
+    }
+}
+
+/**
+* Function Name:
+* app_metrics_on_connect
+*
+* Function Description:
+* @brief   This function counts a connection. Called by the Bluetooth stack
+*          thread.
+*
+* @param   conn_id: Connection ID
+*
+* @return  None
+*/
+void app_metrics_on_connect(uint16_t conn_id)
+{
+    metrics.connections++;
+    metrics_conn_id = conn_id;
+}
+
+/**
+* Function Name:
+* app_metrics_on_disconnect
+*
+* Function Description:
+* @brief   This function stops the notification batch, the CCCD is not kept
+*          across connections, and starts timing the reconnection. Called by
+*          the Bluetooth stack thread.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_metrics_on_disconnect(void)
+{
+    metrics_conn_id = 0;
+    metrics_congested = WICED_FALSE;
+    metrics_batch_pending = WICED_FALSE;
+    app_metrics_counters_client_char_config[0] = 0;
+    app_metrics_counters_client_char_config[1] = 0;
+    cy_rtos_timer_stop(&metrics_timer);
+
+    metrics_disconnected = WICED_TRUE;
+    cy_rtos_get_time(&metrics_disconnect_time);
+}
+
+/**
+* Function Name:
+* app_metrics_on_reconnect
+*
+* Function Description:
+* @brief   This function records the reconnect latency, from the last
+*          disconnection to a bonded peer encrypting the link, once per
+*          disconnection. Called by the Bluetooth stack thread.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_metrics_on_reconnect(void)
+{
+    cy_time_t now;
+    uint32_t latency_ms;
+    uint32_t i;
+
+    if (WICED_TRUE != metrics_disconnected)
+    {
+        return;
+    }
+    metrics_disconnected = WICED_FALSE;
+
+    cy_rtos_get_time(&now);
+    latency_ms = (uint32_t)(now - metrics_disconnect_time);
+    for (i = 0; (i < (APP_METRICS_LATENCY_BUCKETS - 1)) && (latency_ms >= metrics_latency_bounds[i]); i++)
+    {
+    }
+    if (UINT16_MAX != metrics.latency[i])
+    {
+        metrics.latency[i]++;
+    }
+    if (latency_ms > metrics.latency_max_ms)
+    {
+        metrics.latency_max_ms = latency_ms;
+    }
+    metrics.reconnections++;
+}
+
+/**
+* Function Name:
+* app_metrics_on_eviction
+*
+* Function Description:
+* @brief   This function counts the oldest bond removed to make room.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_metrics_on_eviction(void)
+{
+    metrics.evictions++;
+}
+
+/**
+* Function Name:
+* app_metrics_on_kv_write
+*
+* Function Description:
+* @brief   This function counts a successful kv-store write.
+*
+* @param   size: Size of the value written
+*
+* @return  None
+*/
+void app_metrics_on_kv_write(uint32_t size)
+{
+    metrics.kv_writes++;
+    metrics.kv_bytes += size;
+}
+
+/**
+* Function Name:
+* app_metrics_on_notification
+*
+* Function Description:
+* @brief   This function counts a notification handed to the stack, or
+*          dropped if the stack refused it.
+*
+* @param   status: Status of wiced_bt_gatt_server_send_notification()
+*
+* @return  None
+*/
+void app_metrics_on_notification(wiced_bt_gatt_status_t status)
+{
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        metrics.notifications++;
+    }
+    else
+    {
+        metrics.notification_drops++;
+    }
+}
+
+/**
+* Function Name:
+* app_metrics_on_congestion
+*
+* Function Description:
+* @brief   This function counts the link becoming congested, and sends the
+*          batch held back by the congestion once it clears. Called by the
+*          Bluetooth stack thread.
+*
+* @param   congested: WICED_TRUE if the link became congested
+*
+* @return  None
+*/
+void app_metrics_on_congestion(wiced_bool_t congested)
+{
+    if ((WICED_TRUE == congested) && (WICED_TRUE != metrics_congested))
+    {
+        metrics.congestions++;
+    }
+    metrics_congested = congested;
+
+    if ((WICED_TRUE != congested) && (WICED_TRUE == metrics_batch_pending))
+    {
+        app_event_post(APP_EVT_METRICS, 0);
+    }
+}
+
+/**
+* Function Name:
+* app_metrics_is_attribute
+*
+* Function Description:
+* @brief   This function tells whether a handle is a Metrics value, to be
+*          refreshed before it is read.
+*
+* @param   handle: Attribute handle
+*
+* @return  wiced_bool_t: WICED_TRUE for a Metrics value
+*/
+wiced_bool_t app_metrics_is_attribute(uint16_t handle)
+{
+    return ((HDLC_METRICS_COUNTERS_VALUE == handle) || (HDLC_METRICS_LATENCY_VALUE == handle) ||
+            (HDLC_METRICS_RESOURCES_VALUE == handle)) ? WICED_TRUE : WICED_FALSE;
+}
+
+/**
+* Function Name:
+* app_metrics_refresh
+*
+* Function Description:
+* @brief   This function writes the counters to the values of the Metrics
+*          characteristics before they are read. Called by the Bluetooth stack
+*          thread only: the notification batch of the event loop is built in
+*          buffers of its own, so a read never returns a value half written.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_metrics_refresh(void)
+{
+    metrics_build(app_metrics_counters, app_metrics_latency, app_metrics_resources);
+}
+
+/**
+* Function Name:
+* app_metrics_set_cccd
+*
+* Function Description:
+* @brief   This function starts the notification batch when the client
+*          enables the Counters notifications, with a first batch right
+*          away, and stops it when they are disabled.
+*
+* @param   cccd: Value written to the Counters CCCD
+*
+* @return  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS
+*/
+wiced_bt_gatt_status_t app_metrics_set_cccd(uint16_t cccd)
+{
+    if (cccd & GATT_CLIENT_CONFIG_NOTIFICATION)
+    {
+        cy_rtos_timer_start(&metrics_timer, APP_METRICS_NOTIFY_PERIOD_MS);
+        app_event_post(APP_EVT_METRICS, 0);
+    }
+    else
+    {
+        cy_rtos_timer_stop(&metrics_timer);
+    }
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/**
+* Function Name:
+* app_metrics_event_handler
+*
+* Function Description:
+* @brief   This function sends the notification batch, the three Metrics
+*          values back to back, if the client enabled it. While the link is
+*          congested the batch is held until the congestion clears. The
+*          values are built in buffers freed by the stack once transmitted.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_metrics_event_handler(uint32_t data)
+{
+    uint8_t *p_counters;
+    uint8_t *p_latency;
+    uint8_t *p_resources;
+
+    (void) data;
+
+    if ((0 == metrics_conn_id) ||
+        !(app_metrics_counters_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION))
+    {
+        return;
+    }
+    if (WICED_TRUE == metrics_congested)
+    {
+        metrics_batch_pending = WICED_TRUE;
+        return;
+    }
+    metrics_batch_pending = WICED_FALSE;
+
+    p_counters = app_alloc_buffer(app_metrics_counters_len);
+    p_latency = app_alloc_buffer(app_metrics_latency_len);
+    p_resources = app_alloc_buffer(app_metrics_resources_len);
+    if ((NULL == p_counters) || (NULL == p_latency) || (NULL == p_resources))
+    {
+        app_free_buffer(p_counters);
+        app_free_buffer(p_latency);
+        app_free_buffer(p_resources);
+        return;
+    }
+
+    metrics_build(p_counters, p_latency, p_resources);
+    metrics_notify(HDLC_METRICS_COUNTERS_VALUE, p_counters, app_metrics_counters_len);
+    metrics_notify(HDLC_METRICS_LATENCY_VALUE, p_latency, app_metrics_latency_len);
+    metrics_notify(HDLC_METRICS_RESOURCES_VALUE, p_resources, app_metrics_resources_len);
+}
+
+/**
+* Function Name:
+* metrics_build
+*
+* Function Description:
+* @brief   This function writes the counters to the three Metrics values,
+*          little endian:
+*          Counters:  version, bonds, bond slots, congested (1 byte each),
+*                     uptime s, connections, reconnections, evictions,
+*                     kv writes, kv bytes, notifications, notification
+*                     drops, congestions (4 bytes each)
+*          Latency:   reconnections per latency bucket (2 bytes each,
+*                     saturated), slowest reconnection ms (4 bytes)
+*          Resources: heap bytes in use, heap high-water mark (4 bytes
+*                     each), then per stack buffer pool its buffer size,
+*                     buffers in use, most in use and total (2 bytes each)
+*
+* @param   p_counters: Counters value
+* @param   p_latency: Latency value
+* @param   p_resources: Resources value
+*
+* @return  None
+*/
+static void metrics_build(uint8_t *p_counters, uint8_t *p_latency, uint8_t *p_resources)
+{
+    wiced_bt_buffer_statistics_t pools[APP_METRICS_POOLS];
+    uint32_t heap_high_water;
+    uint32_t heap_in_use;
+    cy_time_t now;
+    uint8_t *p;
+    uint32_t i;
+
+    cy_rtos_get_time(&now);
+    {
+        uint32_t counters[] =
+        {
+            now / 1000,
+            metrics.connections,
+            metrics.reconnections,
+            metrics.evictions,
+            metrics.kv_writes,
+            metrics.kv_bytes,
+            metrics.notifications,
+            metrics.notification_drops,
+            metrics.congestions,
+        };
+
+        p = p_counters;
+        *p++ = APP_METRICS_VERSION;
+        *p++ = bondinfo.slot_data[NUM_BONDED];
+        *p++ = BOND_INDEX_MAX;
+        *p++ = (WICED_TRUE == metrics_congested) ? 1 : 0;
+        for (i = 0; i < sizeof(counters) / sizeof(counters[0]); i++)
+        {
+            p = metrics_put(p, counters[i], 4);
+        }
+    }
+
+    p = p_latency;
+    for (i = 0; i < APP_METRICS_LATENCY_BUCKETS; i++)
+    {
+        p = metrics_put(p, metrics.latency[i], 2);
+    }
+    metrics_put(p, metrics.latency_max_ms, 4);
+
+    memset(pools, 0, sizeof(pools));
+    wiced_bt_get_buffer_usage(pools, sizeof(pools));
+    heap_in_use = app_heap_get_usage(&heap_high_water);
+    p = metrics_put(p_resources, heap_in_use, 4);
+    p = metrics_put(p, heap_high_water, 4);
+    for (i = 0; i < APP_METRICS_POOLS; i++)
+    {
+        p = metrics_put(p, pools[i].pool_size, 2);
+        p = metrics_put(p, pools[i].current_allocated_count, 2);
+        p = metrics_put(p, pools[i].max_allocated_count, 2);
+        p = metrics_put(p, pools[i].total_count, 2);
+    }
+}
+
+/**
+* Function Name:
+* metrics_put
+*
+* Function Description:
+* @brief   This function writes a value little endian.
+*
+* @param   p_data: Where to write
+* @param   value: Value
+* @param   size: Bytes to write, 2 or 4
+*
+* @return  uint8_t*: Byte after the value
+*/
+static uint8_t *metrics_put(uint8_t *p_data, uint32_t value, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        *p_data++ = (uint8_t)(value >> (8 * i));
+    }
+    return p_data;
+}
+
+/**
+* Function Name:
+* metrics_notify
+*
+* Function Description:
+* @brief   This function sends one value of the batch and counts it. The
+*          buffer is freed by the stack, or here if the stack refuses it.
+*
+* @param   handle: Value handle
+* @param   p_val: Value, from app_alloc_buffer()
+* @param   len: Length of the value
+*
+* @return  None
+*/
+static void metrics_notify(uint16_t handle, uint8_t *p_val, uint16_t len)
+{
+    wiced_bt_gatt_status_t status = wiced_bt_gatt_server_send_notification(metrics_conn_id, handle, len, p_val,
+                                                                            (void *)app_free_buffer);
+
+    app_metrics_on_notification(status);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        app_free_buffer(p_val);
+    }
+}
+
+/**
+* Function Name:
+* metrics_timer_cb
+*
+* Function Description:
+* @brief   This callback asks the event loop for the next notification batch.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void metrics_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void) arg;
+
+    app_event_post(APP_EVT_METRICS, 0);
+}
+
+/* [] END OF FILE */
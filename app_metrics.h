@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name:   app_metrics.h
+*
+* Description: This is the header file of the counters of the Metrics GATT service,
+*              read by gateways without the debug UART.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_METRICS_H_
+#define __APP_METRICS_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Version of the layout of the Metrics characteristics, first byte of Counters */
+#define APP_METRICS_VERSION                 (1u)
+
+/* Upper bounds of the reconnect latency buckets, in ms, the last bucket is
+ * open-ended */
+#define APP_METRICS_LATENCY_BOUNDS_MS       { 100, 200, 500, 1000, 2000, 5000, 10000 }
+#define APP_METRICS_LATENCY_BUCKETS         (8)
+
+/* Buffer pools of the stack reported in Resources */
+#define APP_METRICS_POOLS                   (4)
+
+/* Period of the notification batch while the Counters CCCD is enabled */
+#define APP_METRICS_NOTIFY_PERIOD_MS        (60 * 1000)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Counters since boot */
+typedef struct
+{
+    uint32_t    connections;
+    uint32_t    reconnections;      /* Bonded peers encrypted again after a disconnection */
+    uint32_t    evictions;          /* Oldest bond removed to make room */
+    uint32_t    kv_writes;          /* Successful kv-store writes */
+    uint32_t    kv_bytes;
+    uint32_t    notifications;      /* Handed to the stack */
+    uint32_t    notification_drops; /* Refused by the stack */
+    uint32_t    congestions;        /* Times the link became congested */
+    uint32_t    latency_max_ms;     /* Slowest reconnection */
+    uint16_t    latency[APP_METRICS_LATENCY_BUCKETS];
+} app_metrics_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_metrics_init                (void);
+void            app_metrics_on_connect          (uint16_t conn_id);
+void            app_metrics_on_disconnect       (void);
+void            app_metrics_on_reconnect        (void);
+void            app_metrics_on_eviction         (void);
+void            app_metrics_on_kv_write         (uint32_t size);
+void            app_metrics_on_notification     (wiced_bt_gatt_status_t status);
+void            app_metrics_on_congestion       (wiced_bool_t congested);
+wiced_bool_t    app_metrics_is_attribute        (uint16_t handle);
+void            app_metrics_refresh             (void);
+wiced_bt_gatt_status_t app_metrics_set_cccd     (uint16_t cccd);
+void            app_metrics_event_handler       (uint32_t data);
+
+#endif // __APP_METRICS_H_
+
+/* [] END OF FILE */
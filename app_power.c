@@ -0,0 +1,492 @@
+/******************************************************************************
+* File Name:   app_power.c
+*
+* Description: This file implements the power manager of the Peripheral_Privacy
+*              Example for ModusToolbox. Deep sleep is allowed whenever the device
+*              is idle, and locked only while the kv-store is accessed or the
+*              terminal is in use. The time spent in each power state and the
+*              wake-up latency are measured from the system power callbacks.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "cy_retarget_io.h"
+#include "cybsp.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_power.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static cyhal_syspm_callback_data_t  power_cb_data;
+
+/* Deep sleep lock held for the terminal, and the time of the last character
+ * received, released by the timer once the terminal has been idle for
+ * APP_POWER_UART_IDLE_MS */
+static cy_timer_t                   power_uart_timer;
+static volatile bool                power_uart_locked;
+static volatile cy_time_t           power_uart_last_ms;
+
+/* Time the awake time was last counted, and the time the CPU went to sleep */
+static uint64_t                     power_last_us;
+static uint64_t                     power_sleep_start_us;
+
+/* Falling edge of the debug UART receive pin, a start bit, in deep sleep */
+static cyhal_gpio_callback_data_t   power_uart_wake_cb_data;
+
+/* Time of the last exit from deep sleep. power_woke is set until the CPU
+ * idles again or a wake-up interrupt is taken; power_wake_pending is set
+ * from that interrupt until its event is handled. */
+static uint32_t                     power_wake_us;
+static volatile bool                power_woke;
+static volatile bool                power_wake_pending;
+
+static app_power_stats_t            power_stats;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static bool power_syspm_callback    (cyhal_syspm_callback_state_t state,
+                                     cyhal_syspm_callback_mode_t mode, void *callback_arg);
+static void power_uart_timer_cb     (cy_timer_callback_arg_t arg);
+static void power_uart_wake_isr     (void *handler_arg, cyhal_gpio_event_t event);
+static void power_count_awake       (void);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_power_init
+*
+* Function Description:
+* @brief   This function registers the power callbacks and starts counting
+*          the time in each power state. The debug UART receive pin is set up
+*          to wake the device from deep sleep. With the APP_POWER_NO_DEEPSLEEP
+*          build option deep sleep stays locked, as needed to keep a debugger
+*          attached.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_init(void)
+{
+    cy_rslt_t rslt;
+
+    memset(&power_stats, 0, sizeof(power_stats));
+    power_stats.wake_min_us = UINT32_MAX;
+    power_last_us = app_timestamp_us64();
+
+    rslt = cy_rtos_timer_init(&power_uart_timer, CY_TIMER_TYPE_ONCE, power_uart_timer_cb, NULL);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to create the UART idle timer!!\r\n");
+        CY_ASSERT(0);
+    }
+
+    power_cb_data.callback = power_syspm_callback;
+    power_cb_data.states = (cyhal_syspm_callback_state_t)(CYHAL_SYSPM_CB_CPU_SLEEP |
+                                                          CYHAL_SYSPM_CB_CPU_DEEPSLEEP);
+    power_cb_data.ignore_modes = (cyhal_syspm_callback_mode_t)0;
+    power_cb_data.args = NULL;
+    power_cb_data.next = NULL;
+    cyhal_syspm_register_callback(&power_cb_data);
+
+    /* The pin stays with the UART, only its edge interrupt is used */
+    power_uart_wake_cb_data.callback = power_uart_wake_isr;
+    power_uart_wake_cb_data.callback_arg = NULL;
+    cyhal_gpio_register_callback(CYBSP_DEBUG_UART_RX, &power_uart_wake_cb_data);
+
+#ifdef APP_POWER_NO_DEEPSLEEP
+    cyhal_syspm_lock_deepsleep();
+#endif
+}
+
+/**
+* Function Name:
+* app_power_lock
+*
+* Function Description:
+* @brief   This function keeps the device out of deep sleep until the matching
+*          app_power_unlock. Locks are counted and can be nested.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_lock(void)
+{
+    power_stats.locks++;
+    cyhal_syspm_lock_deepsleep();
+}
+
+/**
+* Function Name:
+* app_power_unlock
+*
+* Function Description:
+* @brief   This function releases a lock taken with app_power_lock.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_unlock(void)
+{
+    cyhal_syspm_unlock_deepsleep();
+}
+
+/**
+* Function Name:
+* app_power_uart_activity
+*
+* Function Description:
+* @brief   This function is called by the UART receive interrupt. It locks
+*          deep sleep, if not already locked, until the terminal has been idle
+*          for APP_POWER_UART_IDLE_MS.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_uart_activity(void)
+{
+    cy_time_t now;
+
+    cy_rtos_get_time(&now);
+    power_uart_last_ms = now;
+    if (!power_uart_locked)
+    {
+        power_uart_locked = true;
+        power_stats.uart_windows++;
+        cyhal_syspm_lock_deepsleep();
+        cy_rtos_timer_start(&power_uart_timer, APP_POWER_UART_IDLE_MS);
+    }
+}
+
+/**
+* Function Name:
+* app_power_wake_source
+*
+* Function Description:
+* @brief   This function is called by the interrupts that can wake the device.
+*          If the device has just left deep sleep, the interrupt is counted as
+*          the wake-up source and its event is timed.
+*
+* @param   source: Interrupt
+*
+* @return  None
+*/
+void app_power_wake_source(app_power_wake_t source)
+{
+    if (power_woke)
+    {
+        power_woke = false;
+        power_wake_pending = true;
+        power_stats.wakes[source]++;
+    }
+}
+
+/**
+* Function Name:
+* app_power_wake_handled
+*
+* Function Description:
+* @brief   This function is called by the event loop before each handler. It
+*          records the wake-up latency if the event is the one of a wake-up
+*          interrupt.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_wake_handled(void)
+{
+    uint32_t latency_us;
+
+    if (!power_wake_pending)
+    {
+        return;
+    }
+    power_wake_pending = false;
+
+    latency_us = app_timestamp_us() - power_wake_us;
+    power_stats.wake_count++;
+    power_stats.wake_last_us = latency_us;
+    power_stats.wake_total_us += latency_us;
+    if (latency_us < power_stats.wake_min_us)
+    {
+        power_stats.wake_min_us = latency_us;
+    }
+    if (latency_us > power_stats.wake_max_us)
+    {
+        power_stats.wake_max_us = latency_us;
+    }
+}
+
+/**
+* Function Name:
+* app_power_get_stats
+*
+* Function Description:
+* @brief   This function returns the power statistics.
+*
+* @param   None
+*
+* @return  const app_power_stats_t *: Statistics
+*/
+const app_power_stats_t *app_power_get_stats(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    power_count_awake();
+    cyhal_system_critical_section_exit(state);
+    return &power_stats;
+}
+
+/**
+* Function Name:
+* app_power_print_stats
+*
+* Function Description:
+* @brief   This function prints the time spent in each power state and the
+*          wake-up statistics.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_power_print_stats(void)
+{
+    const app_power_stats_t *p_stats = app_power_get_stats();
+    uint32_t awake_ms = (uint32_t)(p_stats->awake_us / 1000u);
+    uint32_t sleep_ms = (uint32_t)(p_stats->sleep_us / 1000u);
+    uint32_t deepsleep_ms = (uint32_t)(p_stats->deepsleep_us / 1000u);
+    uint32_t other_wakes = p_stats->deepsleep_entries;
+
+    printf("Power (ms): active %" PRIu32 ", sleep %" PRIu32 " (%" PRIu32 " entries), deep sleep %" PRIu32
+           " (%" PRIu32 " entries, %" PRIu32 " refused)%s\r\n",
+           awake_ms - sleep_ms, sleep_ms, p_stats->sleep_entries, deepsleep_ms,
+           p_stats->deepsleep_entries, p_stats->deepsleep_denied,
+#ifdef APP_POWER_NO_DEEPSLEEP
+           ", deep sleep disabled");
+#else
+           "");
+#endif
+
+    for (uint32_t i = 0; i < APP_POWER_WAKE_MAX; i++)
+    {
+        other_wakes -= p_stats->wakes[i];
+    }
+    printf("Wake sources: button %" PRIu32 ", UART %" PRIu32 ", other %" PRIu32
+           ", locks: flash %" PRIu32 ", UART %" PRIu32 "%s\r\n",
+           p_stats->wakes[APP_POWER_WAKE_BUTTON], p_stats->wakes[APP_POWER_WAKE_UART], other_wakes,
+           p_stats->locks, p_stats->uart_windows, power_uart_locked ? " (UART held)" : "");
+
+    if (0 == p_stats->wake_count)
+    {
+        return;
+    }
+    printf("Wake latency (us): last: %" PRIu32 ", min: %" PRIu32 ", max: %" PRIu32 ", mean: %" PRIu32 "\r\n",
+           p_stats->wake_last_us, p_stats->wake_min_us, p_stats->wake_max_us,
+           (uint32_t)(p_stats->wake_total_us / p_stats->wake_count));
+}
+
+/**
+* Function Name:
+* power_syspm_callback
+*
+* Function Description:
+* @brief   This is the system power callback for sleep and deep sleep. Deep
+*          sleep is refused while the UART still sends, as the characters in
+*          its FIFO would be lost, and the interrupt of the UART receive pin
+*          is enabled to wake the device. It is called with the interrupts
+*          disabled.
+*
+* @param   state: Power state being entered
+* @param   mode: Step of the transition
+* @param   callback_arg: Not used
+*
+* @return  bool: false to refuse the transition
+*/
+static bool power_syspm_callback(cyhal_syspm_callback_state_t state,
+                                 cyhal_syspm_callback_mode_t mode, void *callback_arg)
+{
+    (void) callback_arg;
+
+    switch (mode)
+    {
+        case CYHAL_SYSPM_CHECK_READY:
+            if ((CYHAL_SYSPM_CB_CPU_DEEPSLEEP == state) &&
+                cyhal_uart_is_tx_active(&cy_retarget_io_uart_obj))
+            {
+                power_stats.deepsleep_denied++;
+                return false;
+            }
+            break;
+
+        case CYHAL_SYSPM_BEFORE_TRANSITION:
+            /* A wake-up interrupt is taken before the CPU idles again */
+            power_woke = false;
+            power_count_awake();
+            power_sleep_start_us = power_last_us;
+            if (CYHAL_SYSPM_CB_CPU_DEEPSLEEP == state)
+            {
+                cyhal_gpio_enable_event(CYBSP_DEBUG_UART_RX, CYHAL_GPIO_IRQ_FALL,
+                                        APP_POWER_UART_WAKE_PRIORITY, true);
+            }
+            break;
+
+        case CYHAL_SYSPM_AFTER_TRANSITION:
+            if (CYHAL_SYSPM_CB_CPU_SLEEP == state)
+            {
+                power_stats.sleep_entries++;
+                power_stats.sleep_us += app_timestamp_us64() - power_sleep_start_us;
+                power_count_awake();
+            }
+            else
+            {
+                /* The timestamp kept counting in deep sleep */
+                power_last_us = app_timestamp_us64();
+                power_stats.deepsleep_entries++;
+                power_stats.deepsleep_us += power_last_us - power_sleep_start_us;
+                power_wake_us = (uint32_t)power_last_us;
+                power_woke = true;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/**
+* Function Name:
+* power_uart_timer_cb
+*
+* Function Description:
+* @brief   This timer callback releases the deep sleep lock of the terminal if
+*          no character was received for APP_POWER_UART_IDLE_MS, or waits for
+*          the rest of the idle time.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void power_uart_timer_cb(cy_timer_callback_arg_t arg)
+{
+    cy_time_t now;
+    cy_time_t idle_ms;
+    uint32_t state;
+
+    (void) arg;
+
+    state = cyhal_system_critical_section_enter();
+    cy_rtos_get_time(&now);
+    idle_ms = now - power_uart_last_ms;
+    if (idle_ms >= APP_POWER_UART_IDLE_MS)
+    {
+        power_uart_locked = false;
+        cyhal_syspm_unlock_deepsleep();
+    }
+    cyhal_system_critical_section_exit(state);
+
+    if (idle_ms < APP_POWER_UART_IDLE_MS)
+    {
+        cy_rtos_timer_start(&power_uart_timer, APP_POWER_UART_IDLE_MS - idle_ms);
+    }
+}
+
+/**
+* Function Name:
+* power_uart_wake_isr
+*
+* Function Description:
+* @brief   This interrupt of the debug UART receive pin is enabled before deep
+*          sleep and disables itself: the start bit of a character typed on
+*          the terminal wakes the device. That character is lost, the UART is
+*          not clocked yet, but deep sleep is then locked for the next ones as
+*          for any terminal input.
+*
+* @param   handler_arg: Not used
+* @param   event: Not used
+*
+* @return  None
+*/
+static void power_uart_wake_isr(void *handler_arg, cyhal_gpio_event_t event)
+{
+    (void) handler_arg;
+    (void) event;
+
+    cyhal_gpio_enable_event(CYBSP_DEBUG_UART_RX, CYHAL_GPIO_IRQ_FALL, APP_POWER_UART_WAKE_PRIORITY, false);
+    app_power_wake_source(APP_POWER_WAKE_UART);
+    app_power_uart_activity();
+}
+
+/**
+* Function Name:
+* power_count_awake
+*
+* Function Description:
+* @brief   This function adds the time elapsed since the last call to the
+*          awake time. It is called at every power transition but after deep
+*          sleep, whose time is counted apart. The caller must keep the
+*          interrupts disabled.
+*
+* @param   None
+*
+* @return  None
+*/
+static void power_count_awake(void)
+{
+    uint64_t now = app_timestamp_us64();
+
+    power_stats.awake_us += now - power_last_us;
+    power_last_us = now;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   app_power.h
+*
+* Description: This is the header file for the power manager of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_POWER_H_
+#define __APP_POWER_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Deep sleep stays locked this long after the last character received on the
+ * debug UART, so a command typed on the terminal is not cut by deep sleep */
+#define APP_POWER_UART_IDLE_MS              (10000u)
+
+/* Priority of the interrupt of the debug UART receive pin, enabled in deep
+ * sleep only to wake the device */
+#define APP_POWER_UART_WAKE_PRIORITY        (3u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Interrupts that can wake the device from deep sleep */
+typedef enum
+{
+    APP_POWER_WAKE_BUTTON,
+    APP_POWER_WAKE_UART,
+    APP_POWER_WAKE_MAX
+} app_power_wake_t;
+
+/* Power statistics. Wake latency is from the power callback after the deep
+ * sleep transition to the event loop handling the event of the interrupt
+ * that woke the device; the exit from deep sleep before the callback is not
+ * included. */
+typedef struct
+{
+    uint64_t    awake_us;           /* Time in active and sleep */
+    uint64_t    sleep_us;           /* Time in sleep */
+    uint64_t    deepsleep_us;       /* Time in deep sleep */
+    uint32_t    sleep_entries;
+    uint32_t    deepsleep_entries;
+    uint32_t    deepsleep_denied;   /* Deep sleep refused, UART still sending */
+    uint32_t    wakes[APP_POWER_WAKE_MAX];
+    uint32_t    locks;              /* Deep sleep locks taken for flash access */
+    uint32_t    uart_windows;       /* Deep sleep locks taken for UART input */
+    uint32_t    wake_count;
+    uint32_t    wake_last_us;
+    uint32_t    wake_min_us;
+    uint32_t    wake_max_us;
+    uint64_t    wake_total_us;
+} app_power_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void                        app_power_init          (void);
+void                        app_power_lock          (void);
+void                        app_power_unlock        (void);
+void                        app_power_uart_activity (void);
+void                        app_power_wake_source   (app_power_wake_t source);
+void                        app_power_wake_handled  (void);
+const app_power_stats_t    *app_power_get_stats     (void);
+void                        app_power_print_stats   (void);
+
+#endif // __APP_POWER_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,361 @@
+/******************************************************************************
+* File Name:   app_stack_mon.c
+*
+* Description: This file reports the stack high-water mark of every thread of the
+*              Peripheral_Privacy Example for ModusToolbox, Bluetooth stack threads
+*              included, and recommends stack sizes from a soak test.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "tx_api.h"
+#include "stdio.h"
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "app_event.h"
+#include "app_stack_mon.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Stack of one thread, collected from the ThreadX created list */
+typedef struct
+{
+    const char  *name;
+    uint8_t     *p_start;
+    uint32_t    size;
+    bool        filled;     /* Stack filled with the pattern before the thread started */
+} stack_mon_thread_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* List of all created threads, kept by ThreadX */
+extern TX_THREAD   *_tx_thread_created_ptr;
+extern ULONG        _tx_thread_created_count;
+
+/* Stacks filled by app_stack_mon_paint() */
+static const void   *stack_mon_painted[STACK_MON_MAX_PAINTED];
+static uint32_t     stack_mon_num_painted;
+
+#if (STACK_MON_REPORT_PERIOD_MS > 0)
+static cy_timer_t   stack_mon_timer;
+#endif
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint32_t     stack_mon_collect   (stack_mon_thread_t *p_threads, uint32_t max_threads);
+static uint32_t     stack_mon_used      (const stack_mon_thread_t *p_thread);
+static bool         stack_mon_is_filled (const void *p_stack);
+#ifdef APP_STACK_SIZING
+static uint32_t     stack_mon_recommend (uint32_t used);
+#endif
+#if (STACK_MON_REPORT_PERIOD_MS > 0)
+static void         stack_mon_timer_cb  (cy_timer_callback_arg_t arg);
+#endif
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_stack_mon_paint
+*
+* Function Description:
+* @brief   This function fills a stack with the fill pattern before its thread
+*          is created, so that the high-water mark can be measured even if the
+*          RTOS is built without stack filling.
+*
+* @param   p_stack: Stack memory of the thread
+* @param   size: Size of the stack in bytes
+*
+* @return  None
+*/
+void app_stack_mon_paint(void *p_stack, uint32_t size)
+{
+    memset(p_stack, STACK_MON_FILL_BYTE, size);
+    if (stack_mon_num_painted < STACK_MON_MAX_PAINTED)
+    {
+        stack_mon_painted[stack_mon_num_painted++] = p_stack;
+    }
+}
+
+/**
+* Function Name:
+* app_stack_mon_init
+*
+* Function Description:
+* @brief   This function starts the periodic stack report when the report
+*          period is not 0. The report itself runs in the event loop.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_stack_mon_init(void)
+{
+#if (STACK_MON_REPORT_PERIOD_MS > 0)
+    cy_rslt_t rslt;
+
+    rslt = cy_rtos_timer_init(&stack_mon_timer, CY_TIMER_TYPE_PERIODIC, stack_mon_timer_cb, NULL);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to create the stack report timer!\n");
+        return;
+    }
+    cy_rtos_timer_start(&stack_mon_timer, STACK_MON_REPORT_PERIOD_MS);
+#endif
+}
+
+/**
+* Function Name:
+* app_stack_mon_report
+*
+* Function Description:
+* @brief   This function prints the size, high-water mark and free space of
+*          the stack of every thread. With the STACK_SIZING build option it
+*          also prints the stack sizes recommended from the high-water marks.
+*          Stacks that were not filled with the pattern are reported as
+*          unknown: scanning them would give a meaningless high-water mark.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_stack_mon_report(void)
+{
+    stack_mon_thread_t threads[STACK_MON_MAX_THREADS];
+    uint32_t used[STACK_MON_MAX_THREADS];
+    uint32_t num_threads;
+
+    num_threads = stack_mon_collect(threads, STACK_MON_MAX_THREADS);
+
+    printf("Stacks (bytes)             size     used     free  used %%\r\n");
+    for (uint32_t i = 0; i < num_threads; i++)
+    {
+        if (!threads[i].filled)
+        {
+            printf("  %-22.22s %8" PRIu32 "        ?        ?       ?  not filled\r\n",
+                   threads[i].name, threads[i].size);
+            continue;
+        }
+        used[i] = stack_mon_used(&threads[i]);
+        printf("  %-22.22s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %7" PRIu32 "%s\r\n",
+               threads[i].name, threads[i].size, used[i], threads[i].size - used[i],
+               threads[i].size ? (used[i] * 100 / threads[i].size) : 0,
+               (used[i] >= threads[i].size) ? "  OVERFLOW" : "");
+    }
+
+#ifdef APP_STACK_SIZING
+    printf("Recommended stack sizes (high-water mark + %d%%):\r\n", STACK_MON_MARGIN_PERCENT);
+    for (uint32_t i = 0; i < num_threads; i++)
+    {
+        if (threads[i].filled)
+        {
+            printf("  %-22.22s (%" PRIu32 ")\r\n", threads[i].name, stack_mon_recommend(used[i]));
+        }
+        else
+        {
+            printf("  %-22.22s (unknown)\r\n", threads[i].name);
+        }
+    }
+#endif
+}
+
+/**
+* Function Name:
+* app_stack_mon_event_handler
+*
+* Function Description:
+* @brief   This function handles the periodic stack report event in the event
+*          loop.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_stack_mon_event_handler(uint32_t data)
+{
+    (void) data;
+
+    app_stack_mon_report();
+}
+
+/**
+* Function Name:
+* stack_mon_collect
+*
+* Function Description:
+* @brief   This function copies the name and stack of every created thread.
+*          The created list is only walked with interrupts disabled; the
+*          stacks are scanned afterwards.
+*
+* @param   p_threads: Array to fill
+* @param   max_threads: Size of the array
+*
+* @return  uint32_t: Number of threads copied
+*/
+static uint32_t stack_mon_collect(stack_mon_thread_t *p_threads, uint32_t max_threads)
+{
+    TX_THREAD *p_thread;
+    uint32_t count;
+    uint32_t state;
+
+    state = cyhal_system_critical_section_enter();
+
+    count = (_tx_thread_created_count < max_threads) ? _tx_thread_created_count : max_threads;
+    p_thread = _tx_thread_created_ptr;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p_threads[i].name = (NULL != p_thread->tx_thread_name) ? p_thread->tx_thread_name : "?";
+        p_threads[i].p_start = (uint8_t *)p_thread->tx_thread_stack_start;
+        p_threads[i].size = (uint32_t)p_thread->tx_thread_stack_size;
+        p_threads[i].filled = stack_mon_is_filled(p_thread->tx_thread_stack_start);
+        p_thread = p_thread->tx_thread_created_next;
+    }
+
+    cyhal_system_critical_section_exit(state);
+
+    return count;
+}
+
+/**
+* Function Name:
+* stack_mon_used
+*
+* Function Description:
+* @brief   This function measures the high-water mark of a stack. Stacks grow
+*          down, so the bytes still holding the fill pattern from the start of
+*          the stack have never been used.
+*
+* @param   p_thread: Thread to measure
+*
+* @return  uint32_t: Bytes of the stack used at least once
+*/
+static uint32_t stack_mon_used(const stack_mon_thread_t *p_thread)
+{
+    uint32_t unused = 0;
+
+    while ((unused < p_thread->size) && (STACK_MON_FILL_BYTE == p_thread->p_start[unused]))
+    {
+        unused++;
+    }
+
+    return p_thread->size - unused;
+}
+
+/**
+* Function Name:
+* stack_mon_is_filled
+*
+* Function Description:
+* @brief   This function tells if a stack was filled with the pattern before
+*          its thread started: painted by the application, or by ThreadX for
+*          every thread when it is built with TX_ENABLE_STACK_CHECKING.
+*
+* @param   p_stack: Start of the stack
+*
+* @return  bool: true if the high-water mark of the stack can be measured
+*/
+static bool stack_mon_is_filled(const void *p_stack)
+{
+#ifdef TX_ENABLE_STACK_CHECKING
+    (void) p_stack;
+
+    return true;
+#else
+    for (uint32_t i = 0; i < stack_mon_num_painted; i++)
+    {
+        if (stack_mon_painted[i] == p_stack)
+        {
+            return true;
+        }
+    }
+
+    return false;
+#endif
+}
+
+#ifdef APP_STACK_SIZING
+/**
+* Function Name:
+* stack_mon_recommend
+*
+* Function Description:
+* @brief   This function adds the safety margin to a high-water mark and
+*          rounds it up to the stack size granularity.
+*
+* @param   used: High-water mark in bytes
+*
+* @return  uint32_t: Recommended stack size in bytes
+*/
+static uint32_t stack_mon_recommend(uint32_t used)
+{
+    uint32_t size = used + (used * STACK_MON_MARGIN_PERCENT) / 100;
+
+    return ((size + STACK_MON_SIZE_ALIGN - 1) / STACK_MON_SIZE_ALIGN) * STACK_MON_SIZE_ALIGN;
+}
+#endif
+
+#if (STACK_MON_REPORT_PERIOD_MS > 0)
+/**
+* Function Name:
+* stack_mon_timer_cb
+*
+* Function Description:
+* @brief   This callback asks the event loop for a stack report; printing is
+*          left out of the timer context.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void stack_mon_timer_cb(cy_timer_callback_arg_t arg)
+{
+    (void) arg;
+
+    app_event_post(APP_EVT_STACK_REPORT, 0);
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   app_stack_mon.h
+*
+* Description: This is the header file for the thread stack usage monitor of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_STACK_MON_H_
+#define __APP_STACK_MON_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Value unused stack bytes are filled with, same as ThreadX */
+#define STACK_MON_FILL_BYTE                 (0xEF)
+
+/* Max number of threads in a report */
+#define STACK_MON_MAX_THREADS               (16)
+
+/* Max number of stacks painted by the application. Other stacks, those of
+ * the Bluetooth stack threads, are only filled by ThreadX when it is built
+ * with TX_ENABLE_STACK_CHECKING; the application must then be built with the
+ * same define, otherwise their high-water mark is reported as unknown. */
+#define STACK_MON_MAX_PAINTED               (4)
+
+/* Margin added to the high-water mark for the recommended size, in percent,
+ * and granularity of the recommended size in bytes */
+#define STACK_MON_MARGIN_PERCENT            (25)
+#define STACK_MON_SIZE_ALIGN                (256)
+
+/* Period of the automatic report in ms, 0 for on-demand reports only.
+ * Set by the STACK_SIZING build option for soak tests. */
+#ifndef STACK_MON_REPORT_PERIOD_MS
+#ifdef APP_STACK_SIZING
+#define STACK_MON_REPORT_PERIOD_MS          (60000)
+#else
+#define STACK_MON_REPORT_PERIOD_MS          (0)
+#endif
+#endif
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void    app_stack_mon_paint         (void *p_stack, uint32_t size);
+void    app_stack_mon_init          (void);
+void    app_stack_mon_report        (void);
+void    app_stack_mon_event_handler (uint32_t data);
+
+#endif // __APP_STACK_MON_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,933 @@
+/******************************************************************************
+* File Name:   app_state.c
+*
+* Description: This file implements the application state machine of the
+*              Peripheral_Privacy Example for ModusToolbox. The state, the bonding
+*              mode and the bond slot of the connected peer are only changed by
+*              the event loop, from the transition table below. The Bluetooth
+*              stack callbacks post their events to a queue drained by the event
+*              loop, so events are handled one at a time in the order they occur.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "stdio.h"
+#include <string.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_log.h"
+#include "app_bt_bonding.h"
+#include "app_bt_adv.h"
+#include "app_bt_link_loss.h"
+#include "app_bt_privacy.h"
+#include "peripheral_privacy.h"
+#include "app_state.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define STATE_QUEUE_MASK                    (APP_STATE_QUEUE_SIZE - 1)
+
+/* States a transition starts from */
+#define STATE_BIT(state)                    (1u << (state))
+#define STATE_IDLE_ANY                      (STATE_BIT(IDLE_NO_DATA) | STATE_BIT(IDLE_DATA) | \
+                                             STATE_BIT(IDLE_PRIVACY_CHANGE))
+#define STATE_LINK_ANY                      (STATE_BIT(CONNECTED) | STATE_BIT(BONDED))
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Row of the transition table. The first row matching the state, the event
+ * and the guard, if any, is taken. */
+typedef struct
+{
+    uint32_t            from;                       /* STATE_BIT of the states */
+    app_state_evt_t     evt;
+    bool                (*guard)(uint32_t arg);
+    app_state_t         to;
+    cy_rslt_t           (*action)(uint32_t arg);
+} state_transition_t;
+
+/* Event waiting in the queue */
+typedef struct
+{
+    app_state_evt_t     evt;
+    uint32_t            arg;
+    uint32_t            posted_us;
+} state_queued_evt_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static bool      state_has_bonds            (uint32_t arg);
+static bool      state_not_directed         (uint32_t arg);
+static cy_rslt_t state_started              (uint32_t arg);
+static cy_rslt_t state_started_no_bonds     (uint32_t arg);
+static cy_rslt_t state_bond_mode_off        (uint32_t arg);
+static cy_rslt_t state_set_bond_mode        (uint32_t arg);
+static cy_rslt_t state_connected            (uint32_t arg);
+static cy_rslt_t state_encrypted            (uint32_t arg);
+static cy_rslt_t state_save_cccd            (uint32_t arg);
+static cy_rslt_t state_disconnected_bonded  (uint32_t arg);
+static cy_rslt_t state_disconnected         (uint32_t arg);
+static cy_rslt_t state_disconnected_no_bonds(uint32_t arg);
+static cy_rslt_t state_offer_bonds          (void);
+static cy_rslt_t state_delete_bonds         (uint32_t arg);
+static cy_rslt_t state_kvstore_reset        (uint32_t arg);
+static cy_rslt_t state_directed_adv         (uint32_t arg);
+static cy_rslt_t state_privacy_select       (uint32_t arg);
+static cy_rslt_t state_privacy_toggle       (uint32_t arg);
+static cy_rslt_t state_run                  (app_state_evt_t evt, uint32_t arg, uint32_t posted_us);
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static const state_transition_t state_table[] =
+{
+    /* Startup, once the bond data is restored advertising starts */
+    { STATE_BIT(IDLE_NO_DATA),      APP_STATE_EVT_STARTED,          state_has_bonds,    IDLE_DATA,              state_started },
+    { STATE_BIT(IDLE_NO_DATA),      APP_STATE_EVT_STARTED,          NULL,               IDLE_NO_DATA,           state_started_no_bonds },
+
+    /* Connection */
+    { STATE_IDLE_ANY,               APP_STATE_EVT_CONNECTED,        NULL,               CONNECTED,              state_connected },
+    { STATE_LINK_ANY,               APP_STATE_EVT_ENCRYPTED,        NULL,               BONDED,                 state_encrypted },
+    { STATE_BIT(CONNECTED),         APP_STATE_EVT_PAIRED,           NULL,               CONNECTED,              state_bond_mode_off },
+    { STATE_BIT(BONDED),            APP_STATE_EVT_PAIRED,           NULL,               BONDED,                 state_bond_mode_off },
+    /* Only the CCCD of a bonded peer is saved, in its bond slot */
+    { STATE_BIT(CONNECTED),         APP_STATE_EVT_CCCD_WRITTEN,     NULL,               CONNECTED,              NULL },
+    { STATE_BIT(BONDED),            APP_STATE_EVT_CCCD_WRITTEN,     NULL,               BONDED,                 state_save_cccd },
+
+    /* Disconnection, advertising is restarted for the next connection */
+    { STATE_BIT(BONDED),            APP_STATE_EVT_DISCONNECTED,     NULL,               IDLE_DATA,              state_disconnected_bonded },
+    { STATE_BIT(CONNECTED),         APP_STATE_EVT_DISCONNECTED,     state_has_bonds,    IDLE_DATA,              state_disconnected },
+    { STATE_BIT(CONNECTED),         APP_STATE_EVT_DISCONNECTED,     NULL,               IDLE_NO_DATA,           state_disconnected_no_bonds },
+
+    /* User commands, not available while advertising to a bonded peer for the erasures */
+    { STATE_BIT(IDLE_DATA),         APP_STATE_EVT_DELETE_BONDS,     state_not_directed, IDLE_NO_DATA,           state_delete_bonds },
+    { STATE_IDLE_ANY,               APP_STATE_EVT_KVSTORE_RESET,    state_not_directed, IDLE_NO_DATA,           state_kvstore_reset },
+    { STATE_BIT(IDLE_NO_DATA),      APP_STATE_EVT_BOND_MODE,        NULL,               IDLE_NO_DATA,           state_set_bond_mode },
+    { STATE_BIT(IDLE_DATA),         APP_STATE_EVT_BOND_MODE,        NULL,               IDLE_DATA,              state_set_bond_mode },
+    { STATE_BIT(IDLE_PRIVACY_CHANGE), APP_STATE_EVT_BOND_MODE,      NULL,               IDLE_PRIVACY_CHANGE,    state_set_bond_mode },
+    { STATE_BIT(IDLE_DATA),         APP_STATE_EVT_DIRECTED_ADV,     NULL,               IDLE_DATA,              state_directed_adv },
+    { STATE_BIT(IDLE_DATA) | STATE_BIT(IDLE_PRIVACY_CHANGE),
+                                    APP_STATE_EVT_PRIVACY_SELECT,   NULL,               IDLE_PRIVACY_CHANGE,    state_privacy_select },
+    { STATE_BIT(IDLE_PRIVACY_CHANGE), APP_STATE_EVT_PRIVACY_TOGGLE, NULL,               IDLE_DATA,              state_privacy_toggle },
+    { STATE_BIT(IDLE_NO_DATA),      APP_STATE_EVT_PRIVACY_TOGGLE,   NULL,               IDLE_NO_DATA,           state_privacy_toggle },
+    { STATE_BIT(IDLE_DATA),         APP_STATE_EVT_PRIVACY_TOGGLE,   NULL,               IDLE_DATA,              state_privacy_toggle },
+    { STATE_BIT(CONNECTED),         APP_STATE_EVT_PRIVACY_TOGGLE,   NULL,               CONNECTED,              state_privacy_toggle },
+    { STATE_BIT(BONDED),            APP_STATE_EVT_PRIVACY_TOGGLE,   NULL,               BONDED,                 state_privacy_toggle },
+};
+
+static const char *const state_names[APP_STATE_MAX] =
+{
+    [IDLE_NO_DATA]          = "IDLE_NO_DATA",
+    [IDLE_DATA]             = "IDLE_DATA",
+    [IDLE_PRIVACY_CHANGE]   = "IDLE_PRIVACY_CHANGE",
+    [CONNECTED]             = "CONNECTED",
+    [BONDED]                = "BONDED",
+};
+
+static const char *const state_evt_names[APP_STATE_EVT_MAX] =
+{
+    [APP_STATE_EVT_STARTED]         = "STARTED",
+    [APP_STATE_EVT_CONNECTED]       = "CONNECTED",
+    [APP_STATE_EVT_ENCRYPTED]       = "ENCRYPTED",
+    [APP_STATE_EVT_PAIRED]          = "PAIRED",
+    [APP_STATE_EVT_CCCD_WRITTEN]    = "CCCD_WRITTEN",
+    [APP_STATE_EVT_DISCONNECTED]    = "DISCONNECTED",
+    [APP_STATE_EVT_DELETE_BONDS]    = "DELETE_BONDS",
+    [APP_STATE_EVT_KVSTORE_RESET]   = "KVSTORE_RESET",
+    [APP_STATE_EVT_BOND_MODE]       = "BOND_MODE",
+    [APP_STATE_EVT_DIRECTED_ADV]    = "DIRECTED_ADV",
+    [APP_STATE_EVT_PRIVACY_SELECT]  = "PRIVACY_SELECT",
+    [APP_STATE_EVT_PRIVACY_TOGGLE]  = "PRIVACY_TOGGLE",
+};
+
+/* Owned by the event loop, read anywhere */
+static volatile app_state_t     state = IDLE_NO_DATA;
+
+/* If true we will go into bonding mode. This will be set false if pre-existing bonding info is available */
+static volatile wiced_bool_t    bond_mode = WICED_TRUE;
+
+/* Bond slot of the peer we are currently bonded to */
+static volatile uint8_t         bondindex = 0;
+
+/* Events posted by the Bluetooth stack. Posted under a critical section,
+ * drained by the event loop. */
+static state_queued_evt_t       state_queue[APP_STATE_QUEUE_SIZE];
+static volatile uint32_t        state_head;
+static volatile uint32_t        state_tail;
+
+static app_state_stats_t        state_stats;
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_state_post
+*
+* Function Description:
+* @brief   This function queues an event for the event loop. It never blocks
+*          and can be called from any thread; the event is lost and counted if
+*          the queue is full.
+*
+* @param   evt: Event
+* @param   arg: Argument of the event
+*
+* @return  None
+*/
+void app_state_post(app_state_evt_t evt, uint32_t arg)
+{
+    uint32_t state_irq;
+    uint32_t head;
+    bool lost = false;
+
+    state_irq = cyhal_system_critical_section_enter();
+    head = state_head;
+    if ((head - state_tail) >= APP_STATE_QUEUE_SIZE)
+    {
+        state_stats.lost++;
+        lost = true;
+    }
+    else
+    {
+        state_queue[head & STATE_QUEUE_MASK].evt = evt;
+        state_queue[head & STATE_QUEUE_MASK].arg = arg;
+        state_queue[head & STATE_QUEUE_MASK].posted_us = app_timestamp_us();
+        state_head = head + 1;
+    }
+    cyhal_system_critical_section_exit(state_irq);
+
+    if (lost)
+    {
+        APP_LOG(LOG_STATE_LOST, APP_LOG_STR(state_evt_names[evt]));
+        return;
+    }
+    app_event_post_urgent(APP_EVT_STATE);
+}
+
+/**
+* Function Name:
+* app_state_handle
+*
+* Function Description:
+* @brief   This function runs the transition of an event at once. It must
+*          only be called from the event loop, e.g. by the command handlers.
+*
+* @param   evt: Event
+* @param   arg: Argument of the event
+*
+* @return  cy_rslt_t: Result of the action of the transition, or
+*          APP_STATE_RSLT_REJECTED if the event is not allowed in the current
+*          state
+*/
+cy_rslt_t app_state_handle(app_state_evt_t evt, uint32_t arg)
+{
+    return state_run(evt, arg, app_timestamp_us());
+}
+
+/**
+* Function Name:
+* app_state_event_handler
+*
+* Function Description:
+* @brief   This function handles the events posted by the Bluetooth stack,
+*          oldest first. It runs on the urgent path of the event loop.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_state_event_handler(uint32_t data)
+{
+    state_queued_evt_t queued;
+    uint32_t tail;
+
+    (void) data;
+
+    while ((tail = state_tail) != state_head)
+    {
+        queued = state_queue[tail & STATE_QUEUE_MASK];
+        state_tail = tail + 1;
+        (void) state_run(queued.evt, queued.arg, queued.posted_us);
+    }
+}
+
+/**
+* Function Name:
+* app_state_get
+*
+* Function Description:
+* @brief   This function returns the state of the application.
+*
+* @param   None
+*
+* @return  app_state_t: State
+*/
+app_state_t app_state_get(void)
+{
+    return state;
+}
+
+/**
+* Function Name:
+* app_state_bond_mode
+*
+* Function Description:
+* @brief   This function tells if new devices are allowed to bond.
+*
+* @param   None
+*
+* @return  wiced_bool_t: WICED_TRUE in bonding mode
+*/
+wiced_bool_t app_state_bond_mode(void)
+{
+    return bond_mode;
+}
+
+/**
+* Function Name:
+* app_state_bond_index
+*
+* Function Description:
+* @brief   This function returns the bond slot of the connected peer, valid in
+*          the BONDED state.
+*
+* @param   None
+*
+* @return  uint8_t: Bond slot, starting at 0
+*/
+uint8_t app_state_bond_index(void)
+{
+    return bondindex;
+}
+
+/**
+* Function Name:
+* app_state_get_stats
+*
+* Function Description:
+* @brief   This function returns the state machine statistics.
+*
+* @param   None
+*
+* @return  const app_state_stats_t *: Statistics
+*/
+const app_state_stats_t *app_state_get_stats(void)
+{
+    return &state_stats;
+}
+
+/**
+* Function Name:
+* app_state_print_stats
+*
+* Function Description:
+* @brief   This function prints the state and the state machine statistics.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_state_print_stats(void)
+{
+    printf("State: %s, bonding mode %s, %" PRIu32 " transitions, %" PRIu32 " rejected, %" PRIu32
+           " lost, max wait %" PRIu32 " us, max action %" PRIu32 " us\r\n",
+           state_names[state], (WICED_TRUE == bond_mode) ? "on" : "off", state_stats.transitions,
+           state_stats.rejected, state_stats.lost, state_stats.max_wait_us, state_stats.max_run_us);
+}
+
+/**
+* Function Name:
+* state_run
+*
+* Function Description:
+* @brief   This function looks the event up in the transition table, runs the
+*          action of the first matching row and enters its state. Every
+*          transition is logged with the time the event waited and the time
+*          spent in the action.
+*
+* @param   evt: Event
+* @param   arg: Argument of the event
+* @param   posted_us: Time the event was posted
+*
+* @return  cy_rslt_t: Result of the action, APP_STATE_RSLT_REJECTED if no row
+*          matches
+*/
+static cy_rslt_t state_run(app_state_evt_t evt, uint32_t arg, uint32_t posted_us)
+{
+    const state_transition_t *p_row = NULL;
+    cy_rslt_t rslt = CY_RSLT_SUCCESS;
+    app_state_t from = state;
+    uint32_t start_us;
+    uint32_t wait_us;
+    uint32_t run_us;
+
+    for (uint32_t i = 0; i < (sizeof(state_table) / sizeof(state_table[0])); i++)
+    {
+        if ((state_table[i].evt == evt) && (0 != (state_table[i].from & STATE_BIT(from))) &&
+            ((NULL == state_table[i].guard) || state_table[i].guard(arg)))
+        {
+            p_row = &state_table[i];
+            break;
+        }
+    }
+
+    if (NULL == p_row)
+    {
+        state_stats.rejected++;
+        APP_LOG(LOG_STATE_REJECTED, APP_LOG_STR(state_names[from]), APP_LOG_STR(state_evt_names[evt]));
+        return APP_STATE_RSLT_REJECTED;
+    }
+
+    start_us = app_timestamp_us();
+    wait_us = start_us - posted_us;
+    state = p_row->to;
+    if (NULL != p_row->action)
+    {
+        rslt = p_row->action(arg);
+    }
+    run_us = app_timestamp_us() - start_us;
+
+    state_stats.transitions++;
+    if (wait_us > state_stats.max_wait_us)
+    {
+        state_stats.max_wait_us = wait_us;
+    }
+    if (run_us > state_stats.max_run_us)
+    {
+        state_stats.max_run_us = run_us;
+    }
+    APP_LOG(LOG_STATE_TRANSITION, APP_LOG_STR(state_names[from]), APP_LOG_STR(state_names[p_row->to]),
+            APP_LOG_STR(state_evt_names[evt]), wait_us, run_us);
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* state_has_bonds
+*
+* Function Description:
+* @brief   Guard true if bond data is present.
+*
+* @param   arg: Not used
+*
+* @return  bool
+*/
+static bool state_has_bonds(uint32_t arg)
+{
+    (void) arg;
+
+    return (0 < bondinfo.slot_data[NUM_BONDED]) && (BOND_INDEX_MAX >= bondinfo.slot_data[NUM_BONDED]);
+}
+
+
+/**
+* Function Name:
+* state_not_directed
+*
+* Function Description:
+* @brief   Guard true unless advertising to a bonded peer, whose bond data
+*          must not be erased meanwhile.
+*
+* @param   arg: Not used
+*
+* @return  bool
+*/
+static bool state_not_directed(uint32_t arg)
+{
+    (void) arg;
+
+    return (BTM_BLE_ADVERT_DIRECTED_LOW != app_bt_adv_get_mode()) &&
+           (BTM_BLE_ADVERT_DIRECTED_HIGH != app_bt_adv_get_mode());
+}
+
+/**
+* Function Name:
+* state_started
+*
+* Function Description:
+* @brief   Action at startup with bond data present. A single bonded device is
+*          called back with directed advertising, otherwise the bonded devices
+*          are offered for selection.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_started(uint32_t arg)
+{
+    (void) arg;
+
+    /* New devices not allowed to bond in the IDLE_DATA state, can be enabled by entering e on Terminal */
+    bond_mode = WICED_FALSE;
+    if (1 == bondinfo.slot_data[NUM_BONDED])
+    {
+        APP_LOG(LOG_ONE_DEVICE, APP_LOG_BDA(bondinfo.link_keys[0].bd_addr), APP_LOG_BDA(bondinfo.link_keys[0].conn_addr));
+        APP_LOG0(LOG_PROMPT_BOND_MODE);
+        app_bt_adv_start(BTM_BLE_ADVERT_DIRECTED_HIGH, bondinfo.link_keys[0].key_data.ble_addr_type,
+                         bondinfo.link_keys[0].bd_addr);
+    }
+    else
+    {
+        APP_LOG0(LOG_PROMPT_SELECT_DIRECTED);
+        print_device_selection_menu();
+        APP_LOG0(LOG_PROMPT_SLOT);
+        APP_LOG0(LOG_PROMPT_BOND_MODE);
+        APP_LOG0(LOG_NOTE_SLOTS_FULL);
+        /* With extended advertising any bonded device can reconnect meanwhile */
+        if (WICED_BT_SUCCESS == app_bt_adv_start_accept_list())
+        {
+            APP_LOG0(LOG_ACCEPT_LIST);
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_started_no_bonds
+*
+* Function Description:
+* @brief   Action at startup with no bond data, advertising starts in bonding
+*          mode.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_started_no_bonds(uint32_t arg)
+{
+    (void) arg;
+
+    bond_mode = WICED_TRUE;
+    app_bt_adv_start(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_bond_mode_off
+*
+* Function Description:
+* @brief   Action leaving bonding mode, once the device is bonded.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_bond_mode_off(uint32_t arg)
+{
+    (void) arg;
+
+    bond_mode = WICED_FALSE;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_set_bond_mode
+*
+* Function Description:
+* @brief   Action entering or exiting bonding mode on request. Entering it with
+*          all the slots in use removes the oldest peer, then advertising
+*          restarts for new peers.
+*
+* @param   arg: WICED_TRUE to enter bonding mode
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_set_bond_mode(uint32_t arg)
+{
+    wiced_bool_t enter = (0 != arg) ? WICED_TRUE : WICED_FALSE;
+
+    if (enter == bond_mode)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    bond_mode = enter;
+    if (WICED_TRUE == enter)
+    {
+        /* Check to see if we need to erase one of the existing devices */
+        if (BOND_INDEX_MAX == bondinfo.slot_data[NUM_BONDED])
+        {
+            (void) app_bt_delete_oldest_device();
+        }
+        APP_LOG0(LOG_BOND_MODE_ENTERED);
+#ifdef PSOC6_BLE
+/* This is a workaround for the issue mentioned in the Notes section under Document History in Readme.md
+ * It allows the PSoC 6 Bluetooth LE device to connect to a new peer device even if PSoC 6 Bluetooth LE
+ * has bonded with other devices previously. If there is a need to connect to a new device, clear the
+ * controller address resolution list, start advertisement to connect with any new device, add the
+ * old devices back to controller address resolution list immediately after connection. */
+        pairing_mode = TRUE;
+        if (WICED_BT_SUCCESS == wiced_bt_ble_address_resolution_list_clear_and_disable())
+        {
+            APP_LOG0(LOG_RESOLVING_LIST_CLEARED);
+        }
+        else
+        {
+            APP_LOG0(LOG_RESOLVING_CLEAR_FAILED);
+        }
+#endif
+
+        /* restart the advertisements in Bonding Mode */
+        app_bt_link_loss_cancel();
+        app_bt_adv_start(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+    }
+    else
+    {
+        app_bt_adv_exit_bond_mode();
+        APP_LOG0(LOG_BOND_MODE_EXITED);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_connected
+*
+* Function Description:
+* @brief   Action on a connection, the advertising scheduler stops. A peer back
+*          from a link loss keeps its bond slot.
+*
+* @param   arg: Bond slot + 1 of a peer back from a link loss, or 0
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_connected(uint32_t arg)
+{
+    app_bt_adv_on_connect();
+    if (0 != arg)
+    {
+        bondindex = (uint8_t)(arg - 1);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_encrypted
+*
+* Function Description:
+* @brief   Action on encryption with a bonded peer.
+*
+* @param   arg: Bond slot of the peer
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_encrypted(uint32_t arg)
+{
+    bondindex = (uint8_t)arg;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_save_cccd
+*
+* Function Description:
+* @brief   Action saving the CCCD written by the bonded peer in its bond slot,
+*          so that it is restored on the next connection.
+*
+* @param   arg: CCCD value
+*
+* @return  cy_rslt_t: Result of the flash update
+*/
+static cy_rslt_t state_save_cccd(uint32_t arg)
+{
+    cy_rslt_t rslt;
+
+    rslt = app_bt_update_cccd((uint16_t)arg, bondindex);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        APP_LOG0(LOG_CCCD_SAVE_FAILED);
+    }
+    else
+    {
+        APP_LOG0(LOG_CCCD_SAVED);
+    }
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* state_disconnected_bonded
+*
+* Function Description:
+* @brief   Action on the disconnection of a bonded peer. If the link was lost
+*          the peer is called back with directed advertising, otherwise the
+*          bonded devices are offered for reconnection.
+*
+* @param   arg: Disconnection reason and CCCD, see APP_STATE_DISCONNECT_ARG
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_disconnected_bonded(uint32_t arg)
+{
+    wiced_bt_gatt_disconn_reason_t reason = (wiced_bt_gatt_disconn_reason_t)(arg & 0xFFFFu);
+    uint16_t cccd = (uint16_t)(arg >> 16);
+
+    app_bt_privacy_on_disconnect(bondindex);
+
+    /* Restart the advertising interval curve from its first step */
+    app_bt_adv_on_disconnect();
+    if ((WICED_TRUE == app_bt_link_loss_is_link_loss(reason)) &&
+        (WICED_TRUE == app_bt_link_loss_start(bondindex, cccd)))
+    {
+        /* Directed advertising to the dropped peer is already running */
+        bond_mode = WICED_FALSE;
+        return CY_RSLT_SUCCESS;
+    }
+    return state_offer_bonds();
+}
+
+/**
+* Function Name:
+* state_disconnected
+*
+* Function Description:
+* @brief   Action on a disconnection with bond data present, the bonded
+*          devices can reconnect or be selected for directed advertising.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_disconnected(uint32_t arg)
+{
+    (void) arg;
+
+    app_bt_adv_on_disconnect();
+    return state_offer_bonds();
+}
+
+/**
+* Function Name:
+* state_offer_bonds
+*
+* Function Description:
+* @brief   This function offers the bonded devices for reconnection after a
+*          disconnection, once the interval curve was restarted: the devices
+*          can be selected for directed advertising and advertising starts
+*          with the accept list.
+*
+* @param   None
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_offer_bonds(void)
+{
+    print_device_selection_menu();
+    APP_LOG0(LOG_PROMPT_SLOT);
+    APP_LOG0(LOG_PROMPT_BOND_MODE);
+    bond_mode = WICED_FALSE;
+    if (WICED_BT_SUCCESS == app_bt_adv_start_accept_list())
+    {
+        APP_LOG0(LOG_ACCEPT_LIST);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_disconnected_no_bonds
+*
+* Function Description:
+* @brief   Action on a disconnection with no bond data, advertising restarts
+*          in bonding mode.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_disconnected_no_bonds(uint32_t arg)
+{
+    (void) arg;
+
+    app_bt_adv_on_disconnect();
+    bond_mode = WICED_TRUE;
+    app_bt_adv_start(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_delete_bonds
+*
+* Function Description:
+* @brief   Action erasing the bond data of all the peers, advertising restarts
+*          in bonding mode.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: Result of the flash update
+*/
+static cy_rslt_t state_delete_bonds(uint32_t arg)
+{
+    cy_rslt_t rslt;
+
+    (void) arg;
+
+    app_bt_link_loss_cancel();
+    rslt = app_bt_delete_bond_info();
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        APP_LOG0(LOG_BONDS_ERASED);
+    }
+    else
+    {
+        APP_LOG0(LOG_FLASH_WRITE_ERROR);
+    }
+    bond_mode = WICED_TRUE;
+    app_bt_adv_start(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* state_kvstore_reset
+*
+* Function Description:
+* @brief   Action erasing the kv-store, bond data and local keys, advertising
+*          restarts in bonding mode.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: Result of the kv-store reset
+*/
+static cy_rslt_t state_kvstore_reset(uint32_t arg)
+{
+    cy_rslt_t rslt;
+
+    (void) arg;
+
+    rslt = app_bt_reset_kvstore();
+    app_bt_link_loss_cancel();
+    bond_mode = WICED_TRUE;
+    app_bt_adv_start(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+
+    return rslt;
+}
+
+/**
+* Function Name:
+* state_directed_adv
+*
+* Function Description:
+* @brief   Action starting high duty directed advertising to a bonded peer,
+*          chosen on the terminal or by the control protocol.
+*
+* @param   arg: Bond slot of the peer + 1
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_directed_adv(uint32_t arg)
+{
+    wiced_bt_device_link_keys_t *p_keys = &bondinfo.link_keys[arg - 1];
+
+    /* No need to stop advertising first, switching modes is done by app_bt_adv_start */
+    app_bt_link_loss_cancel();
+    APP_LOG(LOG_DIRECTED_ADV, APP_LOG_BDA(p_keys->bd_addr));
+    APP_LOG0(LOG_PROMPT_BOND_MODE);
+    if (WICED_BT_SUCCESS != app_bt_adv_start(BTM_BLE_ADVERT_DIRECTED_HIGH, p_keys->key_data.ble_addr_type,
+                                             p_keys->bd_addr))
+    {
+        APP_LOG0(LOG_DIRECTED_ADV_FAILED);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_privacy_select
+*
+* Function Description:
+* @brief   Action asking for the bond slot whose privacy mode is toggled.
+*
+* @param   arg: Not used
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_privacy_select(uint32_t arg)
+{
+    (void) arg;
+
+    APP_LOG0(LOG_PROMPT_SELECT_PRIVACY);
+    print_device_selection_menu();
+    APP_LOG0(LOG_PROMPT_PRIVACY_SLOT);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* state_privacy_toggle
+*
+* Function Description:
+* @brief   Action toggling the privacy mode of a bonded peer.
+*
+* @param   arg: Bond slot of the peer + 1
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+static cy_rslt_t state_privacy_toggle(uint32_t arg)
+{
+    app_bt_privacy_toggle_mode((uint8_t)(arg - 1));
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/******************************************************************************
+* File Name:   app_state.h
+*
+* Description: This is the header file for the application state machine of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_STATE_H_
+#define __APP_STATE_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_result.h"
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Events posted from the Bluetooth stack and waiting for the event loop, must
+ * be a power of 2 */
+#define APP_STATE_QUEUE_SIZE                (16)
+
+/* Result of app_state_handle() for an event not allowed in the current state */
+#define APP_STATE_RSLT_REJECTED             ((cy_rslt_t)0x0002FFFFU)
+
+/* Argument of APP_STATE_EVT_DISCONNECTED */
+#define APP_STATE_DISCONNECT_ARG(reason, cccd)  (((uint32_t)(cccd) << 16) | (uint16_t)(reason))
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* States of the application. The values are reported by the control
+ * protocol and must not change. */
+typedef enum StateMachine
+{
+    IDLE_NO_DATA,
+    IDLE_DATA,
+    IDLE_PRIVACY_CHANGE,
+    CONNECTED,
+    BONDED,
+    APP_STATE_MAX
+} app_state_t;
+
+/* Events of the state machine, with their argument */
+typedef enum
+{
+    APP_STATE_EVT_STARTED,          /* Stack ready and bond data restored, no argument */
+    APP_STATE_EVT_CONNECTED,        /* Bond slot + 1 of a peer back from a link loss, or 0 */
+    APP_STATE_EVT_ENCRYPTED,        /* Link encrypted with a bonded peer, its bond slot */
+    APP_STATE_EVT_PAIRED,           /* Bonding complete, no argument */
+    APP_STATE_EVT_CCCD_WRITTEN,     /* CCCD written by the peer, its value */
+    APP_STATE_EVT_DISCONNECTED,     /* See APP_STATE_DISCONNECT_ARG */
+    APP_STATE_EVT_DELETE_BONDS,     /* Erase the bond data, no argument */
+    APP_STATE_EVT_KVSTORE_RESET,    /* Erase the kv-store, local keys included, no argument */
+    APP_STATE_EVT_BOND_MODE,        /* WICED_TRUE to enter bonding mode, WICED_FALSE to exit */
+    APP_STATE_EVT_DIRECTED_ADV,     /* Advertise to a bonded peer, its bond slot + 1 */
+    APP_STATE_EVT_PRIVACY_SELECT,   /* Wait for the slot to toggle privacy, no argument */
+    APP_STATE_EVT_PRIVACY_TOGGLE,   /* Toggle the privacy mode of a peer, its bond slot + 1 */
+    APP_STATE_EVT_MAX
+} app_state_evt_t;
+
+/* State machine statistics */
+typedef struct
+{
+    uint32_t    transitions;
+    uint32_t    rejected;       /* Events not allowed in the state they found */
+    uint32_t    lost;           /* Events lost because the queue was full */
+    uint32_t    max_wait_us;    /* Time from posting to handling */
+    uint32_t    max_run_us;     /* Time spent in the action of a transition */
+} app_state_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void                        app_state_post          (app_state_evt_t evt, uint32_t arg);
+cy_rslt_t                   app_state_handle        (app_state_evt_t evt, uint32_t arg);
+void                        app_state_event_handler (uint32_t data);
+app_state_t                 app_state_get           (void);
+wiced_bool_t                app_state_bond_mode     (void);
+uint8_t                     app_state_bond_index    (void);
+const app_state_stats_t    *app_state_get_stats     (void);
+void                        app_state_print_stats   (void);
+
+#endif // __APP_STATE_H_
+
+/* [] END OF FILE */
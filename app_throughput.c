@@ -0,0 +1,512 @@
+/******************************************************************************
+* File Name:   app_throughput.c
+*
+* Description: This file implements the Throughput GATT service, a benchmark of the ATT
+*              paths of the application. The client writes commands without response to
+*              the Sink, which counts the bytes received, and the Source streams
+*              notifications with a sequence number, a few in flight at a time. Runs are
+*              started and stopped on the Control point, which reads back the results.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include "stdio.h"
+#include <string.h>
+#include "cycfg_gatt_db.h"
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_metrics.h"
+#include "app_throughput.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static app_throughput_t         throughput;
+
+static volatile app_throughput_state_t throughput_state;
+
+/* Connection of the run, 0 when disconnected, and its ATT MTU */
+static uint16_t                 throughput_conn_id;
+static uint16_t                 throughput_mtu = GATT_DEF_BLE_MTU_SIZE;
+
+/* Source run: payload length, notifications to send (0 until stopped), sent */
+static uint16_t                 throughput_payload_len;
+static uint32_t                 throughput_count;
+static uint32_t                 throughput_sent;
+
+/* Notifications handed to the stack, each one holds its buffer until it is
+ * transmitted. They are transmitted in order, so the buffers are used in turn. */
+static volatile uint8_t         throughput_in_flight;
+static uint8_t                  throughput_tx_buf[APP_THROUGHPUT_IN_FLIGHT][APP_THROUGHPUT_PAYLOAD_MAX];
+
+static cy_timer_t               throughput_retry_timer;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint8_t  *throughput_put         (uint8_t *p_data, uint32_t value, uint8_t size);
+static void     throughput_stop         (void);
+static void     throughput_tx_done      (uint8_t *p_buf);
+static void     throughput_retry_cb     (cy_timer_callback_arg_t arg);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_throughput_init
+*
+* Function Description:
+* @brief   This function creates the timer sending again once the stack
+*          refused a notification of the source.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_throughput_init(void)
+{
+    if (CY_RSLT_SUCCESS != cy_rtos_timer_init(&throughput_retry_timer, CY_TIMER_TYPE_ONCE,
+                                              throughput_retry_cb, NULL))
+    {
+        printf("Failed to create the throughput timer!\n");
+    }
+}
+
+/**
+* Function Name:
+* app_throughput_on_connect
+*
+* Function Description:
+* @brief   This function keeps the connection of the runs, with the default
+*          ATT MTU until it is exchanged. Called by the Bluetooth stack thread.
+*
+* @param   conn_id: Connection ID
+*
+* @return  None
+*/
+void app_throughput_on_connect(uint16_t conn_id)
+{
+    throughput_conn_id = conn_id;
+    throughput_mtu = GATT_DEF_BLE_MTU_SIZE;
+}
+
+/**
+* Function Name:
+* app_throughput_on_disconnect
+*
+* Function Description:
+* @brief   This function ends the run in progress, its results are kept, and
+*          clears the Source CCCD. Called by the Bluetooth stack thread.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_throughput_on_disconnect(void)
+{
+    throughput_stop();
+    throughput_conn_id = 0;
+    throughput_in_flight = 0;
+    app_throughput_source_client_char_config[0] = 0;
+    app_throughput_source_client_char_config[1] = 0;
+}
+
+/**
+* Function Name:
+* app_throughput_set_mtu
+*
+* Function Description:
+* @brief   This function keeps the ATT MTU of the connection, the default
+*          source payload fills it.
+*
+* @param   mtu: ATT MTU agreed with the client
+*
+* @return  None
+*/
+void app_throughput_set_mtu(uint16_t mtu)
+{
+    throughput_mtu = mtu;
+}
+
+/**
+* Function Name:
+* app_throughput_on_sink
+*
+* Function Description:
+* @brief   This function counts a write to the Sink during a sink run, and
+*          times the first and the last. Called by the Bluetooth stack thread.
+*
+* @param   len: Length of the value written
+*
+* @return  None
+*/
+void app_throughput_on_sink(uint16_t len)
+{
+    uint32_t now = app_timestamp_us();
+
+    if (APP_THROUGHPUT_SINK != throughput_state)
+    {
+        return;
+    }
+    if (0 == throughput.sink_writes)
+    {
+        throughput.sink_first_us = now;
+    }
+    throughput.sink_last_us = now;
+    throughput.sink_writes++;
+    throughput.sink_bytes += len;
+}
+
+/**
+* Function Name:
+* app_throughput_on_control
+*
+* Function Description:
+* @brief   This function runs a command written to the Control point:
+*          0x00         stop the run in progress
+*          0x01         start a sink run, the Sink counts the writes
+*          0x02 [L][N]  start a source run of N notifications (4 bytes, 0
+*                       until stopped) of L bytes (2 bytes, 0 to fill the
+*                       ATT MTU), little endian, both optional.
+*          A run starts again from zero, the results of the other direction
+*          are kept. Called by the Bluetooth stack thread.
+*
+* @param   p_val: Command
+* @param   len: Length of the command
+*
+* @return  wiced_bt_gatt_status_t: WICED_BT_GATT_SUCCESS, or the error returned
+*          to the client
+*/
+wiced_bt_gatt_status_t app_throughput_on_control(const uint8_t *p_val, uint16_t len)
+{
+    uint16_t payload_len = 0;
+    uint32_t count = 0;
+
+    if (0 == len)
+    {
+        return WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+    if (APP_THROUGHPUT_CMD_STOP == p_val[0])
+    {
+        throughput_stop();
+        return WICED_BT_GATT_SUCCESS;
+    }
+    if (APP_THROUGHPUT_IDLE != throughput_state)
+    {
+        return WICED_BT_GATT_PRC_IN_PROGRESS;
+    }
+
+    switch (p_val[0])
+    {
+        case APP_THROUGHPUT_CMD_SINK:
+            if (1 != len)
+            {
+                return WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
+            throughput.sink_bytes = 0;
+            throughput.sink_writes = 0;
+            throughput.sink_first_us = 0;
+            throughput.sink_last_us = 0;
+            throughput_state = APP_THROUGHPUT_SINK;
+            return WICED_BT_GATT_SUCCESS;
+
+        case APP_THROUGHPUT_CMD_SOURCE:
+            if ((1 != len) && (3 != len) && (7 != len))
+            {
+                return WICED_BT_GATT_INVALID_ATTR_LEN;
+            }
+            if (len >= 3)
+            {
+                payload_len = p_val[1] | (p_val[2] << 8);
+            }
+            if (len == 7)
+            {
+                count = p_val[3] | (p_val[4] << 8) | (p_val[5] << 16) | ((uint32_t)p_val[6] << 24);
+            }
+            if (0 == payload_len)
+            {
+                payload_len = MIN(throughput_mtu - 3u, APP_THROUGHPUT_PAYLOAD_MAX);
+            }
+            /* The payload starts with the sequence number */
+            if ((payload_len < 4) || (payload_len > APP_THROUGHPUT_PAYLOAD_MAX) ||
+                (payload_len > throughput_mtu - 3))
+            {
+                return WICED_BT_GATT_OUT_OF_RANGE;
+            }
+            if (!(app_throughput_source_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION))
+            {
+                return WICED_BT_GATT_CCC_CFG_ERR;
+            }
+
+            for (uint32_t i = 0; i < APP_THROUGHPUT_IN_FLIGHT; i++)
+            {
+                for (uint32_t j = 4; j < payload_len; j++)
+                {
+                    throughput_tx_buf[i][j] = (uint8_t)j;
+                }
+            }
+            throughput_payload_len = payload_len;
+            throughput_count = count;
+            throughput_sent = 0;
+            throughput.source_bytes = 0;
+            throughput.source_notifications = 0;
+            throughput.source_stalls = 0;
+            throughput.source_start_us = app_timestamp_us();
+            throughput.source_last_us = throughput.source_start_us;
+            throughput_state = APP_THROUGHPUT_SOURCE;
+            app_event_post(APP_EVT_THROUGHPUT, 0);
+            return WICED_BT_GATT_SUCCESS;
+
+        default:
+            return WICED_BT_GATT_OUT_OF_RANGE;
+    }
+}
+
+/**
+* Function Name:
+* app_throughput_refresh
+*
+* Function Description:
+* @brief   This function writes the results to the Control value, little
+*          endian: state, notifications in flight (1 byte each), source
+*          payload length (2 bytes), then sink bytes, sink writes, sink us
+*          from the first write to the last, source bytes, source
+*          notifications, source us from the start to the last notification
+*          transmitted, source stalls (4 bytes each). The Source value is
+*          the number of notifications sent.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_throughput_refresh(void)
+{
+    uint32_t results[] =
+    {
+        throughput.sink_bytes,
+        throughput.sink_writes,
+        throughput.sink_last_us - throughput.sink_first_us,
+        throughput.source_bytes,
+        throughput.source_notifications,
+        throughput.source_last_us - throughput.source_start_us,
+        throughput.source_stalls,
+    };
+    uint8_t *p = app_throughput_control;
+
+    *p++ = (uint8_t)throughput_state;
+    *p++ = throughput_in_flight;
+    p = throughput_put(p, throughput_payload_len, 2);
+    for (uint32_t i = 0; i < sizeof(results) / sizeof(results[0]); i++)
+    {
+        p = throughput_put(p, results[i], 4);
+    }
+
+    throughput_put(app_throughput_source, throughput_sent, 4);
+}
+
+/**
+* Function Name:
+* app_throughput_event_handler
+*
+* Function Description:
+* @brief   This function sends notifications of the source run until
+*          APP_THROUGHPUT_IN_FLIGHT are in flight, the next ones are sent as
+*          these are transmitted. If the stack refuses one, it is sent again
+*          on the next transmission, or after APP_THROUGHPUT_RETRY_MS if none
+*          is in flight. The run ends once all were transmitted, or if the
+*          client disables the notifications.
+*
+* @param   data: Not used
+*
+* @return  None
+*/
+void app_throughput_event_handler(uint32_t data)
+{
+    wiced_bt_gatt_status_t status;
+    uint32_t critical;
+    uint8_t *p_buf;
+
+    (void) data;
+
+    while (APP_THROUGHPUT_SOURCE == throughput_state)
+    {
+        if ((0 == throughput_conn_id) ||
+            !(app_throughput_source_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION))
+        {
+            throughput_stop();
+            break;
+        }
+        if ((0 != throughput_count) && (throughput_sent == throughput_count))
+        {
+            if (0 == throughput_in_flight)
+            {
+                throughput_state = APP_THROUGHPUT_IDLE;
+            }
+            break;
+        }
+        if (throughput_in_flight >= APP_THROUGHPUT_IN_FLIGHT)
+        {
+            break;
+        }
+
+        p_buf = throughput_tx_buf[throughput_sent % APP_THROUGHPUT_IN_FLIGHT];
+        throughput_put(p_buf, throughput_sent, 4);
+
+        /* Counted before it is sent, it can be transmitted before the call returns */
+        critical = cyhal_system_critical_section_enter();
+        throughput_in_flight++;
+        cyhal_system_critical_section_exit(critical);
+
+        status = wiced_bt_gatt_server_send_notification(throughput_conn_id, HDLC_THROUGHPUT_SOURCE_VALUE,
+                                                        throughput_payload_len, p_buf,
+                                                        (void *)throughput_tx_done);
+        app_metrics_on_notification(status);
+        if (WICED_BT_GATT_SUCCESS != status)
+        {
+            critical = cyhal_system_critical_section_enter();
+            throughput_in_flight--;
+            cyhal_system_critical_section_exit(critical);
+
+            throughput.source_stalls++;
+            if (0 == throughput_in_flight)
+            {
+                cy_rtos_timer_start(&throughput_retry_timer, APP_THROUGHPUT_RETRY_MS);
+            }
+            break;
+        }
+        throughput_sent++;
+    }
+}
+
+/**
+* Function Name:
+* throughput_put
+*
+* Function Description:
+* @brief   This function writes a value little endian.
+*
+* @param   p_data: Where to write
+* @param   value: Value
+* @param   size: Bytes to write, 2 or 4
+*
+* @return  uint8_t*: Byte after the value
+*/
+static uint8_t *throughput_put(uint8_t *p_data, uint32_t value, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        *p_data++ = (uint8_t)(value >> (8 * i));
+    }
+    return p_data;
+}
+
+/**
+* Function Name:
+* throughput_stop
+*
+* Function Description:
+* @brief   This function ends the run in progress. The notifications in flight
+*          are still counted once transmitted.
+*
+* @param   None
+*
+* @return  None
+*/
+static void throughput_stop(void)
+{
+    throughput_state = APP_THROUGHPUT_IDLE;
+    cy_rtos_timer_stop(&throughput_retry_timer);
+}
+
+/**
+* Function Name:
+* throughput_tx_done
+*
+* Function Description:
+* @brief   This function is given to the stack with every notification of
+*          the source, in place of a function freeing the buffer. It counts
+*          the notification once transmitted and asks the event loop for the
+*          next one. Called by the Bluetooth stack thread.
+*
+* @param   p_buf: Buffer of the notification
+*
+* @return  None
+*/
+static void throughput_tx_done(uint8_t *p_buf)
+{
+    uint32_t critical;
+
+    (void) p_buf;
+
+    critical = cyhal_system_critical_section_enter();
+    if (0 != throughput_in_flight)
+    {
+        throughput_in_flight--;
+    }
+    cyhal_system_critical_section_exit(critical);
+
+    throughput.source_notifications++;
+    throughput.source_bytes += throughput_payload_len;
+    throughput.source_last_us = app_timestamp_us();
+    app_event_post(APP_EVT_THROUGHPUT, 0);
+}
+
+/**
+* Function Name:
+* throughput_retry_cb
+*
+* Function Description:
+* @brief   This callback asks the event loop to send the notification the
+*          stack refused again.
+*
+* @param   arg: Not used
+*
+* @return  None
+*/
+static void throughput_retry_cb(cy_timer_callback_arg_t arg)
+{
+    (void) arg;
+
+    app_event_post(APP_EVT_THROUGHPUT, 0);
+}
+
+/* [] END OF FILE */
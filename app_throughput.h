@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   app_throughput.h
+*
+* Description: This is the header file of the Throughput GATT service, a benchmark of
+*              the ATT write and notification paths.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_THROUGHPUT_H_
+#define __APP_THROUGHPUT_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Commands written to the Control point, first byte */
+#define APP_THROUGHPUT_CMD_STOP             (0x00u)
+#define APP_THROUGHPUT_CMD_SINK             (0x01u)     /* No parameters */
+#define APP_THROUGHPUT_CMD_SOURCE           (0x02u)     /* Payload length (2 bytes), count (4 bytes) */
+
+/* Notifications of the source handed to the stack and not transmitted yet */
+#define APP_THROUGHPUT_IN_FLIGHT            (4u)
+
+/* Largest source payload, an LE data length of 251 bytes less the L2CAP and
+ * ATT headers */
+#define APP_THROUGHPUT_PAYLOAD_MAX          (244u)
+
+/* Wait before sending again when the stack refused a notification with none
+ * in flight, in ms */
+#define APP_THROUGHPUT_RETRY_MS             (10u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Run in progress */
+typedef enum
+{
+    APP_THROUGHPUT_IDLE,
+    APP_THROUGHPUT_SINK,
+    APP_THROUGHPUT_SOURCE,
+} app_throughput_state_t;
+
+/* Results of the last run of each direction, kept until the next one starts */
+typedef struct
+{
+    uint32_t    sink_bytes;
+    uint32_t    sink_writes;
+    uint32_t    sink_first_us;      /* First and last write received */
+    uint32_t    sink_last_us;
+    uint32_t    source_bytes;
+    uint32_t    source_notifications;   /* Transmitted */
+    uint32_t    source_start_us;
+    uint32_t    source_last_us;     /* Last notification transmitted */
+    uint32_t    source_stalls;      /* Notifications refused by the stack */
+} app_throughput_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void            app_throughput_init             (void);
+void            app_throughput_on_connect       (uint16_t conn_id);
+void            app_throughput_on_disconnect    (void);
+void            app_throughput_set_mtu          (uint16_t mtu);
+void            app_throughput_on_sink          (uint16_t len);
+wiced_bt_gatt_status_t app_throughput_on_control (const uint8_t *p_val, uint16_t len);
+void            app_throughput_refresh          (void);
+void            app_throughput_event_handler    (uint32_t data);
+
+#endif // __APP_THROUGHPUT_H_
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/******************************************************************************
+* File Name:   app_trace.c
+*
+* Description: This file records timestamped trace points of the Bluetooth
+*              callbacks, advertising, kv-store accesses and button of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "stdio.h"
+#include <stdbool.h>
+#include <inttypes.h>
+#include "app_utils.h"
+#include "app_trace.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define TRACE_RING_MASK                     (APP_TRACE_RING_SIZE - 1)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+#ifdef APP_TRACE_ENABLE
+/* Names of the trace points, in the order of app_trace_type_t */
+static const char *const trace_names[APP_TRACE_MAX] =
+{
+    "BTM",
+    "GATT",
+    "ADV",
+    "CONNECT",
+    "DISCONNECT",
+    "ENCRYPTED",
+    "BUTTON",
+    "NOTIFY",
+    "KV_READ_START",
+    "KV_READ_END",
+    "KV_WRITE_START",
+    "KV_WRITE_END",
+};
+
+static app_trace_record_t   trace_ring[APP_TRACE_RING_SIZE];
+
+/* Number of records written since boot, the ring holds the last ones */
+static uint32_t             trace_count;
+
+/* Recording stops while the ring is dumped, records are counted as lost */
+static bool                 trace_paused;
+static uint32_t             trace_lost;
+#endif
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_trace_record
+*
+* Function Description:
+* @brief   This function records a trace point with the current timestamp. It
+*          can be called from any thread or interrupt.
+*
+* @param   type: Trace point
+* @param   id: Event, mode or result, depending on the trace point
+* @param   arg: Argument of the trace point
+*
+* @return  None
+*/
+void app_trace_record(app_trace_type_t type, uint8_t id, uint16_t arg)
+{
+#ifdef APP_TRACE_ENABLE
+    app_trace_record_t *p_rec;
+    uint32_t state;
+
+    state = cyhal_system_critical_section_enter();
+    if (trace_paused)
+    {
+        trace_lost++;
+    }
+    else
+    {
+        p_rec = &trace_ring[trace_count & TRACE_RING_MASK];
+        p_rec->timestamp_us = app_timestamp_us();
+        p_rec->type = (uint8_t)type;
+        p_rec->id = id;
+        p_rec->arg = arg;
+        trace_count++;
+    }
+    cyhal_system_critical_section_exit(state);
+#else
+    (void) type;
+    (void) id;
+    (void) arg;
+#endif
+}
+
+/**
+* Function Name:
+* app_trace_dump
+*
+* Function Description:
+* @brief   This function prints the trace records, oldest first, one per line
+*          as "timestamp,point,id,arg" between TRACE BEGIN and TRACE END lines.
+*          Trace points hit while printing are lost.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_trace_dump(void)
+{
+#ifdef APP_TRACE_ENABLE
+    const app_trace_record_t *p_rec;
+    uint32_t state;
+    uint32_t first;
+    uint32_t last;
+
+    state = cyhal_system_critical_section_enter();
+    trace_paused = true;
+    last = trace_count;
+    cyhal_system_critical_section_exit(state);
+
+    first = (last > APP_TRACE_RING_SIZE) ? (last - APP_TRACE_RING_SIZE) : 0;
+    printf("TRACE BEGIN %" PRIu32 " records, %" PRIu32 " overwritten, %" PRIu32 " lost\r\n",
+           last - first, first, trace_lost);
+    for (uint32_t i = first; i < last; i++)
+    {
+        p_rec = &trace_ring[i & TRACE_RING_MASK];
+        printf("%" PRIu32 ",%s,%u,%u\r\n", p_rec->timestamp_us,
+               (APP_TRACE_MAX > p_rec->type) ? trace_names[p_rec->type] : "?", p_rec->id, p_rec->arg);
+    }
+    printf("TRACE END\r\n");
+
+    state = cyhal_system_critical_section_enter();
+    trace_paused = false;
+    cyhal_system_critical_section_exit(state);
+#else
+    printf("Trace not built, build with TRACE=1\r\n");
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/******************************************************************************
+* File Name:   app_trace.h
+*
+* Description: This is the header file for the event trace of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_TRACE_H_
+#define __APP_TRACE_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Number of trace records kept, must be a power of 2. The oldest records are
+ * overwritten when the ring is full. */
+#define APP_TRACE_RING_SIZE                 (512)
+
+/* Record a trace point. Compiled out unless the TRACE build option is set. */
+#ifdef APP_TRACE_ENABLE
+#define APP_TRACE(type, id, arg)            app_trace_record((type), (uint8_t)(id), (uint16_t)(arg))
+#else
+#define APP_TRACE(type, id, arg)            ((void)0)
+#endif
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Trace points. The names are printed in the dump and read by
+ * tools/trace_analyze.py. */
+typedef enum
+{
+    APP_TRACE_BTM,              /* Management event, id: event */
+    APP_TRACE_GATT,             /* GATT event, id: event */
+    APP_TRACE_ADV,              /* Advertising state change, id: mode */
+    APP_TRACE_CONNECT,          /* Connected, arg: connection id */
+    APP_TRACE_DISCONNECT,       /* Disconnected, id: reason */
+    APP_TRACE_ENCRYPTED,        /* Encryption status, id: result */
+    APP_TRACE_BUTTON,           /* Button interrupt */
+    APP_TRACE_NOTIFY,           /* Button value handled, id: 0 notification sent,
+                                 * 1 notifications disabled, 2 not connected,
+                                 * arg: attribute handle */
+    APP_TRACE_KV_READ_START,    /* kv-store read, arg: key */
+    APP_TRACE_KV_READ_END,      /* kv-store read done, id: 0 if successful */
+    APP_TRACE_KV_WRITE_START,   /* kv-store write, arg: key */
+    APP_TRACE_KV_WRITE_END,     /* kv-store write done, id: 0 if successful */
+    APP_TRACE_MAX
+} app_trace_type_t;
+
+/* Trace record, 8 bytes */
+typedef struct
+{
+    uint32_t    timestamp_us;
+    uint8_t     type;
+    uint8_t     id;
+    uint16_t    arg;
+} app_trace_record_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void    app_trace_record    (app_trace_type_t type, uint8_t id, uint16_t arg);
+void    app_trace_dump      (void);
+
+#endif // __APP_TRACE_H_
+
+/* [] END OF FILE */
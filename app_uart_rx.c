@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name:   app_uart_rx.c
+*
+* Description: This file implements the debug UART receive ring buffer of the
+*              Peripheral_Privacy Example for ModusToolbox. The UART interrupt is
+*              the only producer and the event loop the only consumer, so the ring
+*              needs no lock.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "stdio.h"
+#include <stdbool.h>
+#include <inttypes.h>
+#include "app_event.h"
+#include "app_power.h"
+#include "app_uart_rx.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define UART_RX_RING_MASK                   (APP_UART_RX_RING_SIZE - 1)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* Ring storage. Head is only written by the interrupt and tail only by the
+ * event loop; both run freely and are masked on access, so head - tail is
+ * the number of bytes waiting. */
+static uint8_t              uart_rx_ring[APP_UART_RX_RING_SIZE];
+static volatile uint32_t    uart_rx_head;
+static volatile uint32_t    uart_rx_tail;
+
+/* Set when an event has been posted for bytes not yet read, so that a burst
+ * of input takes a single slot of the event queue */
+static volatile bool        uart_rx_event_pending;
+
+static app_uart_rx_stats_t  uart_rx_stats;
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* app_uart_rx_isr
+*
+* Function Description:
+* @brief   This is the interrupt handler for received characters. It moves all
+*          the bytes the UART holds into the ring without waiting, and posts
+*          an event to the event loop if none is pending. Deep sleep is kept
+*          locked while the terminal is in use.
+*
+* @param   handler_arg: Not used
+* @param   event: UART event
+*
+* @return  None
+*/
+void app_uart_rx_isr(void *handler_arg, cyhal_uart_event_t event)
+{
+    uint32_t head = uart_rx_head;
+    uint32_t fill;
+    uint8_t readbyte;
+
+    (void) handler_arg;
+    (void) event;
+
+    app_power_wake_source(APP_POWER_WAKE_UART);
+    app_power_uart_activity();
+
+    while ((0 < cyhal_uart_readable(&cy_retarget_io_uart_obj)) &&
+           (CY_RSLT_SUCCESS == cyhal_uart_getc(&cy_retarget_io_uart_obj, &readbyte, 0)))
+    {
+        uart_rx_stats.received++;
+        if (APP_UART_RX_RING_SIZE <= (head - uart_rx_tail))
+        {
+            uart_rx_stats.overflows++;
+            continue;
+        }
+        uart_rx_ring[head & UART_RX_RING_MASK] = readbyte;
+        head++;
+    }
+
+    /* Publish the bytes only once they are stored */
+    uart_rx_head = head;
+
+    fill = head - uart_rx_tail;
+    if (fill > uart_rx_stats.max_fill)
+    {
+        uart_rx_stats.max_fill = fill;
+    }
+
+    if ((0 < fill) && !uart_rx_event_pending)
+    {
+        uart_rx_event_pending = true;
+        if (CY_RSLT_SUCCESS != app_event_post(APP_EVT_UART_RX, 0))
+        {
+            /* Try again with the next byte */
+            uart_rx_event_pending = false;
+        }
+    }
+}
+
+/**
+* Function Name:
+* app_uart_rx_read
+*
+* Function Description:
+* @brief   This function copies the received bytes out of the ring. It is
+*          called from the event loop only. Bytes received while it runs post
+*          a new event, so nothing is left behind when it returns 0.
+*
+* @param   p_buf: Buffer for the bytes
+* @param   max_len: Size of the buffer
+*
+* @return  uint32_t: Number of bytes copied
+*/
+uint32_t app_uart_rx_read(uint8_t *p_buf, uint32_t max_len)
+{
+    uint32_t tail = uart_rx_tail;
+    uint32_t len = 0;
+
+    uart_rx_event_pending = false;
+
+    while ((len < max_len) && (tail != uart_rx_head))
+    {
+        p_buf[len++] = uart_rx_ring[tail & UART_RX_RING_MASK];
+        tail++;
+    }
+
+    /* Free the slots only once they are read */
+    uart_rx_tail = tail;
+
+    return len;
+}
+
+/**
+* Function Name:
+* app_uart_rx_print_stats
+*
+* Function Description:
+* @brief   This function prints the receive statistics of the debug UART.
+*
+* @param   None
+*
+* @return  None
+*/
+void app_uart_rx_print_stats(void)
+{
+    printf("UART RX: %" PRIu32 " bytes, %" PRIu32 " lost, max fill %" PRIu32 "/%d\r\n",
+           uart_rx_stats.received, uart_rx_stats.overflows, uart_rx_stats.max_fill,
+           APP_UART_RX_RING_SIZE);
+}
+
+/* [] END OF FILE */
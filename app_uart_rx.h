@@ -0,0 +1,76 @@
+/******************************************************************************
+* File Name:   app_uart_rx.h
+*
+* Description: This is the header file for the UART receive ring buffer of the
+*              Peripheral_Privacy Example for ModusToolbox.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __APP_UART_RX_H_
+#define __APP_UART_RX_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include "cyhal.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Size of the receive ring in bytes, must be a power of 2 */
+#define APP_UART_RX_RING_SIZE               (256)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Receive statistics */
+typedef struct
+{
+    uint32_t    received;       /* Bytes read from the UART */
+    uint32_t    overflows;      /* Bytes lost because the ring was full */
+    uint32_t    max_fill;       /* Most bytes waiting in the ring */
+} app_uart_rx_stats_t;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+void     app_uart_rx_isr         (void *handler_arg, cyhal_uart_event_t event);
+uint32_t app_uart_rx_read        (uint8_t *p_buf, uint32_t max_len);
+void     app_uart_rx_print_stats (void);
+
+#endif // __APP_UART_RX_H_
+
+/* [] END OF FILE */
@@ -46,6 +46,18 @@
 #include "stdio.h"
 #include "app_utils.h"
 #include "stdlib.h"
+#include "cyhal.h"
+
+/*******************************************************************************
+ *                                VARIABLES
+ ******************************************************************************/
+/* Low-power timer used for timestamps, it keeps counting in deep sleep. Its
+ * ticks are counted in 64 bits at every read. */
+static cyhal_lptimer_t  app_timestamp_timer;
+static uint32_t         app_timestamp_hz;
+static uint32_t         app_timestamp_mask;     /* Largest counter value */
+static uint32_t         app_timestamp_last;     /* Counter at the last read */
+static uint64_t         app_timestamp_ticks;
 
 
 /*******************************************************************************
@@ -382,23 +394,94 @@ const char *get_bt_gatt_evt_name(wiced_bt_gatt_evt_t event)
  ******************************************************************************/
 void app_free_buffer(uint8_t *p_buf)
 {
-    free(p_buf);
+    app_heap_free(p_buf);
 }
 
 /*******************************************************************************
  * Function Name: app_alloc_buffer
  *******************************************************************************
  * Summary:
- *  This function allocates a memory buffer.
+ *  This function allocates a memory buffer. The name is in parentheses so
+ *  that the HEAP_TRACE macro of the same name does not replace it.
  *
  *
  * Parameters:
  *  int len: Length to allocate
  *
  ******************************************************************************/
-void* app_alloc_buffer(int len)
+void* (app_alloc_buffer)(int len)
+{
+    return app_heap_alloc(len, __func__, (uint16_t)__LINE__);
+}
+
+/*******************************************************************************
+ * Function Name: app_timestamp_init
+ *******************************************************************************
+ * Summary:
+ *  This function starts the low-power timer used by app_timestamp_us(). It
+ *  runs from the 32 kHz clock in active, sleep and deep sleep, so timestamps
+ *  have a resolution of about 31 us and keep counting through deep sleep.
+ *
+ * Parameters:
+ *  None
+ *
+ ******************************************************************************/
+void app_timestamp_init(void)
+{
+    cyhal_lptimer_info_t info;
+
+    if (CY_RSLT_SUCCESS != cyhal_lptimer_init(&app_timestamp_timer))
+    {
+        printf("Failed to start the timestamp timer!\n");
+        CY_ASSERT(0);
+    }
+    cyhal_lptimer_get_info(&app_timestamp_timer, &info);
+    app_timestamp_hz = info.frequency_hz;
+    app_timestamp_mask = info.max_counter_value;
+    app_timestamp_last = cyhal_lptimer_read(&app_timestamp_timer);
+}
+
+/*******************************************************************************
+ * Function Name: app_timestamp_us64
+ *******************************************************************************
+ * Summary:
+ *  This function returns the time since app_timestamp_init() in microseconds.
+ *  It can be called from any context, including interrupts, and must be
+ *  called at least once per period of the low-power counter, which the power
+ *  callback does at every sleep transition.
+ *
+ * Parameters:
+ *  None
+ *
+ ******************************************************************************/
+uint64_t app_timestamp_us64(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+    uint32_t now = cyhal_lptimer_read(&app_timestamp_timer);
+    uint64_t ticks;
+
+    app_timestamp_ticks += (now - app_timestamp_last) & app_timestamp_mask;
+    app_timestamp_last = now;
+    ticks = app_timestamp_ticks;
+    cyhal_system_critical_section_exit(state);
+
+    return (ticks * 1000000u) / app_timestamp_hz;
+}
+
+/*******************************************************************************
+ * Function Name: app_timestamp_us
+ *******************************************************************************
+ * Summary:
+ *  This function returns a timestamp in microseconds. It wraps after about
+ *  71 minutes, only differences of timestamps are meaningful.
+ *
+ * Parameters:
+ *  None
+ *
+ ******************************************************************************/
+uint32_t app_timestamp_us(void)
 {
-    return malloc(len);
+    return (uint32_t)app_timestamp_us64();
 }
 
 /* [] END OF FILE */
@@ -48,6 +48,7 @@
  ******************************************************************************/
 #include "wiced_bt_dev.h"
 #include "wiced_bt_gatt.h"
+#include "app_heap.h"
 /******************************************************************************
  *                                Constants
  ******************************************************************************/
@@ -70,6 +71,17 @@ const char *get_bt_smp_status_name(wiced_bt_smp_status_t status);
 
 void         app_free_buffer(uint8_t *p_buf);
 void        *app_alloc_buffer(int len);
+
+void         app_timestamp_init(void);
+uint32_t     app_timestamp_us(void);
+uint64_t     app_timestamp_us64(void);
+
+/* With HEAP_TRACE, every buffer is recorded with the function and line
+ * allocating it. app_free_buffer() stays a function, it is handed to the
+ * stack to free the response buffers. */
+#ifdef APP_HEAP_TRACE
+#define app_alloc_buffer(len)           app_heap_alloc((len), __func__, (uint16_t)__LINE__)
+#endif
 #endif      /* __APP_UTILS_H__ */
 
 
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   cycfg_bt_settings.c
+*
+* Description: This file mirrors the Bluetooth settings the Bluetooth Configurator
+*              generates from design.cybt, for the host build. Keep it in step
+*              with design.cybt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cycfg_bt_settings.h"
+#include "cycfg_gatt_db.h"
+
+/* Advertising settings, intervals in slots of 0.625 ms and durations in s */
+const wiced_bt_cfg_ble_advert_settings_t wiced_bt_cfg_ble_advert_settings =
+{
+    .channel_map = BTM_BLE_ADVERT_CHNL_37 | BTM_BLE_ADVERT_CHNL_38 | BTM_BLE_ADVERT_CHNL_39,
+    .high_duty_min_interval = 48,
+    .high_duty_max_interval = 48,
+    .high_duty_duration = 60,
+    .low_duty_min_interval = 2048,
+    .low_duty_max_interval = 2048,
+    .low_duty_duration = 0,
+    .high_duty_directed_min_interval = 400,
+    .high_duty_directed_max_interval = 800,
+    .low_duty_directed_min_interval = 48,
+    .low_duty_directed_max_interval = 48,
+    .low_duty_directed_duration = 30,
+    .high_duty_nonconn_min_interval = 160,
+    .high_duty_nonconn_max_interval = 160,
+    .high_duty_nonconn_duration = 30,
+    .low_duty_nonconn_min_interval = 2048,
+    .low_duty_nonconn_max_interval = 2048,
+    .low_duty_nonconn_duration = 30,
+};
+
+/* Scan settings, the example does not scan */
+const wiced_bt_cfg_ble_scan_settings_t wiced_bt_cfg_scan_settings =
+{
+    .scan_mode = 0,
+};
+
+/* LE settings */
+const wiced_bt_cfg_ble_t wiced_bt_cfg_ble =
+{
+    .ble_max_simultaneous_links = 1,
+    .ble_max_rx_pdu_size = 512,
+    .p_ble_scan_cfg = &wiced_bt_cfg_scan_settings,
+    .p_ble_advert_cfg = &wiced_bt_cfg_ble_advert_settings,
+    .appearance = 0,
+    .host_addr_resolution_db_size = 4,
+    .rpa_refresh_timeout = 900,
+};
+
+/* GATT settings */
+const wiced_bt_cfg_gatt_t wiced_bt_cfg_gatt =
+{
+    .appearance = 0,
+    .client_max_links = 0,
+    .server_max_links = 1,
+    .max_attr_len = 512,
+    .max_mtu_size = 517,
+};
+
+/* Bluetooth stack settings */
+const wiced_bt_cfg_settings_t wiced_bt_cfg_settings =
+{
+    .device_name = (uint8_t*)app_gap_device_name,
+    .p_br_cfg = NULL,
+    .p_ble_cfg = &wiced_bt_cfg_ble,
+    .p_gatt_cfg = &wiced_bt_cfg_gatt,
+    .p_isoc_cfg = NULL,
+    .p_l2cap_app_cfg = NULL,
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/******************************************************************************
+* File Name:   cycfg_gap.c
+*
+* Description: This file mirrors the advertising data the Bluetooth Configurator
+*              generates from design.cybt, for the host build. Keep it in step
+*              with design.cybt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cycfg_gap.h"
+
+/* Advertisement elements */
+static uint8_t cy_bt_adv_packet_elem_0[1] = { 0x06 };
+static uint8_t cy_bt_adv_packet_elem_1[11] = { 0x42, 0x4C, 0x45, 0x20, 0x50, 0x52, 0x49, 0x56, 0x41, 0x43, 0x59 };
+static uint8_t cy_bt_adv_packet_elem_2[2] = { 0x00, 0x00 };
+wiced_bt_ble_advert_elem_t cy_bt_adv_packet_data[] =
+{
+    /* Flags */
+    {
+        .advert_type = BTM_BLE_ADVERT_TYPE_FLAG,
+        .len = 1,
+        .p_data = (uint8_t*)cy_bt_adv_packet_elem_0,
+    },
+    /* Complete local name */
+    {
+        .advert_type = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE,
+        .len = 11,
+        .p_data = (uint8_t*)cy_bt_adv_packet_elem_1,
+    },
+    /* Appearance */
+    {
+        .advert_type = BTM_BLE_ADVERT_TYPE_APPEARANCE,
+        .len = 2,
+        .p_data = (uint8_t*)cy_bt_adv_packet_elem_2,
+    },
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,67 @@
+/******************************************************************************
+* File Name:   cycfg_gap.h
+*
+* Description: This file mirrors the advertising data the Bluetooth Configurator
+*              generates from design.cybt, for the host build. Keep it in step
+*              with design.cybt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if !defined(CYCFG_GAP_H)
+#define CYCFG_GAP_H
+
+#include "stdint.h"
+#include "wiced_bt_ble.h"
+#include "cycfg_gatt_db.h"
+
+/* Silicon generated 'Company assigned' part of device address */
+#define CY_BT_SILICON_DEVICE_ADDRESS_EN             0
+
+/* Appearance */
+#define CY_BT_APPEARANCE                            0
+
+/* Advertisement elements */
+#define CY_BT_ADV_PACKET_ELEM_0                     0
+#define CY_BT_ADV_PACKET_ELEM_1                     1
+#define CY_BT_ADV_PACKET_ELEM_2                     2
+#define CY_BT_ADV_PACKET_DATA_SIZE                  3
+
+/* External definitions */
+extern wiced_bt_ble_advert_elem_t cy_bt_adv_packet_data[];
+
+#endif /* CYCFG_GAP_H */
+
+/* [] END OF FILE */
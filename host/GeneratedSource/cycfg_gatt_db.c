@@ -0,0 +1,189 @@
+/******************************************************************************
+* File Name:   cycfg_gatt_db.c
+*
+* Description: This file mirrors the GATT database the Bluetooth Configurator
+*              generates from design.cybt, for the host build. Keep it in step
+*              with design.cybt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cycfg_gatt_db.h"
+#include "wiced_bt_gatt.h"
+
+/*************************************************************************************
+* GATT server definitions
+*************************************************************************************/
+
+const uint8_t gatt_database[] =
+{
+    /* Primary Service: Generic Access */
+    PRIMARY_SERVICE_UUID16 (HDLS_GAP, __UUID_SERVICE_GENERIC_ACCESS),
+        /* Characteristic: Device Name */
+        CHARACTERISTIC_UUID16 (HDLC_GAP_DEVICE_NAME, HDLC_GAP_DEVICE_NAME_VALUE,
+            __UUID_CHARACTERISTIC_DEVICE_NAME, GATTDB_CHAR_PROP_READ, LEGATTDB_PERM_READABLE),
+        /* Characteristic: Appearance */
+        CHARACTERISTIC_UUID16 (HDLC_GAP_APPEARANCE, HDLC_GAP_APPEARANCE_VALUE,
+            __UUID_CHARACTERISTIC_APPEARANCE, GATTDB_CHAR_PROP_READ, LEGATTDB_PERM_READABLE),
+
+    /* Primary Service: Generic Attribute */
+    PRIMARY_SERVICE_UUID16 (HDLS_GATT, __UUID_SERVICE_GENERIC_ATTRIBUTE),
+
+    /* Primary Service: WICEDBUTTON */
+    PRIMARY_SERVICE_UUID128 (HDLS_WICEDBUTTON, __UUID_SERVICE_WICEDBUTTON),
+        /* Characteristic: MB1 */
+        CHARACTERISTIC_UUID128 (HDLC_WICEDBUTTON_MB1, HDLC_WICEDBUTTON_MB1_VALUE,
+            __UUID_CHARACTERISTIC_WICEDBUTTON_MB1, GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+            LEGATTDB_PERM_READABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE (HDLD_WICEDBUTTON_MB1_CLIENT_CHAR_CONFIG,
+                __UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                LEGATTDB_PERM_READABLE | LEGATTDB_PERM_WRITE_REQ | LEGATTDB_PERM_AUTH_WRITABLE),
+
+    /* Primary Service: METRICS */
+    PRIMARY_SERVICE_UUID128 (HDLS_METRICS, __UUID_SERVICE_METRICS),
+        /* Characteristic: COUNTERS */
+        CHARACTERISTIC_UUID128 (HDLC_METRICS_COUNTERS, HDLC_METRICS_COUNTERS_VALUE,
+            __UUID_CHARACTERISTIC_METRICS_COUNTERS, GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+            LEGATTDB_PERM_READABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE (HDLD_METRICS_COUNTERS_CLIENT_CHAR_CONFIG,
+                __UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                LEGATTDB_PERM_READABLE | LEGATTDB_PERM_WRITE_REQ),
+        /* Characteristic: LATENCY */
+        CHARACTERISTIC_UUID128 (HDLC_METRICS_LATENCY, HDLC_METRICS_LATENCY_VALUE,
+            __UUID_CHARACTERISTIC_METRICS_LATENCY, GATTDB_CHAR_PROP_READ,
+            LEGATTDB_PERM_READABLE),
+        /* Characteristic: RESOURCES */
+        CHARACTERISTIC_UUID128 (HDLC_METRICS_RESOURCES, HDLC_METRICS_RESOURCES_VALUE,
+            __UUID_CHARACTERISTIC_METRICS_RESOURCES, GATTDB_CHAR_PROP_READ,
+            LEGATTDB_PERM_READABLE),
+
+    /* Primary Service: THROUGHPUT */
+    PRIMARY_SERVICE_UUID128 (HDLS_THROUGHPUT, __UUID_SERVICE_THROUGHPUT),
+        /* Characteristic: SINK */
+        CHARACTERISTIC_UUID128_WRITABLE (HDLC_THROUGHPUT_SINK, HDLC_THROUGHPUT_SINK_VALUE,
+            __UUID_CHARACTERISTIC_THROUGHPUT_SINK, GATTDB_CHAR_PROP_WRITE_NO_RESPONSE,
+            LEGATTDB_PERM_VARIABLE_LENGTH | LEGATTDB_PERM_WRITE_CMD),
+        /* Characteristic: SOURCE */
+        CHARACTERISTIC_UUID128 (HDLC_THROUGHPUT_SOURCE, HDLC_THROUGHPUT_SOURCE_VALUE,
+            __UUID_CHARACTERISTIC_THROUGHPUT_SOURCE, GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+            LEGATTDB_PERM_READABLE),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE (HDLD_THROUGHPUT_SOURCE_CLIENT_CHAR_CONFIG,
+                __UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                LEGATTDB_PERM_READABLE | LEGATTDB_PERM_WRITE_REQ),
+        /* Characteristic: CONTROL */
+        CHARACTERISTIC_UUID128_WRITABLE (HDLC_THROUGHPUT_CONTROL, HDLC_THROUGHPUT_CONTROL_VALUE,
+            __UUID_CHARACTERISTIC_THROUGHPUT_CONTROL, GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_WRITE,
+            LEGATTDB_PERM_READABLE | LEGATTDB_PERM_VARIABLE_LENGTH | LEGATTDB_PERM_WRITE_REQ),
+
+    /* Primary Service: ECHO */
+    PRIMARY_SERVICE_UUID128 (HDLS_ECHO, __UUID_SERVICE_ECHO),
+        /* Characteristic: ECHO */
+        CHARACTERISTIC_UUID128_WRITABLE (HDLC_ECHO_ECHO, HDLC_ECHO_ECHO_VALUE,
+            __UUID_CHARACTERISTIC_ECHO_ECHO, GATTDB_CHAR_PROP_WRITE | GATTDB_CHAR_PROP_NOTIFY,
+            LEGATTDB_PERM_VARIABLE_LENGTH | LEGATTDB_PERM_WRITE_REQ),
+            /* Descriptor: Client Characteristic Configuration */
+            CHAR_DESCRIPTOR_UUID16_WRITABLE (HDLD_ECHO_ECHO_CLIENT_CHAR_CONFIG,
+                __UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                LEGATTDB_PERM_READABLE | LEGATTDB_PERM_WRITE_REQ),
+};
+
+/* Length of the GATT database */
+const uint16_t gatt_database_len = sizeof(gatt_database);
+
+/*************************************************************************************
+ * GATT Initial Value Arrays
+ ************************************************************************************/
+
+uint8_t app_gap_device_name[]                        = {'B', 'L', 'E', ' ', 'P', 'R', 'I', 'V', 'A', 'C', 'Y', '\0', };
+uint8_t app_gap_appearance[]                         = {0x00, 0x00, };
+uint8_t app_wicedbutton_mb1[]                        = {0x00, };
+uint8_t app_wicedbutton_mb1_client_char_config[]     = {0x00, 0x00, };
+uint8_t app_metrics_counters[]                       = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_metrics_counters_client_char_config[]    = {0x00, 0x00, };
+uint8_t app_metrics_latency[]                        = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_metrics_resources[]                      = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_throughput_sink[]                        = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_throughput_source[]                      = {0x00, 0x00, 0x00, 0x00, };
+uint8_t app_throughput_source_client_char_config[]   = {0x00, 0x00, };
+uint8_t app_throughput_control[]                     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_echo_echo[]                              = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, };
+uint8_t app_echo_echo_client_char_config[]           = {0x00, 0x00, };
+
+/************************************************************************************
+ * GATT Lookup Table
+ ************************************************************************************/
+
+gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[] =
+{
+    /* { attribute handle,                        max_len, cur_len, attribute data } */
+    { HDLC_GAP_DEVICE_NAME_VALUE,                     11,      11,      app_gap_device_name },
+    { HDLC_GAP_APPEARANCE_VALUE,                      2,       2,       app_gap_appearance },
+    { HDLC_WICEDBUTTON_MB1_VALUE,                     1,       1,       app_wicedbutton_mb1 },
+    { HDLD_WICEDBUTTON_MB1_CLIENT_CHAR_CONFIG,        2,       2,       app_wicedbutton_mb1_client_char_config },
+    { HDLC_METRICS_COUNTERS_VALUE,                    40,      40,      app_metrics_counters },
+    { HDLD_METRICS_COUNTERS_CLIENT_CHAR_CONFIG,       2,       2,       app_metrics_counters_client_char_config },
+    { HDLC_METRICS_LATENCY_VALUE,                     20,      20,      app_metrics_latency },
+    { HDLC_METRICS_RESOURCES_VALUE,                   40,      40,      app_metrics_resources },
+    { HDLC_THROUGHPUT_SINK_VALUE,                     512,     512,     app_throughput_sink },
+    { HDLC_THROUGHPUT_SOURCE_VALUE,                   4,       4,       app_throughput_source },
+    { HDLD_THROUGHPUT_SOURCE_CLIENT_CHAR_CONFIG,      2,       2,       app_throughput_source_client_char_config },
+    { HDLC_THROUGHPUT_CONTROL_VALUE,                  32,      32,      app_throughput_control },
+    { HDLC_ECHO_ECHO_VALUE,                           12,      12,      app_echo_echo },
+    { HDLD_ECHO_ECHO_CLIENT_CHAR_CONFIG,              2,       2,       app_echo_echo_client_char_config },
+};
+
+/* Number of Lookup Table entries */
+const uint16_t app_gatt_db_ext_attr_tbl_size = (sizeof(app_gatt_db_ext_attr_tbl) / sizeof(gatt_db_lookup_table_t));
+
+/* Number of GATT initial value arrays entries */
+const uint16_t app_gap_device_name_len = 11;
+const uint16_t app_gap_appearance_len = (sizeof(app_gap_appearance));
+const uint16_t app_wicedbutton_mb1_len = (sizeof(app_wicedbutton_mb1));
+const uint16_t app_wicedbutton_mb1_client_char_config_len = (sizeof(app_wicedbutton_mb1_client_char_config));
+const uint16_t app_metrics_counters_len = (sizeof(app_metrics_counters));
+const uint16_t app_metrics_counters_client_char_config_len = (sizeof(app_metrics_counters_client_char_config));
+const uint16_t app_metrics_latency_len = (sizeof(app_metrics_latency));
+const uint16_t app_metrics_resources_len = (sizeof(app_metrics_resources));
+const uint16_t app_throughput_sink_len = (sizeof(app_throughput_sink));
+const uint16_t app_throughput_source_len = (sizeof(app_throughput_source));
+const uint16_t app_throughput_source_client_char_config_len = (sizeof(app_throughput_source_client_char_config));
+const uint16_t app_throughput_control_len = (sizeof(app_throughput_control));
+const uint16_t app_echo_echo_len = (sizeof(app_echo_echo));
+const uint16_t app_echo_echo_client_char_config_len = (sizeof(app_echo_echo_client_char_config));
+
+/* [] END OF FILE */
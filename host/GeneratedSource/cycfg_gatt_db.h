@@ -0,0 +1,180 @@
+/******************************************************************************
+* File Name:   cycfg_gatt_db.h
+*
+* Description: This file mirrors the GATT database the Bluetooth Configurator
+*              generates from design.cybt, for the host build. Keep it in step
+*              with design.cybt.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if !defined(CYCFG_GATT_DB_H)
+#define CYCFG_GATT_DB_H
+
+#include "stdint.h"
+#include "wiced_bt_gatt.h"
+
+#define __UUID_SERVICE_GENERIC_ACCESS                   0x1800
+#define __UUID_CHARACTERISTIC_DEVICE_NAME               0x2A00
+#define __UUID_CHARACTERISTIC_APPEARANCE                0x2A01
+#define __UUID_SERVICE_GENERIC_ATTRIBUTE                0x1801
+#define __UUID_SERVICE_WICEDBUTTON                      0x76u, 0xDAu, 0xECu, 0x81u, 0x7Du, 0x50u, 0xCDu, 0x9Bu, \
+                                                        0x80u, 0x4Du, 0x60u, 0x75u, 0x65u, 0xE4u, 0x19u, 0xE7u
+#define __UUID_CHARACTERISTIC_WICEDBUTTON_MB1           0xE2u, 0xEEu, 0xA7u, 0xE6u, 0x54u, 0x6Cu, 0x28u, 0xA8u, \
+                                                        0x13u, 0x4Cu, 0xE6u, 0xFAu, 0x05u, 0x2Eu, 0x2Bu, 0x03u
+#define __UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION 0x2902
+#define __UUID_SERVICE_METRICS                          0x6Fu, 0xA7u, 0xAFu, 0x8Du, 0xF4u, 0x94u, 0x3Bu, 0xA5u, \
+                                                        0x29u, 0x44u, 0x04u, 0xF6u, 0xBCu, 0xB9u, 0x9Au, 0xCBu
+#define __UUID_CHARACTERISTIC_METRICS_COUNTERS          0xB5u, 0x9Cu, 0xF5u, 0xE9u, 0x0Cu, 0xC8u, 0x51u, 0xA8u, \
+                                                        0x68u, 0x4Du, 0xD2u, 0xBDu, 0x4Du, 0xD7u, 0x47u, 0xF6u
+#define __UUID_CHARACTERISTIC_METRICS_LATENCY           0x9Au, 0x28u, 0xB6u, 0x74u, 0x06u, 0xACu, 0xC1u, 0x9Cu, \
+                                                        0x23u, 0x4Cu, 0x73u, 0xEEu, 0x4Cu, 0x90u, 0xE3u, 0xFBu
+#define __UUID_CHARACTERISTIC_METRICS_RESOURCES         0x18u, 0xD9u, 0x1Fu, 0x2Cu, 0xE8u, 0x01u, 0x1Bu, 0x8Fu, \
+                                                        0x47u, 0x40u, 0x70u, 0x88u, 0xABu, 0xB2u, 0xE5u, 0xA3u
+#define __UUID_SERVICE_THROUGHPUT                       0xF1u, 0xBAu, 0xABu, 0xFBu, 0xA6u, 0xFEu, 0xF4u, 0x96u, \
+                                                        0x2Au, 0x4Cu, 0xC5u, 0x9Bu, 0xE7u, 0x01u, 0x4Fu, 0x59u
+#define __UUID_CHARACTERISTIC_THROUGHPUT_SINK           0x00u, 0x4Au, 0xF1u, 0x9Cu, 0x63u, 0xBBu, 0x57u, 0xBDu, \
+                                                        0x97u, 0x4Fu, 0x50u, 0x44u, 0xD7u, 0x05u, 0x3Cu, 0xBFu
+#define __UUID_CHARACTERISTIC_THROUGHPUT_SOURCE         0x91u, 0x8Eu, 0x6Du, 0x77u, 0x14u, 0x4Fu, 0x29u, 0x9Bu, \
+                                                        0x16u, 0x41u, 0x47u, 0x6Bu, 0xFBu, 0xF5u, 0x83u, 0xF8u
+#define __UUID_CHARACTERISTIC_THROUGHPUT_CONTROL        0x2Au, 0xB0u, 0xFDu, 0x9Bu, 0x6Bu, 0x14u, 0xACu, 0xA5u, \
+                                                        0xDDu, 0x48u, 0xC0u, 0x29u, 0xB2u, 0x67u, 0x04u, 0x3Du
+#define __UUID_SERVICE_ECHO                             0x03u, 0xEDu, 0x5Au, 0x39u, 0xE1u, 0xB7u, 0x46u, 0x86u, \
+                                                        0x3Fu, 0x4Eu, 0x07u, 0x5Cu, 0x03u, 0x50u, 0x11u, 0x3Eu
+#define __UUID_CHARACTERISTIC_ECHO_ECHO                 0x05u, 0x2Eu, 0xB0u, 0xE5u, 0x8Cu, 0xDAu, 0x52u, 0x9Fu, \
+                                                        0x52u, 0x42u, 0x0Fu, 0xE3u, 0x77u, 0x25u, 0x59u, 0xFBu
+
+/* Service Generic Access */
+#define HDLS_GAP                                        0x0001
+/* Characteristic Device Name */
+#define HDLC_GAP_DEVICE_NAME                            0x0002
+#define HDLC_GAP_DEVICE_NAME_VALUE                      0x0003
+/* Characteristic Appearance */
+#define HDLC_GAP_APPEARANCE                             0x0004
+#define HDLC_GAP_APPEARANCE_VALUE                       0x0005
+
+/* Service Generic Attribute */
+#define HDLS_GATT                                       0x0006
+
+/* Service WICEDBUTTON */
+#define HDLS_WICEDBUTTON                                0x0007
+/* Characteristic MB1 */
+#define HDLC_WICEDBUTTON_MB1                            0x0008
+#define HDLC_WICEDBUTTON_MB1_VALUE                      0x0009
+/* Descriptor Client Characteristic Configuration */
+#define HDLD_WICEDBUTTON_MB1_CLIENT_CHAR_CONFIG         0x000A
+
+/* Service METRICS */
+#define HDLS_METRICS                                    0x000B
+/* Characteristic COUNTERS */
+#define HDLC_METRICS_COUNTERS                           0x000C
+#define HDLC_METRICS_COUNTERS_VALUE                     0x000D
+/* Descriptor Client Characteristic Configuration */
+#define HDLD_METRICS_COUNTERS_CLIENT_CHAR_CONFIG        0x000E
+/* Characteristic LATENCY */
+#define HDLC_METRICS_LATENCY                            0x000F
+#define HDLC_METRICS_LATENCY_VALUE                      0x0010
+/* Characteristic RESOURCES */
+#define HDLC_METRICS_RESOURCES                          0x0011
+#define HDLC_METRICS_RESOURCES_VALUE                    0x0012
+
+/* Service THROUGHPUT */
+#define HDLS_THROUGHPUT                                 0x0013
+/* Characteristic SINK */
+#define HDLC_THROUGHPUT_SINK                            0x0014
+#define HDLC_THROUGHPUT_SINK_VALUE                      0x0015
+/* Characteristic SOURCE */
+#define HDLC_THROUGHPUT_SOURCE                          0x0016
+#define HDLC_THROUGHPUT_SOURCE_VALUE                    0x0017
+/* Descriptor Client Characteristic Configuration */
+#define HDLD_THROUGHPUT_SOURCE_CLIENT_CHAR_CONFIG       0x0018
+/* Characteristic CONTROL */
+#define HDLC_THROUGHPUT_CONTROL                         0x0019
+#define HDLC_THROUGHPUT_CONTROL_VALUE                   0x001A
+
+/* Service ECHO */
+#define HDLS_ECHO                                       0x001B
+/* Characteristic ECHO */
+#define HDLC_ECHO_ECHO                                  0x001C
+#define HDLC_ECHO_ECHO_VALUE                            0x001D
+/* Descriptor Client Characteristic Configuration */
+#define HDLD_ECHO_ECHO_CLIENT_CHAR_CONFIG               0x001E
+
+/* External Lookup Table Entry */
+typedef struct
+{
+    uint16_t handle;
+    uint16_t max_len;
+    uint16_t cur_len;
+    uint8_t  *p_data;
+} gatt_db_lookup_table_t;
+
+/* External definitions */
+extern const uint8_t  gatt_database[];
+extern const uint16_t gatt_database_len;
+extern gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[];
+extern const uint16_t app_gatt_db_ext_attr_tbl_size;
+extern uint8_t app_gap_device_name[];
+extern const uint16_t app_gap_device_name_len;
+extern uint8_t app_gap_appearance[];
+extern const uint16_t app_gap_appearance_len;
+extern uint8_t app_wicedbutton_mb1[];
+extern const uint16_t app_wicedbutton_mb1_len;
+extern uint8_t app_wicedbutton_mb1_client_char_config[];
+extern const uint16_t app_wicedbutton_mb1_client_char_config_len;
+extern uint8_t app_metrics_counters[];
+extern const uint16_t app_metrics_counters_len;
+extern uint8_t app_metrics_counters_client_char_config[];
+extern const uint16_t app_metrics_counters_client_char_config_len;
+extern uint8_t app_metrics_latency[];
+extern const uint16_t app_metrics_latency_len;
+extern uint8_t app_metrics_resources[];
+extern const uint16_t app_metrics_resources_len;
+extern uint8_t app_throughput_sink[];
+extern const uint16_t app_throughput_sink_len;
+extern uint8_t app_throughput_source[];
+extern const uint16_t app_throughput_source_len;
+extern uint8_t app_throughput_source_client_char_config[];
+extern const uint16_t app_throughput_source_client_char_config_len;
+extern uint8_t app_throughput_control[];
+extern const uint16_t app_throughput_control_len;
+extern uint8_t app_echo_echo[];
+extern const uint16_t app_echo_echo_len;
+extern uint8_t app_echo_echo_client_char_config[];
+extern const uint16_t app_echo_echo_client_char_config_len;
+
+#endif /* CYCFG_GATT_DB_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   cyabs_rtos.h
+*
+* Description: Host stand-in for the RTOS abstraction. Threads are pthreads,
+*              time is the virtual clock of host.h, see host/src/host_rtos.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef CYABS_RTOS_H
+#define CYABS_RTOS_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cy_result.h"
+#include "cyabs_rtos_impl.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define CY_RTOS_NEVER_TIMEOUT               ((uint32_t)0xffffffffUL)
+
+#define CY_RTOS_TIMEOUT                     CY_RSLT_HOST_TIMEOUT
+#define CY_RTOS_GENERAL_ERROR               CY_RSLT_HOST_ERROR
+#define CY_RTOS_NO_MEMORY                   CY_RSLT_HOST_NO_MEMORY
+#define CY_RTOS_BAD_PARAM                   CY_RSLT_HOST_ERROR
+#define CY_RTOS_QUEUE_FULL                  CY_RSLT_HOST_TIMEOUT
+#define CY_RTOS_QUEUE_EMPTY                 CY_RSLT_HOST_TIMEOUT
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef void *cy_thread_arg_t;
+typedef void (*cy_thread_entry_fn_t)(cy_thread_arg_t arg);
+
+typedef uint32_t cy_time_t;
+
+typedef enum
+{
+    CY_TIMER_TYPE_PERIODIC,
+    CY_TIMER_TYPE_ONCE
+} cy_timer_trigger_type_t;
+
+typedef void *cy_timer_callback_arg_t;
+typedef void (*cy_timer_callback_t)(cy_timer_callback_arg_t arg);
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function,
+                                const char *name, void *stack, uint32_t stack_size,
+                                cy_thread_priority_t priority, cy_thread_arg_t arg);
+cy_rslt_t cy_rtos_thread_set_notification(cy_thread_t *thread);
+cy_rslt_t cy_rtos_thread_wait_notification(cy_time_t timeout_ms);
+
+cy_rslt_t cy_rtos_queue_init(cy_queue_t *queue, size_t length, size_t itemsize);
+cy_rslt_t cy_rtos_queue_put(cy_queue_t *queue, const void *item_ptr, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_queue_get(cy_queue_t *queue, void *item_ptr, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_queue_count(cy_queue_t *queue, size_t *num_waiting);
+
+cy_rslt_t cy_rtos_mutex_init(cy_mutex_t *mutex, bool recursive);
+cy_rslt_t cy_rtos_mutex_get(cy_mutex_t *mutex, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_mutex_set(cy_mutex_t *mutex);
+
+cy_rslt_t cy_rtos_timer_init(cy_timer_t *timer, cy_timer_trigger_type_t type,
+                             cy_timer_callback_t fun, cy_timer_callback_arg_t arg);
+cy_rslt_t cy_rtos_timer_start(cy_timer_t *timer, cy_time_t num_ms);
+cy_rslt_t cy_rtos_timer_stop(cy_timer_t *timer);
+cy_rslt_t cy_rtos_timer_is_running(cy_timer_t *timer, bool *state);
+
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval);
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms);
+
+#endif /* CYABS_RTOS_H */
+
+/* [] END OF FILE */
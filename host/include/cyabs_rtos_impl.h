@@ -0,0 +1,66 @@
+/******************************************************************************
+* File Name:   cyabs_rtos_impl.h
+*
+* Description: Host stand-in for the ThreadX port of the RTOS abstraction.
+*              The RTOS objects are handles to the objects of host/src/host_rtos.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef CYABS_RTOS_IMPL_H
+#define CYABS_RTOS_IMPL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    CY_RTOS_PRIORITY_MIN            = 0,
+    CY_RTOS_PRIORITY_LOW            = 1,
+    CY_RTOS_PRIORITY_BELOWNORMAL    = 2,
+    CY_RTOS_PRIORITY_NORMAL         = 3,
+    CY_RTOS_PRIORITY_ABOVENORMAL    = 4,
+    CY_RTOS_PRIORITY_HIGH           = 5,
+    CY_RTOS_PRIORITY_REALTIME       = 6,
+    CY_RTOS_PRIORITY_MAX            = 7
+} cy_thread_priority_t;
+
+typedef struct host_thread  *cy_thread_t;
+typedef struct host_queue   *cy_queue_t;
+typedef struct host_mutex   *cy_mutex_t;
+typedef struct host_timer   *cy_timer_t;
+
+#endif /* CYABS_RTOS_IMPL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,217 @@
+/******************************************************************************
+* File Name:   cyhal.h
+*
+* Description: Host stand-in for the hardware abstraction layer. Declares the
+*              GPIO, PWM, UART, low-power timer, system power and critical
+*              section APIs used by the application, see host/src/host_hal.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef CYHAL_H
+#define CYHAL_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "cy_result.h"
+
+/*******************************************************************************
+*        GPIO
+*******************************************************************************/
+typedef int cyhal_gpio_t;
+
+#define NC                                  ((cyhal_gpio_t)-1)
+
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_ANALOG,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESHIGH,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_PULLUPDOWN
+} cyhal_gpio_drive_mode_t;
+
+typedef enum
+{
+    CYHAL_GPIO_IRQ_NONE = 0,
+    CYHAL_GPIO_IRQ_RISE = 1,
+    CYHAL_GPIO_IRQ_FALL = 2,
+    CYHAL_GPIO_IRQ_BOTH = 3
+} cyhal_gpio_event_t;
+
+typedef void (*cyhal_gpio_event_callback_t)(void *callback_arg, cyhal_gpio_event_t event);
+
+typedef struct cyhal_gpio_callback_data_s
+{
+    cyhal_gpio_event_callback_t         callback;
+    void                                *callback_arg;
+    struct cyhal_gpio_callback_data_s   *next;
+    cyhal_gpio_t                        pin;
+} cyhal_gpio_callback_data_t;
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void      cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_callback_data_t *callback_data);
+void      cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event,
+                                  uint8_t intr_priority, bool enable);
+bool      cyhal_gpio_read(cyhal_gpio_t pin);
+void      cyhal_gpio_write(cyhal_gpio_t pin, bool value);
+
+/*******************************************************************************
+*        Clock and PWM
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    id;
+} cyhal_clock_t;
+
+typedef struct
+{
+    cyhal_gpio_t    pin;
+    float           duty_cycle;
+    uint32_t        frequency_hz;
+    bool            running;
+} cyhal_pwm_t;
+
+cy_rslt_t cyhal_pwm_init(cyhal_pwm_t *obj, cyhal_gpio_t pin, const cyhal_clock_t *clk);
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle, uint32_t frequencyhal_hz);
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj);
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj);
+
+/*******************************************************************************
+*        UART
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    id;
+} cyhal_uart_t;
+
+typedef enum
+{
+    CYHAL_UART_IRQ_NONE                 = 0,
+    CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO  = 1 << 1,
+    CYHAL_UART_IRQ_TX_DONE              = 1 << 2,
+    CYHAL_UART_IRQ_TX_ERROR             = 1 << 4,
+    CYHAL_UART_IRQ_RX_FULL              = 1 << 5,
+    CYHAL_UART_IRQ_RX_DONE              = 1 << 6,
+    CYHAL_UART_IRQ_RX_ERROR             = 1 << 7,
+    CYHAL_UART_IRQ_RX_NOT_EMPTY         = 1 << 8,
+    CYHAL_UART_IRQ_TX_EMPTY             = 1 << 9
+} cyhal_uart_event_t;
+
+typedef void (*cyhal_uart_event_callback_t)(void *callback_arg, cyhal_uart_event_t event);
+
+void      cyhal_uart_register_callback(cyhal_uart_t *obj, cyhal_uart_event_callback_t callback,
+                                       void *callback_arg);
+void      cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                                  uint8_t intr_priority, bool enable);
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout);
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value);
+uint32_t  cyhal_uart_readable(cyhal_uart_t *obj);
+cy_rslt_t cyhal_uart_write(cyhal_uart_t *obj, void *tx, size_t *tx_length);
+bool      cyhal_uart_is_tx_active(cyhal_uart_t *obj);
+
+/*******************************************************************************
+*        Low-power timer
+*******************************************************************************/
+typedef struct
+{
+    bool        running;
+} cyhal_lptimer_t;
+
+typedef struct
+{
+    uint32_t    frequency_hz;
+    uint8_t     min_set_delay;
+    uint32_t    max_counter_value;
+} cyhal_lptimer_info_t;
+
+cy_rslt_t cyhal_lptimer_init(cyhal_lptimer_t *obj);
+void      cyhal_lptimer_get_info(cyhal_lptimer_t *obj, cyhal_lptimer_info_t *info);
+uint32_t  cyhal_lptimer_read(const cyhal_lptimer_t *obj);
+
+/*******************************************************************************
+*        System power management
+*******************************************************************************/
+typedef enum
+{
+    CYHAL_SYSPM_CB_CPU_SLEEP            = 0x01,
+    CYHAL_SYSPM_CB_CPU_DEEPSLEEP        = 0x02,
+    CYHAL_SYSPM_CB_SYSTEM_HIBERNATE     = 0x04
+} cyhal_syspm_callback_state_t;
+
+typedef enum
+{
+    CYHAL_SYSPM_CHECK_READY             = 0x01,
+    CYHAL_SYSPM_CHECK_FAIL              = 0x02,
+    CYHAL_SYSPM_BEFORE_TRANSITION       = 0x04,
+    CYHAL_SYSPM_AFTER_TRANSITION        = 0x08
+} cyhal_syspm_callback_mode_t;
+
+typedef bool (*cyhal_syspm_callback_t)(cyhal_syspm_callback_state_t state,
+                                       cyhal_syspm_callback_mode_t mode, void *callback_arg);
+
+typedef struct cyhal_syspm_callback_data
+{
+    cyhal_syspm_callback_t              callback;
+    cyhal_syspm_callback_state_t        states;
+    cyhal_syspm_callback_mode_t         ignore_modes;
+    void                                *args;
+    struct cyhal_syspm_callback_data    *next;
+} cyhal_syspm_callback_data_t;
+
+void      cyhal_syspm_register_callback(cyhal_syspm_callback_data_t *callback_data);
+void      cyhal_syspm_lock_deepsleep(void);
+void      cyhal_syspm_unlock_deepsleep(void);
+
+/*******************************************************************************
+*        Critical sections
+*******************************************************************************/
+uint32_t  cyhal_system_critical_section_enter(void);
+void      cyhal_system_critical_section_exit(uint32_t old_state);
+
+#endif /* CYHAL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,207 @@
+/******************************************************************************
+* File Name:   host.h
+*
+* Description: This is the header file of the host build of the Peripheral_Privacy
+*              Example. It drives the application built for Linux: the virtual
+*              clock, the interrupts of the button and the UART, and the events
+*              of the Bluetooth stack.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef __HOST_H_
+#define __HOST_H_
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Largest flash of the kv-store model, in sectors */
+#define HOST_FLASH_SECTORS_MAX              (64u)
+
+/* Keys counted apart in host_flash_stats_t */
+#define HOST_FLASH_KEYS_MAX                 (8u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* What the application asked from the stack stand-in */
+typedef struct
+{
+    wiced_bt_ble_advert_mode_t  adv_mode;           /* Current advertising mode */
+    uint32_t    adv_starts;                         /* Calls changing the advertising mode */
+    uint32_t    adv_data_sets;                      /* Advertising and scan response data set */
+    uint32_t    ext_adv_starts;                     /* Extended advertising enabled or disabled */
+    uint64_t    adv_on_us;                          /* Virtual time advertising, legacy only */
+    uint64_t    adv_events;                         /* Advertising events in that time */
+    uint32_t    rpa_rotations;                      /* Local RPA regenerated, see host_bt.c */
+    uint32_t    notifications;
+    uint32_t    indications;
+    uint32_t    read_rsps;                          /* Read, read blob and read by type */
+    uint32_t    write_rsps;
+    uint32_t    mtu_rsps;
+    uint32_t    error_rsps;
+    wiced_bt_gatt_status_t  last_error;
+    uint32_t    security_grants;
+    uint32_t    confirm_replies;
+    uint32_t    conn_param_updates;
+    uint32_t    bond_deletes;
+    uint32_t    privacy_mode_sets;
+    uint32_t    resolving_list_size;                /* Devices in the address resolution db */
+    uint32_t    accept_list_size;
+    uint32_t    buffers_transmitted;                /* GATT_APP_BUFFER_TRANSMITTED_EVT sent */
+    uint8_t     last_notification[16];
+    uint16_t    last_notification_len;
+} host_bt_stats_t;
+
+/* Calls made to the kv-store */
+typedef struct
+{
+    uint32_t    reads;
+    uint32_t    writes;
+    uint32_t    deletes;
+    uint32_t    resets;
+    uint64_t    bytes_read;
+    uint64_t    bytes_written;
+} host_kvstore_stats_t;
+
+/* Flash under the kv-store */
+typedef struct
+{
+    uint32_t    sector_size;                        /* Erase unit, in bytes */
+    uint32_t    sectors;                            /* Split in two areas used in turn */
+    uint32_t    program_size;                       /* Program unit, records are padded to it */
+    uint32_t    program_us;                         /* Time to program one unit */
+    uint32_t    erase_us;                           /* Time to erase one sector */
+    uint32_t    endurance;                          /* Erase cycles of a sector */
+} host_flash_cfg_t;
+
+/* Writes of one key, the copies made by garbage collection excluded */
+typedef struct
+{
+    uint16_t    key;
+    uint32_t    writes;
+    uint64_t    logical_bytes;                      /* Values written by the application */
+    uint64_t    programmed_bytes;                   /* Headers and padding included */
+} host_flash_key_stats_t;
+
+/* Work done on the flash. The erase counts are kept in the kv-store file,
+ * the rest is counted from the start. */
+typedef struct
+{
+    uint64_t    logical_bytes;                      /* Values written by the application */
+    uint64_t    programmed_bytes;                   /* Everything programmed */
+    uint64_t    gc_bytes;                           /* Programmed by garbage collection */
+    uint32_t    gcs;
+    uint32_t    ops;                                /* Writes, deletes and resets */
+    uint64_t    busy_us;                            /* Program and erase time */
+    uint32_t    max_op_us;                          /* Of one operation */
+    uint32_t    erases[HOST_FLASH_SECTORS_MAX];
+    host_flash_key_stats_t  keys[HOST_FLASH_KEYS_MAX];
+} host_flash_stats_t;
+
+typedef struct
+{
+    uint64_t    allocs;
+    uint64_t    frees;
+    uint64_t    bytes;                              /* Allocated, in total */
+    int64_t     in_use;                             /* Allocated and not freed yet */
+} host_heap_stats_t;
+
+/* Called in the thread delivering a stack event, before the application
+ * handles it and once it returned */
+typedef void (host_bt_hook_t)(bool gatt, uint8_t event, const void *p_event_data, bool done);
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+/* Application entry, main() of main.c built as app_main() */
+int                         app_main(void);
+
+/* Virtual clock, started at 0. Advancing it fires the expired RTOS timers in
+ * their order and lets the application handle each before the next one. */
+uint64_t                    host_clock_us(void);
+void                        host_clock_advance_us(uint64_t delta_us);
+
+/* Wait until every application thread is blocked with nothing to do and every
+ * deferred stack event was delivered */
+void                        host_settle(void);
+
+/* Interrupts: the callbacks registered by the application run in the caller,
+ * with the critical sections of the application excluded */
+void                        host_button_set(bool pressed);
+void                        host_uart_rx(const uint8_t *p_data, uint32_t len);
+
+/* Bluetooth stack: events are delivered in the caller, which acts as the
+ * Bluetooth thread */
+wiced_result_t              host_bt_management_event(wiced_bt_management_evt_t event,
+                                                     wiced_bt_management_evt_data_t *p_event_data);
+wiced_bt_gatt_status_t      host_bt_gatt_event(wiced_bt_gatt_evt_t event,
+                                               wiced_bt_gatt_event_data_t *p_event_data);
+bool                        host_bt_run_pending(void);
+const host_bt_stats_t       *host_bt_get_stats(void);
+void                        host_bt_set_hook(host_bt_hook_t *p_hook);
+void                        host_bt_make_rpa(const uint8_t *p_irk, uint32_t prand,
+                                             wiced_bt_device_address_t rpa);
+bool                        host_bt_resolve_rpa(const wiced_bt_device_address_t bd_addr,
+                                                wiced_bt_device_address_t identity);
+float                       host_led_duty_cycle(uint32_t *p_frequency_hz);
+
+/* kv-store: kept on a flash model in RAM, and in the file if one is set before
+ * app_main(). The flash is set before app_main() too, the geometry of the file
+ * wins. */
+void                        host_kvstore_set_file(const char *p_path);
+bool                        host_kvstore_set_flash(const char *p_spec);
+const host_flash_cfg_t      *host_kvstore_get_flash_cfg(void);
+const host_flash_stats_t    *host_kvstore_get_flash_stats(void);
+void                        host_kvstore_clear_flash_stats(void);
+const host_kvstore_stats_t  *host_kvstore_get_stats(void);
+const host_kvstore_stats_t  *host_kvstore_get_thread_stats(void);
+
+/* Heap: what the application allocated, in all threads or in the caller */
+void                        host_heap_get_stats(host_heap_stats_t *p_stats, bool this_thread);
+
+/* Internal, between the stand-ins */
+void                        host_irq_enter(void);
+void                        host_irq_exit(void);
+void                        host_rtos_wait_idle(void);
+
+#endif /* __HOST_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,64 @@
+/******************************************************************************
+* File Name:   mtb_kvstore_cat5.h
+*
+* Description: Host stand-in for the CAT5 kv-store library, kept in RAM and
+*              optionally in a file, see host/src/host_kvstore.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef MTB_KVSTORE_CAT5_H
+#define MTB_KVSTORE_CAT5_H
+
+#include "cy_result.h"
+
+#define MTB_KVSTORE_BAD_PARAM_ERROR         CY_RSLT_HOST_ERROR
+#define MTB_KVSTORE_ITEM_NOT_FOUND_ERROR    CY_RSLT_HOST_NOT_FOUND
+#define MTB_KVSTORE_STORAGE_FULL_ERROR      CY_RSLT_HOST_NO_MEMORY
+
+typedef struct
+{
+    bool    initialized;
+} mtb_kvstore_t;
+
+cy_rslt_t mtb_kvstore_init(mtb_kvstore_t *obj);
+cy_rslt_t mtb_kvstore_read_numeric_key(mtb_kvstore_t *obj, uint16_t key, uint8_t *data, uint32_t *size);
+cy_rslt_t mtb_kvstore_write_numeric_key(mtb_kvstore_t *obj, uint16_t key, const uint8_t *data,
+                                        uint32_t size, bool overwrite);
+cy_rslt_t mtb_kvstore_delete_numeric_key(mtb_kvstore_t *obj, uint16_t key);
+cy_rslt_t mtb_kvstore_reset(mtb_kvstore_t *obj);
+
+#endif /* MTB_KVSTORE_CAT5_H */
+
+/* [] END OF FILE */
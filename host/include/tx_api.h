@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name:   tx_api.h
+*
+* Description: Host stand-in for the ThreadX API. Only the list of created
+*              threads is kept, for the stack monitor.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef TX_API_H
+#define TX_API_H
+
+typedef char            CHAR;
+typedef unsigned char   UCHAR;
+typedef unsigned int    UINT;
+typedef unsigned long   ULONG;
+
+#define VOID            void
+
+#define TX_STACK_FILL   ((ULONG)0xEFEFEFEFUL)
+
+/* The stack of a host thread is the pthread stack, the stack fields describe
+ * the buffer given to cy_rtos_thread_create, which stays unused */
+typedef struct TX_THREAD_STRUCT
+{
+    ULONG                       tx_thread_id;
+    VOID                        *tx_thread_stack_ptr;
+    VOID                        *tx_thread_stack_start;
+    VOID                        *tx_thread_stack_end;
+    ULONG                       tx_thread_stack_size;
+    CHAR                        *tx_thread_name;
+    UINT                        tx_thread_priority;
+    struct TX_THREAD_STRUCT     *tx_thread_created_next;
+    struct TX_THREAD_STRUCT     *tx_thread_created_previous;
+} TX_THREAD;
+
+extern TX_THREAD    *_tx_thread_created_ptr;
+extern ULONG        _tx_thread_created_count;
+
+#endif /* TX_API_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,168 @@
+/******************************************************************************
+* File Name:   wiced_bt_ble.h
+*
+* Description: Host stand-in for the LE API of the Bluetooth stack: legacy and
+*              extended advertising, privacy modes and the filter accept list.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef WICED_BT_BLE_H
+#define WICED_BT_BLE_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_types.h"
+
+/* Needed by the management events of wiced_bt_dev.h */
+enum
+{
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW
+};
+typedef uint8_t wiced_bt_ble_advert_mode_t;
+
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define BTM_BLE_PRIVACY_MODE_NETWORK                    (0)
+#define BTM_BLE_PRIVACY_MODE_DEVICE                     (1)
+
+#define BTM_BLE_ADVERT_TYPE_FLAG                        (0x01)
+#define BTM_BLE_ADVERT_TYPE_16SRV_COMPLETE              (0x03)
+#define BTM_BLE_ADVERT_TYPE_128SRV_COMPLETE             (0x07)
+#define BTM_BLE_ADVERT_TYPE_NAME_SHORT                  (0x08)
+#define BTM_BLE_ADVERT_TYPE_NAME_COMPLETE               (0x09)
+#define BTM_BLE_ADVERT_TYPE_TX_POWER                    (0x0A)
+#define BTM_BLE_ADVERT_TYPE_APPEARANCE                  (0x19)
+#define BTM_BLE_ADVERT_TYPE_MANUFACTURER                (0xFF)
+
+#define BTM_BLE_LIMITED_DISCOVERABLE_FLAG               (0x01)
+#define BTM_BLE_GENERAL_DISCOVERABLE_FLAG               (0x02)
+#define BTM_BLE_BREDR_NOT_SUPPORTED                     (0x04)
+
+#define BTM_BLE_ADV_POLICY_ACCEPT_CONN_AND_SCAN         (0)
+#define BTM_BLE_ADV_POLICY_ACCEPT_CONN_FILTER_SCAN      (1)
+#define BTM_BLE_ADV_POLICY_FILTER_CONN_ACCEPT_SCAN      (2)
+#define BTM_BLE_ADV_POLICY_FILTER_CONN_FILTER_SCAN      (3)
+
+#define WICED_BT_BLE_EXT_ADV_EVENT_CONNECTABLE_ADV                      (1 << 0)
+#define WICED_BT_BLE_EXT_ADV_EVENT_SCANNABLE_ADV                        (1 << 1)
+#define WICED_BT_BLE_EXT_ADV_EVENT_DIRECTED_ADV                         (1 << 2)
+#define WICED_BT_BLE_EXT_ADV_EVENT_HIGH_DUTY_DIRECTED_CONNECTABLE_ADV   (1 << 3)
+#define WICED_BT_BLE_EXT_ADV_EVENT_LEGACY_ADV                           (1 << 4)
+
+#define WICED_BT_BLE_EXT_ADV_PHY_1M                     (1)
+#define WICED_BT_BLE_EXT_ADV_SCAN_REQ_NOTIFY_DISABLE    (0)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef uint8_t     wiced_bt_ble_privacy_mode_t;
+typedef uint8_t     wiced_bt_ble_advert_type_t;
+typedef uint8_t     wiced_bt_ble_advert_filter_policy_t;
+typedef uint8_t     wiced_bt_ble_ext_adv_handle_t;
+typedef uint16_t    wiced_bt_ble_ext_adv_event_property_t;
+typedef uint32_t    wiced_bt_ble_ext_adv_interval_t;
+typedef uint8_t     wiced_bt_ble_ext_adv_phy_t;
+typedef uint8_t     wiced_bt_ble_ext_adv_sid_t;
+typedef uint8_t     wiced_bt_ble_ext_adv_scan_req_notification_setting_t;
+
+typedef struct
+{
+    uint8_t                     *p_data;
+    uint16_t                    len;
+    wiced_bt_ble_advert_type_t  advert_type;
+} wiced_bt_ble_advert_elem_t;
+
+typedef struct
+{
+    wiced_bt_ble_ext_adv_handle_t   adv_handle;
+    uint16_t                        adv_duration;
+    uint8_t                         max_ext_adv_events;
+} wiced_bt_ble_ext_adv_duration_config_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+wiced_result_t  wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                              wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                              wiced_bt_device_address_ptr_t directed_advertisement_bdaddr_ptr);
+wiced_bt_ble_advert_mode_t wiced_bt_ble_get_current_advert_mode(void);
+wiced_result_t  wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_data);
+wiced_result_t  wiced_bt_ble_set_raw_scan_response_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_data);
+wiced_result_t  wiced_bt_ble_set_privacy_mode(wiced_bt_device_address_t remote_bda,
+                                              wiced_bt_ble_address_type_t rem_bda_type,
+                                              wiced_bt_ble_privacy_mode_t privacy_mode);
+wiced_result_t  wiced_bt_ble_address_resolution_list_clear_and_disable(void);
+wiced_result_t  wiced_bt_ble_update_advertising_filter_accept_list(wiced_bool_t add,
+                                                                   wiced_bt_ble_address_type_t addr_type,
+                                                                   wiced_bt_device_address_t remote_bda);
+wiced_bool_t    wiced_bt_ble_clear_filter_accept_list(void);
+
+wiced_result_t  wiced_bt_ble_set_ext_adv_parameters(wiced_bt_ble_ext_adv_handle_t adv_handle,
+                                                    wiced_bt_ble_ext_adv_event_property_t event_properties,
+                                                    wiced_bt_ble_ext_adv_interval_t primary_adv_int_min,
+                                                    wiced_bt_ble_ext_adv_interval_t primary_adv_int_max,
+                                                    uint8_t primary_adv_channel_map,
+                                                    wiced_bt_ble_address_type_t own_addr_type,
+                                                    wiced_bt_ble_address_type_t peer_addr_type,
+                                                    wiced_bt_device_address_t peer_addr,
+                                                    wiced_bt_ble_advert_filter_policy_t adv_filter_policy,
+                                                    int8_t adv_tx_power,
+                                                    wiced_bt_ble_ext_adv_phy_t primary_adv_phy,
+                                                    uint8_t secondary_adv_max_skip,
+                                                    wiced_bt_ble_ext_adv_phy_t secondary_adv_phy,
+                                                    wiced_bt_ble_ext_adv_sid_t adv_sid,
+                                                    wiced_bt_ble_ext_adv_scan_req_notification_setting_t scan_request_not);
+wiced_result_t  wiced_bt_ble_set_ext_adv_data(wiced_bt_ble_ext_adv_handle_t adv_handle, uint16_t data_len,
+                                              uint8_t *p_data);
+wiced_result_t  wiced_bt_ble_set_ext_scan_rsp_data(wiced_bt_ble_ext_adv_handle_t adv_handle, uint16_t data_len,
+                                                   uint8_t *p_data);
+wiced_result_t  wiced_bt_ble_start_ext_adv(uint8_t enable, uint8_t number_of_sets,
+                                           wiced_bt_ble_ext_adv_duration_config_t *p_set_adv_duration_config);
+
+#endif /* WICED_BT_BLE_H */
+
+/* [] END OF FILE */
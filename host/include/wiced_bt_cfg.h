@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   wiced_bt_cfg.h
+*
+* Description: Host stand-in for the configuration structures of the
+*              Bluetooth stack.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef WICED_BT_CFG_H
+#define WICED_BT_CFG_H
+
+#include "wiced_bt_dev.h"
+
+#define BTM_BLE_ADVERT_CHNL_37              (0x01)
+#define BTM_BLE_ADVERT_CHNL_38              (0x02)
+#define BTM_BLE_ADVERT_CHNL_39              (0x04)
+
+typedef uint8_t wiced_bt_ble_advert_chnl_map_t;
+
+typedef struct
+{
+    wiced_bt_ble_advert_chnl_map_t  channel_map;
+    uint16_t    high_duty_min_interval;
+    uint16_t    high_duty_max_interval;
+    uint16_t    high_duty_duration;
+    uint16_t    low_duty_min_interval;
+    uint16_t    low_duty_max_interval;
+    uint16_t    low_duty_duration;
+    uint16_t    high_duty_directed_min_interval;
+    uint16_t    high_duty_directed_max_interval;
+    uint16_t    low_duty_directed_min_interval;
+    uint16_t    low_duty_directed_max_interval;
+    uint16_t    low_duty_directed_duration;
+    uint16_t    high_duty_nonconn_min_interval;
+    uint16_t    high_duty_nonconn_max_interval;
+    uint16_t    high_duty_nonconn_duration;
+    uint16_t    low_duty_nonconn_min_interval;
+    uint16_t    low_duty_nonconn_max_interval;
+    uint16_t    low_duty_nonconn_duration;
+} wiced_bt_cfg_ble_advert_settings_t;
+
+typedef struct
+{
+    uint8_t     scan_mode;
+} wiced_bt_cfg_ble_scan_settings_t;
+
+typedef struct
+{
+    uint16_t                                    ble_max_simultaneous_links;
+    uint16_t                                    ble_max_rx_pdu_size;
+    const wiced_bt_cfg_ble_scan_settings_t      *p_ble_scan_cfg;
+    const wiced_bt_cfg_ble_advert_settings_t    *p_ble_advert_cfg;
+    uint16_t                                    appearance;
+    uint8_t                                     host_addr_resolution_db_size;
+    uint16_t                                    rpa_refresh_timeout;
+} wiced_bt_cfg_ble_t;
+
+typedef struct
+{
+    uint16_t    appearance;
+    uint8_t     client_max_links;
+    uint8_t     server_max_links;
+    uint16_t    max_attr_len;
+    uint16_t    max_mtu_size;
+} wiced_bt_cfg_gatt_t;
+
+typedef struct
+{
+    const uint8_t               *device_name;
+    const void                  *p_br_cfg;
+    const wiced_bt_cfg_ble_t    *p_ble_cfg;
+    const wiced_bt_cfg_gatt_t   *p_gatt_cfg;
+    const void                  *p_isoc_cfg;
+    const void                  *p_l2cap_app_cfg;
+} wiced_bt_cfg_settings_t;
+
+#endif /* WICED_BT_CFG_H */
+
+/* [] END OF FILE */
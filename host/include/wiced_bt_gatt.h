@@ -0,0 +1,351 @@
+/******************************************************************************
+* File Name:   wiced_bt_gatt.h
+*
+* Description: Host stand-in for the GATT API of the Bluetooth stack, with the
+*              macros building the GATT database of GeneratedSource/cycfg_gatt_db.c.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef WICED_BT_GATT_H
+#define WICED_BT_GATT_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define GATT_DEF_BLE_MTU_SIZE               (23)
+
+#define GATT_CLIENT_CONFIG_NOTIFICATION     (0x0001)
+#define GATT_CLIENT_CONFIG_INDICATION       (0x0002)
+
+#define GATT_UUID_PRI_SERVICE               (0x2800)
+#define GATT_UUID_SEC_SERVICE               (0x2801)
+#define GATT_UUID_CHAR_DECLARE              (0x2803)
+#define GATT_UUID_CHAR_CLIENT_CONFIG        (0x2902)
+#define GATT_UUID_GAP_DEVICE_NAME           (0x2A00)
+#define GATT_UUID_GAP_ICON                  (0x2A01)
+#define UUID_SERVICE_GAP                    (0x1800)
+#define UUID_SERVICE_GATT                   (0x1801)
+#define UUID_CHARACTERISTIC_DEVICE_NAME     GATT_UUID_GAP_DEVICE_NAME
+#define UUID_CHARACTERISTIC_APPEARANCE      GATT_UUID_GAP_ICON
+#define UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION GATT_UUID_CHAR_CLIENT_CONFIG
+
+#define GATTDB_CHAR_PROP_BROADCAST          (0x01)
+#define GATTDB_CHAR_PROP_READ               (0x02)
+#define GATTDB_CHAR_PROP_WRITE_NO_RESPONSE  (0x04)
+#define GATTDB_CHAR_PROP_WRITE              (0x08)
+#define GATTDB_CHAR_PROP_NOTIFY             (0x10)
+#define GATTDB_CHAR_PROP_INDICATE           (0x20)
+
+/* Permissions of an attribute. The UUID of an attribute is 128-bit when
+ * LEGATTDB_PERM_SERVICE_UUID_128 is set, 16-bit otherwise */
+#define LEGATTDB_PERM_NONE                  (0x00)
+#define LEGATTDB_PERM_VARIABLE_LENGTH       (0x01)
+#define LEGATTDB_PERM_READABLE              (0x02)
+#define LEGATTDB_PERM_WRITE_CMD             (0x04)
+#define LEGATTDB_PERM_WRITE_REQ             (0x08)
+#define LEGATTDB_PERM_AUTH_READABLE         (0x10)
+#define LEGATTDB_PERM_RELIABLE_WRITE        (0x20)
+#define LEGATTDB_PERM_AUTH_WRITABLE         (0x40)
+#define LEGATTDB_PERM_SERVICE_UUID_128      (0x80)
+#define LEGATTDB_PERM_WRITABLE              (LEGATTDB_PERM_WRITE_CMD | LEGATTDB_PERM_WRITE_REQ)
+
+/* Each attribute of the database is: handle (2), permissions (1), length of
+ * the rest (1), UUID (2 or 16) and the value held by the database, if any.
+ * The values of the characteristics are held by the application. */
+#define LO(x)                               ((uint8_t)((x) & 0xFF))
+#define HI(x)                               ((uint8_t)(((x) >> 8) & 0xFF))
+
+#define PRIMARY_SERVICE_UUID16(handle, service) \
+    LO(handle), HI(handle), LEGATTDB_PERM_READABLE, 4, \
+    LO(GATT_UUID_PRI_SERVICE), HI(GATT_UUID_PRI_SERVICE), LO(service), HI(service)
+
+#define PRIMARY_SERVICE_UUID128(handle, service) \
+    LO(handle), HI(handle), LEGATTDB_PERM_READABLE, 18, \
+    LO(GATT_UUID_PRI_SERVICE), HI(GATT_UUID_PRI_SERVICE), service
+
+#define CHARACTERISTIC_UUID16(handle, handle_value, uuid, properties, permission) \
+    LO(handle), HI(handle), LEGATTDB_PERM_READABLE, 7, \
+    LO(GATT_UUID_CHAR_DECLARE), HI(GATT_UUID_CHAR_DECLARE), \
+    (uint8_t)(properties), LO(handle_value), HI(handle_value), LO(uuid), HI(uuid), \
+    LO(handle_value), HI(handle_value), (uint8_t)(permission), 2, LO(uuid), HI(uuid)
+
+#define CHARACTERISTIC_UUID128(handle, handle_value, uuid, properties, permission) \
+    LO(handle), HI(handle), LEGATTDB_PERM_READABLE, 21, \
+    LO(GATT_UUID_CHAR_DECLARE), HI(GATT_UUID_CHAR_DECLARE), \
+    (uint8_t)(properties), LO(handle_value), HI(handle_value), uuid, \
+    LO(handle_value), HI(handle_value), (uint8_t)((permission) | LEGATTDB_PERM_SERVICE_UUID_128), 16, uuid
+
+/* Same layout here, the value is written by the peer */
+#define CHARACTERISTIC_UUID128_WRITABLE(handle, handle_value, uuid, properties, permission) \
+    LO(handle), HI(handle), LEGATTDB_PERM_READABLE, 21, \
+    LO(GATT_UUID_CHAR_DECLARE), HI(GATT_UUID_CHAR_DECLARE), \
+    (uint8_t)(properties), LO(handle_value), HI(handle_value), uuid, \
+    LO(handle_value), HI(handle_value), (uint8_t)((permission) | LEGATTDB_PERM_SERVICE_UUID_128), 16, uuid
+
+#define CHAR_DESCRIPTOR_UUID16_WRITABLE(handle, uuid, permission) \
+    LO(handle), HI(handle), (uint8_t)(permission), 2, LO(uuid), HI(uuid)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+enum
+{
+    WICED_BT_GATT_SUCCESS               = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE,
+    WICED_BT_GATT_READ_NOT_PERMIT,
+    WICED_BT_GATT_WRITE_NOT_PERMIT,
+    WICED_BT_GATT_INVALID_PDU,
+    WICED_BT_GATT_INSUF_AUTHENTICATION,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED,
+    WICED_BT_GATT_INVALID_OFFSET,
+    WICED_BT_GATT_INSUF_AUTHORIZATION,
+    WICED_BT_GATT_PREPARE_Q_FULL,
+    WICED_BT_GATT_ATTRIBUTE_NOT_FOUND,
+    WICED_BT_GATT_NOT_LONG,
+    WICED_BT_GATT_INSUF_KEY_SIZE,
+    WICED_BT_GATT_INVALID_ATTR_LEN,
+    WICED_BT_GATT_ERR_UNLIKELY,
+    WICED_BT_GATT_INSUF_ENCRYPTION,
+    WICED_BT_GATT_UNSUPPORT_GRP_TYPE,
+    WICED_BT_GATT_INSUF_RESOURCE,
+    WICED_BT_GATT_ILLEGAL_PARAMETER     = 0x87,
+    WICED_BT_GATT_NO_RESOURCES,
+    WICED_BT_GATT_INTERNAL_ERROR,
+    WICED_BT_GATT_WRONG_STATE,
+    WICED_BT_GATT_DB_FULL,
+    WICED_BT_GATT_BUSY,
+    WICED_BT_GATT_ERROR,
+    WICED_BT_GATT_CMD_STARTED,
+    WICED_BT_GATT_PENDING,
+    WICED_BT_GATT_AUTH_FAIL,
+    WICED_BT_GATT_MORE,
+    WICED_BT_GATT_INVALID_CFG,
+    WICED_BT_GATT_SERVICE_STARTED,
+    WICED_BT_GATT_NOT_ENCRYPTED,
+    WICED_BT_GATT_CONGESTED,
+    WICED_BT_GATT_WRITE_REQ_REJECTED    = 0xFC,
+    WICED_BT_GATT_CCC_CFG_ERR,
+    WICED_BT_GATT_PRC_IN_PROGRESS,
+    WICED_BT_GATT_OUT_OF_RANGE
+};
+typedef uint8_t wiced_bt_gatt_status_t;
+
+enum
+{
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT
+};
+typedef uint8_t wiced_bt_gatt_evt_t;
+
+enum
+{
+    GATT_CONN_UNKNOWN                   = 0,
+    GATT_CONN_L2C_FAILURE               = 1,
+    GATT_CONN_TIMEOUT                   = 0x08,
+    GATT_CONN_TERMINATE_PEER_USER       = 0x13,
+    GATT_CONN_TERMINATE_LOCAL_HOST      = 0x16,
+    GATT_CONN_LMP_TIMEOUT               = 0x22,
+    GATT_CONN_FAIL_ESTABLISH            = 0x3e,
+    GATT_CONN_CANCEL                    = 0x0100
+};
+typedef uint16_t wiced_bt_gatt_disconn_reason_t;
+
+enum
+{
+    GATT_REQ_MTU                        = 0x02,
+    GATT_REQ_READ_BY_TYPE               = 0x08,
+    GATT_REQ_READ                       = 0x0A,
+    GATT_REQ_READ_BLOB                  = 0x0C,
+    GATT_REQ_READ_MULTI                 = 0x0E,
+    GATT_REQ_WRITE                      = 0x12,
+    GATT_HANDLE_VALUE_NOTIF             = 0x1B,
+    GATT_HANDLE_VALUE_IND               = 0x1D,
+    GATT_HANDLE_VALUE_CONF              = 0x1E,
+    GATT_REQ_READ_MULTI_VAR             = 0x20,
+    GATT_CMD_WRITE                      = 0x52,
+    GATT_CMD_SIGNED_WRITE               = 0xD2
+};
+typedef uint8_t wiced_bt_gatt_opcode_t;
+
+typedef struct
+{
+    uint16_t    len;
+    union
+    {
+        uint16_t    uuid16;
+        uint32_t    uuid32;
+        uint8_t     uuid128[16];
+    } uu;
+} wiced_bt_uuid_t;
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+} wiced_bt_gatt_read_t;
+
+typedef struct
+{
+    uint16_t        s_handle;
+    uint16_t        e_handle;
+    wiced_bt_uuid_t uuid;
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+    uint16_t    val_len;
+    uint8_t     *p_val;
+} wiced_bt_gatt_write_req_t;
+
+typedef struct
+{
+    uint16_t    num_handles;
+    uint8_t     *p_handle_stream;
+} wiced_bt_gatt_read_multiple_req_t;
+
+typedef struct
+{
+    uint16_t                    conn_id;
+    wiced_bt_gatt_opcode_t      opcode;
+    uint16_t                    len_requested;
+    union
+    {
+        wiced_bt_gatt_read_t                read_req;
+        wiced_bt_gatt_read_by_type_t        read_by_type;
+        wiced_bt_gatt_write_req_t           write_req;
+        uint16_t                            remote_mtu;
+        uint16_t                            confirm_handle;
+        wiced_bt_gatt_read_multiple_req_t   read_multiple_req;
+        uint16_t                            handle;
+    } data;
+} wiced_bt_gatt_attribute_request_t;
+
+typedef struct
+{
+    uint8_t                         *bd_addr;
+    uint16_t                        conn_id;
+    wiced_bool_t                    connected;
+    wiced_bt_gatt_disconn_reason_t  reason;
+    wiced_bt_transport_t            transport;
+    uint8_t                         link_role;
+    wiced_bt_ble_address_type_t     addr_type;
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct
+{
+    uint16_t        conn_id;
+    wiced_bool_t    congested;
+} wiced_bt_gatt_congestion_event_t;
+
+typedef struct
+{
+    uint8_t     *p_app_rsp_buffer;
+    void        *p_app_ctxt;
+} wiced_bt_gatt_buffer_t;
+
+typedef struct
+{
+    uint16_t                len_requested;
+    wiced_bt_gatt_buffer_t  buffer;
+} wiced_bt_gatt_buffer_request_t;
+
+typedef struct
+{
+    uint8_t     *p_app_data;
+    uint16_t    len;
+    void        *p_app_ctxt;
+} wiced_bt_gatt_buffer_transmitted_t;
+
+typedef union
+{
+    wiced_bt_gatt_connection_status_t   connection_status;
+    wiced_bt_gatt_attribute_request_t   attribute_request;
+    wiced_bt_gatt_congestion_event_t    congestion;
+    wiced_bt_gatt_buffer_request_t      buffer_request;
+    wiced_bt_gatt_buffer_transmitted_t  buffer_xmitted;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t (wiced_bt_gatt_cback_t)(wiced_bt_gatt_evt_t event,
+                                                       wiced_bt_gatt_event_data_t *p_event_data);
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback);
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t gatt_db_size, void *hash);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                           uint16_t handle);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                           uint16_t handle, wiced_bt_gatt_status_t status);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t my_mtu);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                 uint16_t len, uint8_t *p_attr_rsp,
+                                                                 void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint8_t type_len, uint16_t data_len,
+                                                                  uint8_t *p_data, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                   uint16_t data_len, uint8_t *p_data,
+                                                                   void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle,
+                                                              uint16_t val_len, uint8_t *p_val, void *p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle,
+                                                            uint16_t val_len, uint8_t *p_val, void *p_app_ctx);
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid);
+int      wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                      uint16_t attr_handle, uint16_t attr_len,
+                                                      const uint8_t *p_attr);
+int      wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream,
+                                                    int stream_len, uint16_t attr_handle, uint16_t attr_len,
+                                                    const uint8_t *p_attr);
+
+#endif /* WICED_BT_GATT_H */
+
+/* [] END OF FILE */
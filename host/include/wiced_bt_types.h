@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   wiced_bt_types.h
+*
+* Description: Host stand-in for the basic types of the Bluetooth stack.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef WICED_BT_TYPES_H
+#define WICED_BT_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef uint32_t    wiced_result_t;
+typedef uint8_t     wiced_bool_t;
+
+#define WICED_TRUE                          (1)
+#define WICED_FALSE                         (0)
+
+#ifndef TRUE
+#define TRUE                                (1)
+#endif
+#ifndef FALSE
+#define FALSE                               (0)
+#endif
+
+#define WICED_SUCCESS                       (0)
+#define WICED_ERROR                         (4)
+
+#define WICED_BT_SUCCESS                    (0)
+#define WICED_BT_PENDING                    (1)
+#define WICED_BT_ERROR                      (2)
+#define WICED_BT_BUSY                       (3)
+#define WICED_BT_NO_RESOURCES               (4)
+#define WICED_BT_UNSUPPORTED                (5)
+#define WICED_BT_BADARG                     (5)
+#define WICED_BT_ILLEGAL_VALUE              (6)
+#define WICED_BT_WRONG_MODE                 (7)
+#define WICED_BT_UNKNOWN_ADDR               (8)
+#define WICED_BT_TIMEOUT                    (9)
+
+#ifndef MIN
+#define MIN(a, b)                           (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b)                           (((a) > (b)) ? (a) : (b))
+#endif
+
+#define BD_ADDR_LEN                         (6)
+typedef uint8_t     wiced_bt_device_address_t[BD_ADDR_LEN];
+typedef uint8_t     *wiced_bt_device_address_ptr_t;
+
+#define BT_OCTET16_LEN                      (16)
+typedef uint8_t     BT_OCTET16[BT_OCTET16_LEN];
+typedef uint8_t     BT_OCTET32[32];
+
+#endif /* WICED_BT_TYPES_H */
+
+/* [] END OF FILE */
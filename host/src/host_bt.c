@@ -0,0 +1,1046 @@
+/******************************************************************************
+* File Name:   host_bt.c
+*
+* Description: This file implements the Bluetooth stack for the host build. It
+*              keeps what the application asked for, answers it as the stack
+*              would, and delivers the events the stack sends by itself.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "wiced_bt_stack.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_memory.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Events the stack sends by itself, waiting for the host to settle */
+#define HOST_BT_PENDING_MAX                 (64u)
+
+/* Devices the controller can hold in a list, and in the filter accept list */
+#define HOST_BT_LIST_MAX                    (16u)
+#define HOST_BT_ACCEPT_LIST_SIZE            (8u)
+
+/* Device address set in design.cybt */
+#define HOST_BT_LOCAL_ADDR                  { 0x00, 0xA0, 0x50, 0x00, 0x00, 0x00 }
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    bool    gatt;
+    uint8_t event;
+    union
+    {
+        wiced_bt_management_evt_data_t  mgmt;
+        wiced_bt_gatt_event_data_t      gatt;
+    } data;
+} host_bt_pending_t;
+
+/* Devices in a list of the controller */
+typedef struct
+{
+    wiced_bt_device_address_t   bd_addr[HOST_BT_LIST_MAX];
+    BT_OCTET16                  irk[HOST_BT_LIST_MAX];  /* Resolving list only */
+    uint32_t                    count;
+    uint32_t                    size;
+} host_bt_addr_list_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static pthread_mutex_t              bt_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static wiced_bt_management_cback_t  *bt_mgmt_cback;
+static wiced_bt_gatt_cback_t        *bt_gatt_cback;
+static host_bt_hook_t               *bt_hook;
+static const uint8_t                *bt_gatt_db;
+static uint16_t                     bt_gatt_db_len;
+
+static host_bt_pending_t            bt_pending[HOST_BT_PENDING_MAX];
+static uint32_t                     bt_pending_head;
+static uint32_t                     bt_pending_count;
+
+static host_bt_addr_list_t          bt_resolving_list;
+static host_bt_addr_list_t          bt_accept_list;
+
+static host_bt_stats_t              bt_stats;
+
+/* Advertising parameters of the application, and the advertising running:
+ * its start in virtual time, its interval in slots and the time and events
+ * of the ones before */
+static const wiced_bt_cfg_ble_advert_settings_t *bt_adv_cfg;
+static uint64_t                     bt_adv_start_us;
+static uint16_t                     bt_adv_interval;
+static uint64_t                     bt_adv_done_us;
+static uint64_t                     bt_adv_done_events;
+
+/* RPA timeout the stack was initialized with, in seconds, and the virtual
+ * time the local RPA is regenerated next. The stack takes the timeout at
+ * wiced_bt_stack_init() only and has no call to change it. */
+static uint16_t                     bt_rpa_timeout;
+static uint64_t                     bt_rpa_next_us;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static void     bt_post                 (const host_bt_pending_t *p_pending);
+static void     bt_post_mgmt            (wiced_bt_management_evt_t event,
+                                         const wiced_bt_management_evt_data_t *p_data);
+static void     bt_post_transmitted     (uint8_t *p_data, uint16_t len, void *p_app_ctx);
+static bool     bt_list_update          (host_bt_addr_list_t *p_list, bool add,
+                                         const wiced_bt_device_address_t bd_addr, const uint8_t *p_irk);
+static void     bt_rpa_hash             (const uint8_t *p_irk, const uint8_t *p_prand, uint8_t *p_hash);
+static void     bt_rpa_count            (uint64_t now_us);
+static void     bt_adv_count            (uint64_t now_us);
+static void     bt_adv_set_mode         (wiced_bt_ble_advert_mode_t mode, uint64_t now_us);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* bt_post
+*
+* Function Description:
+* @brief   This function queues an event the stack sends by itself. Called
+*          with bt_lock held.
+*
+* @param   p_pending: Event
+*
+* @return  None
+*/
+static void bt_post(const host_bt_pending_t *p_pending)
+{
+    if (HOST_BT_PENDING_MAX <= bt_pending_count)
+    {
+        fprintf(stderr, "host: stack event %u lost, the host does not settle\n", p_pending->event);
+        return;
+    }
+    bt_pending[(bt_pending_head + bt_pending_count++) % HOST_BT_PENDING_MAX] = *p_pending;
+}
+
+/**
+* Function Name:
+* bt_post_mgmt
+*
+* Function Description:
+* @brief   This function queues a management event. Called with bt_lock held.
+*
+* @param   event: Management event
+* @param   p_data: Event data, or NULL
+*
+* @return  None
+*/
+static void bt_post_mgmt(wiced_bt_management_evt_t event, const wiced_bt_management_evt_data_t *p_data)
+{
+    host_bt_pending_t pending;
+
+    memset(&pending, 0, sizeof(pending));
+    pending.gatt = false;
+    pending.event = event;
+    if (NULL != p_data)
+    {
+        pending.data.mgmt = *p_data;
+    }
+    bt_post(&pending);
+}
+
+/**
+* Function Name:
+* bt_post_transmitted
+*
+* Function Description:
+* @brief   This function queues the GATT_APP_BUFFER_TRANSMITTED_EVT giving a
+*          buffer of the application back, once sent. Called with bt_lock held.
+*
+* @param   p_data: Buffer sent
+* @param   len: Length sent
+* @param   p_app_ctx: Context given with the buffer, NULL if none is needed
+*
+* @return  None
+*/
+static void bt_post_transmitted(uint8_t *p_data, uint16_t len, void *p_app_ctx)
+{
+    host_bt_pending_t pending;
+
+    if (NULL == p_app_ctx)
+    {
+        return;
+    }
+    memset(&pending, 0, sizeof(pending));
+    pending.gatt = true;
+    pending.event = GATT_APP_BUFFER_TRANSMITTED_EVT;
+    pending.data.gatt.buffer_xmitted.p_app_data = p_data;
+    pending.data.gatt.buffer_xmitted.len = len;
+    pending.data.gatt.buffer_xmitted.p_app_ctxt = p_app_ctx;
+    bt_post(&pending);
+}
+
+/**
+* Function Name:
+* bt_list_update
+*
+* Function Description:
+* @brief   This function adds a device to a list of the controller, or
+*          removes it. Adding a device already in the list succeeds. Called
+*          with bt_lock held.
+*
+* @param   p_list: List
+* @param   add: true to add the device
+* @param   bd_addr: Address of the device
+* @param   p_irk: IRK of the device added to the resolving list, or NULL
+*
+* @return  bool: false if the list is full or the device is not in it
+*/
+static bool bt_list_update(host_bt_addr_list_t *p_list, bool add, const wiced_bt_device_address_t bd_addr,
+                           const uint8_t *p_irk)
+{
+    uint32_t i;
+
+    for (i = 0; i < p_list->count; i++)
+    {
+        if (0 == memcmp(p_list->bd_addr[i], bd_addr, BD_ADDR_LEN))
+        {
+            break;
+        }
+    }
+    if ((i == p_list->count) && (!add || (p_list->size <= p_list->count)))
+    {
+        return false;
+    }
+    if (!add)
+    {
+        p_list->count--;
+        memcpy(p_list->bd_addr[i], p_list->bd_addr[p_list->count], BD_ADDR_LEN);
+        memcpy(p_list->irk[i], p_list->irk[p_list->count], sizeof(BT_OCTET16));
+        return true;
+    }
+    if (i == p_list->count)
+    {
+        memcpy(p_list->bd_addr[p_list->count++], bd_addr, BD_ADDR_LEN);
+    }
+    if (NULL != p_irk)
+    {
+        memcpy(p_list->irk[i], p_irk, sizeof(BT_OCTET16));
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* bt_rpa_hash
+*
+* Function Description:
+* @brief   This function computes the hash of a resolvable private address
+*          from an IRK and the random part. It has the shape of the ah()
+*          function of the specification, 24 bits keyed by the IRK, but it
+*          is not AES-128: the host build only needs a central and the
+*          stand-in to agree.
+*
+* @param   p_irk: IRK, 16 bytes
+* @param   p_prand: Random part, 3 bytes
+* @param   p_hash: Hash, 3 bytes
+*
+* @return  None
+*/
+static void bt_rpa_hash(const uint8_t *p_irk, const uint8_t *p_prand, uint8_t *p_hash)
+{
+    uint32_t h = 0x811C9DC5u ^ ((uint32_t)p_prand[0] << 16) ^ ((uint32_t)p_prand[1] << 8) ^ p_prand[2];
+
+    for (uint32_t i = 0; i < sizeof(BT_OCTET16); i++)
+    {
+        h = (h ^ p_irk[i]) * 0x01000193u;
+        h ^= h >> 13;
+    }
+    p_hash[0] = (uint8_t)(h >> 16);
+    p_hash[1] = (uint8_t)(h >> 8);
+    p_hash[2] = (uint8_t)h;
+}
+
+/**
+* Function Name:
+* bt_rpa_count
+*
+* Function Description:
+* @brief   This function counts the rotations of the local RPA up to now in
+*          the statistics. Called with bt_lock held.
+*
+* @param   now_us: Virtual time
+*
+* @return  None
+*/
+static void bt_rpa_count(uint64_t now_us)
+{
+    if (0 == bt_rpa_timeout)
+    {
+        return;
+    }
+    while (now_us >= bt_rpa_next_us)
+    {
+        bt_stats.rpa_rotations++;
+        bt_rpa_next_us += (uint64_t)bt_rpa_timeout * 1000000u;
+    }
+}
+
+/**
+* Function Name:
+* bt_adv_count
+*
+* Function Description:
+* @brief   This function counts the advertising time and events up to now in
+*          the statistics: an event when advertising starts, then one every
+*          interval. Called with bt_lock held.
+*
+* @param   now_us: Virtual time
+*
+* @return  None
+*/
+static void bt_adv_count(uint64_t now_us)
+{
+    bt_stats.adv_on_us = bt_adv_done_us;
+    bt_stats.adv_events = bt_adv_done_events;
+    if (BTM_BLE_ADVERT_OFF != bt_stats.adv_mode)
+    {
+        bt_stats.adv_on_us += now_us - bt_adv_start_us;
+        bt_stats.adv_events += 1u + ((0 < bt_adv_interval) ?
+                                     ((now_us - bt_adv_start_us) / (bt_adv_interval * 625u)) : 0u);
+    }
+}
+
+/**
+* Function Name:
+* bt_adv_set_mode
+*
+* Function Description:
+* @brief   This function changes the advertising mode, with the interval the
+*          application set for it, and reports the change. Called with
+*          bt_lock held.
+*
+* @param   mode: Advertising mode
+* @param   now_us: Virtual time
+*
+* @return  None
+*/
+static void bt_adv_set_mode(wiced_bt_ble_advert_mode_t mode, uint64_t now_us)
+{
+    wiced_bt_management_evt_data_t data;
+
+    bt_adv_count(now_us);
+    bt_adv_done_us = bt_stats.adv_on_us;
+    bt_adv_done_events = bt_stats.adv_events;
+    bt_adv_start_us = now_us;
+    bt_adv_interval = 0;
+    if (NULL != bt_adv_cfg)
+    {
+        switch (mode)
+        {
+            case BTM_BLE_ADVERT_DIRECTED_HIGH:
+                bt_adv_interval = bt_adv_cfg->high_duty_directed_min_interval;
+                break;
+            case BTM_BLE_ADVERT_DIRECTED_LOW:
+                bt_adv_interval = bt_adv_cfg->low_duty_directed_min_interval;
+                break;
+            case BTM_BLE_ADVERT_UNDIRECTED_HIGH:
+            case BTM_BLE_ADVERT_DISCOVERABLE_HIGH:
+                bt_adv_interval = bt_adv_cfg->high_duty_min_interval;
+                break;
+            case BTM_BLE_ADVERT_NONCONN_HIGH:
+                bt_adv_interval = bt_adv_cfg->high_duty_nonconn_min_interval;
+                break;
+            case BTM_BLE_ADVERT_NONCONN_LOW:
+                bt_adv_interval = bt_adv_cfg->low_duty_nonconn_min_interval;
+                break;
+            default:
+                bt_adv_interval = bt_adv_cfg->low_duty_min_interval;
+                break;
+        }
+    }
+
+    bt_stats.adv_mode = mode;
+    bt_stats.adv_starts++;
+    memset(&data, 0, sizeof(data));
+    data.ble_advert_state_changed = mode;
+    bt_post_mgmt(BTM_BLE_ADVERT_STATE_CHANGED_EVT, &data);
+}
+
+/**
+* Function Name:
+* host_bt_make_rpa
+*
+* Function Description:
+* @brief   This function makes the resolvable private address a central with
+*          the IRK would use.
+*
+* @param   p_irk: IRK, 16 bytes
+* @param   prand: Random part, the two top bits are set as an RPA
+* @param   rpa: Address
+*
+* @return  None
+*/
+void host_bt_make_rpa(const uint8_t *p_irk, uint32_t prand, wiced_bt_device_address_t rpa)
+{
+    rpa[0] = (uint8_t)(((prand >> 16) & 0x3Fu) | 0x40u);
+    rpa[1] = (uint8_t)(prand >> 8);
+    rpa[2] = (uint8_t)prand;
+    bt_rpa_hash(p_irk, rpa, &rpa[3]);
+}
+
+/**
+* Function Name:
+* host_bt_resolve_rpa
+*
+* Function Description:
+* @brief   This function resolves an address with the IRKs of the resolving
+*          list, as the controller does before reporting a connection.
+*
+* @param   bd_addr: Address the central used
+* @param   identity: Identity address of the central, if resolved
+*
+* @return  bool: true if the address was resolved
+*/
+bool host_bt_resolve_rpa(const wiced_bt_device_address_t bd_addr, wiced_bt_device_address_t identity)
+{
+    bool resolved = false;
+    uint8_t hash[3];
+
+    if (0x40u != (bd_addr[0] & 0xC0u))
+    {
+        return false;
+    }
+    pthread_mutex_lock(&bt_lock);
+    for (uint32_t i = 0; !resolved && (i < bt_resolving_list.count); i++)
+    {
+        bt_rpa_hash(bt_resolving_list.irk[i], bd_addr, hash);
+        if (0 == memcmp(hash, &bd_addr[3], sizeof(hash)))
+        {
+            memcpy(identity, bt_resolving_list.bd_addr[i], BD_ADDR_LEN);
+            resolved = true;
+        }
+    }
+    pthread_mutex_unlock(&bt_lock);
+    return resolved;
+}
+
+/**
+* Function Name:
+* host_bt_run_pending
+*
+* Function Description:
+* @brief   This function delivers the events the stack sent by itself, in the
+*          caller. When the application has no local identity keys the stack
+*          generates them and sends them to be saved.
+*
+* @param   None
+*
+* @return  bool: true if any event was delivered
+*/
+bool host_bt_run_pending(void)
+{
+    host_bt_pending_t pending;
+    bool delivered = false;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&bt_lock);
+        if (0 == bt_pending_count)
+        {
+            pthread_mutex_unlock(&bt_lock);
+            break;
+        }
+        pending = bt_pending[bt_pending_head];
+        bt_pending_head = (bt_pending_head + 1) % HOST_BT_PENDING_MAX;
+        bt_pending_count--;
+        pthread_mutex_unlock(&bt_lock);
+
+        delivered = true;
+        if (pending.gatt)
+        {
+            (void)host_bt_gatt_event(pending.event, &pending.data.gatt);
+        }
+        else if (WICED_BT_SUCCESS != host_bt_management_event(pending.event, &pending.data.mgmt) &&
+                 (BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT == pending.event))
+        {
+            wiced_bt_management_evt_data_t keys;
+
+            for (uint32_t i = 0; i < sizeof(keys.local_identity_keys_update.local_key_data); i++)
+            {
+                keys.local_identity_keys_update.local_key_data[i] = (uint8_t)(0x5A ^ (i * 29u));
+            }
+            (void)host_bt_management_event(BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT, &keys);
+        }
+    }
+    return delivered;
+}
+
+/**
+* Function Name:
+* host_bt_management_event
+*
+* Function Description:
+* @brief   This function sends a management event to the application.
+*
+* @param   event: Management event
+* @param   p_event_data: Event data, updated by the application as for the
+*          stack
+*
+* @return  wiced_result_t: Result of the application
+*/
+wiced_result_t host_bt_management_event(wiced_bt_management_evt_t event,
+                                        wiced_bt_management_evt_data_t *p_event_data)
+{
+    wiced_result_t result;
+
+    if (NULL == bt_mgmt_cback)
+    {
+        return WICED_BT_WRONG_MODE;
+    }
+    if (NULL != bt_hook)
+    {
+        bt_hook(false, event, p_event_data, false);
+    }
+    result = bt_mgmt_cback(event, p_event_data);
+    if (NULL != bt_hook)
+    {
+        bt_hook(false, event, p_event_data, true);
+    }
+    return result;
+}
+
+/**
+* Function Name:
+* host_bt_gatt_event
+*
+* Function Description:
+* @brief   This function sends a GATT event to the application.
+*
+* @param   event: GATT event
+* @param   p_event_data: Event data
+*
+* @return  wiced_bt_gatt_status_t: Status of the application
+*/
+wiced_bt_gatt_status_t host_bt_gatt_event(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data)
+{
+    wiced_bt_gatt_status_t status;
+    uint64_t now_us = host_clock_us();
+
+    if (NULL == bt_gatt_cback)
+    {
+        return WICED_BT_GATT_WRONG_STATE;
+    }
+
+    /* The controller stops advertising once connected, and the stack reports it */
+    pthread_mutex_lock(&bt_lock);
+    if ((GATT_CONNECTION_STATUS_EVT == event) && p_event_data->connection_status.connected &&
+        (BTM_BLE_ADVERT_OFF != bt_stats.adv_mode))
+    {
+        bt_adv_set_mode(BTM_BLE_ADVERT_OFF, now_us);
+    }
+    pthread_mutex_unlock(&bt_lock);
+
+    if (NULL != bt_hook)
+    {
+        bt_hook(true, event, p_event_data, false);
+    }
+    status = bt_gatt_cback(event, p_event_data);
+    if (NULL != bt_hook)
+    {
+        bt_hook(true, event, p_event_data, true);
+    }
+    return status;
+}
+
+/**
+* Function Name:
+* host_bt_set_hook
+*
+* Function Description:
+* @brief   This function sets the function called around every event
+*          delivered to the application, to measure it. Set it before
+*          app_main().
+*
+* @param   p_hook: Function, NULL for none
+*
+* @return  None
+*/
+void host_bt_set_hook(host_bt_hook_t *p_hook)
+{
+    bt_hook = p_hook;
+}
+
+/**
+* Function Name:
+* host_bt_get_stats
+*
+* Function Description:
+* @brief   This function returns what the application asked from the stack.
+*
+* @param   None
+*
+* @return  const host_bt_stats_t *: Statistics
+*/
+const host_bt_stats_t *host_bt_get_stats(void)
+{
+    uint64_t now_us = host_clock_us();
+
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.resolving_list_size = bt_resolving_list.count;
+    bt_stats.accept_list_size = bt_accept_list.count;
+    bt_adv_count(now_us);
+    bt_rpa_count(now_us);
+    pthread_mutex_unlock(&bt_lock);
+    return &bt_stats;
+}
+
+/* The API of the stack. The stack starts by asking for the local keys, then
+ * reports it is enabled. */
+wiced_result_t wiced_bt_stack_init(wiced_bt_management_cback_t *p_bt_management_cback,
+                                   const wiced_bt_cfg_settings_t *p_bt_cfg_settings)
+{
+    wiced_bt_management_evt_data_t data;
+
+    pthread_mutex_lock(&bt_lock);
+    bt_mgmt_cback = p_bt_management_cback;
+    bt_adv_cfg = p_bt_cfg_settings->p_ble_cfg->p_ble_advert_cfg;
+    bt_rpa_timeout = p_bt_cfg_settings->p_ble_cfg->rpa_refresh_timeout;
+    bt_rpa_next_us = host_clock_us() + ((uint64_t)bt_rpa_timeout * 1000000u);
+    bt_resolving_list.size = MIN(p_bt_cfg_settings->p_ble_cfg->host_addr_resolution_db_size,
+                                 HOST_BT_LIST_MAX);
+    bt_accept_list.size = HOST_BT_ACCEPT_LIST_SIZE;
+
+    memset(&data, 0, sizeof(data));
+    bt_post_mgmt(BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT, &data);
+    data.enabled.status = WICED_BT_SUCCESS;
+    bt_post_mgmt(BTM_ENABLED_EVT, &data);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr)
+{
+    const wiced_bt_device_address_t local_addr = HOST_BT_LOCAL_ADDR;
+
+    memcpy(bd_addr, local_addr, BD_ADDR_LEN);
+    return WICED_BT_SUCCESS;
+}
+
+void wiced_bt_dev_confirm_req_reply(wiced_result_t res_code, wiced_bt_device_address_t bd_addr)
+{
+    (void)res_code;
+    (void)bd_addr;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.confirm_replies++;
+    pthread_mutex_unlock(&bt_lock);
+}
+
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr, uint8_t res)
+{
+    (void)bd_addr;
+    (void)res;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.security_grants++;
+    pthread_mutex_unlock(&bt_lock);
+}
+
+wiced_bool_t wiced_bt_set_pairable_mode(uint8_t allow_pairing, uint8_t connect_only_paired)
+{
+    (void)allow_pairing;
+    (void)connect_only_paired;
+    return WICED_TRUE;
+}
+
+wiced_result_t wiced_bt_dev_delete_bonded_device(wiced_bt_device_address_t bd_addr)
+{
+    (void)bd_addr;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.bond_deletes++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_dev_add_device_to_address_resolution_db(wiced_bt_device_link_keys_t *p_link_keys)
+{
+    bool added;
+
+    pthread_mutex_lock(&bt_lock);
+    added = bt_list_update(&bt_resolving_list, true, p_link_keys->bd_addr, p_link_keys->key_data.irk);
+    pthread_mutex_unlock(&bt_lock);
+    return added ? WICED_BT_SUCCESS : WICED_BT_NO_RESOURCES;
+}
+
+wiced_result_t wiced_bt_dev_remove_device_from_address_resolution_db(wiced_bt_device_link_keys_t *p_link_keys)
+{
+    bool removed;
+
+    pthread_mutex_lock(&bt_lock);
+    removed = bt_list_update(&bt_resolving_list, false, p_link_keys->bd_addr, NULL);
+    pthread_mutex_unlock(&bt_lock);
+    return removed ? WICED_BT_SUCCESS : WICED_BT_UNKNOWN_ADDR;
+}
+
+wiced_result_t wiced_bt_ble_address_resolution_list_clear_and_disable(void)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_resolving_list.count = 0;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_ble_set_privacy_mode(wiced_bt_device_address_t remote_bda,
+                                             wiced_bt_ble_address_type_t rem_bda_type,
+                                             wiced_bt_ble_privacy_mode_t privacy_mode)
+{
+    wiced_result_t result = WICED_BT_UNKNOWN_ADDR;
+
+    (void)rem_bda_type;
+    (void)privacy_mode;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.privacy_mode_sets++;
+    /* The controller only knows the privacy mode of a device it can resolve */
+    for (uint32_t i = 0; i < bt_resolving_list.count; i++)
+    {
+        if (0 == memcmp(bt_resolving_list.bd_addr[i], remote_bda, BD_ADDR_LEN))
+        {
+            result = WICED_BT_SUCCESS;
+        }
+    }
+    pthread_mutex_unlock(&bt_lock);
+    return result;
+}
+
+/* Starting a mode reports it, as does the stack once the controller runs it */
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             wiced_bt_ble_address_type_t directed_advertisement_bdaddr_type,
+                                             wiced_bt_device_address_ptr_t directed_advertisement_bdaddr_ptr)
+{
+    uint64_t now_us = host_clock_us();
+
+    (void)directed_advertisement_bdaddr_type;
+    (void)directed_advertisement_bdaddr_ptr;
+    pthread_mutex_lock(&bt_lock);
+    if (advert_mode != bt_stats.adv_mode)
+    {
+        bt_adv_set_mode(advert_mode, now_us);
+    }
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bt_ble_advert_mode_t wiced_bt_ble_get_current_advert_mode(void)
+{
+    wiced_bt_ble_advert_mode_t mode;
+
+    pthread_mutex_lock(&bt_lock);
+    mode = bt_stats.adv_mode;
+    pthread_mutex_unlock(&bt_lock);
+    return mode;
+}
+
+wiced_result_t wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_data)
+{
+    (void)num_elem;
+    (void)p_data;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.adv_data_sets++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_ble_set_raw_scan_response_data(uint8_t num_elem, wiced_bt_ble_advert_elem_t *p_data)
+{
+    return wiced_bt_ble_set_raw_advertisement_data(num_elem, p_data);
+}
+
+wiced_result_t wiced_bt_ble_update_advertising_filter_accept_list(wiced_bool_t add,
+                                                                  wiced_bt_ble_address_type_t addr_type,
+                                                                  wiced_bt_device_address_t remote_bda)
+{
+    bool updated;
+
+    (void)addr_type;
+    pthread_mutex_lock(&bt_lock);
+    updated = bt_list_update(&bt_accept_list, add, remote_bda, NULL);
+    pthread_mutex_unlock(&bt_lock);
+    return updated ? WICED_BT_SUCCESS : WICED_BT_NO_RESOURCES;
+}
+
+wiced_bool_t wiced_bt_ble_clear_filter_accept_list(void)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_accept_list.count = 0;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_TRUE;
+}
+
+wiced_result_t wiced_bt_ble_set_ext_adv_parameters(wiced_bt_ble_ext_adv_handle_t adv_handle,
+                                                   wiced_bt_ble_ext_adv_event_property_t event_properties,
+                                                   wiced_bt_ble_ext_adv_interval_t primary_adv_int_min,
+                                                   wiced_bt_ble_ext_adv_interval_t primary_adv_int_max,
+                                                   uint8_t primary_adv_channel_map,
+                                                   wiced_bt_ble_address_type_t own_addr_type,
+                                                   wiced_bt_ble_address_type_t peer_addr_type,
+                                                   wiced_bt_device_address_t peer_addr,
+                                                   wiced_bt_ble_advert_filter_policy_t adv_filter_policy,
+                                                   int8_t adv_tx_power,
+                                                   wiced_bt_ble_ext_adv_phy_t primary_adv_phy,
+                                                   uint8_t secondary_adv_max_skip,
+                                                   wiced_bt_ble_ext_adv_phy_t secondary_adv_phy,
+                                                   wiced_bt_ble_ext_adv_sid_t adv_sid,
+                                                   wiced_bt_ble_ext_adv_scan_req_notification_setting_t scan_request_not)
+{
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_ble_set_ext_adv_data(wiced_bt_ble_ext_adv_handle_t adv_handle, uint16_t data_len,
+                                             uint8_t *p_data)
+{
+    return wiced_bt_ble_set_raw_advertisement_data(0, NULL);
+}
+
+wiced_result_t wiced_bt_ble_set_ext_scan_rsp_data(wiced_bt_ble_ext_adv_handle_t adv_handle, uint16_t data_len,
+                                                  uint8_t *p_data)
+{
+    return wiced_bt_ble_set_raw_advertisement_data(0, NULL);
+}
+
+wiced_result_t wiced_bt_ble_start_ext_adv(uint8_t enable, uint8_t number_of_sets,
+                                          wiced_bt_ble_ext_adv_duration_config_t *p_set_adv_duration_config)
+{
+    (void)enable;
+    (void)number_of_sets;
+    (void)p_set_adv_duration_config;
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.ext_adv_starts++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa, uint16_t min_int,
+                                                   uint16_t max_int, uint16_t latency, uint16_t timeout)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.conn_param_updates++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_TRUE;
+}
+
+wiced_result_t wiced_bt_get_buffer_usage(wiced_bt_buffer_statistics_t *p_buffer_stats, uint16_t size)
+{
+    memset(p_buffer_stats, 0, size);
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback)
+{
+    bt_gatt_cback = p_gatt_cback;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t gatt_db_size, void *hash)
+{
+    (void)hash;
+    bt_gatt_db = p_gatt_db;
+    bt_gatt_db_len = gatt_db_size;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/* Searches the database for an attribute of the type, see the layout in
+ * wiced_bt_gatt.h */
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid)
+{
+    uint16_t offset = 0;
+
+    while ((NULL != bt_gatt_db) && ((offset + 4u) <= bt_gatt_db_len))
+    {
+        const uint8_t *p_attr = &bt_gatt_db[offset];
+        uint16_t handle = (uint16_t)(p_attr[0] | (p_attr[1] << 8));
+        uint8_t uuid_len = (0 != (p_attr[2] & LEGATTDB_PERM_SERVICE_UUID_128)) ? 16 : 2;
+        bool match;
+
+        if ((s_handle <= handle) && (handle <= e_handle) && (uuid_len == p_uuid->len))
+        {
+            match = (2 == uuid_len) ? (p_uuid->uu.uuid16 == (uint16_t)(p_attr[4] | (p_attr[5] << 8))) :
+                                      (0 == memcmp(p_uuid->uu.uuid128, &p_attr[4], 16));
+            if (match)
+            {
+                return handle;
+            }
+        }
+        offset += 4u + p_attr[3];
+    }
+    return 0;
+}
+
+/* Adds a handle-value pair, the first pair sets the length of all */
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                 uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr)
+{
+    int pair_len = attr_len + 2;
+
+    if (0 == *p_pair_len)
+    {
+        pair_len = MIN(MIN(pair_len, stream_len), 255);
+        *p_pair_len = (uint8_t)pair_len;
+    }
+    else if (pair_len != *p_pair_len)
+    {
+        return 0;
+    }
+    if ((pair_len < 2) || (stream_len < pair_len))
+    {
+        return 0;
+    }
+    p_stream[0] = (uint8_t)(attr_handle & 0xFF);
+    p_stream[1] = (uint8_t)(attr_handle >> 8);
+    memcpy(&p_stream[2], p_attr, pair_len - 2);
+    return pair_len;
+}
+
+/* Adds a value, with its length for the variable length request */
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream, int stream_len,
+                                               uint16_t attr_handle, uint16_t attr_len, const uint8_t *p_attr)
+{
+    int header = (GATT_REQ_READ_MULTI_VAR == opcode) ? 2 : 0;
+    int len = MIN(attr_len, stream_len - header);
+
+    (void)attr_handle;
+    if (len < 0)
+    {
+        return 0;
+    }
+    if (0 != header)
+    {
+        p_stream[0] = (uint8_t)(attr_len & 0xFF);
+        p_stream[1] = (uint8_t)(attr_len >> 8);
+    }
+    memcpy(&p_stream[header], p_attr, len);
+    return header + len;
+}
+
+/* The responses are counted, a buffer with a context is given back once sent */
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                          uint16_t handle)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.write_rsps++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                          uint16_t handle, wiced_bt_gatt_status_t status)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.error_rsps++;
+    bt_stats.last_error = status;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t my_mtu)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.mtu_rsps++;
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                uint16_t len, uint8_t *p_attr_rsp, void *p_app_ctx)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.read_rsps++;
+    bt_post_transmitted(p_attr_rsp, len, p_app_ctx);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                 uint8_t type_len, uint16_t data_len,
+                                                                 uint8_t *p_data, void *p_app_ctx)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.read_rsps++;
+    bt_post_transmitted(p_data, data_len, p_app_ctx);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint16_t data_len, uint8_t *p_data,
+                                                                  void *p_app_ctx)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.read_rsps++;
+    bt_post_transmitted(p_data, data_len, p_app_ctx);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(uint16_t conn_id, uint16_t attr_handle,
+                                                             uint16_t val_len, uint8_t *p_val, void *p_app_ctx)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.notifications++;
+    bt_stats.last_notification_len = val_len;
+    memcpy(bt_stats.last_notification, p_val, MIN(val_len, sizeof(bt_stats.last_notification)));
+    bt_post_transmitted(p_val, val_len, p_app_ctx);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(uint16_t conn_id, uint16_t attr_handle,
+                                                           uint16_t val_len, uint8_t *p_val, void *p_app_ctx)
+{
+    pthread_mutex_lock(&bt_lock);
+    bt_stats.indications++;
+    bt_post_transmitted(p_val, val_len, p_app_ctx);
+    pthread_mutex_unlock(&bt_lock);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,391 @@
+/******************************************************************************
+* File Name:   host_hal.c
+*
+* Description: This file implements the hardware abstraction layer, the board
+*              support package and retarget-io for the host build. The debug UART
+*              is the standard input and output of the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "cyhal.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Bytes received on the UART and not read yet */
+#define HOST_UART_RX_FIFO_SIZE              (4096u)
+
+#define HOST_GPIO_MAX                       (8)
+
+/* Clock of the low-power timer */
+#define HOST_LPTIMER_HZ                     (32768u)
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+cyhal_uart_t                        cy_retarget_io_uart_obj;
+
+static bool                         gpio_level[HOST_GPIO_MAX];
+static cyhal_gpio_callback_data_t   *gpio_callback[HOST_GPIO_MAX];
+static cyhal_gpio_event_t           gpio_events[HOST_GPIO_MAX];
+
+static cyhal_uart_event_callback_t  uart_callback;
+static void                         *uart_callback_arg;
+static cyhal_uart_event_t           uart_events;
+static uint8_t                      uart_rx_fifo[HOST_UART_RX_FIFO_SIZE];
+static uint32_t                     uart_rx_head;
+static uint32_t                     uart_rx_tail;
+
+static cyhal_pwm_t                  *led_pwm;
+
+static cyhal_syspm_callback_data_t  *syspm_callbacks;
+static uint32_t                     syspm_deepsleep_locks;
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* cybsp_init
+*
+* Function Description:
+* @brief   This function initializes the board, the button is released.
+*
+* @param   None
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cybsp_init(void)
+{
+    gpio_level[CYBSP_USER_BTN] = CYBSP_BTN_OFF;
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_retarget_io_init
+*
+* Function Description:
+* @brief   This function initializes retarget-io, printf already writes to the
+*          standard output.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx, uint32_t baudrate)
+{
+    (void)tx;
+    (void)rx;
+    (void)baudrate;
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* host_button_set
+*
+* Function Description:
+* @brief   This function presses or releases the user button, running the
+*          callback of the application as an interrupt if its edge is enabled.
+*
+* @param   pressed: true to press the button
+*
+* @return  None
+*/
+void host_button_set(bool pressed)
+{
+    bool level = pressed ? CYBSP_BTN_PRESSED : CYBSP_BTN_OFF;
+    cyhal_gpio_event_t edge = level ? CYHAL_GPIO_IRQ_RISE : CYHAL_GPIO_IRQ_FALL;
+
+    host_irq_enter();
+    if (level != gpio_level[CYBSP_USER_BTN])
+    {
+        gpio_level[CYBSP_USER_BTN] = level;
+        if ((NULL != gpio_callback[CYBSP_USER_BTN]) && (0 != (gpio_events[CYBSP_USER_BTN] & edge)))
+        {
+            gpio_callback[CYBSP_USER_BTN]->callback(gpio_callback[CYBSP_USER_BTN]->callback_arg, edge);
+        }
+    }
+    host_irq_exit();
+}
+
+/**
+* Function Name:
+* host_uart_rx
+*
+* Function Description:
+* @brief   This function receives bytes on the debug UART, running the
+*          callback of the application as an interrupt. Bytes that do not fit
+*          in the FIFO are lost.
+*
+* @param   p_data: Bytes received
+* @param   len: Number of bytes
+*
+* @return  None
+*/
+void host_uart_rx(const uint8_t *p_data, uint32_t len)
+{
+    host_irq_enter();
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if ((uart_rx_head - uart_rx_tail) < HOST_UART_RX_FIFO_SIZE)
+        {
+            uart_rx_fifo[uart_rx_head++ % HOST_UART_RX_FIFO_SIZE] = p_data[i];
+        }
+    }
+    if ((NULL != uart_callback) && (0 != (uart_events & CYHAL_UART_IRQ_RX_NOT_EMPTY)) &&
+        (uart_rx_head != uart_rx_tail))
+    {
+        uart_callback(uart_callback_arg, CYHAL_UART_IRQ_RX_NOT_EMPTY);
+    }
+    host_irq_exit();
+}
+
+/**
+* Function Name:
+* host_led_duty_cycle
+*
+* Function Description:
+* @brief   This function returns the PWM settings of the user LED.
+*
+* @param   p_frequency_hz: Frequency, or NULL
+*
+* @return  float: Duty cycle in percent, 100 if the PWM is not running
+*/
+float host_led_duty_cycle(uint32_t *p_frequency_hz)
+{
+    bool running = (NULL != led_pwm) && led_pwm->running;
+
+    if (NULL != p_frequency_hz)
+    {
+        *p_frequency_hz = running ? led_pwm->frequency_hz : 0;
+    }
+    return running ? led_pwm->duty_cycle : 100.0f;
+}
+
+/* The API of the HAL, see cyhal.h */
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    (void)direction;
+    (void)drive_mode;
+    if ((pin < 0) || (HOST_GPIO_MAX <= pin))
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+    /* An input keeps the level driven by the host */
+    if (CYHAL_GPIO_DIR_INPUT != direction)
+    {
+        gpio_level[pin] = init_val;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_callback_data_t *callback_data)
+{
+    host_irq_enter();
+    gpio_callback[pin] = callback_data;
+    host_irq_exit();
+}
+
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event, uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    host_irq_enter();
+    gpio_events[pin] = enable ? (cyhal_gpio_event_t)(gpio_events[pin] | event) :
+                                (cyhal_gpio_event_t)(gpio_events[pin] & ~event);
+    host_irq_exit();
+}
+
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    return gpio_level[pin];
+}
+
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    gpio_level[pin] = value;
+}
+
+cy_rslt_t cyhal_pwm_init(cyhal_pwm_t *obj, cyhal_gpio_t pin, const cyhal_clock_t *clk)
+{
+    (void)clk;
+    obj->pin = pin;
+    obj->duty_cycle = 100.0f;
+    obj->frequency_hz = 0;
+    obj->running = false;
+    if (CYBSP_USER_LED1 == pin)
+    {
+        led_pwm = obj;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle, uint32_t frequencyhal_hz)
+{
+    if ((duty_cycle < 0.0f) || (duty_cycle > 100.0f) || (0 == frequencyhal_hz))
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+    obj->duty_cycle = duty_cycle;
+    obj->frequency_hz = frequencyhal_hz;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj)
+{
+    obj->running = true;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj)
+{
+    obj->running = false;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_uart_register_callback(cyhal_uart_t *obj, cyhal_uart_event_callback_t callback, void *callback_arg)
+{
+    (void)obj;
+    host_irq_enter();
+    uart_callback = callback;
+    uart_callback_arg = callback_arg;
+    host_irq_exit();
+}
+
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event, uint8_t intr_priority, bool enable)
+{
+    (void)obj;
+    (void)intr_priority;
+    host_irq_enter();
+    uart_events = enable ? (cyhal_uart_event_t)(uart_events | event) :
+                           (cyhal_uart_event_t)(uart_events & ~event);
+    host_irq_exit();
+}
+
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    cy_rslt_t rslt = CY_RSLT_HOST_TIMEOUT;
+
+    (void)obj;
+    (void)timeout;
+    host_irq_enter();
+    if (uart_rx_head != uart_rx_tail)
+    {
+        *value = uart_rx_fifo[uart_rx_tail++ % HOST_UART_RX_FIFO_SIZE];
+        rslt = CY_RSLT_SUCCESS;
+    }
+    host_irq_exit();
+    return rslt;
+}
+
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    uint32_t fill;
+
+    (void)obj;
+    host_irq_enter();
+    fill = uart_rx_head - uart_rx_tail;
+    host_irq_exit();
+    return fill;
+}
+
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value)
+{
+    (void)obj;
+    putchar((int)value);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_uart_write(cyhal_uart_t *obj, void *tx, size_t *tx_length)
+{
+    (void)obj;
+    *tx_length = fwrite(tx, 1, *tx_length, stdout);
+    return CY_RSLT_SUCCESS;
+}
+
+bool cyhal_uart_is_tx_active(cyhal_uart_t *obj)
+{
+    (void)obj;
+    return false;
+}
+
+cy_rslt_t cyhal_lptimer_init(cyhal_lptimer_t *obj)
+{
+    obj->running = true;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_lptimer_get_info(cyhal_lptimer_t *obj, cyhal_lptimer_info_t *info)
+{
+    (void)obj;
+    info->frequency_hz = HOST_LPTIMER_HZ;
+    info->min_set_delay = 3;
+    info->max_counter_value = UINT32_MAX;
+}
+
+/* A free running 32 kHz up counter on the virtual clock, wrapping at 32 bits */
+uint32_t cyhal_lptimer_read(const cyhal_lptimer_t *obj)
+{
+    (void)obj;
+    return (uint32_t)(host_clock_us() * HOST_LPTIMER_HZ / 1000000u);
+}
+
+/* The host never sleeps, the callbacks are only kept */
+void cyhal_syspm_register_callback(cyhal_syspm_callback_data_t *callback_data)
+{
+    callback_data->next = syspm_callbacks;
+    syspm_callbacks = callback_data;
+}
+
+void cyhal_syspm_lock_deepsleep(void)
+{
+    syspm_deepsleep_locks++;
+}
+
+void cyhal_syspm_unlock_deepsleep(void)
+{
+    syspm_deepsleep_locks--;
+}
+
+/* [] END OF FILE */
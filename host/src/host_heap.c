@@ -0,0 +1,124 @@
+/******************************************************************************
+* File Name:   host_heap.c
+*
+* Description: This file counts the heap allocations of the application. The host
+*              make file renames malloc() and free() in the application objects to
+*              the functions below.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <malloc.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "host.h"
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static atomic_uint_fast64_t     heap_allocs;
+static atomic_uint_fast64_t     heap_frees;
+static atomic_uint_fast64_t     heap_bytes;
+static atomic_int_fast64_t      heap_in_use;
+
+/* What the calling thread allocated */
+static __thread host_heap_stats_t heap_thread_stats;
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* host_heap_get_stats
+*
+* Function Description:
+* @brief   This function returns the allocations of the application.
+*
+* @param   p_stats: Statistics
+* @param   this_thread: true for the allocations of the calling thread only,
+*          false for all threads
+*
+* @return  None
+*/
+void host_heap_get_stats(host_heap_stats_t *p_stats, bool this_thread)
+{
+    if (this_thread)
+    {
+        *p_stats = heap_thread_stats;
+        return;
+    }
+    p_stats->allocs = atomic_load(&heap_allocs);
+    p_stats->frees = atomic_load(&heap_frees);
+    p_stats->bytes = atomic_load(&heap_bytes);
+    p_stats->in_use = atomic_load(&heap_in_use);
+}
+
+/* malloc() and free() of the application */
+void *host_malloc(size_t size)
+{
+    void *p_buf = malloc(size);
+
+    if (NULL != p_buf)
+    {
+        size = malloc_usable_size(p_buf);
+        atomic_fetch_add(&heap_allocs, 1);
+        atomic_fetch_add(&heap_bytes, size);
+        atomic_fetch_add(&heap_in_use, (int_fast64_t)size);
+        heap_thread_stats.allocs++;
+        heap_thread_stats.bytes += size;
+        heap_thread_stats.in_use += (int64_t)size;
+    }
+    return p_buf;
+}
+
+void host_free(void *p_buf)
+{
+    if (NULL != p_buf)
+    {
+        size_t size = malloc_usable_size(p_buf);
+
+        atomic_fetch_add(&heap_frees, 1);
+        atomic_fetch_sub(&heap_in_use, (int_fast64_t)size);
+        heap_thread_stats.frees++;
+        heap_thread_stats.in_use -= (int64_t)size;
+    }
+    free(p_buf);
+}
+
+/* [] END OF FILE */
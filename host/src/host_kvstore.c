@@ -0,0 +1,941 @@
+/******************************************************************************
+* File Name:   host_kvstore.c
+*
+* Description: This file implements the kv-store for the host build on a model
+*              of its flash: records are appended to one of two areas of erase
+*              sectors, and the live ones are copied to the other area when it is
+*              full. The program and erase work is counted per operation. If a
+*              file is set, the flash image and the erase count of every sector
+*              are saved to it on every change, so they survive a restart.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mtb_kvstore_cat5.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define HOST_KVSTORE_MAX_KEYS               (64u)
+
+/* Start of the file, followed by the geometry: sector size (4), sectors (4),
+ * program size (4), then the erase count of every sector (4 each) and the
+ * flash image */
+#define HOST_KVSTORE_FILE_MAGIC             "HOSTKV02"
+
+/* Value of erased flash */
+#define KV_ERASED                           (0xFFu)
+
+#define KV_AREA_MAGIC                       (0x4B564152u)
+#define KV_RECORD_MAGIC                     (0x4B56u)
+
+/* Record flags. A deleted key is a record without a value. */
+#define KV_RECORD_DELETED                   (0x01u)
+
+/* Flash of the kit: 4 KB sectors, 256 byte pages, with the typical times of a
+ * serial NOR flash */
+#define KV_DEFAULT_CFG                      { .sector_size = 4096u, .sectors = 8u, \
+                                              .program_size = 256u, .program_us = 400u, \
+                                              .erase_us = 45000u, .endurance = 100000u }
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Start of an area. The area with the highest generation is the current one. */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    generation;
+} kv_area_t;
+
+/* Start of a record, followed by the value and padded to the program size */
+typedef struct
+{
+    uint16_t    magic;
+    uint16_t    key;
+    uint32_t    size;
+    uint8_t     flags;
+    uint8_t     reserved[7];
+} kv_record_t;
+
+/* Live key, its value is read from the flash */
+typedef struct
+{
+    uint16_t    key;
+    uint32_t    size;
+    uint32_t    offset;                             /* Of the value in the flash */
+} host_kv_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static pthread_mutex_t      kv_lock = PTHREAD_MUTEX_INITIALIZER;
+static host_kv_t            kv_keys[HOST_KVSTORE_MAX_KEYS];
+static uint32_t             kv_count;
+static const char           *kv_file;
+static bool                 kv_loaded;
+static host_kvstore_stats_t kv_stats;
+
+/* Accesses of the calling thread */
+static __thread host_kvstore_stats_t kv_thread_stats;
+
+/* Flash image, current area, its generation and the offset of its free space */
+static host_flash_cfg_t     kv_cfg = KV_DEFAULT_CFG;
+static host_flash_stats_t   kv_flash_stats;
+static uint8_t              *kv_flash;
+static uint32_t             kv_area;
+static uint32_t             kv_generation;
+static uint32_t             kv_free;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static host_kv_t    *kv_find        (uint16_t key);
+static void         kv_remove       (uint16_t key);
+static uint32_t     kv_area_size    (void);
+static uint32_t     kv_round_up     (uint32_t len);
+static uint32_t     kv_record_len   (uint32_t size);
+static uint32_t     kv_program      (uint32_t offset, const void *p_head, uint32_t head_len,
+                                     const void *p_data, uint32_t data_len);
+static uint32_t     kv_erase        (uint32_t area);
+static uint32_t     kv_format       (uint32_t area, uint32_t generation);
+static uint32_t     kv_gc           (void);
+static cy_rslt_t    kv_append       (uint16_t key, const uint8_t *p_data, uint32_t size,
+                                     uint8_t flags, uint32_t *p_us);
+static void         kv_op_done      (uint32_t op_us);
+static void         kv_mount        (void);
+static void         kv_load         (void);
+static void         kv_save         (void);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* kv_find
+*
+* Function Description:
+* @brief   This function finds a key. Called with kv_lock held.
+*
+* @param   key: Key
+*
+* @return  host_kv_t *: The key, or NULL
+*/
+static host_kv_t *kv_find(uint16_t key)
+{
+    for (uint32_t i = 0; i < kv_count; i++)
+    {
+        if (key == kv_keys[i].key)
+        {
+            return &kv_keys[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+* Function Name:
+* kv_remove
+*
+* Function Description:
+* @brief   This function drops a key from the live keys, if it is one.
+*          Called with kv_lock held.
+*
+* @param   key: Key
+*
+* @return  None
+*/
+static void kv_remove(uint16_t key)
+{
+    host_kv_t *p_kv = kv_find(key);
+
+    if (NULL != p_kv)
+    {
+        *p_kv = kv_keys[--kv_count];
+    }
+}
+
+/**
+* Function Name:
+* kv_area_size
+*
+* Function Description:
+* @brief   This function returns the size of an area, half of the flash.
+*
+* @param   None
+*
+* @return  uint32_t: Size in bytes
+*/
+static uint32_t kv_area_size(void)
+{
+    return (kv_cfg.sectors / 2u) * kv_cfg.sector_size;
+}
+
+/**
+* Function Name:
+* kv_round_up
+*
+* Function Description:
+* @brief   This function rounds a length up to whole program units.
+*
+* @param   len: Length in bytes
+*
+* @return  uint32_t: Length in bytes, a multiple of the program size
+*/
+static uint32_t kv_round_up(uint32_t len)
+{
+    return ((len + kv_cfg.program_size - 1u) / kv_cfg.program_size) * kv_cfg.program_size;
+}
+
+/**
+* Function Name:
+* kv_record_len
+*
+* Function Description:
+* @brief   This function returns the flash taken by a record, header and
+*          padding included.
+*
+* @param   size: Size of the value
+*
+* @return  uint32_t: Size in bytes, a multiple of the program size
+*/
+static uint32_t kv_record_len(uint32_t size)
+{
+    return kv_round_up(sizeof(kv_record_t) + size);
+}
+
+/**
+* Function Name:
+* kv_program
+*
+* Function Description:
+* @brief   This function programs a header and the data following it, and
+*          counts the program units written. Called with kv_lock held.
+*
+* @param   offset: Offset in the flash, at the start of a program unit
+* @param   p_head: Header
+* @param   head_len: Size of the header
+* @param   p_data: Data, or NULL
+* @param   data_len: Size of the data
+*
+* @return  uint32_t: Program time in us
+*/
+static uint32_t kv_program(uint32_t offset, const void *p_head, uint32_t head_len,
+                           const void *p_data, uint32_t data_len)
+{
+    uint32_t units = kv_round_up(head_len + data_len) / kv_cfg.program_size;
+
+    memcpy(&kv_flash[offset], p_head, head_len);
+    if (0 < data_len)
+    {
+        memcpy(&kv_flash[offset + head_len], p_data, data_len);
+    }
+    kv_flash_stats.programmed_bytes += (uint64_t)units * kv_cfg.program_size;
+    return units * kv_cfg.program_us;
+}
+
+/**
+* Function Name:
+* kv_erase
+*
+* Function Description:
+* @brief   This function erases the sectors of an area. Called with kv_lock
+*          held.
+*
+* @param   area: Area, 0 or 1
+*
+* @return  uint32_t: Erase time in us
+*/
+static uint32_t kv_erase(uint32_t area)
+{
+    uint32_t first = area * (kv_cfg.sectors / 2u);
+    uint32_t op_us = 0;
+
+    for (uint32_t sector = first; sector < (first + (kv_cfg.sectors / 2u)); sector++)
+    {
+        memset(&kv_flash[sector * kv_cfg.sector_size], KV_ERASED, kv_cfg.sector_size);
+        kv_flash_stats.erases[sector]++;
+        op_us += kv_cfg.erase_us;
+    }
+    return op_us;
+}
+
+/**
+* Function Name:
+* kv_format
+*
+* Function Description:
+* @brief   This function erases an area, writes its header and makes it the
+*          current area. Called with kv_lock held.
+*
+* @param   area: Area, 0 or 1
+* @param   generation: Generation of the area
+*
+* @return  uint32_t: Erase and program time in us
+*/
+static uint32_t kv_format(uint32_t area, uint32_t generation)
+{
+    kv_area_t header = { .magic = KV_AREA_MAGIC, .generation = generation };
+    uint32_t op_us = kv_erase(area);
+
+    op_us += kv_program(area * kv_area_size(), &header, sizeof(header), NULL, 0);
+
+    kv_area = area;
+    kv_generation = generation;
+    kv_free = kv_round_up(sizeof(header));
+    return op_us;
+}
+
+/**
+* Function Name:
+* kv_gc
+*
+* Function Description:
+* @brief   This function copies the live keys to the other area and switches
+*          to it. The current area stays as it is until the next switch.
+*          Called with kv_lock held.
+*
+* @param   None
+*
+* @return  uint32_t: Erase and program time in us
+*/
+static uint32_t kv_gc(void)
+{
+    uint64_t programmed = kv_flash_stats.programmed_bytes;
+    uint32_t op_us = kv_format(kv_area ^ 1u, kv_generation + 1u);
+
+    for (uint32_t i = 0; i < kv_count; i++)
+    {
+        kv_record_t record = { .magic = KV_RECORD_MAGIC, .key = kv_keys[i].key, .size = kv_keys[i].size };
+        uint32_t offset = (kv_area * kv_area_size()) + kv_free;
+
+        op_us += kv_program(offset, &record, sizeof(record), &kv_flash[kv_keys[i].offset], kv_keys[i].size);
+        kv_keys[i].offset = offset + sizeof(record);
+        kv_free += kv_record_len(kv_keys[i].size);
+    }
+    kv_flash_stats.gcs++;
+    kv_flash_stats.gc_bytes += kv_flash_stats.programmed_bytes - programmed;
+    return op_us;
+}
+
+/**
+* Function Name:
+* kv_append
+*
+* Function Description:
+* @brief   This function appends a record for a key to the current area,
+*          collecting the garbage first if it does not fit. The old value of
+*          the key is not copied. Called with kv_lock held.
+*
+* @param   key: Key
+* @param   p_data: Value
+* @param   size: Size of the value
+* @param   flags: KV_RECORD_DELETED to delete the key
+* @param   p_us: Incremented by the erase and program time in us
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS, or MTB_KVSTORE_STORAGE_FULL_ERROR
+*/
+static cy_rslt_t kv_append(uint16_t key, const uint8_t *p_data, uint32_t size,
+                           uint8_t flags, uint32_t *p_us)
+{
+    kv_record_t record = { .magic = KV_RECORD_MAGIC, .key = key, .size = size, .flags = flags };
+    bool deleted = (0u != (flags & KV_RECORD_DELETED));
+    uint32_t len = kv_record_len(size);
+    uint32_t offset;
+
+    if (!deleted && (NULL == kv_find(key)) && (HOST_KVSTORE_MAX_KEYS <= kv_count))
+    {
+        return MTB_KVSTORE_STORAGE_FULL_ERROR;
+    }
+
+    if ((kv_free + len) > kv_area_size())
+    {
+        uint32_t live = kv_round_up(sizeof(kv_area_t)) + (deleted ? 0u : len);
+
+        for (uint32_t i = 0; i < kv_count; i++)
+        {
+            live += (key != kv_keys[i].key) ? kv_record_len(kv_keys[i].size) : 0u;
+        }
+        if (live > kv_area_size())
+        {
+            return MTB_KVSTORE_STORAGE_FULL_ERROR;
+        }
+        kv_remove(key);
+        *p_us += kv_gc();
+        if (deleted)
+        {
+            /* Gone with the old area */
+            return CY_RSLT_SUCCESS;
+        }
+    }
+
+    offset = (kv_area * kv_area_size()) + kv_free;
+    *p_us += kv_program(offset, &record, sizeof(record), p_data, size);
+    kv_free += len;
+
+    if (deleted)
+    {
+        kv_remove(key);
+    }
+    else
+    {
+        host_kv_t *p_kv = kv_find(key);
+
+        if (NULL == p_kv)
+        {
+            p_kv = &kv_keys[kv_count++];
+            p_kv->key = key;
+        }
+        p_kv->size = size;
+        p_kv->offset = offset + sizeof(record);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* kv_op_done
+*
+* Function Description:
+* @brief   This function counts the flash time of a write, delete or reset.
+*          Called with kv_lock held.
+*
+* @param   op_us: Erase and program time of the operation in us
+*
+* @return  None
+*/
+static void kv_op_done(uint32_t op_us)
+{
+    kv_flash_stats.ops++;
+    kv_flash_stats.busy_us += op_us;
+    if (op_us > kv_flash_stats.max_op_us)
+    {
+        kv_flash_stats.max_op_us = op_us;
+    }
+}
+
+/**
+* Function Name:
+* kv_mount
+*
+* Function Description:
+* @brief   This function finds the current area and rebuilds the live keys
+*          from its records, or formats the flash if it holds no area.
+*          Called with kv_lock held.
+*
+* @param   None
+*
+* @return  None
+*/
+static void kv_mount(void)
+{
+    bool found = false;
+
+    for (uint32_t area = 0; area < 2u; area++)
+    {
+        kv_area_t header;
+
+        memcpy(&header, &kv_flash[area * kv_area_size()], sizeof(header));
+        if ((KV_AREA_MAGIC == header.magic) && (!found || (header.generation > kv_generation)))
+        {
+            kv_area = area;
+            kv_generation = header.generation;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        (void)kv_format(0, 1u);
+        return;
+    }
+
+    kv_count = 0;
+    kv_free = kv_round_up(sizeof(kv_area_t));
+    while ((kv_free + sizeof(kv_record_t)) <= kv_area_size())
+    {
+        uint32_t offset = (kv_area * kv_area_size()) + kv_free;
+        kv_record_t record;
+
+        memcpy(&record, &kv_flash[offset], sizeof(record));
+        if ((KV_RECORD_MAGIC != record.magic) || ((kv_free + kv_record_len(record.size)) > kv_area_size()))
+        {
+            break;
+        }
+        kv_free += kv_record_len(record.size);
+
+        kv_remove(record.key);
+        if ((0u == (record.flags & KV_RECORD_DELETED)) && (HOST_KVSTORE_MAX_KEYS > kv_count))
+        {
+            kv_keys[kv_count].key = record.key;
+            kv_keys[kv_count].size = record.size;
+            kv_keys[kv_count].offset = offset + sizeof(record);
+            kv_count++;
+        }
+    }
+}
+
+/**
+* Function Name:
+* kv_load
+*
+* Function Description:
+* @brief   This function allocates the flash and reads it from the file, if
+*          there is one. The geometry of the file is kept over the one set.
+*          Called with kv_lock held.
+*
+* @param   None
+*
+* @return  None
+*/
+static void kv_load(void)
+{
+    char magic[sizeof(HOST_KVSTORE_FILE_MAGIC)] = {0};
+    uint32_t geometry[3];
+    FILE *p_file = NULL;
+    bool ok = false;
+
+    if ((NULL != kv_file) && (NULL != (p_file = fopen(kv_file, "rb"))))
+    {
+        if ((1 == fread(magic, sizeof(HOST_KVSTORE_FILE_MAGIC) - 1, 1, p_file)) &&
+            (0 == strcmp(magic, HOST_KVSTORE_FILE_MAGIC)) &&
+            (1 == fread(geometry, sizeof(geometry), 1, p_file)) &&
+            (0 < geometry[2]) && (0 == (geometry[0] % geometry[2])) &&
+            (2u <= geometry[1]) && (HOST_FLASH_SECTORS_MAX >= geometry[1]) && (0 == (geometry[1] % 2u)))
+        {
+            if ((geometry[0] != kv_cfg.sector_size) || (geometry[1] != kv_cfg.sectors) ||
+                (geometry[2] != kv_cfg.program_size))
+            {
+                fprintf(stderr, "host: %s holds %u sectors of %u bytes programmed by %u bytes, used\n",
+                        kv_file, geometry[1], geometry[0], geometry[2]);
+                kv_cfg.sector_size = geometry[0];
+                kv_cfg.sectors = geometry[1];
+                kv_cfg.program_size = geometry[2];
+            }
+            ok = true;
+        }
+        else
+        {
+            fprintf(stderr, "host: %s is not a kv-store file, ignored\n", kv_file);
+        }
+    }
+
+    kv_flash = malloc(kv_cfg.sectors * kv_cfg.sector_size);
+    if (NULL == kv_flash)
+    {
+        fprintf(stderr, "host: no memory for a flash of %u bytes\n", kv_cfg.sectors * kv_cfg.sector_size);
+        exit(EXIT_FAILURE);
+    }
+    memset(kv_flash, KV_ERASED, kv_cfg.sectors * kv_cfg.sector_size);
+
+    if (ok && ((1 != fread(kv_flash_stats.erases, sizeof(kv_flash_stats.erases[0]) * kv_cfg.sectors, 1, p_file)) ||
+               (1 != fread(kv_flash, kv_cfg.sectors * kv_cfg.sector_size, 1, p_file))))
+    {
+        fprintf(stderr, "host: %s is truncated, ignored\n", kv_file);
+        memset(kv_flash_stats.erases, 0, sizeof(kv_flash_stats.erases));
+        memset(kv_flash, KV_ERASED, kv_cfg.sectors * kv_cfg.sector_size);
+    }
+    if (NULL != p_file)
+    {
+        fclose(p_file);
+    }
+}
+
+/**
+* Function Name:
+* kv_save
+*
+* Function Description:
+* @brief   This function writes the flash to the file, if there is one.
+*          Called with kv_lock held.
+*
+* @param   None
+*
+* @return  None
+*/
+static void kv_save(void)
+{
+    uint32_t geometry[3] = { kv_cfg.sector_size, kv_cfg.sectors, kv_cfg.program_size };
+    FILE *p_file;
+
+    if ((NULL == kv_file) || (NULL == (p_file = fopen(kv_file, "wb"))))
+    {
+        return;
+    }
+    fwrite(HOST_KVSTORE_FILE_MAGIC, sizeof(HOST_KVSTORE_FILE_MAGIC) - 1, 1, p_file);
+    fwrite(geometry, sizeof(geometry), 1, p_file);
+    fwrite(kv_flash_stats.erases, sizeof(kv_flash_stats.erases[0]) * kv_cfg.sectors, 1, p_file);
+    fwrite(kv_flash, kv_cfg.sectors * kv_cfg.sector_size, 1, p_file);
+    fclose(p_file);
+}
+
+/**
+* Function Name:
+* host_kvstore_set_file
+*
+* Function Description:
+* @brief   This function sets the file keeping the flash. Call it before
+*          app_main(), the flash is read when the kv-store is initialized.
+*
+* @param   p_path: Path of the file, created on the first write
+*
+* @return  None
+*/
+void host_kvstore_set_file(const char *p_path)
+{
+    kv_file = p_path;
+}
+
+/**
+* Function Name:
+* host_kvstore_set_flash
+*
+* Function Description:
+* @brief   This function sets the geometry and timing of the flash from a
+*          list of name=value, e.g. "sector=4096,sectors=8,program=256". Names
+*          not given keep their value. Call it before app_main().
+*
+* @param   p_spec: sector, sectors, program, program_us, erase_us and
+*                  endurance, separated by commas
+*
+* @return  bool: false if the list is not valid, nothing is changed then
+*/
+bool host_kvstore_set_flash(const char *p_spec)
+{
+    static const struct
+    {
+        const char  *p_name;
+        size_t      offset;
+    } fields[] =
+    {
+        { "sector",     offsetof(host_flash_cfg_t, sector_size) },
+        { "sectors",    offsetof(host_flash_cfg_t, sectors) },
+        { "program",    offsetof(host_flash_cfg_t, program_size) },
+        { "program_us", offsetof(host_flash_cfg_t, program_us) },
+        { "erase_us",   offsetof(host_flash_cfg_t, erase_us) },
+        { "endurance",  offsetof(host_flash_cfg_t, endurance) },
+    };
+    host_flash_cfg_t cfg = kv_cfg;
+    const char *p_item = p_spec;
+
+    while ('\0' != *p_item)
+    {
+        const char *p_end = strchr(p_item, ',');
+        size_t len = (NULL != p_end) ? (size_t)(p_end - p_item) : strlen(p_item);
+        const char *p_value = memchr(p_item, '=', len);
+        uint32_t i;
+        char *p_num_end;
+        unsigned long value;
+
+        if (NULL == p_value)
+        {
+            return false;
+        }
+        for (i = 0; i < (sizeof(fields) / sizeof(fields[0])); i++)
+        {
+            if ((strlen(fields[i].p_name) == (size_t)(p_value - p_item)) &&
+                (0 == strncmp(fields[i].p_name, p_item, (size_t)(p_value - p_item))))
+            {
+                break;
+            }
+        }
+        value = strtoul(p_value + 1, &p_num_end, 0);
+        if ((i == (sizeof(fields) / sizeof(fields[0]))) || (p_num_end != (p_item + len)) ||
+            (p_num_end == (p_value + 1)) || (UINT32_MAX < value))
+        {
+            return false;
+        }
+        *(uint32_t *)((uint8_t *)&cfg + fields[i].offset) = (uint32_t)value;
+        p_item += len + ((NULL != p_end) ? 1u : 0u);
+    }
+
+    /* Two areas of whole sectors, each holding its header and a record */
+    if ((0 == cfg.program_size) || (0 != (cfg.sector_size % cfg.program_size)) ||
+        (2u > cfg.sectors) || (HOST_FLASH_SECTORS_MAX < cfg.sectors) || (0 != (cfg.sectors % 2u)) ||
+        (((cfg.sectors / 2u) * cfg.sector_size) < (2u * (sizeof(kv_record_t) + cfg.program_size))) ||
+        (0 == cfg.endurance))
+    {
+        return false;
+    }
+    kv_cfg = cfg;
+    return true;
+}
+
+/**
+* Function Name:
+* host_kvstore_get_flash_cfg
+*
+* Function Description:
+* @brief   This function returns the geometry and timing of the flash, the
+*          ones of the file once the kv-store is initialized.
+*
+* @param   None
+*
+* @return  const host_flash_cfg_t *: Flash
+*/
+const host_flash_cfg_t *host_kvstore_get_flash_cfg(void)
+{
+    return &kv_cfg;
+}
+
+/**
+* Function Name:
+* host_kvstore_get_flash_stats
+*
+* Function Description:
+* @brief   This function returns the work done on the flash.
+*
+* @param   None
+*
+* @return  const host_flash_stats_t *: Statistics
+*/
+const host_flash_stats_t *host_kvstore_get_flash_stats(void)
+{
+    return &kv_flash_stats;
+}
+
+/**
+* Function Name:
+* host_kvstore_clear_flash_stats
+*
+* Function Description:
+* @brief   This function clears the work done on the flash, except the erase
+*          counts of the sectors.
+*
+* @param   None
+*
+* @return  None
+*/
+void host_kvstore_clear_flash_stats(void)
+{
+    uint32_t erases[HOST_FLASH_SECTORS_MAX];
+
+    pthread_mutex_lock(&kv_lock);
+    memcpy(erases, kv_flash_stats.erases, sizeof(erases));
+    memset(&kv_flash_stats, 0, sizeof(kv_flash_stats));
+    memcpy(kv_flash_stats.erases, erases, sizeof(erases));
+    pthread_mutex_unlock(&kv_lock);
+}
+
+/**
+* Function Name:
+* host_kvstore_get_stats
+*
+* Function Description:
+* @brief   This function returns the counts of kv-store calls.
+*
+* @param   None
+*
+* @return  const host_kvstore_stats_t *: Statistics
+*/
+const host_kvstore_stats_t *host_kvstore_get_stats(void)
+{
+    return &kv_stats;
+}
+
+/**
+* Function Name:
+* host_kvstore_get_thread_stats
+*
+* Function Description:
+* @brief   This function returns the accesses made by the calling thread.
+*
+* @param   None
+*
+* @return  const host_kvstore_stats_t *: Statistics of the thread
+*/
+const host_kvstore_stats_t *host_kvstore_get_thread_stats(void)
+{
+    return &kv_thread_stats;
+}
+
+/* The API of the kv-store, see mtb_kvstore_cat5.h. The application calls
+ * mtb_kvstore_init each time the stack asks for the local keys. The program
+ * and erase time is counted, the caller does not wait for it. */
+cy_rslt_t mtb_kvstore_init(mtb_kvstore_t *obj)
+{
+    pthread_mutex_lock(&kv_lock);
+    if (!kv_loaded)
+    {
+        kv_load();
+        kv_mount();
+        kv_loaded = true;
+    }
+    obj->initialized = true;
+    pthread_mutex_unlock(&kv_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_kvstore_read_numeric_key(mtb_kvstore_t *obj, uint16_t key, uint8_t *data, uint32_t *size)
+{
+    cy_rslt_t rslt = MTB_KVSTORE_ITEM_NOT_FOUND_ERROR;
+    host_kv_t *p_kv;
+
+    if (!obj->initialized)
+    {
+        return MTB_KVSTORE_BAD_PARAM_ERROR;
+    }
+
+    pthread_mutex_lock(&kv_lock);
+    kv_stats.reads++;
+    kv_thread_stats.reads++;
+    p_kv = kv_find(key);
+    if (NULL != p_kv)
+    {
+        if ((NULL != data) && (NULL != size))
+        {
+            /* As the library, read at most the size of the buffer */
+            *size = (*size < p_kv->size) ? *size : p_kv->size;
+            memcpy(data, &kv_flash[p_kv->offset], *size);
+            kv_stats.bytes_read += *size;
+            kv_thread_stats.bytes_read += *size;
+        }
+        else if (NULL != size)
+        {
+            *size = p_kv->size;
+        }
+        rslt = CY_RSLT_SUCCESS;
+    }
+    pthread_mutex_unlock(&kv_lock);
+    return rslt;
+}
+
+cy_rslt_t mtb_kvstore_write_numeric_key(mtb_kvstore_t *obj, uint16_t key, const uint8_t *data,
+                                        uint32_t size, bool overwrite)
+{
+    cy_rslt_t rslt;
+    uint64_t programmed;
+    uint32_t op_us = 0;
+
+    if (!obj->initialized || ((NULL == data) && (0 < size)))
+    {
+        return MTB_KVSTORE_BAD_PARAM_ERROR;
+    }
+
+    pthread_mutex_lock(&kv_lock);
+    kv_stats.writes++;
+    kv_thread_stats.writes++;
+    if (!overwrite && (NULL != kv_find(key)))
+    {
+        rslt = MTB_KVSTORE_BAD_PARAM_ERROR;
+    }
+    else
+    {
+        programmed = kv_flash_stats.programmed_bytes - kv_flash_stats.gc_bytes;
+        rslt = kv_append(key, data, size, 0, &op_us);
+        if (CY_RSLT_SUCCESS == rslt)
+        {
+            host_flash_key_stats_t *p_key = NULL;
+
+            for (uint32_t i = 0; (NULL == p_key) && (i < HOST_FLASH_KEYS_MAX); i++)
+            {
+                if ((0 == kv_flash_stats.keys[i].writes) || (key == kv_flash_stats.keys[i].key))
+                {
+                    p_key = &kv_flash_stats.keys[i];
+                }
+            }
+            if (NULL != p_key)
+            {
+                p_key->key = key;
+                p_key->writes++;
+                p_key->logical_bytes += size;
+                p_key->programmed_bytes += kv_flash_stats.programmed_bytes - kv_flash_stats.gc_bytes - programmed;
+            }
+            kv_flash_stats.logical_bytes += size;
+            kv_stats.bytes_written += size;
+            kv_thread_stats.bytes_written += size;
+            kv_op_done(op_us);
+            kv_save();
+        }
+    }
+    pthread_mutex_unlock(&kv_lock);
+    return rslt;
+}
+
+cy_rslt_t mtb_kvstore_delete_numeric_key(mtb_kvstore_t *obj, uint16_t key)
+{
+    cy_rslt_t rslt = MTB_KVSTORE_ITEM_NOT_FOUND_ERROR;
+    uint32_t op_us = 0;
+
+    if (!obj->initialized)
+    {
+        return MTB_KVSTORE_BAD_PARAM_ERROR;
+    }
+
+    pthread_mutex_lock(&kv_lock);
+    kv_stats.deletes++;
+    kv_thread_stats.deletes++;
+    if (NULL != kv_find(key))
+    {
+        rslt = kv_append(key, NULL, 0, KV_RECORD_DELETED, &op_us);
+        kv_op_done(op_us);
+        kv_save();
+    }
+    pthread_mutex_unlock(&kv_lock);
+    return rslt;
+}
+
+cy_rslt_t mtb_kvstore_reset(mtb_kvstore_t *obj)
+{
+    uint32_t op_us;
+
+    if (!obj->initialized)
+    {
+        return MTB_KVSTORE_BAD_PARAM_ERROR;
+    }
+
+    /* As the library, erase the whole storage */
+    pthread_mutex_lock(&kv_lock);
+    kv_stats.resets++;
+    kv_thread_stats.resets++;
+    kv_count = 0;
+    op_us = kv_erase(1u);
+    op_us += kv_format(0, 1u);
+    kv_op_done(op_us);
+    kv_save();
+    pthread_mutex_unlock(&kv_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,403 @@
+/******************************************************************************
+* File Name:   host_kvwear.c
+*
+* Description: This file drives the kv-store of the host build with the writes of
+*              the bonding code, app_bt_update_bond_data(), app_bt_update_cccd()
+*              and app_bt_save_local_identity_key(), and reports the write
+*              amplification and the flash lifetime it leads to.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "app_bt_bonding.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define KVWEAR_DEFAULT_OPS                  (100000u)
+#define KVWEAR_DEFAULT_OPS_PER_DAY          (100u)
+
+/* Share of the writes per 100, in the order of kvwear_ops */
+#define KVWEAR_DEFAULT_WEIGHTS              "20,79,1"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    const char  *p_name;
+    uint16_t    key;
+    uint32_t    weight;
+    uint32_t    count;
+    uint32_t    failed;
+} kvwear_op_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static kvwear_op_t          kvwear_ops[] =
+{
+    { "bond data",  bond_data,  0, 0, 0 },
+    { "CCCD",       cccd_data,  0, 0, 0 },
+    { "local IRK",  local_irk,  0, 0, 0 },
+};
+
+#define KVWEAR_OP_COUNT                     (sizeof(kvwear_ops) / sizeof(kvwear_ops[0]))
+
+/* State of the pseudo-random sequence, the same on every run */
+static uint32_t             kvwear_seed = 1u;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint32_t     kvwear_random   (void);
+static bool         kvwear_weights  (const char *p_str);
+static cy_rslt_t    kvwear_write    (uint32_t op);
+static void         kvwear_report   (uint32_t ops, double ops_per_day, const uint32_t *p_erases);
+static void         usage           (const char *p_name);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* kvwear_random
+*
+* Function Description:
+* @brief   This function returns the next pseudo-random number (xorshift).
+*
+* @param   None
+*
+* @return  uint32_t: Number
+*/
+static uint32_t kvwear_random(void)
+{
+    kvwear_seed ^= kvwear_seed << 13;
+    kvwear_seed ^= kvwear_seed >> 17;
+    kvwear_seed ^= kvwear_seed << 5;
+    return kvwear_seed;
+}
+
+/**
+* Function Name:
+* kvwear_weights
+*
+* Function Description:
+* @brief   This function sets the share of every kind of write.
+*
+* @param   p_str: Weights separated by commas, in the order of kvwear_ops
+*
+* @return  bool: false if the list is not valid
+*/
+static bool kvwear_weights(const char *p_str)
+{
+    uint32_t total = 0;
+    char *p_end;
+
+    for (uint32_t i = 0; i < KVWEAR_OP_COUNT; i++)
+    {
+        unsigned long weight = strtoul(p_str, &p_end, 10);
+
+        if ((p_end == p_str) || (1000000u < weight) ||
+            (((KVWEAR_OP_COUNT - 1u) == i) ? ('\0' != *p_end) : (',' != *p_end)))
+        {
+            return false;
+        }
+        kvwear_ops[i].weight = (uint32_t)weight;
+        total += (uint32_t)weight;
+        p_str = p_end + 1;
+    }
+    return (0 < total);
+}
+
+/**
+* Function Name:
+* kvwear_write
+*
+* Function Description:
+* @brief   This function makes one write of the bonding code, with the value
+*          it would hold: a CCCD of one of the slots, or local keys.
+*
+* @param   op: Index in kvwear_ops
+*
+* @return  cy_rslt_t: Result of the bonding code
+*/
+static cy_rslt_t kvwear_write(uint32_t op)
+{
+    wiced_bt_local_identity_keys_t keys;
+    uint32_t value = kvwear_random();
+
+    switch (kvwear_ops[op].key)
+    {
+        case bond_data:
+            bondinfo.privacy_mode[value % BOND_INDEX_MAX] = (wiced_bt_ble_privacy_mode_t)((value >> 8) & 1u);
+            return app_bt_update_bond_data();
+        case cccd_data:
+            return app_bt_update_cccd((uint16_t)((value >> 8) & GATT_CLIENT_CONFIG_NOTIFICATION),
+                                      (uint8_t)(value % BOND_INDEX_MAX));
+        default:
+            for (uint32_t i = 0; i < sizeof(keys.local_key_data); i++)
+            {
+                keys.local_key_data[i] = (uint8_t)kvwear_random();
+            }
+            return app_bt_save_local_identity_key(keys);
+    }
+}
+
+/**
+* Function Name:
+* kvwear_report
+*
+* Function Description:
+* @brief   This function prints the writes, the work they made on the flash
+*          and the projected lifetime of the flash.
+*
+* @param   ops: Writes made
+* @param   ops_per_day: Writes of the device per day, for the lifetime in years
+* @param   p_erases: Erase count of every sector before the writes
+*
+* @return  None
+*/
+static void kvwear_report(uint32_t ops, double ops_per_day, const uint32_t *p_erases)
+{
+    const host_flash_cfg_t *p_cfg = host_kvstore_get_flash_cfg();
+    const host_flash_stats_t *p_stats = host_kvstore_get_flash_stats();
+    uint32_t min_erases = UINT32_MAX;
+    uint32_t max_erases = 0;
+    uint64_t erases = 0;
+    double per_op;
+    double even_ops;
+
+    printf("Flash: %u sectors of %u bytes in 2 areas, programmed by %u bytes, "
+           "%u us per program, %u us per erase, %u erase cycles\n",
+           p_cfg->sectors, p_cfg->sector_size, p_cfg->program_size,
+           p_cfg->program_us, p_cfg->erase_us, p_cfg->endurance);
+    printf("Workload: %u writes", ops);
+    for (uint32_t i = 0; i < KVWEAR_OP_COUNT; i++)
+    {
+        printf(", %s %u", kvwear_ops[i].p_name, kvwear_ops[i].count);
+    }
+    printf("\n\n");
+
+    printf("%-12s %8s %8s %12s %14s %8s\n", "Key", "writes", "value", "logical", "programmed", "ampl");
+    for (uint32_t i = 0; i < HOST_FLASH_KEYS_MAX; i++)
+    {
+        const host_flash_key_stats_t *p_key = &p_stats->keys[i];
+        const char *p_name = "other";
+
+        if (0 == p_key->writes)
+        {
+            continue;
+        }
+        for (uint32_t op = 0; op < KVWEAR_OP_COUNT; op++)
+        {
+            p_name = (kvwear_ops[op].key == p_key->key) ? kvwear_ops[op].p_name : p_name;
+        }
+        printf("%-12s %8u %8llu %12llu %14llu %8.2f\n", p_name, p_key->writes,
+               (unsigned long long)(p_key->logical_bytes / p_key->writes),
+               (unsigned long long)p_key->logical_bytes, (unsigned long long)p_key->programmed_bytes,
+               (double)p_key->programmed_bytes / (double)((0 < p_key->logical_bytes) ? p_key->logical_bytes : 1u));
+    }
+    printf("%-12s %8u %8s %12s %14llu\n", "gc copies", p_stats->gcs, "", "",
+           (unsigned long long)p_stats->gc_bytes);
+    printf("%-12s %8u %8s %12llu %14llu %8.2f\n\n", "total", p_stats->ops, "",
+           (unsigned long long)p_stats->logical_bytes, (unsigned long long)p_stats->programmed_bytes,
+           (double)p_stats->programmed_bytes / (double)((0 < p_stats->logical_bytes) ? p_stats->logical_bytes : 1u));
+
+    printf("Flash busy %.3f s, %.1f us per write on average, %u us at most\n",
+           (double)p_stats->busy_us / 1e6, (double)p_stats->busy_us / (double)((0 < ops) ? ops : 1u),
+           p_stats->max_op_us);
+
+    for (uint32_t sector = 0; sector < p_cfg->sectors; sector++)
+    {
+        uint32_t count = p_stats->erases[sector] - p_erases[sector];
+
+        min_erases = (count < min_erases) ? count : min_erases;
+        max_erases = (count > max_erases) ? count : max_erases;
+        erases += count;
+    }
+    printf("Sector erases in this run: min %u, max %u, mean %.1f\n",
+           min_erases, max_erases, (double)erases / p_cfg->sectors);
+
+    /* Every byte programmed costs its share of an erase later on: with the
+     * erases spread evenly, the flash lasts until every sector used its
+     * endurance. The worst sector gives the lifetime measured in this run. */
+    per_op = (double)p_stats->programmed_bytes / (double)((0 < ops) ? ops : 1u);
+    even_ops = (double)p_cfg->endurance * p_cfg->sectors * p_cfg->sector_size / ((0 < per_op) ? per_op : 1.0);
+    printf("Projected lifetime, %.0f bytes programmed per write, %.0f writes per day:\n", per_op, ops_per_day);
+    printf("  even wear     %14.0f writes, %10.1f years\n", even_ops, even_ops / ops_per_day / 365.25);
+    if (0 < max_erases)
+    {
+        double worst_ops = (double)p_cfg->endurance * ops / max_erases;
+
+        printf("  worst sector  %14.0f writes, %10.1f years\n", worst_ops, worst_ops / ops_per_day / 365.25);
+    }
+    else
+    {
+        printf("  worst sector  no sector erased, run more writes\n");
+    }
+    for (uint32_t i = 0; i < KVWEAR_OP_COUNT; i++)
+    {
+        if (0 < kvwear_ops[i].failed)
+        {
+            printf("%u writes of %s failed\n", kvwear_ops[i].failed, kvwear_ops[i].p_name);
+        }
+    }
+}
+
+/**
+* Function Name:
+* usage
+*
+* Function Description:
+* @brief   This function prints the options and exits.
+*
+* @param   p_name: Name of the program
+*
+* @return  None
+*/
+static void usage(const char *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n writes] [-w bond,cccd,irk] [-r writes_per_day] [-f flash] [-k kvstore_file]\n"
+            "  -n  number of writes, %u by default\n"
+            "  -w  share of the bond data, CCCD and local IRK writes, " KVWEAR_DEFAULT_WEIGHTS " by default\n"
+            "  -r  writes of the device per day, for the lifetime in years, %u by default\n"
+            "  -f  flash of the kv-store, e.g. sector=4096,sectors=8,program=256,program_us=400,\n"
+            "      erase_us=45000,endurance=100000\n"
+            "  -k  start from the flash in the file, and keep it there\n",
+            p_name, KVWEAR_DEFAULT_OPS, KVWEAR_DEFAULT_OPS_PER_DAY);
+    exit(EXIT_FAILURE);
+}
+
+/**
+* Function Name:
+* main
+*
+* Function Description:
+* @brief   Entry of the wear workload. The bonding code writes to the
+*          kv-store as it does on the device, without the application
+*          running; the writes are picked at random in the given shares.
+*
+* @param   argc: Number of arguments
+* @param   argv: Arguments
+*
+* @return  int: EXIT_SUCCESS if every write succeeded
+*/
+int main(int argc, char *argv[])
+{
+    uint32_t erases[HOST_FLASH_SECTORS_MAX];
+    uint32_t ops = KVWEAR_DEFAULT_OPS;
+    double ops_per_day = KVWEAR_DEFAULT_OPS_PER_DAY;
+    uint32_t total = 0;
+    bool ok = true;
+    int opt;
+
+    (void)kvwear_weights(KVWEAR_DEFAULT_WEIGHTS);
+    while (-1 != (opt = getopt(argc, argv, "n:w:r:f:k:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                ops = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                if (!kvwear_weights(optarg))
+                {
+                    usage(argv[0]);
+                }
+                break;
+            case 'r':
+                ops_per_day = strtod(optarg, NULL);
+                break;
+            case 'f':
+                if (!host_kvstore_set_flash(optarg))
+                {
+                    usage(argv[0]);
+                }
+                break;
+            case 'k':
+                host_kvstore_set_file(optarg);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if ((optind != argc) || (0 == ops) || (0 >= ops_per_day))
+    {
+        usage(argv[0]);
+    }
+
+    /* The writes of a fresh device: the keys and the bond data exist */
+    app_kv_store_init();
+    for (uint32_t i = 0; i < KVWEAR_OP_COUNT; i++)
+    {
+        (void)kvwear_write(i);
+        total += kvwear_ops[i].weight;
+    }
+    memcpy(erases, host_kvstore_get_flash_stats()->erases, sizeof(erases));
+    host_kvstore_clear_flash_stats();
+
+    for (uint32_t n = 0; n < ops; n++)
+    {
+        uint32_t pick = kvwear_random() % total;
+        uint32_t op = 0;
+
+        while (pick >= kvwear_ops[op].weight)
+        {
+            pick -= kvwear_ops[op++].weight;
+        }
+        kvwear_ops[op].count++;
+        if (CY_RSLT_SUCCESS != kvwear_write(op))
+        {
+            kvwear_ops[op].failed++;
+            ok = false;
+        }
+    }
+
+    kvwear_report(ops, ops_per_day, erases);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
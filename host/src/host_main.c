@@ -0,0 +1,166 @@
+/******************************************************************************
+* File Name:   host_main.c
+*
+* Description: This file runs the application on the host. It boots it, feeds the
+*              standard input to the debug UART as the terminal would, and runs
+*              the virtual clock in steps of 10 ms.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Step of the virtual clock */
+#define HOST_STEP_US                        (10000u)
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void usage                           (const char *p_name);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* usage
+*
+* Function Description:
+* @brief   This function prints the options and exits.
+*
+* @param   p_name: Name of the program
+*
+* @return  None
+*/
+static void usage(const char *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-t seconds] [-k kvstore_file] [-f flash]\n"
+            "  -t  run for the virtual time, otherwise until the end of the input\n"
+            "  -k  keep the kv-store in the file across runs\n"
+            "  -f  flash of the kv-store, e.g. sector=4096,sectors=8,program=256\n",
+            p_name);
+    exit(EXIT_FAILURE);
+}
+
+/**
+* Function Name:
+* main
+*
+* Function Description:
+* @brief   Entry of the host build. When the input is a terminal the virtual
+*          clock follows the time spent waiting for it, otherwise the input
+*          is taken as fast as the application handles it.
+*
+* @param   argc: Number of arguments
+* @param   argv: Arguments
+*
+* @return  int: EXIT_SUCCESS
+*/
+int main(int argc, char *argv[])
+{
+    uint64_t run_us = 0;
+    bool input_open = true;
+    bool tty = isatty(STDIN_FILENO);
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:k:f:")))
+    {
+        switch (opt)
+        {
+            case 't':
+                run_us = (uint64_t)(strtod(optarg, NULL) * 1000000.0);
+                break;
+            case 'k':
+                host_kvstore_set_file(optarg);
+                break;
+            case 'f':
+                if (!host_kvstore_set_flash(optarg))
+                {
+                    usage(argv[0]);
+                }
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind != argc)
+    {
+        usage(argv[0]);
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    (void)app_main();
+    host_settle();
+
+    while ((0 == run_us) ? input_open : (host_clock_us() < run_us))
+    {
+        if (input_open)
+        {
+            struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+
+            if (0 < poll(&pfd, 1, tty ? (int)(HOST_STEP_US / 1000u) : 0))
+            {
+                uint8_t buf[256];
+                ssize_t len = read(STDIN_FILENO, buf, sizeof(buf));
+
+                if (0 < len)
+                {
+                    host_uart_rx(buf, (uint32_t)len);
+                    host_settle();
+                }
+                else
+                {
+                    input_open = false;
+                }
+            }
+        }
+        host_clock_advance_us(HOST_STEP_US);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1048 @@
+/******************************************************************************
+* File Name:   host_replay.c
+*
+* Description: This file replays scripted sequences of Bluetooth stack events into
+*              the application at full speed on the virtual clock, and reports the
+*              CPU time, heap allocations and kv-store accesses of every handler,
+*              checked against a budget.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "wiced_bt_stack.h"
+#include "wiced_bt_gatt.h"
+#include "cycfg_bt_settings.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define REPLAY_LINE_MAX                     (512u)
+#define REPLAY_LINES_MAX                    (1024u)
+#define REPLAY_TOKENS_MAX                   (8u)
+#define REPLAY_REPEAT_DEPTH                 (4u)
+#define REPLAY_HANDLERS_MAX                 (64u)
+#define REPLAY_NAME_MAX                     (48u)
+
+/* Connection ID given to the connections of the script */
+#define REPLAY_CONN_ID                      (0x8001u)
+
+/* Button held down for longer than the debounce time of the application */
+#define REPLAY_BUTTON_HOLD_US               (60000u)
+
+/* Budget column not checked */
+#define REPLAY_UNCHECKED                    (-1.0)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Cost of one kind of event, in the thread delivering it */
+typedef struct
+{
+    char        name[REPLAY_NAME_MAX];
+    uint32_t    calls;
+    uint64_t    cpu_ns;
+    uint64_t    cpu_ns_max;
+    uint64_t    allocs;
+    uint64_t    allocs_max;
+    uint64_t    kv_reads;
+    uint64_t    kv_reads_max;
+    uint64_t    kv_writes;
+    uint64_t    kv_writes_max;
+} replay_handler_t;
+
+/* Handler being measured */
+typedef struct
+{
+    replay_handler_t        *p_handler;
+    uint64_t                cpu_ns;
+    host_heap_stats_t       heap;
+    host_kvstore_stats_t    kv;
+} replay_measure_t;
+
+/* Script, with the position of the open repeat blocks */
+typedef struct
+{
+    const char  *p_path;
+    char        *p_lines[REPLAY_LINES_MAX];
+    uint32_t    count;
+    uint32_t    repeat_line[REPLAY_REPEAT_DEPTH];
+    uint32_t    repeat_left[REPLAY_REPEAT_DEPTH];
+    uint32_t    depth;
+} replay_script_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static replay_handler_t     replay_handlers[REPLAY_HANDLERS_MAX];
+static uint32_t             replay_handler_count;
+static replay_measure_t     replay_measure;
+static uint32_t             replay_measure_depth;
+static uint32_t             replay_events;
+
+/* Peer of the current connection */
+static wiced_bt_device_address_t replay_peer;
+static uint16_t             replay_conn_id;
+static uint16_t             replay_mtu = GATT_DEF_BLE_MTU_SIZE;
+
+/* Report, the terminal output of the application goes to stdout */
+static FILE                 *replay_out;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint64_t         replay_cpu_ns           (void);
+static const char       *replay_event_name      (bool gatt, uint8_t event, const void *p_event_data);
+static replay_handler_t *replay_handler_get     (const char *p_name);
+static void             replay_hook             (bool gatt, uint8_t event, const void *p_event_data, bool done);
+static bool             replay_parse_addr       (const char *p_str, wiced_bt_device_address_t bd_addr);
+static uint32_t         replay_parse_hex        (const char *p_str, uint8_t *p_buf, uint32_t size);
+static void             replay_link_keys        (const wiced_bt_device_address_t bd_addr,
+                                                 wiced_bt_device_link_keys_t *p_keys);
+static void             replay_mgmt             (wiced_bt_management_evt_t event,
+                                                 wiced_bt_management_evt_data_t *p_data);
+static void             replay_attr_req         (wiced_bt_gatt_attribute_request_t *p_req);
+static bool             replay_expect           (const char *p_what, uint64_t value);
+static bool             replay_step             (char **pp_tok, uint32_t ntok);
+static bool             replay_run              (replay_script_t *p_script);
+static bool             replay_load             (replay_script_t *p_script, const char *p_path);
+static void             replay_report           (void);
+static bool             replay_check_budget     (const char *p_path);
+static void             usage                   (const char *p_name);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* replay_cpu_ns
+*
+* Function Description:
+* @brief   This function returns the CPU time of the calling thread.
+*
+* @param   None
+*
+* @return  uint64_t: CPU time in ns
+*/
+static uint64_t replay_cpu_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+* Function Name:
+* replay_event_name
+*
+* Function Description:
+* @brief   This function returns the name an event is reported under. The
+*          attribute requests are reported by opcode.
+*
+* @param   gatt: true for a GATT event
+* @param   event: Event
+* @param   p_event_data: Event data
+*
+* @return  const char *: Name
+*/
+static const char *replay_event_name(bool gatt, uint8_t event, const void *p_event_data)
+{
+    static char unknown[REPLAY_NAME_MAX];
+
+    if (!gatt)
+    {
+        switch (event)
+        {
+        case BTM_ENABLED_EVT:                           return "BTM_ENABLED_EVT";
+        case BTM_USER_CONFIRMATION_REQUEST_EVT:         return "BTM_USER_CONFIRMATION_REQUEST_EVT";
+        case BTM_PASSKEY_NOTIFICATION_EVT:              return "BTM_PASSKEY_NOTIFICATION_EVT";
+        case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT: return "BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT";
+        case BTM_PAIRING_COMPLETE_EVT:                  return "BTM_PAIRING_COMPLETE_EVT";
+        case BTM_ENCRYPTION_STATUS_EVT:                 return "BTM_ENCRYPTION_STATUS_EVT";
+        case BTM_SECURITY_REQUEST_EVT:                  return "BTM_SECURITY_REQUEST_EVT";
+        case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:    return "BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT";
+        case BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT:   return "BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT";
+        case BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT:        return "BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT";
+        case BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT:       return "BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT";
+        case BTM_BLE_ADVERT_STATE_CHANGED_EVT:          return "BTM_BLE_ADVERT_STATE_CHANGED_EVT";
+        case BTM_BLE_CONNECTION_PARAM_UPDATE:           return "BTM_BLE_CONNECTION_PARAM_UPDATE";
+        default:
+            snprintf(unknown, sizeof(unknown), "BTM_EVT_%u", event);
+            return unknown;
+        }
+    }
+
+    switch (event)
+    {
+    case GATT_CONNECTION_STATUS_EVT:
+        return ((const wiced_bt_gatt_event_data_t *)p_event_data)->connection_status.connected ?
+               "GATT_CONNECTION_STATUS_EVT/up" : "GATT_CONNECTION_STATUS_EVT/down";
+    case GATT_GET_RESPONSE_BUFFER_EVT:      return "GATT_GET_RESPONSE_BUFFER_EVT";
+    case GATT_APP_BUFFER_TRANSMITTED_EVT:   return "GATT_APP_BUFFER_TRANSMITTED_EVT";
+    case GATT_CONGESTION_EVT:               return "GATT_CONGESTION_EVT";
+    case GATT_ATTRIBUTE_REQUEST_EVT:
+        switch (((const wiced_bt_gatt_event_data_t *)p_event_data)->attribute_request.opcode)
+        {
+        case GATT_REQ_MTU:                  return "GATT_REQ_MTU";
+        case GATT_REQ_READ:                 return "GATT_REQ_READ";
+        case GATT_REQ_READ_BLOB:            return "GATT_REQ_READ_BLOB";
+        case GATT_REQ_READ_BY_TYPE:         return "GATT_REQ_READ_BY_TYPE";
+        case GATT_REQ_READ_MULTI:           return "GATT_REQ_READ_MULTI";
+        case GATT_REQ_READ_MULTI_VAR:       return "GATT_REQ_READ_MULTI_VAR";
+        case GATT_REQ_WRITE:                return "GATT_REQ_WRITE";
+        case GATT_CMD_WRITE:                return "GATT_CMD_WRITE";
+        case GATT_HANDLE_VALUE_NOTIF:       return "GATT_HANDLE_VALUE_NOTIF";
+        default:
+            snprintf(unknown, sizeof(unknown), "GATT_REQ_0x%02X",
+                     ((const wiced_bt_gatt_event_data_t *)p_event_data)->attribute_request.opcode);
+            return unknown;
+        }
+    default:
+        snprintf(unknown, sizeof(unknown), "GATT_EVT_%u", event);
+        return unknown;
+    }
+}
+
+/**
+* Function Name:
+* replay_handler_get
+*
+* Function Description:
+* @brief   This function returns the cost entry of an event, added on first use.
+*
+* @param   p_name: Name of the event
+*
+* @return  replay_handler_t *: Entry, NULL if the table is full
+*/
+static replay_handler_t *replay_handler_get(const char *p_name)
+{
+    for (uint32_t i = 0; i < replay_handler_count; i++)
+    {
+        if (0 == strcmp(replay_handlers[i].name, p_name))
+        {
+            return &replay_handlers[i];
+        }
+    }
+    if (REPLAY_HANDLERS_MAX <= replay_handler_count)
+    {
+        return NULL;
+    }
+    snprintf(replay_handlers[replay_handler_count].name, REPLAY_NAME_MAX, "%s", p_name);
+    return &replay_handlers[replay_handler_count++];
+}
+
+/**
+* Function Name:
+* replay_hook
+*
+* Function Description:
+* @brief   This function measures the application handling one stack event,
+*          in the thread delivering it: CPU time, heap allocations and
+*          kv-store accesses. Work the handler defers to other threads is not
+*          counted.
+*
+* @param   gatt: true for a GATT event
+* @param   event: Event
+* @param   p_event_data: Event data
+* @param   done: false before the handler, true once it returned
+*
+* @return  None
+*/
+static void replay_hook(bool gatt, uint8_t event, const void *p_event_data, bool done)
+{
+    replay_measure_t *p_m = &replay_measure;
+    host_heap_stats_t heap;
+    const host_kvstore_stats_t *p_kv = host_kvstore_get_thread_stats();
+    replay_handler_t *p_h;
+    uint64_t cpu_ns;
+    uint64_t allocs;
+    uint64_t reads;
+    uint64_t writes;
+
+    /* An event delivered from within a handler is counted in it */
+    if (!done)
+    {
+        if (0 == replay_measure_depth++)
+        {
+            p_m->p_handler = replay_handler_get(replay_event_name(gatt, event, p_event_data));
+            host_heap_get_stats(&p_m->heap, true);
+            p_m->kv = *p_kv;
+            p_m->cpu_ns = replay_cpu_ns();
+        }
+        return;
+    }
+    if (0 != --replay_measure_depth)
+    {
+        return;
+    }
+
+    cpu_ns = replay_cpu_ns() - p_m->cpu_ns;
+    host_heap_get_stats(&heap, true);
+    p_h = p_m->p_handler;
+    replay_events++;
+    if (NULL == p_h)
+    {
+        return;
+    }
+    allocs = heap.allocs - p_m->heap.allocs;
+    reads = p_kv->reads - p_m->kv.reads;
+    writes = p_kv->writes + p_kv->deletes + p_kv->resets - (p_m->kv.writes + p_m->kv.deletes + p_m->kv.resets);
+
+    p_h->calls++;
+    p_h->cpu_ns += cpu_ns;
+    p_h->cpu_ns_max = MAX(p_h->cpu_ns_max, cpu_ns);
+    p_h->allocs += allocs;
+    p_h->allocs_max = MAX(p_h->allocs_max, allocs);
+    p_h->kv_reads += reads;
+    p_h->kv_reads_max = MAX(p_h->kv_reads_max, reads);
+    p_h->kv_writes += writes;
+    p_h->kv_writes_max = MAX(p_h->kv_writes_max, writes);
+}
+
+/**
+* Function Name:
+* replay_parse_addr
+*
+* Function Description:
+* @brief   This function parses a Bluetooth address written XX:XX:XX:XX:XX:XX.
+*
+* @param   p_str: Text
+* @param   bd_addr: Address
+*
+* @return  bool: false if the text is not an address
+*/
+static bool replay_parse_addr(const char *p_str, wiced_bt_device_address_t bd_addr)
+{
+    unsigned int b[BD_ADDR_LEN];
+
+    if (BD_ADDR_LEN != sscanf(p_str, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < BD_ADDR_LEN; i++)
+    {
+        bd_addr[i] = (uint8_t)b[i];
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* replay_parse_hex
+*
+* Function Description:
+* @brief   This function parses bytes written in hexadecimal, e.g. 0100.
+*
+* @param   p_str: Text
+* @param   p_buf: Bytes
+* @param   size: Size of the buffer
+*
+* @return  uint32_t: Number of bytes, 0 if the text is not hexadecimal
+*/
+static uint32_t replay_parse_hex(const char *p_str, uint8_t *p_buf, uint32_t size)
+{
+    uint32_t len = 0;
+    unsigned int byte;
+
+    if ((0 != (strlen(p_str) % 2)) || ((strlen(p_str) / 2) > size))
+    {
+        return 0;
+    }
+    while (('\0' != p_str[0]) && isxdigit((unsigned char)p_str[0]) && isxdigit((unsigned char)p_str[1]) &&
+           (1 == sscanf(p_str, "%2x", &byte)))
+    {
+        p_buf[len++] = (uint8_t)byte;
+        p_str += 2;
+    }
+    return ('\0' == p_str[0]) ? len : 0;
+}
+
+/**
+* Function Name:
+* replay_link_keys
+*
+* Function Description:
+* @brief   This function makes the keys a peer gets when it pairs. They
+*          depend on the address only, so the replay is repeatable.
+*
+* @param   bd_addr: Address of the peer
+* @param   p_keys: Keys
+*
+* @return  None
+*/
+static void replay_link_keys(const wiced_bt_device_address_t bd_addr, wiced_bt_device_link_keys_t *p_keys)
+{
+    uint8_t *p_key = (uint8_t *)&p_keys->key_data;
+
+    memset(p_keys, 0, sizeof(*p_keys));
+    memcpy(p_keys->bd_addr, bd_addr, BD_ADDR_LEN);
+    memcpy(p_keys->conn_addr, bd_addr, BD_ADDR_LEN);
+    for (uint32_t i = 0; i < 5 * sizeof(BT_OCTET16); i++)
+    {
+        p_key[i] = (uint8_t)(bd_addr[i % BD_ADDR_LEN] ^ (i * 37u));
+    }
+    p_keys->key_data.le_keys_available_mask = BTM_LE_KEY_PENC | BTM_LE_KEY_PID;
+    p_keys->key_data.ble_addr_type = BLE_ADDR_PUBLIC;
+}
+
+/**
+* Function Name:
+* replay_mgmt
+*
+* Function Description:
+* @brief   This function delivers a management event, then lets the
+*          application handle what it posted.
+*
+* @param   event: Management event
+* @param   p_data: Event data
+*
+* @return  None
+*/
+static void replay_mgmt(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_data)
+{
+    (void)host_bt_management_event(event, p_data);
+    host_settle();
+}
+
+/**
+* Function Name:
+* replay_attr_req
+*
+* Function Description:
+* @brief   This function delivers an attribute request on the current
+*          connection, then lets the application handle what it posted.
+*
+* @param   p_req: Request, the connection ID is set here
+*
+* @return  None
+*/
+static void replay_attr_req(wiced_bt_gatt_attribute_request_t *p_req)
+{
+    wiced_bt_gatt_event_data_t data;
+
+    p_req->conn_id = replay_conn_id;
+    data.attribute_request = *p_req;
+    (void)host_bt_gatt_event(GATT_ATTRIBUTE_REQUEST_EVT, &data);
+    host_settle();
+}
+
+/**
+* Function Name:
+* replay_expect
+*
+* Function Description:
+* @brief   This function checks what the application asked from the stack,
+*          or its heap, against the value the script expects.
+*
+* @param   p_what: Name of the value
+* @param   value: Expected value
+*
+* @return  bool: false if the value differs or is unknown
+*/
+static bool replay_expect(const char *p_what, uint64_t value)
+{
+    const host_bt_stats_t *p_bt = host_bt_get_stats();
+    host_heap_stats_t heap;
+    uint64_t actual;
+
+    host_heap_get_stats(&heap, false);
+    if (0 == strcmp(p_what, "adv_mode"))                 actual = p_bt->adv_mode;
+    else if (0 == strcmp(p_what, "notifications"))       actual = p_bt->notifications;
+    else if (0 == strcmp(p_what, "error_rsps"))          actual = p_bt->error_rsps;
+    else if (0 == strcmp(p_what, "write_rsps"))          actual = p_bt->write_rsps;
+    else if (0 == strcmp(p_what, "read_rsps"))           actual = p_bt->read_rsps;
+    else if (0 == strcmp(p_what, "security_grants"))     actual = p_bt->security_grants;
+    else if (0 == strcmp(p_what, "confirm_replies"))     actual = p_bt->confirm_replies;
+    else if (0 == strcmp(p_what, "resolving_list"))      actual = p_bt->resolving_list_size;
+    else if (0 == strcmp(p_what, "accept_list"))         actual = p_bt->accept_list_size;
+    else if (0 == strcmp(p_what, "heap_in_use"))         actual = (uint64_t)heap.in_use;
+    else
+    {
+        fprintf(stderr, "unknown value %s\n", p_what);
+        return false;
+    }
+    if (actual != value)
+    {
+        fprintf(stderr, "expected %s %llu, got %llu\n", p_what, (unsigned long long)value,
+                (unsigned long long)actual);
+        return false;
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* replay_step
+*
+* Function Description:
+* @brief   This function runs one line of a script, see host/replay/README.md
+*          for the commands.
+*
+* @param   pp_tok: Words of the line
+* @param   ntok: Number of words
+*
+* @return  bool: false if the line is invalid or an expectation failed
+*/
+static bool replay_step(char **pp_tok, uint32_t ntok)
+{
+    const char *p_cmd = pp_tok[0];
+    wiced_bt_management_evt_data_t mgmt;
+    wiced_bt_gatt_event_data_t gatt;
+    wiced_bt_gatt_attribute_request_t req;
+    wiced_bt_device_address_t bda;
+    uint8_t value[REPLAY_LINE_MAX / 2];
+    unsigned long arg1 = (1 < ntok) ? strtoul(pp_tok[1], NULL, 0) : 0;
+    unsigned long arg2 = (2 < ntok) ? strtoul(pp_tok[2], NULL, 0) : 0;
+    unsigned long arg3 = (3 < ntok) ? strtoul(pp_tok[3], NULL, 0) : 0;
+    bool has_addr = (1 < ntok) && replay_parse_addr(pp_tok[1], bda);
+
+    memset(&mgmt, 0, sizeof(mgmt));
+    memset(&gatt, 0, sizeof(gatt));
+    memset(&req, 0, sizeof(req));
+
+    if (0 == strcmp(p_cmd, "wait") && (2 == ntok))
+    {
+        host_clock_advance_us((uint64_t)arg1 * 1000u);
+    }
+    else if (0 == strcmp(p_cmd, "uart") && (2 <= ntok))
+    {
+        /* The rest of the line, as typed on the terminal */
+        for (uint32_t i = 1; i < ntok; i++)
+        {
+            host_uart_rx((const uint8_t *)pp_tok[i], (uint32_t)strlen(pp_tok[i]));
+            host_uart_rx((const uint8_t *)((i + 1 < ntok) ? " " : "\r"), 1);
+        }
+        host_settle();
+    }
+    else if (0 == strcmp(p_cmd, "button") && (ntok <= 2))
+    {
+        for (unsigned long i = 0; i < ((2 == ntok) ? arg1 : 1); i++)
+        {
+            host_button_set(true);
+            host_clock_advance_us(REPLAY_BUTTON_HOLD_US);
+            host_button_set(false);
+            host_clock_advance_us(REPLAY_BUTTON_HOLD_US);
+        }
+    }
+    else if (0 == strcmp(p_cmd, "connect") && has_addr && (ntok <= 3))
+    {
+        memcpy(replay_peer, bda, BD_ADDR_LEN);
+        replay_conn_id = (3 == ntok) ? (uint16_t)arg2 : REPLAY_CONN_ID;
+        replay_mtu = GATT_DEF_BLE_MTU_SIZE;
+        gatt.connection_status.bd_addr = replay_peer;
+        gatt.connection_status.conn_id = replay_conn_id;
+        gatt.connection_status.connected = WICED_TRUE;
+        gatt.connection_status.transport = BT_TRANSPORT_LE;
+        (void)host_bt_gatt_event(GATT_CONNECTION_STATUS_EVT, &gatt);
+        host_settle();
+    }
+    else if (0 == strcmp(p_cmd, "disconnect") && (ntok <= 2))
+    {
+        gatt.connection_status.bd_addr = replay_peer;
+        gatt.connection_status.conn_id = replay_conn_id;
+        gatt.connection_status.connected = WICED_FALSE;
+        gatt.connection_status.reason = (2 == ntok) ? (uint16_t)arg1 : GATT_CONN_TERMINATE_PEER_USER;
+        gatt.connection_status.transport = BT_TRANSPORT_LE;
+        (void)host_bt_gatt_event(GATT_CONNECTION_STATUS_EVT, &gatt);
+        host_settle();
+    }
+    else if (0 == strcmp(p_cmd, "security_request") && has_addr && (2 == ntok))
+    {
+        memcpy(mgmt.security_request.bd_addr, bda, BD_ADDR_LEN);
+        replay_mgmt(BTM_SECURITY_REQUEST_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "io_caps") && has_addr && (2 == ntok))
+    {
+        memcpy(mgmt.pairing_io_capabilities_ble_request.bd_addr, bda, BD_ADDR_LEN);
+        replay_mgmt(BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "confirm") && has_addr && (3 == ntok))
+    {
+        memcpy(mgmt.user_confirmation_request.bd_addr, bda, BD_ADDR_LEN);
+        mgmt.user_confirmation_request.numeric_value = (uint32_t)arg2;
+        replay_mgmt(BTM_USER_CONFIRMATION_REQUEST_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "passkey") && has_addr && (3 == ntok))
+    {
+        memcpy(mgmt.user_passkey_notification.bd_addr, bda, BD_ADDR_LEN);
+        mgmt.user_passkey_notification.passkey = (uint32_t)arg2;
+        replay_mgmt(BTM_PASSKEY_NOTIFICATION_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "keys_update") && has_addr && (2 == ntok))
+    {
+        replay_link_keys(bda, &mgmt.paired_device_link_keys_update);
+        replay_mgmt(BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "keys_request") && has_addr && (2 == ntok))
+    {
+        memcpy(mgmt.paired_device_link_keys_request.bd_addr, bda, BD_ADDR_LEN);
+        replay_mgmt(BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "pairing_complete") && has_addr && (ntok <= 3))
+    {
+        memcpy(mgmt.pairing_complete.bd_addr, bda, BD_ADDR_LEN);
+        mgmt.pairing_complete.transport = BT_TRANSPORT_LE;
+        mgmt.pairing_complete.pairing_complete_info.ble.reason = (wiced_bt_smp_status_t)arg2;
+        replay_mgmt(BTM_PAIRING_COMPLETE_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "encryption") && has_addr && (ntok <= 3))
+    {
+        memcpy(mgmt.encryption_status.bd_addr, bda, BD_ADDR_LEN);
+        mgmt.encryption_status.transport = BT_TRANSPORT_LE;
+        mgmt.encryption_status.result = (wiced_result_t)arg2;
+        replay_mgmt(BTM_ENCRYPTION_STATUS_EVT, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "conn_params") && (4 == ntok))
+    {
+        memcpy(mgmt.ble_connection_param_update.bd_addr, replay_peer, BD_ADDR_LEN);
+        mgmt.ble_connection_param_update.status = WICED_BT_SUCCESS;
+        mgmt.ble_connection_param_update.conn_interval = (uint16_t)arg1;
+        mgmt.ble_connection_param_update.conn_latency = (uint16_t)arg2;
+        mgmt.ble_connection_param_update.supervision_timeout = (uint16_t)arg3;
+        replay_mgmt(BTM_BLE_CONNECTION_PARAM_UPDATE, &mgmt);
+    }
+    else if (0 == strcmp(p_cmd, "mtu") && (2 == ntok))
+    {
+        req.opcode = GATT_REQ_MTU;
+        req.data.remote_mtu = (uint16_t)arg1;
+        replay_attr_req(&req);
+        replay_mtu = (uint16_t)MIN(arg1, wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
+    }
+    else if (0 == strcmp(p_cmd, "read") && (2 <= ntok) && (ntok <= 3))
+    {
+        req.opcode = (3 == ntok) ? GATT_REQ_READ_BLOB : GATT_REQ_READ;
+        req.len_requested = replay_mtu - 1;
+        req.data.read_req.handle = (uint16_t)arg1;
+        req.data.read_req.offset = (uint16_t)arg2;
+        replay_attr_req(&req);
+    }
+    else if (0 == strcmp(p_cmd, "read_by_type") && (4 == ntok))
+    {
+        req.opcode = GATT_REQ_READ_BY_TYPE;
+        req.len_requested = replay_mtu - 1;
+        req.data.read_by_type.s_handle = (uint16_t)arg1;
+        req.data.read_by_type.e_handle = (uint16_t)arg2;
+        req.data.read_by_type.uuid.len = 2;
+        req.data.read_by_type.uuid.uu.uuid16 = (uint16_t)arg3;
+        replay_attr_req(&req);
+    }
+    else if (((0 == strcmp(p_cmd, "read_multi")) || (0 == strcmp(p_cmd, "read_multi_var"))) && (2 <= ntok))
+    {
+        req.opcode = (0 == strcmp(p_cmd, "read_multi")) ? GATT_REQ_READ_MULTI : GATT_REQ_READ_MULTI_VAR;
+        req.len_requested = replay_mtu - 1;
+        req.data.read_multiple_req.num_handles = (uint16_t)(ntok - 1);
+        req.data.read_multiple_req.p_handle_stream = value;
+        for (uint32_t i = 1; i < ntok; i++)
+        {
+            uint16_t handle = (uint16_t)strtoul(pp_tok[i], NULL, 0);
+
+            value[2 * (i - 1)] = (uint8_t)handle;
+            value[2 * (i - 1) + 1] = (uint8_t)(handle >> 8);
+        }
+        replay_attr_req(&req);
+    }
+    else if (0 == strcmp(p_cmd, "congestion") && (2 == ntok))
+    {
+        gatt.congestion.conn_id = replay_conn_id;
+        gatt.congestion.congested = (0 != arg1) ? WICED_TRUE : WICED_FALSE;
+        (void)host_bt_gatt_event(GATT_CONGESTION_EVT, &gatt);
+        host_settle();
+    }
+    else if (((0 == strcmp(p_cmd, "write")) || (0 == strcmp(p_cmd, "write_cmd"))) && (3 == ntok))
+    {
+        req.opcode = (0 == strcmp(p_cmd, "write")) ? GATT_REQ_WRITE : GATT_CMD_WRITE;
+        req.data.write_req.handle = (uint16_t)arg1;
+        req.data.write_req.p_val = value;
+        req.data.write_req.val_len = (uint16_t)replay_parse_hex(pp_tok[2], value, sizeof(value));
+        if (0 == req.data.write_req.val_len)
+        {
+            return false;
+        }
+        replay_attr_req(&req);
+    }
+    else if (0 == strcmp(p_cmd, "buffer") && (2 == ntok))
+    {
+        /* The stack asks for a response buffer, then gives it back once sent */
+        gatt.buffer_request.len_requested = (uint16_t)arg1;
+        (void)host_bt_gatt_event(GATT_GET_RESPONSE_BUFFER_EVT, &gatt);
+        if (NULL != gatt.buffer_request.buffer.p_app_rsp_buffer)
+        {
+            wiced_bt_gatt_event_data_t xmitted;
+
+            memset(&xmitted, 0, sizeof(xmitted));
+            xmitted.buffer_xmitted.p_app_data = gatt.buffer_request.buffer.p_app_rsp_buffer;
+            xmitted.buffer_xmitted.len = (uint16_t)arg1;
+            xmitted.buffer_xmitted.p_app_ctxt = gatt.buffer_request.buffer.p_app_ctxt;
+            (void)host_bt_gatt_event(GATT_APP_BUFFER_TRANSMITTED_EVT, &xmitted);
+        }
+        host_settle();
+    }
+    else if (0 == strcmp(p_cmd, "expect") && (3 == ntok))
+    {
+        return replay_expect(pp_tok[1], strtoull(pp_tok[2], NULL, 0));
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* replay_load
+*
+* Function Description:
+* @brief   This function reads a script, without its comments and blank lines.
+*
+* @param   p_script: Script
+* @param   p_path: File
+*
+* @return  bool: false if the file cannot be read or is too long
+*/
+static bool replay_load(replay_script_t *p_script, const char *p_path)
+{
+    char line[REPLAY_LINE_MAX];
+    FILE *p_file = fopen(p_path, "r");
+
+    memset(p_script, 0, sizeof(*p_script));
+    p_script->p_path = p_path;
+    if (NULL == p_file)
+    {
+        perror(p_path);
+        return false;
+    }
+    while (NULL != fgets(line, sizeof(line), p_file))
+    {
+        char *p_start = line;
+
+        line[strcspn(line, "#\r\n")] = '\0';
+        while (isspace((unsigned char)*p_start))
+        {
+            p_start++;
+        }
+        /* Blank lines are kept so errors give the line number */
+        p_script->p_lines[p_script->count++] = ('\0' == *p_start) ? NULL : strdup(p_start);
+        if (REPLAY_LINES_MAX <= p_script->count)
+        {
+            fprintf(stderr, "%s: more than %u lines\n", p_path, REPLAY_LINES_MAX);
+            fclose(p_file);
+            return false;
+        }
+    }
+    fclose(p_file);
+    return true;
+}
+
+/**
+* Function Name:
+* replay_run
+*
+* Function Description:
+* @brief   This function runs a script, with its repeat blocks.
+*
+* @param   p_script: Script
+*
+* @return  bool: false on the first invalid line or failed expectation
+*/
+static bool replay_run(replay_script_t *p_script)
+{
+    uint32_t line = 0;
+
+    while (line < p_script->count)
+    {
+        char buf[REPLAY_LINE_MAX];
+        char *p_tok[REPLAY_TOKENS_MAX] = { NULL };
+        char *p_save = NULL;
+        uint32_t ntok = 0;
+
+        if (NULL == p_script->p_lines[line])
+        {
+            line++;
+            continue;
+        }
+        snprintf(buf, sizeof(buf), "%s", p_script->p_lines[line]);
+        for (char *p = strtok_r(buf, " \t", &p_save); (NULL != p) && (ntok < REPLAY_TOKENS_MAX);
+             p = strtok_r(NULL, " \t", &p_save))
+        {
+            p_tok[ntok++] = p;
+        }
+
+        if ((0 == strcmp(p_tok[0], "repeat")) && (2 == ntok) && (p_script->depth < REPLAY_REPEAT_DEPTH))
+        {
+            p_script->repeat_line[p_script->depth] = line + 1;
+            p_script->repeat_left[p_script->depth++] = (uint32_t)strtoul(p_tok[1], NULL, 0);
+            line++;
+        }
+        else if ((0 == strcmp(p_tok[0], "end")) && (1 == ntok) && (0 < p_script->depth))
+        {
+            if (1 < p_script->repeat_left[p_script->depth - 1]--)
+            {
+                line = p_script->repeat_line[p_script->depth - 1];
+            }
+            else
+            {
+                p_script->depth--;
+                line++;
+            }
+        }
+        else if (replay_step(p_tok, ntok))
+        {
+            line++;
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: failed: %s\n", p_script->p_path, line + 1, p_script->p_lines[line]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* replay_report
+*
+* Function Description:
+* @brief   This function prints the cost of every event handled, in the
+*          format of the budget file.
+*
+* @param   None
+*
+* @return  None
+*/
+static void replay_report(void)
+{
+    host_heap_stats_t heap;
+    const host_kvstore_stats_t *p_kv = host_kvstore_get_stats();
+
+    host_heap_get_stats(&heap, false);
+    fprintf(replay_out, "%u events over %.3f s of virtual time\n", replay_events, host_clock_us() / 1e6);
+    fprintf(replay_out, "All threads: %llu allocations, %lld bytes not freed, kv-store %u reads %u writes %u deletes\n\n",
+            (unsigned long long)heap.allocs, (long long)heap.in_use, p_kv->reads, p_kv->writes, p_kv->deletes);
+    fprintf(replay_out, "# %-44s %7s %9s %9s %7s %8s %9s\n", "Handler", "calls", "cpu us", "max us",
+            "allocs", "kv reads", "kv writes");
+    fprintf(replay_out, "# %-44s %7s %9s %9s %7s %8s %9s\n", "", "", "(mean)", "", "(max)", "(max)", "(max)");
+    for (uint32_t i = 0; i < replay_handler_count; i++)
+    {
+        const replay_handler_t *p_h = &replay_handlers[i];
+
+        fprintf(replay_out, "  %-44s %7u %9.2f %9.2f %7llu %8llu %9llu\n", p_h->name, p_h->calls,
+                p_h->cpu_ns / 1e3 / MAX(p_h->calls, 1u), p_h->cpu_ns_max / 1e3,
+                (unsigned long long)p_h->allocs_max, (unsigned long long)p_h->kv_reads_max,
+                (unsigned long long)p_h->kv_writes_max);
+    }
+}
+
+/**
+* Function Name:
+* replay_check_budget
+*
+* Function Description:
+* @brief   This function checks the cost of the handlers against a budget
+*          file. Each line is a handler name followed by its mean CPU time
+*          in us and its maximum allocations, kv-store reads and kv-store
+*          writes per call; - leaves a column unchecked. Handlers not in the
+*          budget are not checked.
+*
+* @param   p_path: Budget file
+*
+* @return  bool: false if a handler is over its budget
+*/
+static bool replay_check_budget(const char *p_path)
+{
+    char line[REPLAY_LINE_MAX];
+    bool within = true;
+    FILE *p_file = fopen(p_path, "r");
+
+    if (NULL == p_file)
+    {
+        perror(p_path);
+        return false;
+    }
+    while (NULL != fgets(line, sizeof(line), p_file))
+    {
+        char name[REPLAY_NAME_MAX];
+        char col[4][16];
+        double limit[4];
+        double actual[4];
+        const replay_handler_t *p_h = NULL;
+
+        line[strcspn(line, "#\r\n")] = '\0';
+        if (5 != sscanf(line, "%47s %15s %15s %15s %15s", name, col[0], col[1], col[2], col[3]))
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < replay_handler_count; i++)
+        {
+            if (0 == strcmp(replay_handlers[i].name, name))
+            {
+                p_h = &replay_handlers[i];
+            }
+        }
+        if ((NULL == p_h) || (0 == p_h->calls))
+        {
+            continue;
+        }
+        actual[0] = p_h->cpu_ns / 1e3 / p_h->calls;
+        actual[1] = (double)p_h->allocs_max;
+        actual[2] = (double)p_h->kv_reads_max;
+        actual[3] = (double)p_h->kv_writes_max;
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            static const char *const col_names[4] = { "cpu us", "allocs", "kv reads", "kv writes" };
+
+            limit[i] = (0 == strcmp(col[i], "-")) ? REPLAY_UNCHECKED : strtod(col[i], NULL);
+            if ((REPLAY_UNCHECKED != limit[i]) && (limit[i] < actual[i]))
+            {
+                fprintf(replay_out, "OVER BUDGET: %s %s %.2f, budget %.2f\n", name, col_names[i],
+                        actual[i], limit[i]);
+                within = false;
+            }
+        }
+    }
+    fclose(p_file);
+    return within;
+}
+
+/**
+* Function Name:
+* usage
+*
+* Function Description:
+* @brief   This function prints the options and exits.
+*
+* @param   p_name: Name of the program
+*
+* @return  None
+*/
+static void usage(const char *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-v] [-b budget] script...\n"
+            "  -v  print the terminal output of the application\n"
+            "  -b  fail if a handler is over its budget\n",
+            p_name);
+    exit(EXIT_FAILURE);
+}
+
+/**
+* Function Name:
+* main
+*
+* Function Description:
+* @brief   Entry of the replay. The application boots on a fresh kv-store,
+*          then every script runs in turn on the same application.
+*
+* @param   argc: Number of arguments
+* @param   argv: Arguments
+*
+* @return  int: EXIT_SUCCESS if every script ran and the budget is met
+*/
+int main(int argc, char *argv[])
+{
+    const char *p_budget = NULL;
+    bool verbose = false;
+    bool ok = true;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "vb:")))
+    {
+        switch (opt)
+        {
+            case 'v':
+                verbose = true;
+                break;
+            case 'b':
+                p_budget = optarg;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind == argc)
+    {
+        usage(argv[0]);
+    }
+
+    /* Keep the report apart from the terminal output of the application */
+    replay_out = fdopen(dup(STDOUT_FILENO), "w");
+    setvbuf(replay_out, NULL, _IOLBF, 0);
+    if (!verbose && (NULL == freopen("/dev/null", "w", stdout)))
+    {
+        perror("/dev/null");
+        return EXIT_FAILURE;
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    host_bt_set_hook(replay_hook);
+    (void)app_main();
+    host_settle();
+
+    for (int i = optind; ok && (i < argc); i++)
+    {
+        replay_script_t script;
+
+        fprintf(replay_out, "Replaying %s\n", argv[i]);
+        ok = replay_load(&script, argv[i]) && replay_run(&script);
+        for (uint32_t line = 0; line < script.count; line++)
+        {
+            free(script.p_lines[line]);
+        }
+    }
+
+    replay_report();
+    if (ok && (NULL != p_budget))
+    {
+        ok = replay_check_budget(p_budget);
+        fprintf(replay_out, "%s budget %s\n", ok ? "Within" : "Over", p_budget);
+    }
+    fflush(stdout);
+    fflush(replay_out);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,945 @@
+/******************************************************************************
+* File Name:   host_rtos.c
+*
+* Description: This file implements the RTOS abstraction of the host build on
+*              pthreads, with a virtual clock. Time only moves when the host
+*              advances it, so a run is repeatable and as fast as the host.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cyabs_rtos.h"
+#include "tx_api.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Stack of the pthreads, the stacks given by the application stay unused */
+#define HOST_THREAD_STACK_SIZE              (256u * 1024u)
+
+#define HOST_NEVER                          UINT64_MAX
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* What a thread is blocked on */
+typedef enum
+{
+    HOST_WAIT_NONE,
+    HOST_WAIT_QUEUE_GET,
+    HOST_WAIT_QUEUE_PUT,
+    HOST_WAIT_NOTIFICATION,
+    HOST_WAIT_DELAY,
+    HOST_WAIT_MUTEX,
+    HOST_WAIT_EXITED
+} host_wait_t;
+
+struct host_thread
+{
+    TX_THREAD               tx;
+    pthread_t               pthread;
+    cy_thread_entry_fn_t    entry;
+    cy_thread_arg_t         arg;
+    host_wait_t             wait;
+    void                    *p_wait_obj;
+    uint64_t                deadline_us;
+    bool                    notified;
+    struct host_thread      *next;
+};
+
+struct host_queue
+{
+    uint8_t     *p_items;
+    size_t      length;
+    size_t      itemsize;
+    size_t      head;
+    size_t      count;
+};
+
+struct host_mutex
+{
+    struct host_thread      *owner;
+    uint32_t                depth;
+    bool                    recursive;
+};
+
+struct host_timer
+{
+    cy_timer_trigger_type_t type;
+    cy_timer_callback_t     fun;
+    cy_timer_callback_arg_t arg;
+    bool                    running;
+    uint64_t                deadline_us;
+    uint64_t                period_us;
+    struct host_timer       *next;
+};
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+/* One lock for every RTOS object, so the idle state is read consistently */
+static pthread_mutex_t      host_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t       host_cond = PTHREAD_COND_INITIALIZER;
+
+/* Interrupts and critical sections exclude each other */
+static pthread_mutex_t      host_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static uint64_t             host_now_us;
+static struct host_thread   *host_threads;
+static struct host_timer    *host_timers;
+
+/* The RTOS thread running, or NULL for the threads of the host itself, which
+ * use host_foreign to wait */
+static __thread struct host_thread  *host_self;
+static __thread struct host_thread  host_foreign;
+
+/* Threads created, read by the stack monitor */
+TX_THREAD                   *_tx_thread_created_ptr;
+ULONG                       _tx_thread_created_count;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static bool     host_wait_ready     (const struct host_thread *p_thread);
+static bool     host_can_run        (const struct host_thread *p_thread);
+static bool     host_idle_locked    (void);
+static bool     host_block          (host_wait_t wait, void *p_obj, cy_time_t timeout_ms);
+static void     *host_thread_main   (void *arg);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* host_wait_ready
+*
+* Function Description:
+* @brief   This function checks if the object a thread waits on is ready.
+*          Called with host_lock held.
+*
+* @param   p_thread: Waiting thread
+*
+* @return  bool: true if the wait is over
+*/
+static bool host_wait_ready(const struct host_thread *p_thread)
+{
+    const struct host_queue *p_queue = (const struct host_queue *)p_thread->p_wait_obj;
+    const struct host_mutex *p_mutex = (const struct host_mutex *)p_thread->p_wait_obj;
+
+    switch (p_thread->wait)
+    {
+        case HOST_WAIT_NONE:
+            return true;
+        case HOST_WAIT_QUEUE_GET:
+            return (0 < p_queue->count);
+        case HOST_WAIT_QUEUE_PUT:
+            return (p_queue->count < p_queue->length);
+        case HOST_WAIT_NOTIFICATION:
+            return p_thread->notified;
+        case HOST_WAIT_MUTEX:
+            return ((NULL == p_mutex->owner) || (p_thread == p_mutex->owner));
+        case HOST_WAIT_DELAY:
+        case HOST_WAIT_EXITED:
+        default:
+            return false;
+    }
+}
+
+/**
+* Function Name:
+* host_can_run
+*
+* Function Description:
+* @brief   This function checks if a thread is running or about to run,
+*          because its wait is over or timed out. Called with host_lock held.
+*
+* @param   p_thread: Thread
+*
+* @return  bool: true if the thread can run
+*/
+static bool host_can_run(const struct host_thread *p_thread)
+{
+    if (HOST_WAIT_EXITED == p_thread->wait)
+    {
+        return false;
+    }
+    return (host_wait_ready(p_thread) || (p_thread->deadline_us <= host_now_us));
+}
+
+/**
+* Function Name:
+* host_idle_locked
+*
+* Function Description:
+* @brief   This function checks if no RTOS thread can run. Called with
+*          host_lock held.
+*
+* @param   None
+*
+* @return  bool: true if idle
+*/
+static bool host_idle_locked(void)
+{
+    for (const struct host_thread *p_thread = host_threads; NULL != p_thread; p_thread = p_thread->next)
+    {
+        if (host_can_run(p_thread))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* Function Name:
+* host_block
+*
+* Function Description:
+* @brief   This function blocks the calling thread until the object is ready
+*          or the timeout expires on the virtual clock. Called with host_lock
+*          held. A thread of the host cannot wait for the clock it advances,
+*          it waits at most until the RTOS threads are idle.
+*
+* @param   wait: Kind of object
+* @param   p_obj: Object waited on
+* @param   timeout_ms: Timeout, CY_RTOS_NEVER_TIMEOUT to wait forever
+*
+* @return  bool: true if the object is ready, false on timeout
+*/
+static bool host_block(host_wait_t wait, void *p_obj, cy_time_t timeout_ms)
+{
+    struct host_thread *p_self = (NULL != host_self) ? host_self : &host_foreign;
+    bool ready;
+
+    p_self->wait = wait;
+    p_self->p_wait_obj = p_obj;
+    p_self->deadline_us = (CY_RTOS_NEVER_TIMEOUT == timeout_ms) ?
+                          HOST_NEVER : (host_now_us + (uint64_t)timeout_ms * 1000u);
+
+    /* The host may be waiting for this thread to block */
+    pthread_cond_broadcast(&host_cond);
+
+    while (!host_wait_ready(p_self))
+    {
+        if ((NULL != host_self) ? (p_self->deadline_us <= host_now_us) :
+            ((0 == timeout_ms) || host_idle_locked()))
+        {
+            break;
+        }
+        pthread_cond_wait(&host_cond, &host_lock);
+    }
+
+    ready = host_wait_ready(p_self);
+    p_self->wait = HOST_WAIT_NONE;
+    p_self->deadline_us = HOST_NEVER;
+    return ready;
+}
+
+/**
+* Function Name:
+* host_thread_main
+*
+* Function Description:
+* @brief   This function is the pthread entry of an RTOS thread.
+*
+* @param   arg: The host_thread
+*
+* @return  void *: NULL
+*/
+static void *host_thread_main(void *arg)
+{
+    host_self = (struct host_thread *)arg;
+    host_self->entry(host_self->arg);
+
+    pthread_mutex_lock(&host_lock);
+    host_self->wait = HOST_WAIT_EXITED;
+    pthread_cond_broadcast(&host_cond);
+    pthread_mutex_unlock(&host_lock);
+    return NULL;
+}
+
+/**
+* Function Name:
+* host_rtos_wait_idle
+*
+* Function Description:
+* @brief   This function waits until every RTOS thread is blocked on an object
+*          that is not ready, with a timeout later than the virtual time.
+*
+* @param   None
+*
+* @return  None
+*/
+void host_rtos_wait_idle(void)
+{
+    pthread_mutex_lock(&host_lock);
+    while (!host_idle_locked())
+    {
+        pthread_cond_wait(&host_cond, &host_lock);
+    }
+    pthread_mutex_unlock(&host_lock);
+}
+
+/**
+* Function Name:
+* host_settle
+*
+* Function Description:
+* @brief   This function lets the application handle everything pending: the
+*          RTOS threads run until idle and the deferred stack events are
+*          delivered, until neither has anything left.
+*
+* @param   None
+*
+* @return  None
+*/
+void host_settle(void)
+{
+    do
+    {
+        host_rtos_wait_idle();
+    } while (host_bt_run_pending());
+}
+
+/**
+* Function Name:
+* host_clock_us
+*
+* Function Description:
+* @brief   This function returns the virtual time.
+*
+* @param   None
+*
+* @return  uint64_t: Time since the start, in us
+*/
+uint64_t host_clock_us(void)
+{
+    uint64_t now;
+
+    pthread_mutex_lock(&host_lock);
+    now = host_now_us;
+    pthread_mutex_unlock(&host_lock);
+    return now;
+}
+
+/**
+* Function Name:
+* host_clock_advance_us
+*
+* Function Description:
+* @brief   This function advances the virtual clock. The clock stops at each
+*          timer expiry and timeout on the way, the timer callback runs as an
+*          interrupt and the application settles before the clock moves on.
+*
+* @param   delta_us: Time to advance by
+*
+* @return  None
+*/
+void host_clock_advance_us(uint64_t delta_us)
+{
+    uint64_t target;
+    struct host_timer *p_expired;
+
+    host_settle();
+
+    pthread_mutex_lock(&host_lock);
+    target = host_now_us + delta_us;
+    for (;;)
+    {
+        uint64_t next = target;
+
+        p_expired = NULL;
+        for (struct host_timer *p_timer = host_timers; NULL != p_timer; p_timer = p_timer->next)
+        {
+            if (p_timer->running && (p_timer->deadline_us <= next))
+            {
+                /* The first created wins a tie */
+                if ((NULL == p_expired) || (p_timer->deadline_us < next))
+                {
+                    p_expired = p_timer;
+                    next = p_timer->deadline_us;
+                }
+            }
+        }
+        for (struct host_thread *p_thread = host_threads; NULL != p_thread; p_thread = p_thread->next)
+        {
+            if ((HOST_WAIT_NONE != p_thread->wait) && (host_now_us < p_thread->deadline_us) &&
+                (p_thread->deadline_us < next))
+            {
+                p_expired = NULL;
+                next = p_thread->deadline_us;
+            }
+        }
+
+        if (next > host_now_us)
+        {
+            host_now_us = next;
+        }
+        pthread_cond_broadcast(&host_cond);
+
+        if (NULL != p_expired)
+        {
+            cy_timer_callback_t fun = p_expired->fun;
+            cy_timer_callback_arg_t arg = p_expired->arg;
+
+            if (CY_TIMER_TYPE_PERIODIC == p_expired->type)
+            {
+                p_expired->deadline_us += p_expired->period_us;
+            }
+            else
+            {
+                p_expired->running = false;
+            }
+
+            pthread_mutex_unlock(&host_lock);
+            host_irq_enter();
+            fun(arg);
+            host_irq_exit();
+            host_settle();
+            pthread_mutex_lock(&host_lock);
+        }
+        else if (next < target)
+        {
+            /* A timeout expired, let the thread run */
+            pthread_mutex_unlock(&host_lock);
+            host_settle();
+            pthread_mutex_lock(&host_lock);
+        }
+        else
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&host_lock);
+
+    host_settle();
+}
+
+/**
+* Function Name:
+* host_irq_enter
+*
+* Function Description:
+* @brief   This function starts an interrupt, waiting for any critical
+*          section of the application to end.
+*
+* @param   None
+*
+* @return  None
+*/
+void host_irq_enter(void)
+{
+    pthread_mutex_lock(&host_irq_lock);
+}
+
+/**
+* Function Name:
+* host_irq_exit
+*
+* Function Description:
+* @brief   This function ends an interrupt.
+*
+* @param   None
+*
+* @return  None
+*/
+void host_irq_exit(void)
+{
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+/**
+* Function Name:
+* cyhal_system_critical_section_enter
+*
+* Function Description:
+* @brief   This function starts a critical section, excluding the interrupts.
+*
+* @param   None
+*
+* @return  uint32_t: State to give back to cyhal_system_critical_section_exit
+*/
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    pthread_mutex_lock(&host_irq_lock);
+    return 0;
+}
+
+/**
+* Function Name:
+* cyhal_system_critical_section_exit
+*
+* Function Description:
+* @brief   This function ends a critical section.
+*
+* @param   old_state: State returned by cyhal_system_critical_section_enter
+*
+* @return  None
+*/
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+/**
+* Function Name:
+* cy_rtos_thread_create
+*
+* Function Description:
+* @brief   This function creates a thread on a pthread. The priority is not
+*          modelled: the threads run in parallel.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the thread was created
+*/
+cy_rslt_t cy_rtos_thread_create(cy_thread_t *thread, cy_thread_entry_fn_t entry_function,
+                                const char *name, void *stack, uint32_t stack_size,
+                                cy_thread_priority_t priority, cy_thread_arg_t arg)
+{
+    struct host_thread *p_thread = calloc(1, sizeof(*p_thread));
+    pthread_attr_t attr;
+    int err;
+
+    if (NULL == p_thread)
+    {
+        return CY_RTOS_NO_MEMORY;
+    }
+
+    p_thread->tx.tx_thread_name = (CHAR *)name;
+    p_thread->tx.tx_thread_stack_start = stack;
+    p_thread->tx.tx_thread_stack_end = (uint8_t *)stack + stack_size - 1;
+    p_thread->tx.tx_thread_stack_ptr = p_thread->tx.tx_thread_stack_end;
+    p_thread->tx.tx_thread_stack_size = stack_size;
+    p_thread->tx.tx_thread_priority = (UINT)priority;
+    p_thread->entry = entry_function;
+    p_thread->arg = arg;
+    p_thread->wait = HOST_WAIT_NONE;
+    p_thread->deadline_us = HOST_NEVER;
+
+    pthread_mutex_lock(&host_lock);
+    /* ThreadX keeps the created threads in a circular list */
+    if (NULL == _tx_thread_created_ptr)
+    {
+        p_thread->tx.tx_thread_created_next = &p_thread->tx;
+        p_thread->tx.tx_thread_created_previous = &p_thread->tx;
+        _tx_thread_created_ptr = &p_thread->tx;
+    }
+    else
+    {
+        TX_THREAD *p_last = _tx_thread_created_ptr->tx_thread_created_previous;
+
+        p_thread->tx.tx_thread_created_next = _tx_thread_created_ptr;
+        p_thread->tx.tx_thread_created_previous = p_last;
+        p_last->tx_thread_created_next = &p_thread->tx;
+        _tx_thread_created_ptr->tx_thread_created_previous = &p_thread->tx;
+    }
+    p_thread->tx.tx_thread_id = ++_tx_thread_created_count;
+    p_thread->next = host_threads;
+    host_threads = p_thread;
+    *thread = p_thread;
+    pthread_mutex_unlock(&host_lock);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, HOST_THREAD_STACK_SIZE);
+    err = pthread_create(&p_thread->pthread, &attr, host_thread_main, p_thread);
+    pthread_attr_destroy(&attr);
+    if (0 != err)
+    {
+        fprintf(stderr, "host: cannot create thread %s\n", name);
+        abort();
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_thread_set_notification
+*
+* Function Description:
+* @brief   This function notifies a thread.
+*
+* @param   thread: Thread to notify
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_thread_set_notification(cy_thread_t *thread)
+{
+    if ((NULL == thread) || (NULL == *thread))
+    {
+        return CY_RTOS_BAD_PARAM;
+    }
+
+    pthread_mutex_lock(&host_lock);
+    (*thread)->notified = true;
+    pthread_cond_broadcast(&host_cond);
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_thread_wait_notification
+*
+* Function Description:
+* @brief   This function waits for a notification of the calling thread.
+*
+* @param   timeout_ms: Timeout
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if notified, CY_RTOS_TIMEOUT otherwise
+*/
+cy_rslt_t cy_rtos_thread_wait_notification(cy_time_t timeout_ms)
+{
+    bool ready;
+
+    pthread_mutex_lock(&host_lock);
+    ready = host_block(HOST_WAIT_NOTIFICATION, NULL, timeout_ms);
+    if (ready)
+    {
+        ((NULL != host_self) ? host_self : &host_foreign)->notified = false;
+    }
+    pthread_mutex_unlock(&host_lock);
+    return ready ? CY_RSLT_SUCCESS : CY_RTOS_TIMEOUT;
+}
+
+/**
+* Function Name:
+* cy_rtos_queue_init
+*
+* Function Description:
+* @brief   This function creates a queue.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the queue was created
+*/
+cy_rslt_t cy_rtos_queue_init(cy_queue_t *queue, size_t length, size_t itemsize)
+{
+    struct host_queue *p_queue = calloc(1, sizeof(*p_queue));
+
+    if ((NULL == p_queue) || (NULL == (p_queue->p_items = calloc(length, itemsize))))
+    {
+        free(p_queue);
+        return CY_RTOS_NO_MEMORY;
+    }
+    p_queue->length = length;
+    p_queue->itemsize = itemsize;
+    *queue = p_queue;
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_queue_put
+*
+* Function Description:
+* @brief   This function adds an item at the end of a queue.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS, or CY_RTOS_QUEUE_FULL on timeout
+*/
+cy_rslt_t cy_rtos_queue_put(cy_queue_t *queue, const void *item_ptr, cy_time_t timeout_ms)
+{
+    struct host_queue *p_queue = *queue;
+    cy_rslt_t rslt = CY_RTOS_QUEUE_FULL;
+
+    pthread_mutex_lock(&host_lock);
+    if (host_block(HOST_WAIT_QUEUE_PUT, p_queue, timeout_ms))
+    {
+        size_t tail = (p_queue->head + p_queue->count) % p_queue->length;
+
+        memcpy(p_queue->p_items + tail * p_queue->itemsize, item_ptr, p_queue->itemsize);
+        p_queue->count++;
+        pthread_cond_broadcast(&host_cond);
+        rslt = CY_RSLT_SUCCESS;
+    }
+    pthread_mutex_unlock(&host_lock);
+    return rslt;
+}
+
+/**
+* Function Name:
+* cy_rtos_queue_get
+*
+* Function Description:
+* @brief   This function removes the item at the head of a queue.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS, or CY_RTOS_QUEUE_EMPTY on timeout
+*/
+cy_rslt_t cy_rtos_queue_get(cy_queue_t *queue, void *item_ptr, cy_time_t timeout_ms)
+{
+    struct host_queue *p_queue = *queue;
+    cy_rslt_t rslt = CY_RTOS_QUEUE_EMPTY;
+
+    pthread_mutex_lock(&host_lock);
+    if (host_block(HOST_WAIT_QUEUE_GET, p_queue, timeout_ms))
+    {
+        memcpy(item_ptr, p_queue->p_items + p_queue->head * p_queue->itemsize, p_queue->itemsize);
+        p_queue->head = (p_queue->head + 1) % p_queue->length;
+        p_queue->count--;
+        pthread_cond_broadcast(&host_cond);
+        rslt = CY_RSLT_SUCCESS;
+    }
+    pthread_mutex_unlock(&host_lock);
+    return rslt;
+}
+
+/**
+* Function Name:
+* cy_rtos_queue_count
+*
+* Function Description:
+* @brief   This function returns the number of items in a queue.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_queue_count(cy_queue_t *queue, size_t *num_waiting)
+{
+    pthread_mutex_lock(&host_lock);
+    *num_waiting = (*queue)->count;
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_mutex_init
+*
+* Function Description:
+* @brief   This function creates a mutex.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the mutex was created
+*/
+cy_rslt_t cy_rtos_mutex_init(cy_mutex_t *mutex, bool recursive)
+{
+    struct host_mutex *p_mutex = calloc(1, sizeof(*p_mutex));
+
+    if (NULL == p_mutex)
+    {
+        return CY_RTOS_NO_MEMORY;
+    }
+    p_mutex->recursive = recursive;
+    *mutex = p_mutex;
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_mutex_get
+*
+* Function Description:
+* @brief   This function takes a mutex.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS, or CY_RTOS_TIMEOUT
+*/
+cy_rslt_t cy_rtos_mutex_get(cy_mutex_t *mutex, cy_time_t timeout_ms)
+{
+    struct host_mutex *p_mutex = *mutex;
+    struct host_thread *p_self = (NULL != host_self) ? host_self : &host_foreign;
+    cy_rslt_t rslt = CY_RTOS_TIMEOUT;
+
+    pthread_mutex_lock(&host_lock);
+    if ((p_self == p_mutex->owner) && !p_mutex->recursive)
+    {
+        rslt = CY_RTOS_GENERAL_ERROR;
+    }
+    else if (host_block(HOST_WAIT_MUTEX, p_mutex, timeout_ms))
+    {
+        p_mutex->owner = p_self;
+        p_mutex->depth++;
+        rslt = CY_RSLT_SUCCESS;
+    }
+    pthread_mutex_unlock(&host_lock);
+    return rslt;
+}
+
+/**
+* Function Name:
+* cy_rtos_mutex_set
+*
+* Function Description:
+* @brief   This function releases a mutex.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS, or an error if not the owner
+*/
+cy_rslt_t cy_rtos_mutex_set(cy_mutex_t *mutex)
+{
+    struct host_mutex *p_mutex = *mutex;
+    struct host_thread *p_self = (NULL != host_self) ? host_self : &host_foreign;
+    cy_rslt_t rslt = CY_RTOS_GENERAL_ERROR;
+
+    pthread_mutex_lock(&host_lock);
+    if (p_self == p_mutex->owner)
+    {
+        if (0 == --p_mutex->depth)
+        {
+            p_mutex->owner = NULL;
+            pthread_cond_broadcast(&host_cond);
+        }
+        rslt = CY_RSLT_SUCCESS;
+    }
+    pthread_mutex_unlock(&host_lock);
+    return rslt;
+}
+
+/**
+* Function Name:
+* cy_rtos_timer_init
+*
+* Function Description:
+* @brief   This function creates a timer on the virtual clock.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS if the timer was created
+*/
+cy_rslt_t cy_rtos_timer_init(cy_timer_t *timer, cy_timer_trigger_type_t type,
+                             cy_timer_callback_t fun, cy_timer_callback_arg_t arg)
+{
+    struct host_timer *p_timer = calloc(1, sizeof(*p_timer));
+    struct host_timer **pp_last;
+
+    if (NULL == p_timer)
+    {
+        return CY_RTOS_NO_MEMORY;
+    }
+    p_timer->type = type;
+    p_timer->fun = fun;
+    p_timer->arg = arg;
+
+    pthread_mutex_lock(&host_lock);
+    /* Keep the order of creation, ties expire in this order */
+    for (pp_last = &host_timers; NULL != *pp_last; pp_last = &(*pp_last)->next)
+    {
+    }
+    *pp_last = p_timer;
+    *timer = p_timer;
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_timer_start
+*
+* Function Description:
+* @brief   This function starts or restarts a timer.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_timer_start(cy_timer_t *timer, cy_time_t num_ms)
+{
+    struct host_timer *p_timer = *timer;
+
+    pthread_mutex_lock(&host_lock);
+    p_timer->period_us = (uint64_t)num_ms * 1000u;
+    p_timer->deadline_us = host_now_us + p_timer->period_us;
+    p_timer->running = true;
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_timer_stop
+*
+* Function Description:
+* @brief   This function stops a timer.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_timer_stop(cy_timer_t *timer)
+{
+    pthread_mutex_lock(&host_lock);
+    (*timer)->running = false;
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_timer_is_running
+*
+* Function Description:
+* @brief   This function checks if a timer is running.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_timer_is_running(cy_timer_t *timer, bool *state)
+{
+    pthread_mutex_lock(&host_lock);
+    *state = (*timer)->running;
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_get_time
+*
+* Function Description:
+* @brief   This function returns the virtual time in ms.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval)
+{
+    *tval = (cy_time_t)(host_clock_us() / 1000u);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+* Function Name:
+* cy_rtos_delay_milliseconds
+*
+* Function Description:
+* @brief   This function blocks the calling thread for a time on the virtual
+*          clock.
+*
+* @return  cy_rslt_t: CY_RSLT_SUCCESS
+*/
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms)
+{
+    pthread_mutex_lock(&host_lock);
+    (void)host_block(HOST_WAIT_DELAY, NULL, num_ms);
+    pthread_mutex_unlock(&host_lock);
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,855 @@
+/******************************************************************************
+* File Name:   host_soak.c
+*
+* Description: This file runs a bond churn soak on the host build: a population of
+*              centrals, each with its identity address and IRK, bonds, reconnects
+*              with a new resolvable private address every time, writes its CCCD and
+*              is evicted when the bond slots run out. It reports the latency of the
+*              bond lookups, link key requests and evictions, and the flash writes
+*              of every connection.
+*
+* Related Document: See README.md
+*
+*******************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "wiced_bt_stack.h"
+#include "wiced_bt_gatt.h"
+#include "cycfg_gatt_db.h"
+#include "app_bt_bonding.h"
+#include "app_bt_adv.h"
+#include "app_bt_privacy.h"
+#include "peripheral_privacy.h"
+#include "host.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define SOAK_DEFAULT_CENTRALS               (300u)
+#define SOAK_DEFAULT_OPS                    (100000u)
+#define SOAK_DEFAULT_CCCD_PCT               (50u)
+#define SOAK_DEFAULT_LOSS_PCT               (0u)
+
+#define SOAK_CONN_ID                        (0x0001u)
+
+/* Virtual time between two connections */
+#define SOAK_DEFAULT_IDLE_MS                (100u)
+
+/* Histogram buckets: exact below 16, then 16 per power of two */
+#define SOAK_HIST_SUB_BITS                  (4u)
+#define SOAK_HIST_BUCKETS                   ((64u - SOAK_HIST_SUB_BITS + 1u) << SOAK_HIST_SUB_BITS)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    const char  *p_name;
+    const char  *p_key;                             /* Name in the parseable report */
+    const char  *p_unit;
+    uint64_t    count;
+    uint64_t    sum;
+    uint64_t    max;
+    uint32_t    buckets[SOAK_HIST_BUCKETS];
+} soak_hist_t;
+
+typedef struct
+{
+    wiced_bt_device_address_t   identity;
+    BT_OCTET16                  irk;
+    bool                        bonded;             /* The central holds keys of the peripheral */
+    bool                        notify;             /* Last CCCD value it wrote */
+    uint32_t                    rpa_seen;           /* Local RPA rotations when it last connected */
+} soak_central_t;
+
+typedef struct
+{
+    uint64_t    connections;
+    uint64_t    reconnections;                      /* Encrypted with the stored keys */
+    uint64_t    keys_lost;                          /* Bonded central the peripheral evicted */
+    uint64_t    bonds;
+    uint64_t    evictions;
+    uint64_t    cccd_writes;
+    uint64_t    link_losses;
+    uint64_t    rpa_changes;                        /* Reconnections to a new local RPA */
+    uint64_t    failures;                           /* Bonding mode refused */
+} soak_counts_t;
+
+/*******************************************************************
+ * Variable Definitions
+ ******************************************************************/
+static soak_central_t       *soak_centrals;
+static soak_counts_t        soak_counts;
+
+static soak_hist_t          soak_find           = { "app_bt_find_device_in_flash", "find_ns", "ns" };
+static soak_hist_t          soak_key_request    = { "link key request", "key_request_ns", "ns" };
+static soak_hist_t          soak_eviction       = { "eviction", "eviction_ns", "ns" };
+static soak_hist_t          soak_kv_writes      = { "flash writes per connection", "kv_writes", "" };
+static soak_hist_t          soak_programmed     = { "bytes programmed per connection", "programmed", "B" };
+
+static soak_hist_t          *soak_hists[] =
+{
+    &soak_find, &soak_key_request, &soak_eviction, &soak_kv_writes, &soak_programmed,
+};
+
+/* State of the pseudo-random sequence, the same on every run */
+static uint64_t             soak_seed = 0x9E3779B97F4A7C15u;
+
+/*******************************************************************
+ * Function Prototypes
+ ******************************************************************/
+static uint32_t     soak_random         (void);
+static uint64_t     soak_now_ns         (void);
+static void         soak_hist_add       (soak_hist_t *p_hist, uint64_t value);
+static uint64_t     soak_hist_pct       (const soak_hist_t *p_hist, uint32_t pct);
+static void         soak_hist_print     (const soak_hist_t *p_hist);
+static bool         soak_set_curve      (wiced_bool_t bonded, const char *p_str);
+static void         soak_mgmt           (wiced_bt_management_evt_t event, const wiced_bt_device_address_t bd_addr);
+static void         soak_connection     (const wiced_bt_device_address_t bd_addr, bool connected,
+                                         wiced_bt_gatt_disconn_reason_t reason);
+static void         soak_write_cccd     (uint16_t value);
+static bool         soak_bond           (soak_central_t *p_central);
+static bool         soak_session        (soak_central_t *p_central, uint32_t cccd_pct, uint32_t loss_pct,
+                                         uint32_t idle_ms);
+static void         soak_report         (bool parseable, uint32_t centrals, double host_s);
+static void         usage               (const char *p_name);
+
+/*******************************************************************************
+ *                              FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/**
+* Function Name:
+* soak_random
+*
+* Function Description:
+* @brief   This function returns the next pseudo-random number (xorshift64*).
+*
+* @param   None
+*
+* @return  uint32_t: Number
+*/
+static uint32_t soak_random(void)
+{
+    soak_seed ^= soak_seed >> 12;
+    soak_seed ^= soak_seed << 25;
+    soak_seed ^= soak_seed >> 27;
+    return (uint32_t)((soak_seed * 0x2545F4914F6CDD1Du) >> 32);
+}
+
+/**
+* Function Name:
+* soak_now_ns
+*
+* Function Description:
+* @brief   This function returns the time of the host.
+*
+* @param   None
+*
+* @return  uint64_t: Time in ns
+*/
+static uint64_t soak_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+* Function Name:
+* soak_hist_add
+*
+* Function Description:
+* @brief   This function counts a value in a histogram.
+*
+* @param   p_hist: Histogram
+* @param   value: Value
+*
+* @return  None
+*/
+static void soak_hist_add(soak_hist_t *p_hist, uint64_t value)
+{
+    uint32_t index = (uint32_t)value;
+
+    if ((1u << SOAK_HIST_SUB_BITS) <= value)
+    {
+        uint32_t msb = 63u - (uint32_t)__builtin_clzll(value);
+
+        index = ((msb - SOAK_HIST_SUB_BITS + 1u) << SOAK_HIST_SUB_BITS) +
+                (uint32_t)((value >> (msb - SOAK_HIST_SUB_BITS)) & ((1u << SOAK_HIST_SUB_BITS) - 1u));
+    }
+    p_hist->buckets[index]++;
+    p_hist->count++;
+    p_hist->sum += value;
+    p_hist->max = (value > p_hist->max) ? value : p_hist->max;
+}
+
+/**
+* Function Name:
+* soak_hist_pct
+*
+* Function Description:
+* @brief   This function returns a percentile of a histogram, the low end of
+*          its bucket, within 1/16 of the value.
+*
+* @param   p_hist: Histogram
+* @param   pct: Percentile, 0 to 100
+*
+* @return  uint64_t: Value
+*/
+static uint64_t soak_hist_pct(const soak_hist_t *p_hist, uint32_t pct)
+{
+    uint64_t rank = ((p_hist->count * pct) + 99u) / 100u;
+    uint64_t seen = 0;
+
+    for (uint32_t index = 0; index < SOAK_HIST_BUCKETS; index++)
+    {
+        seen += p_hist->buckets[index];
+        if ((0 < p_hist->buckets[index]) && (seen >= rank))
+        {
+            uint32_t shift = (index >> SOAK_HIST_SUB_BITS);
+
+            if (0 == shift)
+            {
+                return index;
+            }
+            return (uint64_t)((1u << SOAK_HIST_SUB_BITS) + (index & ((1u << SOAK_HIST_SUB_BITS) - 1u))) << (shift - 1u);
+        }
+    }
+    return p_hist->max;
+}
+
+/**
+* Function Name:
+* soak_hist_print
+*
+* Function Description:
+* @brief   This function prints a line of the report.
+*
+* @param   p_hist: Histogram
+*
+* @return  None
+*/
+static void soak_hist_print(const soak_hist_t *p_hist)
+{
+    if (0 == p_hist->count)
+    {
+        printf("%-32s %10s\n", p_hist->p_name, "-");
+        return;
+    }
+    printf("%-32s %10llu %10.1f %10llu %10llu %10llu %s\n", p_hist->p_name,
+           (unsigned long long)p_hist->count, (double)p_hist->sum / (double)p_hist->count,
+           (unsigned long long)soak_hist_pct(p_hist, 50u), (unsigned long long)soak_hist_pct(p_hist, 99u),
+           (unsigned long long)p_hist->max, p_hist->p_unit);
+}
+
+/**
+* Function Name:
+* soak_set_curve
+*
+* Function Description:
+* @brief   This function replaces an advertising interval curve of the
+*          application, given as in tools/adv_model.py.
+*
+* @param   bonded: WICED_TRUE for the curve used while bonded peers exist
+* @param   p_str: Steps "seconds:interval_ms", separated by commas, the
+*                 first at 0 s
+*
+* @return  bool: false if the curve is not valid
+*/
+static bool soak_set_curve(wiced_bool_t bonded, const char *p_str)
+{
+    adv_sched_step_t steps[ADV_SCHED_MAX_STEPS];
+    uint8_t num_steps = 0;
+    char *p_end;
+
+    while (ADV_SCHED_MAX_STEPS > num_steps)
+    {
+        double seconds = strtod(p_str, &p_end);
+        unsigned long interval_ms;
+
+        if ((p_end == p_str) || (':' != *p_end) || (0 > seconds))
+        {
+            return false;
+        }
+        p_str = p_end + 1;
+        interval_ms = strtoul(p_str, &p_end, 10);
+        if ((p_end == p_str) || (10240u < interval_ms))
+        {
+            return false;
+        }
+        steps[num_steps].elapsed_ms = (uint32_t)(seconds * 1000.0);
+        steps[num_steps].interval = ADV_SCHED_MS_TO_SLOTS(interval_ms);
+        num_steps++;
+        if ('\0' == *p_end)
+        {
+            return (WICED_TRUE == app_bt_adv_set_curve(bonded, steps, num_steps));
+        }
+        if (',' != *p_end)
+        {
+            return false;
+        }
+        p_str = p_end + 1;
+    }
+    return false;
+}
+
+/**
+* Function Name:
+* soak_mgmt
+*
+* Function Description:
+* @brief   This function delivers a management event about a central, then
+*          lets the application handle what it posted.
+*
+* @param   event: BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,
+*                 BTM_USER_CONFIRMATION_REQUEST_EVT, BTM_PAIRING_COMPLETE_EVT
+*                 or BTM_ENCRYPTION_STATUS_EVT
+* @param   bd_addr: Address of the central
+*
+* @return  None
+*/
+static void soak_mgmt(wiced_bt_management_evt_t event, const wiced_bt_device_address_t bd_addr)
+{
+    wiced_bt_management_evt_data_t mgmt;
+
+    memset(&mgmt, 0, sizeof(mgmt));
+    switch (event)
+    {
+        case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT:
+            memcpy(mgmt.pairing_io_capabilities_ble_request.bd_addr, bd_addr, BD_ADDR_LEN);
+            break;
+        case BTM_USER_CONFIRMATION_REQUEST_EVT:
+            memcpy(mgmt.user_confirmation_request.bd_addr, bd_addr, BD_ADDR_LEN);
+            mgmt.user_confirmation_request.numeric_value = soak_random() % 1000000u;
+            break;
+        case BTM_PAIRING_COMPLETE_EVT:
+            memcpy(mgmt.pairing_complete.bd_addr, bd_addr, BD_ADDR_LEN);
+            mgmt.pairing_complete.transport = BT_TRANSPORT_LE;
+            break;
+        default:
+            memcpy(mgmt.encryption_status.bd_addr, bd_addr, BD_ADDR_LEN);
+            mgmt.encryption_status.transport = BT_TRANSPORT_LE;
+            break;
+    }
+    (void)host_bt_management_event(event, &mgmt);
+    host_settle();
+}
+
+/**
+* Function Name:
+* soak_connection
+*
+* Function Description:
+* @brief   This function delivers a connection or disconnection, then lets
+*          the application handle what it posted.
+*
+* @param   bd_addr: Address the connection reports
+* @param   connected: true for a connection
+* @param   reason: Reason of a disconnection
+*
+* @return  None
+*/
+static void soak_connection(const wiced_bt_device_address_t bd_addr, bool connected,
+                            wiced_bt_gatt_disconn_reason_t reason)
+{
+    wiced_bt_gatt_event_data_t gatt;
+    wiced_bt_device_address_t addr;
+
+    memcpy(addr, bd_addr, BD_ADDR_LEN);
+    memset(&gatt, 0, sizeof(gatt));
+    gatt.connection_status.bd_addr = addr;
+    gatt.connection_status.conn_id = SOAK_CONN_ID;
+    gatt.connection_status.connected = connected ? WICED_TRUE : WICED_FALSE;
+    gatt.connection_status.reason = connected ? 0 : reason;
+    gatt.connection_status.transport = BT_TRANSPORT_LE;
+    (void)host_bt_gatt_event(GATT_CONNECTION_STATUS_EVT, &gatt);
+    host_settle();
+}
+
+/**
+* Function Name:
+* soak_write_cccd
+*
+* Function Description:
+* @brief   This function writes the CCCD of the button characteristic.
+*
+* @param   value: GATT_CLIENT_CONFIG_NOTIFICATION or 0
+*
+* @return  None
+*/
+static void soak_write_cccd(uint16_t value)
+{
+    wiced_bt_gatt_event_data_t gatt;
+    uint8_t data[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+
+    memset(&gatt, 0, sizeof(gatt));
+    gatt.attribute_request.conn_id = SOAK_CONN_ID;
+    gatt.attribute_request.opcode = GATT_REQ_WRITE;
+    gatt.attribute_request.data.write_req.handle = HDLD_WICEDBUTTON_MB1_CLIENT_CHAR_CONFIG;
+    gatt.attribute_request.data.write_req.p_val = data;
+    gatt.attribute_request.data.write_req.val_len = sizeof(data);
+    (void)host_bt_gatt_event(GATT_ATTRIBUTE_REQUEST_EVT, &gatt);
+    host_settle();
+    soak_counts.cccd_writes++;
+}
+
+/**
+* Function Name:
+* soak_bond
+*
+* Function Description:
+* @brief   This function bonds a central: the peripheral enters bonding mode,
+*          evicting its oldest bond if the slots are full, then the central
+*          connects with a new address and pairs with numeric comparison. The
+*          connection is left up.
+*
+* @param   p_central: Central
+*
+* @return  bool: false if the peripheral refused to enter bonding mode
+*/
+static bool soak_bond(soak_central_t *p_central)
+{
+    wiced_bt_management_evt_data_t mgmt;
+    wiced_bt_device_link_keys_t *p_keys = &mgmt.paired_device_link_keys_update;
+    wiced_bt_device_address_t rpa;
+    bool full = (BOND_INDEX_MAX == bondinfo.slot_data[NUM_BONDED]);
+    app_action_status_t status;
+    uint64_t start;
+
+    /* As the terminal does from the event loop, with every thread idle */
+    start = soak_now_ns();
+    status = app_action_bond_mode(WICED_TRUE);
+    if (full)
+    {
+        soak_hist_add(&soak_eviction, soak_now_ns() - start);
+        soak_counts.evictions++;
+    }
+    host_settle();
+    if (APP_ACTION_SUCCESS != status)
+    {
+        soak_counts.failures++;
+        return false;
+    }
+
+    host_bt_make_rpa(p_central->irk, soak_random(), rpa);
+    soak_connection(rpa, true, 0);
+    soak_mgmt(BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT, rpa);
+    soak_mgmt(BTM_USER_CONFIRMATION_REQUEST_EVT, rpa);
+    host_uart_rx((const uint8_t *)"y\r", 2);
+    host_settle();
+
+    /* The stack learns the identity of the central and resolves its next
+     * addresses */
+    memset(&mgmt, 0, sizeof(mgmt));
+    memcpy(p_keys->bd_addr, p_central->identity, BD_ADDR_LEN);
+    memcpy(p_keys->conn_addr, rpa, BD_ADDR_LEN);
+    memcpy(p_keys->key_data.irk, p_central->irk, sizeof(BT_OCTET16));
+    for (uint32_t i = 0; i < sizeof(BT_OCTET16); i++)
+    {
+        p_keys->key_data.pltk[i] = (uint8_t)soak_random();
+    }
+    p_keys->key_data.le_keys_available_mask = BTM_LE_KEY_PENC | BTM_LE_KEY_PID;
+    p_keys->key_data.ble_addr_type = BLE_ADDR_PUBLIC;
+    (void)wiced_bt_dev_add_device_to_address_resolution_db(p_keys);
+    (void)host_bt_management_event(BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT, &mgmt);
+    host_settle();
+    soak_mgmt(BTM_PAIRING_COMPLETE_EVT, p_central->identity);
+    soak_mgmt(BTM_ENCRYPTION_STATUS_EVT, p_central->identity);
+
+    p_central->bonded = true;
+    soak_counts.bonds++;
+    return true;
+}
+
+/**
+* Function Name:
+* soak_session
+*
+* Function Description:
+* @brief   This function runs one connection of a central. A bonded central
+*          connects with a new address and encrypts with its keys; if the
+*          peripheral does not know it any more it bonds again, as does a
+*          central that never bonded. A link loss leaves the peripheral
+*          advertising to the central until it comes back.
+*
+* @param   p_central: Central
+* @param   cccd_pct: Chance in percent that the central toggles its CCCD
+* @param   loss_pct: Chance in percent that the link is lost instead of closed
+* @param   idle_ms: Virtual time until the next connection
+*
+* @return  bool: true if the link was lost, the same central connects next
+*/
+static bool soak_session(soak_central_t *p_central, uint32_t cccd_pct, uint32_t loss_pct, uint32_t idle_ms)
+{
+    uint64_t writes = host_kvstore_get_stats()->writes;
+    uint64_t programmed = host_kvstore_get_flash_stats()->programmed_bytes;
+    wiced_bt_management_evt_data_t mgmt;
+    wiced_bt_device_address_t addr;
+    bool connected = false;
+    bool lost = false;
+    uint64_t start;
+
+    soak_counts.connections++;
+    if (p_central->bonded)
+    {
+        wiced_bt_device_address_t rpa;
+        wiced_result_t result;
+
+        /* The controller reports the identity address of the devices it
+         * resolves, the address used otherwise */
+        host_bt_make_rpa(p_central->irk, soak_random(), rpa);
+        if (!host_bt_resolve_rpa(rpa, addr))
+        {
+            memcpy(addr, rpa, BD_ADDR_LEN);
+        }
+
+        start = soak_now_ns();
+        (void)app_bt_find_device_in_flash(addr);
+        soak_hist_add(&soak_find, soak_now_ns() - start);
+
+        soak_connection(addr, true, 0);
+        memset(&mgmt, 0, sizeof(mgmt));
+        memcpy(mgmt.paired_device_link_keys_request.bd_addr, addr, BD_ADDR_LEN);
+        start = soak_now_ns();
+        result = host_bt_management_event(BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT, &mgmt);
+        soak_hist_add(&soak_key_request, soak_now_ns() - start);
+        host_settle();
+
+        if (WICED_BT_SUCCESS == result)
+        {
+            soak_mgmt(BTM_ENCRYPTION_STATUS_EVT, addr);
+            soak_counts.reconnections++;
+            /* The peripheral advertised from an address the central had to
+             * resolve with the IRK it was given */
+            if (host_bt_get_stats()->rpa_rotations != p_central->rpa_seen)
+            {
+                soak_counts.rpa_changes++;
+            }
+            connected = true;
+        }
+        else
+        {
+            /* Evicted: pairing fails, the central drops its keys */
+            soak_connection(addr, false, GATT_CONN_TERMINATE_PEER_USER);
+            p_central->bonded = false;
+            soak_counts.keys_lost++;
+        }
+    }
+    if (!connected)
+    {
+        connected = soak_bond(p_central);
+        memcpy(addr, p_central->identity, BD_ADDR_LEN);
+    }
+
+    if (connected)
+    {
+        p_central->rpa_seen = host_bt_get_stats()->rpa_rotations;
+        if ((soak_random() % 100u) < cccd_pct)
+        {
+            p_central->notify = !p_central->notify;
+            soak_write_cccd(p_central->notify ? GATT_CLIENT_CONFIG_NOTIFICATION : 0);
+        }
+        lost = ((soak_random() % 100u) < loss_pct);
+        soak_counts.link_losses += lost ? 1u : 0u;
+        soak_connection(addr, false, lost ? GATT_CONN_TIMEOUT : GATT_CONN_TERMINATE_PEER_USER);
+    }
+    host_clock_advance_us((uint64_t)idle_ms * 1000u);
+
+    soak_hist_add(&soak_kv_writes, host_kvstore_get_stats()->writes - writes);
+    soak_hist_add(&soak_programmed, host_kvstore_get_flash_stats()->programmed_bytes - programmed);
+    return lost;
+}
+
+/**
+* Function Name:
+* soak_report
+*
+* Function Description:
+* @brief   This function prints the counts and the distributions, as a table
+*          or as one line of name=value for tools/sim_farm.py.
+*
+* @param   parseable: true for one line of name=value
+* @param   centrals: Number of centrals
+* @param   host_s: Time the connections took on the host, in s
+*
+* @return  None
+*/
+static void soak_report(bool parseable, uint32_t centrals, double host_s)
+{
+    const host_bt_stats_t *p_bt = host_bt_get_stats();
+    const host_flash_stats_t *p_flash = host_kvstore_get_flash_stats();
+    double virtual_s = (double)host_clock_us() / 1e6;
+
+    if (parseable)
+    {
+        printf("centrals=%u slots=%u connections=%llu reconnections=%llu keys_lost=%llu bonds=%llu "
+               "evictions=%llu cccd_writes=%llu link_losses=%llu refused=%llu rpa_rotations=%u "
+               "rpa_changes=%llu rpa_estimated=%u",
+               centrals, BOND_INDEX_MAX, (unsigned long long)soak_counts.connections,
+               (unsigned long long)soak_counts.reconnections, (unsigned long long)soak_counts.keys_lost,
+               (unsigned long long)soak_counts.bonds, (unsigned long long)soak_counts.evictions,
+               (unsigned long long)soak_counts.cccd_writes,
+               (unsigned long long)soak_counts.link_losses, (unsigned long long)soak_counts.failures,
+               p_bt->rpa_rotations, (unsigned long long)soak_counts.rpa_changes,
+               privacy_stats.reconnects_rotated);
+        for (uint32_t i = 0; i < (sizeof(soak_hists) / sizeof(soak_hists[0])); i++)
+        {
+            const soak_hist_t *p_hist = soak_hists[i];
+
+            const char *p_sep = "";
+
+            printf(" %s_mean=%.1f %s_p50=%llu %s_p99=%llu %s_max=%llu",
+                   p_hist->p_key, (0 < p_hist->count) ? ((double)p_hist->sum / (double)p_hist->count) : 0.0,
+                   p_hist->p_key, (unsigned long long)soak_hist_pct(p_hist, 50u),
+                   p_hist->p_key, (unsigned long long)soak_hist_pct(p_hist, 99u),
+                   p_hist->p_key, (unsigned long long)p_hist->max);
+            /* The buckets in use, index:count, for merging runs */
+            printf(" %s_hist=", p_hist->p_key);
+            for (uint32_t index = 0; index < SOAK_HIST_BUCKETS; index++)
+            {
+                if (0 < p_hist->buckets[index])
+                {
+                    printf("%s%u:%u", p_sep, index, p_hist->buckets[index]);
+                    p_sep = ",";
+                }
+            }
+        }
+        printf(" adv_events=%llu adv_on_s=%.3f gcs=%u flash_busy_s=%.3f virtual_s=%.3f host_s=%.3f\n",
+               (unsigned long long)p_bt->adv_events, (double)p_bt->adv_on_us / 1e6, p_flash->gcs,
+               (double)p_flash->busy_us / 1e6, virtual_s, host_s);
+        return;
+    }
+
+    printf("%u centrals, %u bond slots, %llu connections in %.1f s of host time, %.0f s of virtual time\n",
+           centrals, BOND_INDEX_MAX, (unsigned long long)soak_counts.connections, host_s, virtual_s);
+    printf("  reconnections %llu, keys lost %llu, bonds %llu, evictions %llu, CCCD writes %llu, "
+           "link losses %llu, refused %llu\n\n",
+           (unsigned long long)soak_counts.reconnections, (unsigned long long)soak_counts.keys_lost,
+           (unsigned long long)soak_counts.bonds, (unsigned long long)soak_counts.evictions,
+           (unsigned long long)soak_counts.cccd_writes, (unsigned long long)soak_counts.link_losses,
+           (unsigned long long)soak_counts.failures);
+    printf("%-32s %10s %10s %10s %10s %10s\n", "", "count", "mean", "p50", "p99", "max");
+    for (uint32_t i = 0; i < (sizeof(soak_hists) / sizeof(soak_hists[0])); i++)
+    {
+        soak_hist_print(soak_hists[i]);
+    }
+    printf("\nAdvertising %.1f%% of the time, %llu events, %.1f per connection\n",
+           100.0 * (double)p_bt->adv_on_us / 1e6 / ((0 < virtual_s) ? virtual_s : 1.0),
+           (unsigned long long)p_bt->adv_events,
+           (double)p_bt->adv_events / (double)((0 < soak_counts.connections) ? soak_counts.connections : 1u));
+    printf("Flash: %u garbage collections, %.3f s busy\n", p_flash->gcs, (double)p_flash->busy_us / 1e6);
+    printf("Local RPA: %u rotations, %llu reconnections to a new address, %u estimated by the application "
+           "out of %u\n", p_bt->rpa_rotations, (unsigned long long)soak_counts.rpa_changes,
+           privacy_stats.reconnects_rotated, privacy_stats.reconnects);
+}
+
+/**
+* Function Name:
+* usage
+*
+* Function Description:
+* @brief   This function prints the options and exits.
+*
+* @param   p_name: Name of the program
+*
+* @return  None
+*/
+static void usage(const char *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-v] [-p] [-c centrals] [-n connections] [-t cccd_percent] [-l loss_percent]\n"
+            "          [-i idle_ms] [-s seed] [-a curve] [-u curve] [-f flash] [-k kvstore_file]\n"
+            "  -v  print the terminal output of the application\n"
+            "  -p  print the report as one line of name=value\n"
+            "  -c  number of centrals, %u by default\n"
+            "  -n  number of connections, %u by default\n"
+            "  -t  chance in percent that a central toggles its CCCD, %u by default\n"
+            "  -l  chance in percent that the link is lost, %u by default\n"
+            "  -i  virtual time between two connections in ms, %u by default\n"
+            "  -s  seed of the random choices\n"
+            "  -a  advertising curve while bonded, e.g. 0:30,30:100,120:1280 (seconds:interval_ms)\n"
+            "  -u  advertising curve while not bonded\n"
+            "  -f  flash of the kv-store, e.g. sector=4096,sectors=8,program=256\n"
+            "  -k  keep the kv-store in the file\n",
+            p_name, SOAK_DEFAULT_CENTRALS, SOAK_DEFAULT_OPS, SOAK_DEFAULT_CCCD_PCT, SOAK_DEFAULT_LOSS_PCT,
+            SOAK_DEFAULT_IDLE_MS);
+    exit(EXIT_FAILURE);
+}
+
+/**
+* Function Name:
+* main
+*
+* Function Description:
+* @brief   Entry of the soak. The application boots on a fresh kv-store, then
+*          centrals picked at random connect one after the other.
+*
+* @param   argc: Number of arguments
+* @param   argv: Arguments
+*
+* @return  int: EXIT_SUCCESS if the peripheral always entered bonding mode
+*/
+int main(int argc, char *argv[])
+{
+    uint32_t centrals = SOAK_DEFAULT_CENTRALS;
+    uint32_t ops = SOAK_DEFAULT_OPS;
+    uint32_t cccd_pct = SOAK_DEFAULT_CCCD_PCT;
+    uint32_t loss_pct = SOAK_DEFAULT_LOSS_PCT;
+    uint32_t idle_ms = SOAK_DEFAULT_IDLE_MS;
+    soak_central_t *p_central = NULL;
+    bool verbose = false;
+    bool parseable = false;
+    FILE *p_out;
+    uint64_t start;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "vpc:n:t:l:i:s:a:u:f:k:")))
+    {
+        switch (opt)
+        {
+            case 'v':
+                verbose = true;
+                break;
+            case 'p':
+                parseable = true;
+                break;
+            case 'c':
+                centrals = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                ops = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                cccd_pct = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                loss_pct = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                idle_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                /* Zero would stop the sequence */
+                soak_seed ^= strtoull(optarg, NULL, 0) * 0x9E3779B97F4A7C15u;
+                soak_seed = (0 != soak_seed) ? soak_seed : 1u;
+                break;
+            case 'a':
+            case 'u':
+                if (!soak_set_curve(('a' == opt) ? WICED_TRUE : WICED_FALSE, optarg))
+                {
+                    usage(argv[0]);
+                }
+                break;
+            case 'k':
+                host_kvstore_set_file(optarg);
+                break;
+            case 'f':
+                if (!host_kvstore_set_flash(optarg))
+                {
+                    usage(argv[0]);
+                }
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if ((optind != argc) || (0 == centrals) || (0xFFFFFFu < centrals) || (0 == ops) || (100u < cccd_pct))
+    {
+        usage(argv[0]);
+    }
+
+    /* Keep the report apart from the terminal output of the application */
+    p_out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!verbose && (NULL == freopen("/dev/null", "w", stdout)))
+    {
+        perror("/dev/null");
+        return EXIT_FAILURE;
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    /* Public identity addresses and IRKs, all different */
+    soak_centrals = calloc(centrals, sizeof(soak_central_t));
+    if (NULL == soak_centrals)
+    {
+        perror("centrals");
+        return EXIT_FAILURE;
+    }
+    for (uint32_t i = 0; i < centrals; i++)
+    {
+        soak_centrals[i].identity[0] = 0x00;
+        soak_centrals[i].identity[1] = 0x50;
+        soak_centrals[i].identity[2] = 0xC2;
+        soak_centrals[i].identity[3] = (uint8_t)(i >> 16);
+        soak_centrals[i].identity[4] = (uint8_t)(i >> 8);
+        soak_centrals[i].identity[5] = (uint8_t)i;
+        for (uint32_t j = 0; j < sizeof(BT_OCTET16); j++)
+        {
+            soak_centrals[i].irk[j] = (uint8_t)soak_random();
+        }
+    }
+
+    (void)app_main();
+    host_settle();
+    host_kvstore_clear_flash_stats();
+
+    start = soak_now_ns();
+    for (uint32_t n = 0; n < ops; n++)
+    {
+        if (NULL == p_central)
+        {
+            p_central = &soak_centrals[soak_random() % centrals];
+        }
+        if (!soak_session(p_central, cccd_pct, loss_pct, idle_ms))
+        {
+            p_central = NULL;
+        }
+    }
+    fflush(stdout);
+
+    stdout = p_out;
+    soak_report(parseable, centrals, (double)(soak_now_ns() - start) / 1e9);
+    fflush(stdout);
+    return (0 == soak_counts.failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
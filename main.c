@@ -51,40 +51,38 @@
 #include "peripheral_privacy.h"
 #include "mtb_kvstore_cat5.h"
 #include "app_bt_bonding.h"
+#include "app_bt_cfg.h"
+#include "app_utils.h"
+#include "app_event.h"
+#include "app_stack_mon.h"
+#include "app_heap.h"
+#include "app_metrics.h"
+#include "app_throughput.h"
+#include "app_uart_rx.h"
+#include "app_ctrl.h"
+#include "app_log.h"
+#include "app_button.h"
+#include "app_power.h"
 #include "cyabs_rtos_impl.h"
 
-#define BUTTON_TASK_STACK_SIZE                    (4096)
-#define BUTTON_TASK_PRIORITY                      (CY_RTOS_PRIORITY_NORMAL)
+/* Single task running the application event loop */
+#define APP_EVENT_TASK_STACK_SIZE                 (4096)
+#define APP_EVENT_TASK_PRIORITY                   (CY_RTOS_PRIORITY_NORMAL)
 
-#define UART_TASK_STACK_SIZE                    (4096)
-#define UART_TASK_PRIORITY                      (CY_RTOS_PRIORITY_NORMAL)
-
-#define LED_TASK_STACK_SIZE                    (4096)
-#define LED_TASK_PRIORITY                      (CY_RTOS_PRIORITY_NORMAL)
+/* Low priority task printing the deferred log records */
+#define APP_LOG_TASK_STACK_SIZE                   (2048)
+#define APP_LOG_TASK_PRIORITY                     (CY_RTOS_PRIORITY_LOW)
 
 
 /*******************************************************************
  * Variable Definitions
  ******************************************************************/
 
-static uint64_t button_task_stack[BUTTON_TASK_STACK_SIZE/8];
-
-static uint64_t uart_task_stack[UART_TASK_STACK_SIZE/8];
-
-static uint64_t led_task_stack[LED_TASK_STACK_SIZE/8];
-
-cy_thread_t button_task_pointer;
-
-cy_thread_t uart_task_pointer;
-
-cy_thread_t led_task_pointer;
-
-
-/* Queue for communication between UART ISR and UART Task*/
-cy_queue_t xUARTQueue;
+static uint64_t app_event_task_stack[APP_EVENT_TASK_STACK_SIZE/8];
+static uint64_t app_log_task_stack[APP_LOG_TASK_STACK_SIZE/8];
 
-/* Queue for communication with LED Task*/
-cy_queue_t xLEDQueue;
+cy_thread_t app_event_task_pointer;
+cy_thread_t app_log_task_pointer;
 
 /**
  * Function Name:
@@ -111,11 +109,15 @@ int main()
     /* Enable global interrupts */
     __enable_irq();
 
-    cyhal_syspm_lock_deepsleep();
-
     /* Initialize retarget-io to use the debug UART port */
     cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
 
+    /* Start the microsecond timestamp used for timing instrumentation */
+    app_timestamp_init();
+
+    /* Allow deep sleep when idle and start the power state accounting */
+    app_power_init();
+
     printf("************* Peripheral Privacy App Start***** ************************\n");
     display_menu();
 
@@ -125,81 +127,64 @@ int main()
         CY_ASSERT(0);
     }
 
-    /* Create a queue capable of unsigned integer values.
-       this is used for communicating between UART ISR and the UART task */
-    result = cy_rtos_queue_init(&xUARTQueue,QUEUE_SIZE,sizeof(uint8_t) );
+    /* Create the event queue before the interrupts can post to it */
+    app_event_init();
 
-    /*Check the status of Queue creation*/
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("Failed to create Queue for communication between UART ISR and Task!!");
-        CY_ASSERT(0);
-    }
-
-    /* Create a queue capable of unsigned integer values.
-       this is used for communicating with LED task */
-
-    result = cy_rtos_queue_init(&xLEDQueue,QUEUE_SIZE,sizeof(uint8_t));
-
-    /*Check the status of Queue creation*/
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("Failed to create Queue for communication with LED Task!!");
-        CY_ASSERT(0);
-    }
+    /* Control protocol events can be sent as soon as the stack runs */
+    app_ctrl_init();
 
     /* Configure the Button GPIO */
-    key_button_app_init();
-
-    result = cy_rtos_thread_create(&button_task_pointer,
-             (cy_thread_entry_fn_t) &button_task,
-                                           "button_task",
-                                           &button_task_stack,
-                                           BUTTON_TASK_STACK_SIZE,
-                                           BUTTON_TASK_PRIORITY,
-                                           0);
+    app_button_init();
+
+    /* Fill the stack so its high-water mark can be reported */
+    app_stack_mon_paint(app_event_task_stack, sizeof(app_event_task_stack));
+
+    /* Button, UART and Bluetooth events are all handled by this task */
+    result = cy_rtos_thread_create(&app_event_task_pointer,
+                                   (cy_thread_entry_fn_t)&app_event_loop,
+                                   "app_event_loop",
+                                   &app_event_task_stack,
+                                   APP_EVENT_TASK_STACK_SIZE,
+                                   APP_EVENT_TASK_PRIORITY,
+                                   0);
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("button_task creation failed \r\n");
+        printf("app_event_loop task creation failed \r\n");
         CY_ASSERT(0);
     }
 
-    result = cy_rtos_thread_create(&uart_task_pointer,
-             (cy_thread_entry_fn_t)&uart_task,
-                                           "uart_task",
-                                           &uart_task_stack,
-                                           UART_TASK_STACK_SIZE,
-                                           UART_TASK_PRIORITY,
-                                           0);
-    if (result != CY_RSLT_SUCCESS)
-    {
-        printf("uart_task creation failed \r\n");
-        CY_ASSERT(0);
-    }
+    app_stack_mon_paint(app_log_task_stack, sizeof(app_log_task_stack));
 
-
-
-    result = cy_rtos_thread_create(&led_task_pointer,
-                                           (cy_thread_entry_fn_t)&app_led_control,
-                                           "app_led_control_task",
-                                          (void*) &led_task_stack,
-                                           LED_TASK_STACK_SIZE,
-                                           LED_TASK_PRIORITY,
-                                           0);
+    /* Log records written from the Bluetooth callbacks are printed by this task */
+    result = cy_rtos_thread_create(&app_log_task_pointer,
+                                   (cy_thread_entry_fn_t)&app_log_drain_task,
+                                   "app_log_drain",
+                                   &app_log_task_stack,
+                                   APP_LOG_TASK_STACK_SIZE,
+                                   APP_LOG_TASK_PRIORITY,
+                                   0);
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("BLE_task creation failed \r\n");
+        printf("app_log_drain task creation failed \r\n");
         CY_ASSERT(0);
     }
 
+    /* Start the periodic stack report, if enabled */
+    app_stack_mon_init();
+    app_heap_init();
+    app_metrics_init();
+    app_throughput_init();
 
     /* Register a callback function and set it to fire for any received UART characters */
-    cyhal_uart_register_callback(&cy_retarget_io_uart_obj, uart_interrupt_handler,NULL);
+    cyhal_uart_register_callback(&cy_retarget_io_uart_obj, app_uart_rx_isr, NULL);
     cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_RX_NOT_EMPTY, INT_PRIORITY, TRUE);
 
 
+    /* Take a RAM copy of the Bluetooth configuration so it can be tuned at runtime */
+    app_bt_cfg_init();
+
     /* Register call back and configuration with stack */
-    wiced_result = wiced_bt_stack_init(app_bt_management_callback, &wiced_bt_cfg_settings);
+    wiced_result = wiced_bt_stack_init(app_bt_management_callback, &app_bt_cfg_settings);
 
     /* Check if stack initialization was successful */
     if (WICED_BT_SUCCESS == wiced_result)
@@ -59,6 +59,22 @@
 #include <inttypes.h>
 #include "peripheral_privacy.h"
 #include "app_bt_bonding.h"
+#include "app_bt_link_loss.h"
+#include "app_bt_adv.h"
+#include "app_bt_privacy.h"
+#include "app_event.h"
+#include "app_stack_mon.h"
+#include "app_uart_rx.h"
+#include "app_ctrl.h"
+#include "app_log.h"
+#include "app_trace.h"
+#include "app_heap.h"
+#include "app_metrics.h"
+#include "app_throughput.h"
+#include "app_echo.h"
+#include "app_button.h"
+#include "app_power.h"
+#include "app_state.h"
 
 /*******************************************************************
  * Variable Definitions
@@ -66,29 +82,11 @@
 typedef void(*pfn_free_buffer_t)            (uint8_t *);
 static uint16_t                             connection_id = 0;
 static wiced_bt_device_address_t            connected_bda;
-static wiced_bt_ble_advert_mode_t *         p_adv_mode = NULL;
-
-/* If true we will go into bonding mode. This will be set false if pre-existing bonding info is available */
-static wiced_bool_t                         bond_mode = WICED_TRUE;
-
-/* This is the index for the link keys,cccd and privacy mode of the host we are currently bonded to */
-static uint8_t                              bondindex = 0;
 
 static  cyhal_pwm_t                         adv_led_pwm;
 bool                                        pairing_mode;
 
 /* Configure GPIO interrupt */
-cyhal_gpio_callback_data_t button_cb_struct;
-
-/* enum for state machine*/
-enum StateMachine
-{
-    IDLE_NO_DATA,
-    IDLE_DATA,
-    IDLE_PRIVACY_CHANGE,
-    CONNECTED,
-    BONDED
-} state;
 
 /* PWM Duty Cycle of LED's for different states */
 enum
@@ -113,27 +111,24 @@ static wiced_bt_gatt_status_t   ble_app_bt_gatt_req_read_by_type_handler (uint16
 static wiced_bt_gatt_status_t   ble_app_write_handler         (uint16_t conn_id,
                                                                wiced_bt_gatt_opcode_t opcode,
                                                                wiced_bt_gatt_write_req_t *p_write_req,
-                                                               uint16_t len_req);
+                                                               uint16_t len_req,
+                                                               uint32_t rx_us);
 static wiced_bt_gatt_status_t   ble_app_set_value             (uint16_t attr_handle,
                                                                uint8_t *p_val,
-                                                               uint16_t len);
+                                                               uint16_t len,
+                                                               uint32_t rx_us);
 static void                     ble_app_init                  (void);
 static wiced_bt_gatt_status_t   ble_app_connect_handler       (wiced_bt_gatt_connection_status_t *p_conn_status);
 static wiced_bt_gatt_status_t   ble_app_read_handler          (uint16_t conn_id,
                                                                wiced_bt_gatt_opcode_t opcode,
                                                                wiced_bt_gatt_read_t *p_read_req,
                                                                uint16_t len_req);
+static wiced_bt_gatt_status_t   ble_app_read_multi_handler    (uint16_t conn_id,
+                                                               wiced_bt_gatt_opcode_t opcode,
+                                                               wiced_bt_gatt_read_multiple_req_t *p_read_req,
+                                                               uint16_t len_req);
 static gatt_db_lookup_table_t   *app_get_attribute            (uint16_t handle);
-
-/*App feature and utility functions*/
-static void                      directed_adv_handler          (uint8_t device_index);
-static void                      privacy_mode_handler          (uint8_t device_index);
-
-
-
-/*Buffer management functions*/
- void                             app_free_buffer                   (uint8_t *p_buf);
- void*                            app_alloc_buffer                  (int len);
+static app_action_status_t      app_action_status             (cy_rslt_t rslt);
 
 /*******************************************************************************
  *                              FUNCTION DEFINITIONS
@@ -163,6 +158,10 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
     wiced_bt_dev_status_t status = WICED_BT_SUCCESS;
     wiced_bt_device_address_t bda = {0};
     wiced_bt_dev_ble_pairing_info_t *p_ble_info = NULL;
+    uint8_t key_index;
+    uint8_t bond_index;
+
+    APP_TRACE(APP_TRACE_BTM, event, 0);
 
     switch (event)
     {
@@ -173,36 +172,31 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
             /* Clear out the bondinfo structure */
             memset(&bondinfo, 0, sizeof(bondinfo));
             wiced_bt_dev_read_local_addr(bda);
-            printf("Local Bluetooth Address: ");
-            print_bd_address(bda);
+            APP_LOG(LOG_LOCAL_ADDR, APP_LOG_BDA(bda));
             /* Perform application-specific initialization */
             ble_app_init();
         }
         else
         {
-            printf( "Bluetooth Disabled \n" );
+            APP_LOG0(LOG_BT_DISABLED);
         }
         break;
 
     case BTM_DISABLED_EVT:
         /* Bluetooth Controller and Host Stack Disabled */
-        printf("Bluetooth Disabled \r\n");
+        APP_LOG0(LOG_BT_DISABLED);
         break;
 
     case BTM_USER_CONFIRMATION_REQUEST_EVT:
-        printf("\n********************\n" );
-        printf("* NUMERIC = %"PRIu32" *\r", p_event_data->user_confirmation_request.numeric_value );
-        printf("\n********************\n" );
-        printf("Press 'y' if the numeric values match on both devices or press 'n' if they do not.\n\n");
+        APP_LOG(LOG_NUMERIC_COMPARE, p_event_data->user_confirmation_request.numeric_value);
+        APP_LOG0(LOG_NUMERIC_PROMPT);
         memcpy(&(connected_bda), &(p_event_data->user_confirmation_request.bd_addr), sizeof(wiced_bt_device_address_t));
+        app_ctrl_event_numeric(p_event_data->user_confirmation_request.numeric_value, connected_bda);
         break;
 
     case BTM_PASSKEY_NOTIFICATION_EVT:
         /* Print passkey to the screen so that the user can enter it. */
-        printf( "**********************************************************************\n");
-        printf( "Passkey Notification\n");
-        printf("PassKey: %"PRIu32" \n", p_event_data->user_passkey_notification.passkey );
-        printf( "**********************************************************************\n");
+        APP_LOG(LOG_PASSKEY, p_event_data->user_passkey_notification.passkey);
         /*for simplicity we are confirming the passkey, end users may want to implement their own input method*/
         wiced_bt_dev_confirm_req_reply(WICED_BT_SUCCESS, p_event_data->user_passkey_notification.bd_addr);
         break;
@@ -210,20 +204,20 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
     case BTM_SECURITY_REQUEST_EVT:
         /* Security Request */
         /* Only grant if we are in bonding mode */
-        if(TRUE == bond_mode)
+        if(WICED_TRUE == app_state_bond_mode())
         {
-            printf("Security Request Granted \n");
+            APP_LOG0(LOG_SECURITY_GRANTED);
             wiced_bt_ble_security_grant(p_event_data->security_request.bd_addr, WICED_SUCCESS);
         }
         else
         {
-            printf("Security Request Denied - not in bonding mode \n");
+            APP_LOG0(LOG_SECURITY_DENIED);
         }
         break;
 
     case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT:
         /* Request for Pairing IO Capabilities (BLE) */
-        printf("BLE Pairing IO Capabilities Request\n");
+        APP_LOG0(LOG_IO_CAP_REQUEST);
         /* IO Capabilities on this Platform */
         p_event_data->pairing_io_capabilities_ble_request.local_io_cap = BTM_IO_CAPABILITIES_DISPLAY_AND_YES_NO_INPUT;
         p_event_data->pairing_io_capabilities_ble_request.auth_req = BTM_LE_AUTH_REQ_SC_MITM_BOND;
@@ -231,18 +225,25 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
         break;
 
     case BTM_BLE_CONNECTION_PARAM_UPDATE:
-        printf("Connection parameter update status:%d, Connection Interval: %d, Connection Latency: %d, Connection Timeout: %d\n",
-                                        p_event_data->ble_connection_param_update.status,
+        APP_LOG(LOG_CONN_PARAM_UPDATE,  p_event_data->ble_connection_param_update.status,
                                         p_event_data->ble_connection_param_update.conn_interval,
                                         p_event_data->ble_connection_param_update.conn_latency,
                                         p_event_data->ble_connection_param_update.supervision_timeout);
+        if (WICED_BT_SUCCESS == p_event_data->ble_connection_param_update.status)
+        {
+            /* Remember the parameters in case the link is lost */
+            app_bt_link_loss_update_conn_params(p_event_data->ble_connection_param_update.conn_interval,
+                                                p_event_data->ble_connection_param_update.conn_latency,
+                                                p_event_data->ble_connection_param_update.supervision_timeout);
+        }
         break;
 
     case BTM_PAIRING_COMPLETE_EVT:
 
         /* Pairing is Complete */
         p_ble_info = &p_event_data->pairing_complete.pairing_complete_info.ble;
-        printf("Pairing Status %s \n", get_bt_smp_status_name(p_ble_info->reason));
+        APP_LOG(LOG_PAIRING_STATUS, APP_LOG_STR(get_bt_smp_status_name(p_ble_info->reason)));
+        app_ctrl_event_pairing((uint8_t)p_ble_info->reason, p_event_data->pairing_complete.bd_addr);
 
         if ( WICED_BT_SUCCESS == p_ble_info->reason ) /* Bonding successful */
         {
@@ -252,90 +253,102 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
             /*Check if the data was updated successfully*/
             if (CY_RSLT_SUCCESS == rslt)
             {
-                printf("Slot Data saved to Flash \r\n");
-                printf("Successfully Bonded to: ");
-                print_bd_address(p_event_data->pairing_complete.bd_addr);
+                APP_LOG0(LOG_SLOT_DATA_SAVED);
+                APP_LOG(LOG_BONDED_TO, APP_LOG_BDA(p_event_data->pairing_complete.bd_addr));
             }
             else
             {
-                printf("Flash Write Error \r\n");
+                APP_LOG0(LOG_FLASH_WRITE_ERROR);
             }
 
-            bond_mode = FALSE; /* remember that the device is now bonded, so disable bonding */
-            printf("Number of bonded devices: %d, Next free slot: %d, Number of slots free: %d\n",bondinfo.slot_data[NUM_BONDED], bondinfo.slot_data[NEXT_FREE_INDEX ]+1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
+            app_state_post(APP_STATE_EVT_PAIRED, 0); /* remember that the device is now bonded, so disable bonding */
+            APP_LOG(LOG_BOND_COUNT, bondinfo.slot_data[NUM_BONDED], bondinfo.slot_data[NEXT_FREE_INDEX ]+1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
         }
         else
         {
-            printf("Bonding failed! \n");
+            APP_LOG0(LOG_BONDING_FAILED);
         }
         break;
 
     case BTM_ENCRYPTION_STATUS_EVT:
         /* Encryption Status Change */
-        printf("Encryption Status event for: ");
-        print_bd_address(p_event_data->encryption_status.bd_addr);
-        printf("Encryption Status event result: %d \n", p_event_data->encryption_status.result);
+        APP_TRACE(APP_TRACE_ENCRYPTED, p_event_data->encryption_status.result, 0);
+        APP_LOG(LOG_ENCRYPTION_STATUS, APP_LOG_BDA(p_event_data->encryption_status.bd_addr),
+                p_event_data->encryption_status.result);
         /*Check and retreive the index of the bond data of the device that got connected*/
         /* This call will return BOND_INDEX_MAX if the device is not found*/
-        bondindex = app_bt_find_device_in_flash(p_event_data->encryption_status.bd_addr);
-        if(bondindex < BOND_INDEX_MAX)
+        bond_index = app_bt_find_device_in_flash(p_event_data->encryption_status.bd_addr);
+        app_ctrl_event_encryption((uint8_t)p_event_data->encryption_status.result,
+                                  (bond_index < BOND_INDEX_MAX) ? bond_index + 1 : 0,
+                                  p_event_data->encryption_status.bd_addr);
+        if ((bond_index < BOND_INDEX_MAX) && (WICED_SUCCESS == p_event_data->encryption_status.result))
+        {
+            /* After a link loss the context is still warm, no need to go to the flash */
+            if (WICED_TRUE == app_bt_link_loss_on_encrypted(p_event_data->encryption_status.bd_addr))
+            {
+                app_wicedbutton_mb1_client_char_config[0] = (uint8_t)link_loss_ctx.cccd;
+            }
+            else
+            {
+                app_bt_restore_bond_data();
+                app_bt_restore_cccd();
+                app_wicedbutton_mb1_client_char_config[0] = peer_cccd_data[bond_index]; /* Set CCCD value from the value that was previously saved in the NVRAM */
+            }
+            APP_LOG(LOG_BOND_INFO_PRESENT, APP_LOG_BDA(p_event_data->encryption_status.bd_addr));
+            app_bt_privacy_on_reconnect(bond_index);
+            app_metrics_on_reconnect();
+            /* The event loop keeps the bond slot of the peer */
+            app_state_post(APP_STATE_EVT_ENCRYPTED, bond_index);
+        }
+        else if (bond_index < BOND_INDEX_MAX)
         {
-            app_bt_restore_bond_data();
-            app_bt_restore_cccd();
-            app_wicedbutton_mb1_client_char_config[0] = peer_cccd_data[bondindex]; /* Set CCCD value from the value that was previously saved in the NVRAM */
-            printf("Bond info present in Flash for device: ");
-            print_bd_address(p_event_data->encryption_status.bd_addr);
-            state = BONDED;
+            /* Encryption failed, the CCCD is not restored: notifications only go out on an
+             * authenticated link */
         }
         else{
-            printf("No Bond info present in Flash for device: ");
-            print_bd_address(p_event_data->encryption_status.bd_addr);
-            bondindex=0;
+            APP_LOG(LOG_BOND_INFO_ABSENT, APP_LOG_BDA(p_event_data->encryption_status.bd_addr));
         }
         break;
 
     case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:
         /* save device keys to Flash */
-        printf( "Paired Device Key Update \r\n");
+        APP_LOG0(LOG_KEY_UPDATE);
         rslt = app_bt_save_device_link_keys(&(p_event_data->paired_device_link_keys_update));
         if (CY_RSLT_SUCCESS == rslt)
         {
-            printf("Successfully Bonded to ");
-            print_bd_address(p_event_data->paired_device_link_keys_update.bd_addr);
+            APP_LOG(LOG_BONDED_TO, APP_LOG_BDA(p_event_data->paired_device_link_keys_update.bd_addr));
         }
         else
         {
-            printf("Failed to bond! \r\n");
+            APP_LOG0(LOG_BOND_FAILED);
         }
         break;
 
     case BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT:
         /* Paired Device Link Keys Request */
-        printf("Paired Device Link keys Request Event for device ");
-        print_bd_address((uint8_t *)(p_event_data->paired_device_link_keys_request.bd_addr));
+        APP_LOG(LOG_KEY_REQUEST, APP_LOG_BDA(p_event_data->paired_device_link_keys_request.bd_addr));
         /* Need to search to see if the BD_ADDR we are looking for is in Flash. If not, we return WICED_BT_ERROR and the stack */
         /* will generate keys and will then call BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT so that they can be stored */
         status = WICED_BT_ERROR;  /* Assume the device won't be found. If it is, we will set this back to WICED_BT_SUCCESS */
 
         /* This call will return BOND_INDEX_MAX if the device is not found*/
-        bondindex = app_bt_find_device_in_flash(p_event_data->paired_device_link_keys_request.bd_addr);
-        if ( bondindex < BOND_INDEX_MAX)
+        key_index = app_bt_find_device_in_flash(p_event_data->paired_device_link_keys_request.bd_addr);
+        if ( key_index < BOND_INDEX_MAX)
         {
             /* Copy the keys to where the stack wants it */
-            memcpy(&(p_event_data->paired_device_link_keys_request), &(bondinfo.link_keys[bondindex]), sizeof(wiced_bt_device_link_keys_t));
+            memcpy(&(p_event_data->paired_device_link_keys_request), &(bondinfo.link_keys[key_index]), sizeof(wiced_bt_device_link_keys_t));
             status = WICED_BT_SUCCESS;
         }
         else
         {
-            printf("Device Link Keys not found in the database! \n");
-            bondindex=0;
+            APP_LOG0(LOG_KEY_NOT_FOUND);
         }
 
         break;
 
     case BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT: /* Update of local privacy keys - save to NVSRAM */
         /* Update of local privacy keys - save to Flash */
-        printf( "Local Identity Key Update\n");
+        APP_LOG0(LOG_LOCAL_KEY_UPDATE);
         rslt = app_bt_save_local_identity_key(p_event_data->local_identity_keys_update);
         if (CY_RSLT_SUCCESS != rslt)
         {
@@ -345,13 +358,13 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
 
     case BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT: /* Request for local privacy keys - read from Flash */
         app_kv_store_init();
-        printf("Local Identity Key Request\r\n");
+        APP_LOG0(LOG_LOCAL_KEY_REQUEST);
         /*Read Local Identity Resolution Keys*/
         rslt = app_bt_read_local_identity_keys();
         if(CY_RSLT_SUCCESS == rslt)
         {
             memcpy(&(p_event_data->local_identity_keys_request), &(identity_keys), sizeof(wiced_bt_local_identity_keys_t));
-            print_array(&identity_keys, sizeof(wiced_bt_local_identity_keys_t));
+            APP_LOG_HEXDUMP(&identity_keys, sizeof(wiced_bt_local_identity_keys_t));
             status = WICED_BT_SUCCESS;
         }
         else
@@ -362,13 +375,12 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event, wiced
 
     case BTM_BLE_ADVERT_STATE_CHANGED_EVT:
         /* Advertisement State Changed */
-        p_adv_mode = &p_event_data->ble_advert_state_changed;
-        led_task_communicator(*p_adv_mode);
-        printf("Advertisement State Change: %d\r\n", *p_adv_mode);
+        led_task_communicator(p_event_data->ble_advert_state_changed);
+        APP_LOG(LOG_ADV_STATE, p_event_data->ble_advert_state_changed);
         break;
 
     default:
-        printf("Unhandled Bluetooth Management Event: 0x%x %s\n", event, get_btm_event_name(event));
+        APP_LOG(LOG_UNHANDLED_BTM_EVENT, event, APP_LOG_STR(get_btm_event_name(event)));
         break;
     }
 
@@ -394,9 +406,10 @@ void ble_app_init(void)
     /* Allow peer to pair */
     wiced_bt_set_pairable_mode(WICED_TRUE, 0);
 
-    /* Set Advertisement Data */
-    wiced_bt_ble_set_raw_advertisement_data(CY_BT_ADV_PACKET_DATA_SIZE,
-    cy_bt_adv_packet_data);
+    /* Initialize the advertising interval scheduler and the advertising payloads,
+     * the payload of each mode is sent to the controller when the mode starts */
+    app_bt_adv_init();
+
 
     /* Register with stack to receive GATT callback */
     wiced_bt_gatt_register(ble_app_gatt_event_handler);
@@ -408,54 +421,32 @@ void ble_app_init(void)
     rslt = app_bt_restore_bond_data();
     if (CY_RSLT_SUCCESS == rslt )
     {
-        printf("Bond data successfully restored from flash!\r\n");
+        APP_LOG0(LOG_BOND_RESTORED);
     }
 
+    /* Reset the reconnection statistics of the privacy module */
+    app_bt_privacy_init();
+
     if (0 == bondinfo.slot_data[NUM_BONDED ] || BOND_INDEX_MAX < bondinfo.slot_data[NUM_BONDED])
     {
-        /* Allow new devices to bond */
-        bond_mode = TRUE;
-        printf("No bonded Device Found,Starting Undirected Advertisement \r\n\r\n");
-        /* Start Undirected LE Advertisements on device startup. */
-        wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
-        /* Set current state to IDLE with no data*/
-        state = IDLE_NO_DATA;
+        /* Allow new devices to bond, in the IDLE_NO_DATA state */
+        APP_LOG0(LOG_NO_BONDED_DEVICE);
     }
     else
     {
-        printf("Number of bonded devices: %d, Next free slot: %d, Number of slots free %d \r\n", bondinfo.slot_data[NUM_BONDED ],
-                                                            bondinfo.slot_data[NEXT_FREE_INDEX] + 1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
-        printf("printing Bonded Device information: \r\n");
-        /* New devices not allowed to bond, can be enabled by entering b on Terminal */
-        bond_mode = FALSE;
+        APP_LOG(LOG_BOND_COUNT, bondinfo.slot_data[NUM_BONDED ],
+                bondinfo.slot_data[NEXT_FREE_INDEX] + 1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
+        APP_LOG0(LOG_BOND_DATA_HEADER);
         print_bond_data();
 
-        /* Change state to IDLE with bond data present*/
-        state = IDLE_DATA;
         /* Add devices to address resolution database*/
         app_bt_add_devices_to_address_resolution_db();
-
-        /*Start Advertisements*/
-        if (1 == bondinfo.slot_data[NUM_BONDED])
-        {
-            printf("\r\nOnly 1 Device Found,Starting directed Advertisement to: ");
-            print_bd_address(bondinfo.link_keys[0].bd_addr);
-            print_bd_address(bondinfo.link_keys[0].conn_addr);
-            printf("Enter 'e' for starting undirected Advertisement to add new device\r\n");
-            wiced_bt_start_advertisements(BTM_BLE_ADVERT_DIRECTED_HIGH, bondinfo.link_keys[0].key_data.ble_addr_type,
-                                          bondinfo.link_keys[0].bd_addr);
-        }
-        else
-        {
-            printf("\r\nSelect the bonded Devices Found in below list to Start Directed Advertisement \r\n");
-            print_device_selection_menu();
-            printf("Enter slot number to start directed advertisement for that device \r\n");
-            printf("Enter e for Starting undirected Advertisement to add new device \r\n");
-            printf("************************** NOTE ***************************************************\r\n");
-            printf("*ONCE THE SLOTS ARE FULL THE OLDEST DEVICE DATA WILL BE OVERWRITTEN FOR NEW DEVICE*\r\n");
-            printf("***********************************************************************************\r\n");
-        }
+        /* Loading the resolving list resets the privacy modes, apply the stored ones */
+        app_bt_privacy_restore_modes();
     }
+
+    /* The event loop enters IDLE_DATA or IDLE_NO_DATA and starts advertising */
+    app_state_post(APP_STATE_EVT_STARTED, 0);
 }
 
 
@@ -477,6 +468,9 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
     wiced_bt_gatt_attribute_request_t *p_attr_req = &p_event_data->attribute_request;
+
+    APP_TRACE(APP_TRACE_GATT, event, 0);
+
     /* Call the appropriate callback function based on the GATT event type, and pass the relevant event
      * parameters to the callback function */
     switch ( event )
@@ -505,6 +499,10 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
             status = WICED_BT_GATT_SUCCESS;
         }
             break;
+        case GATT_CONGESTION_EVT:
+            app_metrics_on_congestion(p_event_data->congestion.congested);
+            status = WICED_BT_GATT_SUCCESS;
+            break;
 
 
         default:
@@ -544,45 +542,54 @@ wiced_bt_gatt_status_t ble_app_connect_handler( wiced_bt_gatt_connection_status_
     if(pairing_mode == TRUE)
     {
         app_bt_add_devices_to_address_resolution_db();
+        app_bt_privacy_restore_modes();
         pairing_mode = FALSE;
     }
 #endif
-            printf("Connected : BD Addr: " );
-            print_bd_address(p_conn_status->bd_addr);
-            printf("Connection ID '%d'\n", p_conn_status->conn_id );
+            APP_TRACE(APP_TRACE_CONNECT, 0, p_conn_status->conn_id);
+            APP_LOG(LOG_CONNECTED, APP_LOG_BDA(p_conn_status->bd_addr), p_conn_status->conn_id);
+            app_ctrl_event_connection(true, 0, p_conn_status->conn_id, p_conn_status->bd_addr);
 
             /* Handling the connection by updating connection ID */
             connection_id = p_conn_status->conn_id;
-            state = CONNECTED;
+            app_metrics_on_connect(p_conn_status->conn_id);
+            app_throughput_on_connect(p_conn_status->conn_id);
+            app_echo_on_connect(p_conn_status->conn_id);
+
+            /* Peer dropped by a link loss is back, its CCCD is restored once the
+             * link is encrypted again */
+            if (WICED_TRUE == app_bt_link_loss_on_connect(p_conn_status->bd_addr))
+            {
+                app_state_post(APP_STATE_EVT_CONNECTED, link_loss_ctx.bond_index + 1);
+            }
+            else
+            {
+                app_state_post(APP_STATE_EVT_CONNECTED, 0);
+            }
             led_task_communicator(BTM_BLE_ADVERT_OFF);
         }
         else
         {
+            /* CCCD of the peer in case the link was lost and it is resumed */
+            uint16_t cccd = app_wicedbutton_mb1_client_char_config[0];
+
             /* Device has disconnected */
-            printf("\nDisconnected : BD Addr: " );
-            print_bd_address(p_conn_status->bd_addr);
-            printf("Connection ID '%d', Reason '%s'\n", p_conn_status->conn_id, get_bt_gatt_disconn_reason_name(p_conn_status->reason) );
+            APP_TRACE(APP_TRACE_DISCONNECT, p_conn_status->reason, p_conn_status->conn_id);
+            APP_LOG(LOG_DISCONNECTED, APP_LOG_BDA(p_conn_status->bd_addr), p_conn_status->conn_id,
+                    APP_LOG_STR(get_bt_gatt_disconn_reason_name(p_conn_status->reason)));
+            app_ctrl_event_connection(false, (uint8_t)p_conn_status->reason, p_conn_status->conn_id, p_conn_status->bd_addr);
 
             led_task_communicator(BTM_BLE_ADVERT_OFF);
             /* Handling the disconnection */
             connection_id = 0;
+            app_metrics_on_disconnect();
+            app_throughput_on_disconnect();
+            app_echo_on_disconnect();
             /* Reset the CCCD value so that on a reconnect CCCD will be off */
             app_wicedbutton_mb1_client_char_config[0] = 0;
 
-            if (bondinfo.slot_data[NUM_BONDED] > 0)
-            {
-                state = IDLE_DATA;
-                print_device_selection_menu();
-                printf("Enter slot number to start directed advertisement for that device \r\n");
-                printf("Enter e for Starting undirected Advertisement to add new device \r\n");
-                bond_mode = WICED_FALSE;
-            }
-            else
-            {
-                state = IDLE_NO_DATA;
-                bond_mode = WICED_TRUE;
-                wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
-            }
+            /* The event loop restarts advertising, or link-loss recovery for a bonded peer */
+            app_state_post(APP_STATE_EVT_DISCONNECTED, APP_STATE_DISCONNECT_ARG(p_conn_status->reason, cccd));
         }
         status = WICED_BT_GATT_SUCCESS;
     }
@@ -607,6 +614,8 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
     wiced_bt_gatt_write_req_t *p_write_request = &p_data->data.write_req;
+    /* Time the request reached the application, for the Echo replies */
+    uint32_t rx_us = app_timestamp_us();
 
     switch ( p_data->opcode )
     {
@@ -616,6 +625,11 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
             status = ble_app_read_handler( p_data->conn_id, p_data->opcode,
                                           &p_data->data.read_req, p_data->len_requested);
             break;
+        case GATT_REQ_READ_MULTI:
+        case GATT_REQ_READ_MULTI_VAR:
+            status = ble_app_read_multi_handler(p_data->conn_id, p_data->opcode,
+                                                &p_data->data.read_multiple_req, p_data->len_requested);
+            break;
         case GATT_REQ_READ_BY_TYPE:
             status = ble_app_bt_gatt_req_read_by_type_handler(p_data->conn_id,
                                                           p_data->opcode,
@@ -628,9 +642,14 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
         case GATT_CMD_SIGNED_WRITE:
              status = ble_app_write_handler(p_data->conn_id, p_data->opcode,
                                             &p_data->data.write_req,
-                                            p_data->len_requested );
+                                            p_data->len_requested, rx_us);
 
-            if ((p_data->opcode == GATT_REQ_WRITE) && (status == WICED_BT_GATT_SUCCESS))
+            /* Commands get no response, not even an error */
+            if (p_data->opcode != GATT_REQ_WRITE)
+            {
+                break;
+            }
+            if (status == WICED_BT_GATT_SUCCESS)
             {
                 wiced_bt_gatt_server_send_write_rsp(p_data->conn_id, p_data->opcode,
                                                     p_write_request->handle);
@@ -642,18 +661,20 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
             }
                break;
         case GATT_REQ_MTU:
+            app_throughput_set_mtu(MIN(p_data->data.remote_mtu,
+                                       wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size));
             /*Application calls wiced_bt_gatt_server_send_mtu_rsp() with desired mtu*/
             status = wiced_bt_gatt_server_send_mtu_rsp(p_data->conn_id,
                                                        p_data->data.remote_mtu,
                                                        wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
             break;
         case GATT_HANDLE_VALUE_NOTIF:
-             printf("Client received our notification\r\n");
+             APP_LOG0(LOG_NOTIFICATION_CONFIRMED);
              status = WICED_BT_GATT_SUCCESS;
              break;
 
         default:
-            printf("Unhandled Event opcode:%d\r\n",p_data->opcode);
+            APP_LOG(LOG_UNHANDLED_OPCODE, p_data->opcode);
             break;
     }
 
@@ -671,6 +692,7 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
 *         opcode        BLE GATT request type opcode
 *         p_write_req   Pointer to BLE GATT write request
 *         len_req       length of data requested
+*         rx_us         Time the request reached the application, app_timestamp_us()
 *
 * @return wiced_bt_gatt_status_t: See possible status codes in wiced_bt_gatt_status_e in wiced_bt_gatt.h
 *
@@ -678,18 +700,20 @@ static wiced_bt_gatt_status_t ble_app_server_handler (wiced_bt_gatt_attribute_re
 static wiced_bt_gatt_status_t ble_app_write_handler(uint16_t conn_id,
                                                     wiced_bt_gatt_opcode_t opcode,
                                                     wiced_bt_gatt_write_req_t *p_write_req,
-                                                    uint16_t len_req)
+                                                    uint16_t len_req,
+                                                    uint32_t rx_us)
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_INVALID_HANDLE;
 
     /* Attempt to perform the Write Request */
     status = ble_app_set_value(p_write_req->handle,
                                 p_write_req->p_val,
-                               p_write_req->val_len);
+                               p_write_req->val_len,
+                               rx_us);
 
     if( WICED_BT_GATT_SUCCESS != status )
         {
-            printf("WARNING: GATT set attr status 0x%x\n", status);
+            APP_LOG(LOG_SET_ATTR_STATUS, status);
         }
 
         return (status);
@@ -729,6 +753,15 @@ static wiced_bt_gatt_status_t ble_app_read_handler( uint16_t conn_id,
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->handle,
                                             WICED_BT_GATT_INVALID_HANDLE);
         return WICED_BT_GATT_INVALID_HANDLE;
+    }
+    /* Metrics are refreshed on the first read, the blobs that follow read the same snapshot */
+    if ((0 == p_read_req->offset) && (WICED_TRUE == app_metrics_is_attribute(p_read_req->handle)))
+    {
+        app_metrics_refresh();
+    }
+    if ((0 == p_read_req->offset) && (HDLC_THROUGHPUT_CONTROL_VALUE == p_read_req->handle))
+    {
+        app_throughput_refresh();
     }
         attr_len_to_copy = puAttribute->cur_len;
         if (p_read_req->offset >= puAttribute->cur_len)
@@ -743,6 +776,69 @@ static wiced_bt_gatt_status_t ble_app_read_handler( uint16_t conn_id,
     return wiced_bt_gatt_server_send_read_handle_rsp(conn_id, opcode, to_send, from, NULL); /* No need for context, as buff not allocated */;
 }
 
+/**
+* Function Name:
+* ble_app_read_multi_handler
+*
+* Function Description:
+* @brief  This function handles Read Multiple and Read Multiple Variable Length
+*         Requests, e.g. the three Metrics values in one request. Metrics are
+*         refreshed once, so the values are from the same snapshot.
+*
+* @param conn_id       Connection ID
+*        opcode        GATT_REQ_READ_MULTI or GATT_REQ_READ_MULTI_VAR
+*        p_read_req    Pointer to the handles to read
+*        len_req       length of data requested
+*
+* @return wiced_bt_gatt_status_t: See possible status codes in wiced_bt_gatt_status_e in
+*         wiced_bt_gatt.h
+*
+**/
+static wiced_bt_gatt_status_t ble_app_read_multi_handler(uint16_t conn_id,
+                                                         wiced_bt_gatt_opcode_t opcode,
+                                                         wiced_bt_gatt_read_multiple_req_t *p_read_req,
+                                                         uint16_t len_req)
+{
+    gatt_db_lookup_table_t *puAttribute;
+    uint8_t *p_rsp = app_alloc_buffer(len_req);
+    wiced_bool_t refreshed = WICED_FALSE;
+    uint16_t handle;
+    int used = 0;
+
+    if (p_rsp == NULL)
+    {
+        APP_LOG(LOG_NO_MEMORY, len_req);
+        wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, 0, WICED_BT_GATT_INSUF_RESOURCE);
+        return WICED_BT_GATT_INSUF_RESOURCE;
+    }
+
+    for (uint16_t i = 0; i < p_read_req->num_handles; i++)
+    {
+        handle = p_read_req->p_handle_stream[2 * i] | (p_read_req->p_handle_stream[2 * i + 1] << 8);
+        if ((puAttribute = app_get_attribute(handle)) == NULL)
+        {
+            wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, handle, WICED_BT_GATT_INVALID_HANDLE);
+            app_free_buffer(p_rsp);
+            return WICED_BT_GATT_INVALID_HANDLE;
+        }
+        if ((WICED_TRUE != refreshed) && (WICED_TRUE == app_metrics_is_attribute(handle)))
+        {
+            app_metrics_refresh();
+            refreshed = WICED_TRUE;
+        }
+        if (HDLC_THROUGHPUT_CONTROL_VALUE == handle)
+        {
+            app_throughput_refresh();
+        }
+
+        /* The response is truncated to the MTU */
+        used += wiced_bt_gatt_put_read_multi_rsp_in_stream(opcode, p_rsp + used, len_req - used, handle,
+                                                           puAttribute->cur_len, puAttribute->p_data);
+    }
+
+    return wiced_bt_gatt_server_send_read_multiple_rsp(conn_id, opcode, used, p_rsp, (void *)app_free_buffer);
+}
+
 /**
 * Function Name:
 * ble_app_set_value
@@ -755,6 +851,7 @@ static wiced_bt_gatt_status_t ble_app_read_handler( uint16_t conn_id,
 * @param  attr_handle  GATT attribute handle
 *         p_val        Pointer to BLE GATT write request value
 *         len          length of GATT write request
+*         rx_us        Time the request reached the application, app_timestamp_us()
 *
 *
 * @return  wiced_bt_gatt_status_t: See possible status codes in wiced_bt_gatt_status_e in
@@ -763,13 +860,13 @@ static wiced_bt_gatt_status_t ble_app_read_handler( uint16_t conn_id,
 */
 static wiced_bt_gatt_status_t ble_app_set_value(uint16_t attr_handle,
                                                 uint8_t *p_val,
-                                                uint16_t len)
+                                                uint16_t len,
+                                                uint32_t rx_us)
 {
     int i = 0;
     wiced_bool_t isHandleInTable = WICED_FALSE;
     wiced_bool_t validLen = WICED_FALSE;
     wiced_bt_gatt_status_t res = WICED_BT_GATT_INVALID_HANDLE;
-    cy_rslt_t rslt = CY_RSLT_SUCCESS;
     uint16_t cccd=0;
 
     // Check for a matching handle entry
@@ -796,19 +893,49 @@ static wiced_bt_gatt_status_t ble_app_set_value(uint16_t attr_handle,
                         return WICED_BT_GATT_INVALID_ATTR_LEN;
                     }
 
-                    /* Update CCCD Value in Flash */
+                    /* The event loop saves the CCCD in the bond slot of the peer, once the
+                     * link is encrypted */
                     cccd = (p_val[0] | (p_val[1]<<8));
-                    rslt = app_bt_update_cccd(cccd, bondindex);
-                    if (CY_RSLT_SUCCESS != rslt)
+                    app_state_post(APP_STATE_EVT_CCCD_WRITTEN, cccd);
+                    break;
+                case HDLD_METRICS_COUNTERS_CLIENT_CHAR_CONFIG:
+                    if (len != 2)
+                    {
+                        return WICED_BT_GATT_INVALID_ATTR_LEN;
+                    }
+
+                    /* Not saved, gateways subscribe on every connection */
+                    res = app_metrics_set_cccd(p_val[0] | (p_val[1] << 8));
+                    break;
+                case HDLC_THROUGHPUT_SINK_VALUE:
+                    app_throughput_on_sink(len);
+                    break;
+                case HDLD_THROUGHPUT_SOURCE_CLIENT_CHAR_CONFIG:
+                    if (len != 2)
                     {
-                        printf("Failed to update CCCD Value in Flash! \r\n");
+                        return WICED_BT_GATT_INVALID_ATTR_LEN;
                     }
-                    else{
-                        printf("CCCD value updated in Flash! \r\n");
+
+                    /* Not saved, the source stops when notifications are disabled */
+                    app_event_post(APP_EVT_THROUGHPUT, 0);
+                    break;
+                case HDLC_THROUGHPUT_CONTROL_VALUE:
+                    /* The command is replaced by the results, read back from the same value */
+                    res = app_throughput_on_control(p_val, len);
+                    app_gatt_db_ext_attr_tbl[i].cur_len = app_throughput_control_len;
+                    app_throughput_refresh();
+                    break;
+                case HDLC_ECHO_ECHO_VALUE:
+                    res = app_echo_on_write(p_val, len, rx_us);
+                    break;
+                case HDLD_ECHO_ECHO_CLIENT_CHAR_CONFIG:
+                    if (len != 2)
+                    {
+                        return WICED_BT_GATT_INVALID_ATTR_LEN;
                     }
                     break;
                 default:
-                    printf("Write is not supported \r\n");
+                    APP_LOG0(LOG_WRITE_NOT_SUPPORTED);
                 }
             }
             else
@@ -826,7 +953,7 @@ static wiced_bt_gatt_status_t ble_app_set_value(uint16_t attr_handle,
         {
         default:
             // The write operation was not performed for the indicated handle
-            printf("Write Request to Invalid Handle: 0x%x\r\n", attr_handle);
+            APP_LOG(LOG_WRITE_INVALID_HANDLE, attr_handle);
             res = WICED_BT_GATT_WRITE_NOT_PERMIT;
             break;
         }
@@ -863,7 +990,7 @@ static wiced_bt_gatt_status_t ble_app_bt_gatt_req_read_by_type_handler(uint16_t
 
     if (p_rsp == NULL)
     {
-        printf("No memory, len_requested: %d!!\r\n",len_requested);
+        APP_LOG(LOG_NO_MEMORY, len_requested);
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, attr_handle, WICED_BT_GATT_INSUF_RESOURCE);
         return WICED_BT_GATT_INSUF_RESOURCE;
     }
@@ -879,7 +1006,7 @@ static wiced_bt_gatt_status_t ble_app_bt_gatt_req_read_by_type_handler(uint16_t
 
         if ((puAttribute = app_get_attribute(attr_handle)) == NULL)
         {
-            printf("found type but no attribute for %d \r\n",last_handle);
+            APP_LOG(LOG_TYPE_NO_ATTRIBUTE, last_handle);
             wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->s_handle,
                                                 WICED_BT_GATT_ERR_UNLIKELY);
             app_free_buffer(p_rsp);
@@ -902,8 +1029,7 @@ static wiced_bt_gatt_status_t ble_app_bt_gatt_req_read_by_type_handler(uint16_t
 
     if (used == 0)
     {
-       printf("attr not found  start_handle: 0x%04x  end_handle: 0x%04x  Type: 0x%04x\r\n",
-               p_read_req->s_handle, p_read_req->e_handle, p_read_req->uuid.uu.uuid16);
+        APP_LOG(LOG_ATTR_NOT_FOUND, p_read_req->s_handle, p_read_req->e_handle, p_read_req->uuid.uu.uuid16);
         wiced_bt_gatt_server_send_error_rsp(conn_id, opcode, p_read_req->s_handle, WICED_BT_GATT_INVALID_HANDLE);
         app_free_buffer(p_rsp);
         return WICED_BT_GATT_INVALID_HANDLE;
@@ -918,8 +1044,8 @@ static wiced_bt_gatt_status_t ble_app_bt_gatt_req_read_by_type_handler(uint16_t
 * led_task_communicator
 *
 * Function Description:
-* @brief   This function handles the communication to the led task by pushing current
-*          advertisement state to the LED queue which is processed by app_led_control
+* @brief   This function handles the communication to the LED handler by posting
+*          the current advertisement state to the application event loop
 *
 * @param  *CurrAdvState:Current Advertisement State
 *
@@ -928,38 +1054,29 @@ static wiced_bt_gatt_status_t ble_app_bt_gatt_req_read_by_type_handler(uint16_t
 */
 void led_task_communicator(wiced_bt_ble_advert_mode_t CurrAdvState)
 {
+    APP_TRACE(APP_TRACE_ADV, CurrAdvState, 0);
 
     /* Post the Current Advertisement State */
-
-
-    if( CY_RSLT_SUCCESS != cy_rtos_queue_put( &xLEDQueue, &CurrAdvState,10))
+    if (CY_RSLT_SUCCESS != app_event_post(APP_EVT_LED, CurrAdvState))
     {
         printf("Failed to queue up Current Advertisement State!");
     }
-
-
 }
 
 /**
  * Function Name:
- * app_led_control
+ * app_led_init
  *
  * Function Description:
- * @brief  This Function to toggle led state depending on the state of advertisement.
- *         1. Advertisement ON (Undirected):   slow Blinking led(T = 1 sec)
- *         2. Advertisement ON (Directed):     fast Blinking led(T = 200 msec)
- *         3. Advertisement OFF, Connected:    LED ON
- *         4. Advertisement OFF, Timed out:    LED OFF
+ * @brief  This function initializes the PWM driving the advertising LED.
  *
- * @param    void *pvParameters:                Not used
+ * @param  None
  *
- * @return  None.
+ * @return None
  */
-
-void app_led_control(cy_thread_arg_t arg)
+void app_led_init(void)
 {
     cy_rslt_t rslt;
-    wiced_bt_ble_advert_mode_t CurrAdvState;
 
     /* Initialize the PWM used for Advertising LED */
     rslt = cyhal_pwm_init(&adv_led_pwm, CYBSP_USER_LED1, NULL);
@@ -970,135 +1087,98 @@ void app_led_control(cy_thread_arg_t arg)
         printf("Advertisement LED PWM Initialization has failed! \n");
         CY_ASSERT(0);
     }
-    while (1)
-    {
-         if (CY_RSLT_SUCCESS == cy_rtos_queue_get(&xLEDQueue, &(CurrAdvState), portMAX_DELAY))
-        {
-            switch (CurrAdvState)
-            {
-            case BTM_BLE_ADVERT_OFF:
-                if (0 != connection_id)
-                {
-                    rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_OFF_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
-                }
-                else
-                {
-                    rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_ON_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
-                }
-                break;
-
-            case BTM_BLE_ADVERT_DIRECTED_HIGH:
-            case BTM_BLE_ADVERT_DIRECTED_LOW:
-                rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_BLINKING_DUTY_CYCLE, DIRECTED_ADV_LED_PWM_FREQUENCY);
-                break;
-
-            case BTM_BLE_ADVERT_UNDIRECTED_HIGH:
-            case BTM_BLE_ADVERT_UNDIRECTED_LOW:
-                rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_BLINKING_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
-                break;
-
-            default:
-                break;
-            }
-        }
-
-        /* Check if update to PWM parameters is successful*/
-        if (CY_RSLT_SUCCESS != rslt)
-        {
-            printf("Failed to set duty cycle parameters!!");
-        }
-
-        rslt = cyhal_pwm_start(&adv_led_pwm);
-
-        /* Check if PWM started successfully */
-        if (CY_RSLT_SUCCESS != rslt)
-        {
-            printf("Failed to start PWM !!");
-        }
-    }
 }
 
 /**
  * Function Name:
- * key_button_app_init
+ * app_led_event_handler
  *
  * Function Description:
- * @brief  This function configures the button for the interrupts.
- *
- * @param  None
+ * @brief  This function sets the led state depending on the state of advertisement.
+ *         1. Advertisement ON (Undirected):   slow Blinking led(T = 1 sec)
+ *         2. Advertisement ON (Directed):     fast Blinking led(T = 200 msec)
+ *         3. Advertisement OFF, Connected:    LED ON
+ *         4. Advertisement OFF, Timed out:    LED OFF
  *
- * @return None
+ * @param  uint32_t data: Advertisement state, wiced_bt_ble_advert_mode_t
  *
+ * @return None.
  */
-/**
-* Function Name:
-* key_button_app_init
-*
-* Function Description:
-* @brief This function configures the button for the interrupts.
-*
-* @param None
-*
-* @return None
-*
-*/
-void key_button_app_init(void)
+void app_led_event_handler(uint32_t data)
 {
-    /* Initialize GPIO for button interrupt*/
-    cy_rslt_t rslt = cyhal_gpio_init(CYBSP_USER_BTN, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF);
-    /* GPIO init failed. Stop program execution */
+    cy_rslt_t rslt = CY_RSLT_SUCCESS;
+    wiced_bt_ble_advert_mode_t CurrAdvState = (wiced_bt_ble_advert_mode_t)data;
+    uint8_t adv_mode = (uint8_t)CurrAdvState;
+
+    /* Test rigs follow the advertising state with the control protocol */
+    app_ctrl_send_event(CTRL_EVT_ADV_STATE, &adv_mode, sizeof(adv_mode));
+
+    switch (CurrAdvState)
+    {
+    case BTM_BLE_ADVERT_OFF:
+        if (0 != connection_id)
+        {
+            rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_OFF_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
+        }
+        else
+        {
+            rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_ON_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
+        }
+        break;
+
+    case BTM_BLE_ADVERT_DIRECTED_HIGH:
+    case BTM_BLE_ADVERT_DIRECTED_LOW:
+        rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_BLINKING_DUTY_CYCLE, DIRECTED_ADV_LED_PWM_FREQUENCY);
+        break;
+
+    case BTM_BLE_ADVERT_UNDIRECTED_HIGH:
+    case BTM_BLE_ADVERT_UNDIRECTED_LOW:
+        rslt = cyhal_pwm_set_duty_cycle(&adv_led_pwm, LED_BLINKING_DUTY_CYCLE, ADV_LED_PWM_FREQUENCY);
+        break;
+
+    default:
+        break;
+    }
+
+    /* Check if update to PWM parameters is successful*/
     if (CY_RSLT_SUCCESS != rslt)
     {
-        printf("Button GPIO init failed! \n");
-        CY_ASSERT(0);
+        printf("Failed to set duty cycle parameters!!");
     }
-    /* Initialize the structure with values. Add these lines just before initializing button */
-    button_cb_struct.callback = button_interrupt_handler;
-    button_cb_struct.callback_arg = NULL;
-    button_cb_struct.pin = NC;
-    button_cb_struct.next = NULL;
-    /* Configure GPIO interrupt. */
-    cyhal_gpio_register_callback(CYBSP_USER_BTN, &button_cb_struct);
-    cyhal_gpio_enable_event(CYBSP_USER_BTN, CYHAL_GPIO_IRQ_FALL, BUTTON_INTERRUPT_PRIORITY, true);
-}
 
-/**
-* Function Name:
-* button_interrupt_handler
-*
-* Function Description:
-* @brief This interrupt handler enables or disables GATT notifications upon button
-* press.
-*
-* @param void *handler_arg: Not used
-* cyhal_gpio_event_t event: Not used
-*
-* @return None
-*
-*/
-void button_interrupt_handler(void *handler_arg, cyhal_gpio_event_t event)
-{
-    cy_rtos_thread_set_notification (&button_task_pointer);
+    rslt = cyhal_pwm_start(&adv_led_pwm);
+
+    /* Check if PWM started successfully */
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to start PWM !!");
+    }
 }
 
 /**
 * Function Name:
-* button_task
+* app_button_event_handler
 *
 * Function Description:
-* @brief   This task starts Bluetooth LE advertisment on first button press and enables
-*          or disables notifications from the server upon successive button presses.
+* @brief   This function counts the button presses and sends the updated value
+*          as a notification, one per press, if the connected client enabled
+*          them. It runs on the urgent path of the event loop and the time
+*          from the button interrupt to the notification is recorded.
 *
-* @param  void *pvParameters:  Not used
+* @param  uint32_t data:  Not used
 *
 * @return None
 *
 */
-void button_task(cy_thread_arg_t arg)
+void app_button_event_handler(uint32_t data)
 {
-    for (;;)
+    uint32_t press_us;
+    wiced_bt_gatt_status_t status;
+
+    (void) data;
+
+    while (app_button_get_press(&press_us))
     {
-        cy_rtos_thread_wait_notification(portMAX_DELAY);
         /* Increment the button value to register the button press */
         app_wicedbutton_mb1[0]++;
         /* If the connection is up and if the client wants notifications, send updated button press value */
@@ -1106,300 +1186,161 @@ void button_task(cy_thread_arg_t arg)
         {
             if (app_wicedbutton_mb1_client_char_config[0] & GATT_CLIENT_CONFIG_NOTIFICATION)
             {
-                wiced_bt_gatt_server_send_notification(connection_id, HDLC_WICEDBUTTON_MB1_VALUE,
-                                                app_wicedbutton_mb1_len, app_wicedbutton_mb1, NULL);
-                printf("Send Notification: sending Button value\r\n");
+                status = wiced_bt_gatt_server_send_notification(connection_id,
+                                                HDLC_WICEDBUTTON_MB1_VALUE, app_wicedbutton_mb1_len,
+                                                app_wicedbutton_mb1, NULL);
+                app_metrics_on_notification(status);
+                /* Only a notification the stack took is a press-to-notify sample */
+                if (WICED_BT_GATT_SUCCESS == status)
+                {
+                    app_button_notified(press_us);
+                }
+                APP_TRACE(APP_TRACE_NOTIFY, 0, HDLC_WICEDBUTTON_MB1_VALUE);
+                APP_LOG(LOG_NOTIFICATION_SENT, status);
             }
             else
             {
-                printf("Notifications are Disabled\r\n");
+                APP_TRACE(APP_TRACE_NOTIFY, 1, HDLC_WICEDBUTTON_MB1_VALUE);
+                APP_LOG0(LOG_NOTIFICATIONS_DISABLED);
             }
         }
         else
         {
-            printf("Connection is not Up \r\n");
+            APP_TRACE(APP_TRACE_NOTIFY, 2, HDLC_WICEDBUTTON_MB1_VALUE);
+            APP_LOG0(LOG_NOT_CONNECTED);
         }
     }
 }
 
 /**
 * Function Name:
-* uart_interrupt_handler
-*
-* Function Description:
-* @brief  This function handles the UART interrupts and pushes the input to the
-*         UART queue for processing by uart_task
-*
-* @param  void *handler_arg:                 Not used
-*         cyhal_uart_event_t event:          Not used
-*
-* @return  None
-*
-*/
-void uart_interrupt_handler(void *handler_arg, cyhal_uart_event_t event)
-{
-    (void) handler_arg;
-    uint8_t readbyte;
-
-    /* Read one byte from the buffer with a 100ms timeout */
-    cyhal_uart_getc(&cy_retarget_io_uart_obj , &readbyte, 100);
-
-    /* Post the byte. */
-    cy_rtos_queue_put(&xUARTQueue, &readbyte, 0);
-}
-
-/**
-* Function Name:
-* uart_task
+* app_command_handler
 *
 * Function Description:
-* @brief  This function runs the UART task which processes the received commands via
-*         Terminal.
+* @brief  This function processes the commands received via Terminal.
 *
-* @param  void *pvParameters   : Not used
+* @param  p_cmd   : Parsed command line
 *
 * @return None
 *
 */
-
-void uart_task(cy_thread_arg_t arg)
+void app_command_handler(const app_cmd_t *p_cmd)
 {
-    uint8_t readbyte = 0;
-    cy_rslt_t rslt = CY_RSLT_SUCCESS;
+    app_action_status_t status;
     uint8_t count = 0;
-    uint8_t device_index = 0;
+    uint32_t device_index = 0;
 
-    for(;;)
+    switch (p_cmd->cmd)
     {
-         if (CY_RSLT_SUCCESS == cy_rtos_queue_get( &xUARTQueue, &(readbyte), portMAX_DELAY))
+    case APP_CMD_SLOT:
+        /* Slot numbers start at 1 */
+        device_index = p_cmd->argv[0];
+        if (IDLE_PRIVACY_CHANGE == app_state_get())
         {
-            /* Extract Device Index for use wherever required*/
-            device_index = readbyte - '0';
-            switch (readbyte)
-            {
-            case '1':
-                if ((IDLE_DATA == state) && (1 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    directed_adv_handler(device_index);
-                }
-                else if ((IDLE_PRIVACY_CHANGE == state) && (1 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    privacy_mode_handler(device_index);
-                    /*once privacy mode is changed go back to idle data state*/
-                    state = IDLE_DATA;
-                }
-                else
-                    printf("Invalid Operation\r\n");
-                break;
-
-            case '2':
-                if ((IDLE_DATA == state) && (2 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    directed_adv_handler(device_index);
-                }
-                else if ((IDLE_PRIVACY_CHANGE == state) && (2 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    privacy_mode_handler(device_index);
-                    /*once privacy mode is changed go back to idle data state*/
-                    state = IDLE_DATA;
-                }
-                else
-                    printf("Invalid Operation\r\n");
-                break;
-
-            case '3':
-                if ((IDLE_DATA == state) && (3 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    directed_adv_handler(device_index);
-                }
-                else if ((IDLE_PRIVACY_CHANGE == state) && (3 <= bondinfo.slot_data[NUM_BONDED]))
-                {
-                    privacy_mode_handler(device_index);
-                    /*once privacy mode is changed go back to idle data state*/
-                    state = IDLE_DATA;
-                }
-                else
-                    printf("Invalid Operation\r\n");
-                break;
+            /* Once privacy mode is changed the state goes back to IDLE_DATA */
+            if (APP_ACTION_SUCCESS != app_action_privacy_toggle(device_index))
+                printf("Invalid Operation\r\n");
+        }
+        else if (APP_ACTION_SUCCESS != app_action_directed_adv(device_index))
+            printf("Invalid Operation\r\n");
+        break;
 
-            case '4':
-                if ((IDLE_DATA == state) && (4 == bondinfo.slot_data[NUM_BONDED]))
-                {
-                    directed_adv_handler(device_index);
-                }
-                else if ((IDLE_PRIVACY_CHANGE == state) && (4 == bondinfo.slot_data[NUM_BONDED]))
-                {
-                    privacy_mode_handler(device_index);
-                    /*once privacy mode is changed go back to idle data state*/
-                    state = IDLE_DATA;
-                }
-                else
-                    printf("Invalid Operation\r\n");
-                break;
+    case 'd':
+        status = app_action_delete_bonds();
+        if (APP_ACTION_INVALID_STATE == status)
+        {
+            if (IDLE_NO_DATA == app_state_get())
+                printf("No bond data present \r\n");
+            else
+                printf("This option is not available when device is in connected or bonded state or its doing directed advertisement!!\r\n");
+        }
+        break;
 
-            case 'd':
-                if (IDLE_DATA == state && BTM_BLE_ADVERT_DIRECTED_LOW != *p_adv_mode && BTM_BLE_ADVERT_DIRECTED_HIGH != *p_adv_mode)
-                {
-                    /* Put into bonding mode  */
-                    bond_mode = TRUE;
-                    rslt = app_bt_delete_bond_info();
-                    if( CY_RSLT_SUCCESS == rslt)
-                    {
-                        printf( "Erased Flash!\n");
-                    }
-                    else
-                    {
-                        printf("Flash Write Error!\n");
-                    }
-                    wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+    case 'e':
+        printf("************************** NOTE ***************************************************\r\n");
+        printf("*ONCE THE SLOTS ARE FULL THE OLDEST DEVICE DATA WILL BE OVERWRITTEN FOR NEW DEVICE*\r\n");
+        printf("***********************************************************************************\r\n");
+        if (APP_ACTION_INVALID_STATE == app_action_bond_mode(!app_state_bond_mode()))
+            printf("This option is not available when device is in connected or bonded state!!");
+        break;
 
-                    /* Change state to Idle and no data */
-                    state = IDLE_NO_DATA;
-                }
-                else if (IDLE_NO_DATA == state)
-                    printf("No bond data present \r\n");
-                else
-                    printf("This option is not available when device is in connected or bonded state or its doing directed advertisement!!\r\n");
+    case 'h':
+        display_menu();
+        break;
 
-                break;
+    case 'l':
+        printf("Number of bonded devices: %d, Next free slot: %d, Number of free slot: %d \r\n", bondinfo.slot_data[NUM_BONDED], bondinfo.slot_data[NEXT_FREE_INDEX] + 1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
+        for (count = 0; count < bondinfo.slot_data[NUM_BONDED]; count++)
+        {
+            printf("Host %d: ", count+1);
+            print_bd_address(bondinfo.link_keys[count].bd_addr);
+        }
+        break;
 
-            case 'e':
-                printf("************************** NOTE ***************************************************\r\n");
-                printf("*ONCE THE SLOTS ARE FULL THE OLDEST DEVICE DATA WILL BE OVERWRITTEN FOR NEW DEVICE*\r\n");
-                printf("***********************************************************************************\r\n");
-                if (!((CONNECTED == state) || (BONDED == state)))
-                {
-                    if (bond_mode == WICED_FALSE) /* Enter bond mode */
-                    {
-                        /* Check to see if we need to erase one of the existing devices */
-                        if (bondinfo.slot_data[NUM_BONDED ] == BOND_INDEX_MAX)
-                        {
-                            printf("Bonding slots full removing the oldest device \r\n");
-
-                            /* Remove oldest device from the bonded device list */
-                            wiced_result_t result = app_bt_delete_device_info(bondinfo.slot_data[NEXT_FREE_INDEX]);
-                            if (WICED_BT_SUCCESS != result)
-                            {
-                                printf("error deleting device bond data!");
-                            }
-                            /* Reduce number of bonded devices by one */
-                            bondinfo.slot_data[NUM_BONDED]--;
-
-                            /*Update bond information in Flash*/
-                             rslt = app_bt_update_bond_data();
-                            if (CY_RSLT_SUCCESS == rslt)
-                            {
-                                printf("Removed host: ");
-                                print_bd_address((uint8_t *)&bondinfo.link_keys[bondinfo.slot_data[NEXT_FREE_INDEX]].bd_addr);
-                            }
-                            else
-                            {
-                                printf("Flash Write Error, Cannot delete device!\n");
-                            }
-                        }
-
-                        /* Put into bonding mode  */
-                        bond_mode = WICED_TRUE;
-                        printf("Bonding Mode Entered\r\n");
-#ifdef PSOC6_BLE
-/* This is a workaround for the issue mentioned in the Notes section under Document History in Readme.md
- * It allows the PSoC 6 Bluetooth LE device to connect to a new peer device even if PSoC 6 Bluetooth LE
- * has bonded with other devices previously. If there is a need to connect to a new device, clear the
- * controller address resolution list, start advertisement to connect with any new device, add the
- * old devices back to controller address resolution list immediately after connection. */
-                pairing_mode = TRUE;
-                wiced_result_t result = wiced_bt_ble_address_resolution_list_clear_and_disable();
-                if(WICED_BT_SUCCESS == result)
-                {
-                    printf("Address resolution list cleared successfully \n");
-                }
-                else
-                {
-                    printf("Failed to clear address resolution list \n");
-                }
-#endif
+    case 's':
+        app_bt_adv_print_sched();
+        app_bt_adv_print_transitions();
+        app_bt_link_loss_print_stats();
+        app_bt_privacy_print_stats();
+        app_event_print_stats();
+        app_uart_rx_print_stats();
+        app_ctrl_print_stats();
+        app_log_print_stats();
+        app_button_print_stats();
+        app_echo_print_stats();
+        app_power_print_stats();
+        app_state_print_stats();
+        break;
 
-                        /* restart the advertisements in Bonding Mode */
-                        wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
-                    }
-                    else /* Exit bonding mode */
-                    {
-                        bond_mode = WICED_FALSE;
-                        printf("Bonding Mode Exited\r\n");
-                    }
-                }
-                else
-                    printf("This option is not available when device is in connected or bonded state!!");
-                break;
+    case 'k':
+        app_stack_mon_report();
+        break;
 
-            case 'h':
-                display_menu();
-                break;
+    case 'x':
+        app_trace_dump();
+        break;
 
-            case 'l':
-                printf("Number of bonded devices: %d, Next free slot: %d, Number of free slot: %d \r\n", bondinfo.slot_data[NUM_BONDED], bondinfo.slot_data[NEXT_FREE_INDEX] + 1, (BOND_INDEX_MAX - bondinfo.slot_data[NUM_BONDED]));
-                for (count = 0; count < bondinfo.slot_data[NUM_BONDED]; count++)
-                {
-                    printf("Host %d: ", count+1);
-                    print_bd_address(bondinfo.link_keys[count].bd_addr);
-                }
-                break;
-            case 'p':
-                /* If current state is bonded toggle current device privacy mode  else
-                * print all devices and ask user for device to toggle Privacy mode*/
-                if (BONDED == state)
-                {
-                    privacy_mode_handler(bondindex);
-                }
-                else
-                {
-                    state = IDLE_PRIVACY_CHANGE;
-                    printf("Select the bonded Devices Found in below list to toggle current privacy mode \r\n\r\n");
-                    print_device_selection_menu();
-                    printf("\r\nEnter the slot number of the device to change privacy mode: \r\n");
-                }
-                break;
+    case 'm':
+        app_heap_dump();
+        break;
 
-            case 'y':
-                /*Useful if using numeric comparison for pairing*/
-                wiced_bt_dev_confirm_req_reply(WICED_BT_SUCCESS,connected_bda);
-                printf("Numeric Values are Matching!!\n");
-                break;
+    case 'p':
+        /* If current state is bonded toggle current device privacy mode  else
+        * print all devices and ask user for device to toggle Privacy mode*/
+        if (BONDED == app_state_get())
+        {
+            (void) app_action_privacy_toggle(app_state_bond_index() + 1);
+        }
+        else if (1 == p_cmd->argc)
+        {
+            /* Slot given on the command line, e.g. "p 3" */
+            if (APP_ACTION_SUCCESS != app_action_privacy_toggle(p_cmd->argv[0]))
+            {
+                printf("Invalid Operation\r\n");
+            }
+        }
+        else if (APP_STATE_RSLT_REJECTED == app_state_handle(APP_STATE_EVT_PRIVACY_SELECT, 0))
+        {
+            printf("Invalid Operation\r\n");
+        }
+        break;
 
-            case 'n':
-                /*Useful if using numeric comparison for pairing*/
-                wiced_bt_dev_confirm_req_reply(WICED_BT_ERROR, connected_bda);
-                printf("Numeric Values Don't Match\n");
-                break;
+    case 'y':
+        /*Useful if using numeric comparison for pairing*/
+        app_action_numeric_reply(WICED_TRUE);
+        break;
 
-            case 'r':
+    case 'n':
+        /*Useful if using numeric comparison for pairing*/
+        app_action_numeric_reply(WICED_FALSE);
+        break;
 
-                if (CONNECTED != state && BONDED != state && BTM_BLE_ADVERT_DIRECTED_LOW != *p_adv_mode && BTM_BLE_ADVERT_DIRECTED_HIGH != *p_adv_mode)
-                {
-                    /*Reset Kv-store library, this will clear the flash*/
-                    rslt = mtb_kvstore_reset(&kvstore_obj);
-                    if (CY_RSLT_SUCCESS == rslt)
-                    {
-                        printf("successfully reset kv-store library, Please reset the device to generate new Keys!\r\n");
-                    }
-                    else
-                    {
-                        printf("failed to reset kv-store libray\r\n");
-                    }
-                    /*Clear bondinfo structure*/
-                    memset(&bondinfo, 0, sizeof(bondinfo));
-                    wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
-                    /* Change state to Idle and no data */
-                    state = IDLE_NO_DATA;
-                    /* Put into bonding mode  */
-                    bond_mode = TRUE;
-                }
-                break;
+    case 'r':
+        app_action_kvstore_reset();
+        break;
 
-            default:
-                printf("Invalid Input\r\n");
-            }
-        }
+    default:
+        printf("Invalid Input\r\n");
     }
 }
 
@@ -1425,62 +1366,174 @@ void display_menu(void)
     printf("**5) Press 'p' to change privacy mode of bonded device                **\r\n");
     printf("**6) Press 'h' any time in application to print the menu              **\r\n");
     printf("**7) Press 'r' to reset kv-store (delete bond data and local IRK)     **\r\n");
+    printf("**8) Press 's' to print advertising and connection statistics         **\r\n");
+    printf("**9) Press 'k' to print the stack usage of every thread               **\r\n");
+    printf("**10) Press 'x' to dump the event trace                               **\r\n");
+    printf("**11) Press 'm' to print the heap buffers outstanding and the trend   **\r\n");
     printf("***********************************************************************\r\n");
 }
 
 /**
- * Function Name: directed_adv_handler
+ * Function Name: app_action_status
  *
  * Function Description:
- * @brief   Directed advertisement Handler.
+ * @brief   Converts the result of a state machine transition to the status
+ *          reported to the terminal and the control protocol.
  *
- * @param   device_index : Index of the device stored in the device list to start directed
- *                         advertisement to.
+ * @param   rslt : Result of app_state_handle()
  *
- * @return  None
+ * @return  app_action_status_t
  *
  */
-void directed_adv_handler(uint8_t device_index)
+static app_action_status_t app_action_status(cy_rslt_t rslt)
 {
-    wiced_result_t result;
-
-    wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF, 0, NULL);
-    printf("Starting directed Advertisement for ");
-    print_bd_address(bondinfo.link_keys[device_index - 1].bd_addr);
-    printf("Enter e for Starting undirected Advertisement to add new device\r\n");
-    result = wiced_bt_start_advertisements(BTM_BLE_ADVERT_DIRECTED_HIGH, bondinfo.link_keys[device_index-1].key_data.ble_addr_type, bondinfo.link_keys[device_index-1].bd_addr);
-    if (WICED_BT_SUCCESS != result)
+    if (APP_STATE_RSLT_REJECTED == rslt)
     {
-        printf("failed to start directed advertisement! \n");
+        return APP_ACTION_INVALID_STATE;
     }
+
+    return (CY_RSLT_SUCCESS == rslt) ? APP_ACTION_SUCCESS : APP_ACTION_FLASH_ERROR;
 }
 
 /**
- * Function Name:
- * void privacy_mode_handler
+ * Function Name: app_action_delete_bonds
  *
  * Function Description:
- * @brief   Handles request for change of privacy mode of bonded devices.
+ * @brief   Erases the bond data of all the peers and restarts advertising in
+ *          bonding mode. Not available while connected or advertising to a
+ *          bonded peer.
  *
- * @param   device_index   Index of the device stored in the device list to change privacy
- *                         mode.
+ * @param   None
  *
- * @return  None
+ * @return  app_action_status_t
  *
  */
-void privacy_mode_handler(uint8_t device_index)
+app_action_status_t app_action_delete_bonds(void)
 {
-    cy_rslt_t rslt;
-    bondinfo.privacy_mode[device_index] ^= 1;
-    printf("Privacy Mode for device %d changed to (0 for Network, 1 for Device) :  %d \r\n", device_index, bondinfo.privacy_mode[device_index]);
-    rslt = mtb_kvstore_write_numeric_key(&kvstore_obj,bond_data, (uint8_t *)&bondinfo, sizeof(bondinfo),true);
-    if(CY_RSLT_SUCCESS != rslt)
+    return app_action_status(app_state_handle(APP_STATE_EVT_DELETE_BONDS, 0));
+}
+
+/**
+ * Function Name: app_action_bond_mode
+ *
+ * Function Description:
+ * @brief   Enters or exits bonding mode. Entering it with all the slots in
+ *          use removes the oldest peer.
+ *
+ * @param   enter : WICED_TRUE to enter bonding mode, WICED_FALSE to exit it
+ *
+ * @return  app_action_status_t
+ *
+ */
+app_action_status_t app_action_bond_mode(wiced_bool_t enter)
+{
+    return app_action_status(app_state_handle(APP_STATE_EVT_BOND_MODE, enter));
+}
+
+/**
+ * Function Name: app_action_directed_adv
+ *
+ * Function Description:
+ * @brief   Starts directed advertising to a bonded peer.
+ *
+ * @param   slot : Bond slot of the peer, starting at 1
+ *
+ * @return  app_action_status_t
+ *
+ */
+app_action_status_t app_action_directed_adv(uint32_t slot)
+{
+    if ((1 > slot) || (bondinfo.slot_data[NUM_BONDED] < slot))
+    {
+        return APP_ACTION_INVALID_SLOT;
+    }
+
+    return app_action_status(app_state_handle(APP_STATE_EVT_DIRECTED_ADV, slot));
+}
+
+/**
+ * Function Name: app_action_privacy_toggle
+ *
+ * Function Description:
+ * @brief   Toggles the privacy mode of a bonded peer. The state goes back to
+ *          IDLE_DATA if it was waiting for the slot.
+ *
+ * @param   slot : Bond slot of the peer, starting at 1
+ *
+ * @return  app_action_status_t
+ *
+ */
+app_action_status_t app_action_privacy_toggle(uint32_t slot)
+{
+    if ((1 > slot) || (bondinfo.slot_data[NUM_BONDED] < slot))
+    {
+        return APP_ACTION_INVALID_SLOT;
+    }
+
+    return app_action_status(app_state_handle(APP_STATE_EVT_PRIVACY_TOGGLE, slot));
+}
+
+/**
+ * Function Name: app_action_kvstore_reset
+ *
+ * Function Description:
+ * @brief   Resets the kv-store, deleting the bond data and the local IRK, and
+ *          restarts advertising in bonding mode. Not available while connected
+ *          or advertising to a bonded peer.
+ *
+ * @param   None
+ *
+ * @return  app_action_status_t
+ *
+ */
+app_action_status_t app_action_kvstore_reset(void)
+{
+    return app_action_status(app_state_handle(APP_STATE_EVT_KVSTORE_RESET, 0));
+}
+
+/**
+ * Function Name: app_action_numeric_reply
+ *
+ * Function Description:
+ * @brief   Answers the numeric comparison of the pairing in progress.
+ *
+ * @param   match : WICED_TRUE if the values shown on both devices match
+ *
+ * @return  app_action_status_t
+ *
+ */
+app_action_status_t app_action_numeric_reply(wiced_bool_t match)
+{
+    if (WICED_TRUE == match)
+    {
+        wiced_bt_dev_confirm_req_reply(WICED_BT_SUCCESS,connected_bda);
+        printf("Numeric Values are Matching!!\n");
+    }
+    else
     {
-        printf("Failed to update ");
+        wiced_bt_dev_confirm_req_reply(WICED_BT_ERROR, connected_bda);
+        printf("Numeric Values Don't Match\n");
     }
-    wiced_bt_ble_set_privacy_mode(bondinfo.link_keys[device_index].bd_addr,
-                                  bondinfo.link_keys[device_index].key_data.ble_addr_type ,
-                                  bondinfo.privacy_mode[device_index]);
+
+    return APP_ACTION_SUCCESS;
+}
+
+/**
+ * Function Name: app_action_get_status
+ *
+ * Function Description:
+ * @brief   Reports the state of the application.
+ *
+ * @param   p_state : State of the application (enum StateMachine)
+ * @param   p_bond_mode : Bonding mode
+ *
+ * @return  None
+ *
+ */
+void app_action_get_status(uint8_t *p_state, wiced_bool_t *p_bond_mode)
+{
+    *p_state = (uint8_t)app_state_get();
+    *p_bond_mode = app_state_bond_mode();
 }
 
 
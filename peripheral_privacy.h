@@ -48,6 +48,7 @@
 #include "cyabs_rtos.h"
 #include "cyhal.h"
 #include "wiced_bt_ble.h"
+#include "app_cmd.h"
 /*******************************************************************************
 *        Macro Definitions
 *******************************************************************************/
@@ -55,22 +56,28 @@
 /* PWM frequency of LED's in Hertz when blinking */
 #define ADV_LED_PWM_FREQUENCY               (1)
 #define DIRECTED_ADV_LED_PWM_FREQUENCY      (3)
-#define BUTTON_INTERRUPT_PRIORITY           (3u)
 #define INT_PRIORITY                        (3u)
 
-/* Queue size for LED and UART tasks*/
-#define QUEUE_SIZE                          (1)
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Result of the actions shared by the terminal and the control protocol */
+typedef enum
+{
+    APP_ACTION_SUCCESS,
+    APP_ACTION_INVALID_STATE,   /* Not available in the current state */
+    APP_ACTION_INVALID_SLOT,    /* No bonded peer in this slot */
+    APP_ACTION_FLASH_ERROR,     /* Done, but the flash could not be updated */
+} app_action_status_t;
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-extern cy_thread_t button_task_pointer;
-
-extern cy_thread_t uart_task_pointer;
-
-extern cy_thread_t led_task_pointer;
-extern cy_queue_t xLEDQueue;
-extern cy_queue_t xUARTQueue;
+extern cy_thread_t app_event_task_pointer;
+#ifdef PSOC6_BLE
+/* Address resolution list cleared to bond with a new peer, see Readme.md */
+extern bool        pairing_mode;
+#endif
 
 #define portMAX_DELAY              0xffffffffUL
 
@@ -81,20 +88,25 @@ extern cy_queue_t xUARTQueue;
 void   display_menu                (void);
 void   app_kv_store_init           (void);
 
-/*Button interrupt configuration and handling functions*/
-void   key_button_app_init         (void);
-void button_interrupt_handler      (void *handler_arg,
-                                    cyhal_gpio_event_t event);
-void   button_task                 (cy_thread_arg_t pvParameters);
+/*Button handling function, see app_button.c for the interrupt*/
+void   app_button_event_handler    (uint32_t data);
 
 /*LED state handlers*/
 void   led_task_communicator       (wiced_bt_ble_advert_mode_t CurrAdvState);
-void   app_led_control             (cy_thread_arg_t pvParameters);
+void   app_led_init                (void);
+void   app_led_event_handler       (uint32_t data);
+
+/*Terminal command handler*/
+void   app_command_handler         (const app_cmd_t *p_cmd);
 
-/*UART interrupt handler*/
-void   uart_interrupt_handler      (void *handler_arg,
-                                    cyhal_uart_event_t event);
-void   uart_task                   (cy_thread_arg_t pvParameters);
+/*Actions shared by the terminal and the control protocol*/
+app_action_status_t app_action_delete_bonds     (void);
+app_action_status_t app_action_bond_mode        (wiced_bool_t enter);
+app_action_status_t app_action_directed_adv     (uint32_t slot);
+app_action_status_t app_action_privacy_toggle   (uint32_t slot);
+app_action_status_t app_action_kvstore_reset    (void);
+app_action_status_t app_action_numeric_reply    (wiced_bool_t match);
+void                app_action_get_status       (uint8_t *p_state, wiced_bool_t *p_bond_mode);
 
 /* Callback function for Bluetooth stack management events */
 wiced_bt_dev_status_t  app_bt_management_callback  (wiced_bt_management_evt_t event,
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""
+Advertising interval curve model for the Peripheral_Privacy example.
+
+Predicts, for one or more advertising interval curves (see app_bt_adv.c), the
+reconnect latency seen by a returning central and the charge spent on
+advertising, so that operating points can be compared before flashing.
+
+Model:
+  * The central comes back at a random time after the disconnect (--arrival)
+    and scans with a fixed scan interval / scan window (--scan-interval,
+    --scan-window), starting a scan window as soon as it is back.
+  * The peripheral advertises at the interval of the curve step active at that
+    time, plus the 0-10 ms advDelay of the spec. At a step boundary the
+    firmware restarts advertising, so the next event follows the boundary.
+  * The central is discovered by the first advertising event that falls in
+    one of its scan windows. Each event covers all three channels, so any
+    event inside a window is a hit. Connection setup adds --setup-ms.
+  * Every advertising event costs --event-charge-uc, on top of --sleep-ua.
+
+Usage:
+  adv_model.py --firmware app_bt_adv.c
+  adv_model.py --curve fast=0:20,10:100,60:1280 --curve slow=0:100,30:1280 \\
+               --arrival exp:120 --scan-interval 4096 --scan-window 1024
+"""
+
+import argparse
+import random
+import re
+import sys
+
+ADV_DELAY_MAX_MS = 10.0
+
+
+def parse_curve(text):
+    """Parse 'name=sec:ms,sec:ms,...' into (name, [(elapsed_ms, interval_ms)])."""
+    name, _, steps = text.partition('=')
+    if not steps:
+        name, steps = 'curve', name
+    curve = []
+    for item in steps.split(','):
+        sec, _, ms = item.partition(':')
+        curve.append((float(sec) * 1000.0, float(ms)))
+    check_curve(name, curve)
+    return name, curve
+
+
+def parse_firmware(path):
+    """Read the default curves from the adv_sched_curve_* tables of app_bt_adv.c."""
+    src = open(path).read()
+    curves = []
+    for m in re.finditer(r'adv_sched_curve_t\s+adv_sched_curve_(\w+)\s*=\s*\{(.*?)\};', src, re.S):
+        steps = [(float(e), float(i)) for e, i in
+                 re.findall(r'\{\s*(\d+)\s*,\s*ADV_SCHED_MS_TO_SLOTS\(\s*(\d+)\s*\)\s*\}', m.group(2))]
+        check_curve(m.group(1), steps)
+        curves.append((m.group(1), steps))
+    if not curves:
+        sys.exit('no adv_sched_curve_* table found in %s' % path)
+    return curves
+
+
+def check_curve(name, curve):
+    if not curve or curve[0][0] != 0:
+        sys.exit('curve %s: first step must start at 0 s' % name)
+    for prev, cur in zip(curve, curve[1:]):
+        if cur[0] <= prev[0]:
+            sys.exit('curve %s: steps must be sorted by time' % name)
+
+
+def arrival_sampler(text, rng):
+    kind, _, val = text.partition(':')
+    val = float(val) * 1000.0
+    if kind == 'exp':
+        return lambda: rng.expovariate(1.0 / val)
+    if kind == 'uniform':
+        return lambda: rng.uniform(0.0, val)
+    if kind == 'fixed':
+        return lambda: val
+    sys.exit('unknown arrival distribution %s' % kind)
+
+
+def step_at(curve, t):
+    idx = 0
+    while idx + 1 < len(curve) and curve[idx + 1][0] <= t:
+        idx += 1
+    return idx
+
+
+def step_end(curve, idx):
+    return curve[idx + 1][0] if idx + 1 < len(curve) else float('inf')
+
+
+def adv_events(curve, t0, t1):
+    """Expected number of advertising events between t0 and t1."""
+    events = 0.0
+    idx = step_at(curve, t0)
+    t = t0
+    while t < t1:
+        end = min(step_end(curve, idx), t1)
+        interval = curve[idx][1]
+        if interval > 0:
+            events += (end - t) / (interval + ADV_DELAY_MAX_MS / 2)
+        t = end
+        idx += 1
+    return events
+
+
+def discovery_latency(curve, arrival, args, rng):
+    """Time from the central coming back to the first advertising event it hears."""
+    limit = arrival + args.horizon * 1000.0
+    idx = step_at(curve, arrival)
+    interval = curve[idx][1]
+    # Random phase of the advertising train when the central shows up
+    ev = arrival + (rng.uniform(0.0, interval + ADV_DELAY_MAX_MS) if interval > 0 else 0.0)
+    while ev < limit:
+        if interval <= 0 or ev >= step_end(curve, idx):
+            # Advertising restarts on the next step boundary
+            idx += 1
+            if idx >= len(curve):
+                return None
+            interval = curve[idx][1]
+            ev = curve[idx][0] + rng.uniform(0.0, ADV_DELAY_MAX_MS)
+            continue
+        if (ev - arrival) % args.scan_interval < args.scan_window:
+            return ev - arrival
+        ev += interval + rng.uniform(0.0, ADV_DELAY_MAX_MS)
+    return None
+
+
+def percentile(values, pct):
+    if not values:
+        return float('nan')
+    values = sorted(values)
+    return values[min(len(values) - 1, int(pct / 100.0 * len(values)))]
+
+
+def evaluate(name, curve, args):
+    rng = random.Random(args.seed)
+    draw = arrival_sampler(args.arrival, rng)
+    latencies, charges = [], []
+    misses = 0
+    for _ in range(args.trials):
+        arrival = draw()
+        if arrival > args.horizon * 1000.0:
+            misses += 1
+            continue
+        lat = discovery_latency(curve, arrival, args, rng)
+        if lat is None:
+            misses += 1
+            continue
+        lat += args.setup_ms
+        latencies.append(lat)
+        connect = arrival + lat
+        charges.append(adv_events(curve, 0.0, connect) * args.event_charge_uc +
+                       args.sleep_ua * connect / 1000.0)
+
+    horizon_ms = args.horizon * 1000.0
+    idle_current = (adv_events(curve, 0.0, horizon_ms) * args.event_charge_uc /
+                    args.horizon) + args.sleep_ua
+    return {
+        'name': name,
+        'curve': curve,
+        'mean': sum(latencies) / len(latencies) if latencies else float('nan'),
+        'p50': percentile(latencies, 50),
+        'p95': percentile(latencies, 95),
+        'p99': percentile(latencies, 99),
+        'miss': 100.0 * misses / args.trials,
+        'charge_mc': (sum(charges) / len(charges) / 1000.0) if charges else float('nan'),
+        'idle_ua': idle_current,
+    }
+
+
+def print_steps(res, args):
+    print('%s:' % res['name'])
+    curve = res['curve']
+    for idx, (start, interval) in enumerate(curve):
+        end = step_end(curve, idx)
+        span = '%7.0f s - %7s' % (start / 1000.0, ('%.0f s' % (end / 1000.0)) if end != float('inf') else 'end')
+        if interval > 0:
+            current = args.event_charge_uc * 1000.0 / (interval + ADV_DELAY_MAX_MS / 2) + args.sleep_ua
+            print('  %s  interval %7.1f ms  avg current %8.1f uA' % (span, interval, current))
+        else:
+            print('  %s  advertising off       avg current %8.1f uA' % (span, args.sleep_ua))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--curve', action='append', default=[],
+                        help="curve as name=sec:ms,sec:ms,... (interval 0 stops advertising)")
+    parser.add_argument('--firmware', help='read the default curves from app_bt_adv.c')
+    parser.add_argument('--arrival', default='exp:120',
+                        help='central return time after the disconnect: exp:MEAN_S, uniform:MAX_S, fixed:S')
+    parser.add_argument('--scan-interval', type=float, default=4096.0, help='central scan interval in ms')
+    parser.add_argument('--scan-window', type=float, default=1024.0, help='central scan window in ms')
+    parser.add_argument('--setup-ms', type=float, default=15.0, help='connection setup time in ms')
+    parser.add_argument('--event-charge-uc', type=float, default=12.0,
+                        help='charge of one connectable advertising event on 3 channels, in uC')
+    parser.add_argument('--sleep-ua', type=float, default=2.0, help='current when not advertising, in uA')
+    parser.add_argument('--horizon', type=float, default=3600.0, help='time after the disconnect considered, in s')
+    parser.add_argument('--trials', type=int, default=5000, help='Monte Carlo trials per curve')
+    parser.add_argument('--seed', type=int, default=1, help='random seed')
+    args = parser.parse_args()
+
+    if args.scan_window > args.scan_interval:
+        sys.exit('scan window cannot exceed the scan interval')
+
+    curves = [parse_curve(c) for c in args.curve]
+    if args.firmware:
+        curves += parse_firmware(args.firmware)
+    if not curves:
+        parser.error('give at least one --curve or --firmware')
+
+    results = [evaluate(name, curve, args) for name, curve in curves]
+
+    for res in results:
+        print_steps(res, args)
+    print()
+    print('central arrival %s, scan %.0f/%.0f ms, %d trials' %
+          (args.arrival, args.scan_window, args.scan_interval, args.trials))
+    print('%-12s %9s %9s %9s %9s %7s %12s %12s' %
+          ('curve', 'mean ms', 'p50 ms', 'p95 ms', 'p99 ms', 'miss %', 'charge mC', 'idle uA'))
+    for res in sorted(results, key=lambda r: r['charge_mc']):
+        print('%-12s %9.0f %9.0f %9.0f %9.0f %7.1f %12.2f %12.1f' %
+              (res['name'], res['mean'], res['p50'], res['p95'], res['p99'], res['miss'],
+               res['charge_mc'], res['idle_ua']))
+    print()
+    print('charge mC: advertising charge from the disconnect to the reconnect, averaged over trials')
+    print('idle uA:   average current over the horizon if nobody reconnects')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+ATT round trip of the Peripheral_Privacy example.
+
+Sends write requests to the Echo characteristic (app_echo.c) from a PC over
+Bluetooth LE, one at a time, and waits for each reply: a notification with
+the time the request reached the application and the time the reply was
+handed to the stack (device microseconds), then the payload of the request,
+which starts with a sequence number. For every transaction it computes:
+
+  rtt      from the write request sent to the reply received, on the PC
+  rsp      from the write request sent to its write response, on the PC
+  app      the processing time of the application: from the request reaching
+           ble_app_server_handler() to the reply handed to the stack, through
+           the write handler and the event loop
+  link     rtt - app, the time in the stacks and on the air, a few connection
+           intervals
+
+and prints their distribution, or every transaction with --csv.
+
+Usage:
+  att_rtt.py -n 500
+  att_rtt.py -a 00:A0:50:12:34:56 -n 200 --interval 0.05 --csv rtt.csv
+"""
+
+import argparse
+import asyncio
+import csv
+import struct
+import sys
+import time
+
+try:
+    from bleak import BleakClient, BleakScanner
+except ImportError:
+    BleakClient = BleakScanner = None
+
+ECHO = 'fb592577-e30f-4252-9f52-da8ce5b02e05'
+
+# Reply: receive and transmit times, then the payload (app_echo_event_handler())
+HEADER = struct.Struct('<II')
+PAYLOAD_MAX = 12
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(p / 100.0 * len(values)))]
+
+
+def print_distribution(name, values):
+    if not values:
+        print('%-5s no transactions' % name)
+        return
+    print('%-5s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f' %
+          (name, min(values), sum(values) / len(values), percentile(values, 50),
+           percentile(values, 90), percentile(values, 99), max(values)))
+
+
+async def run(client, args):
+    replies = asyncio.Queue()
+
+    def on_notification(_, data):
+        replies.put_nowait((time.perf_counter(), bytes(data)))
+
+    await client.start_notify(ECHO, on_notification)
+    transactions = []
+    lost = 0
+    pad = bytes(range(args.length - 4))
+    for seq in range(args.count):
+        start = time.perf_counter()
+        await client.write_gatt_char(ECHO, struct.pack('<I', seq) + pad, response=True)
+        rsp = time.perf_counter()
+        while True:
+            try:
+                received, data = await asyncio.wait_for(replies.get(), args.timeout)
+            except asyncio.TimeoutError:
+                lost += 1
+                break
+            rx_us, tx_us = HEADER.unpack_from(data)
+            if struct.unpack_from('<I', data, HEADER.size)[0] != seq:
+                continue
+            app_ms = ((tx_us - rx_us) & 0xFFFFFFFF) / 1000.0
+            rtt_ms = (received - start) * 1000.0
+            transactions.append((seq, rtt_ms, (rsp - start) * 1000.0, app_ms, rtt_ms - app_ms))
+            break
+        if args.interval:
+            await asyncio.sleep(args.interval)
+    await client.stop_notify(ECHO)
+    return transactions, lost
+
+
+async def main_async(args):
+    address = args.address
+    if address is None:
+        device = await BleakScanner.find_device_by_name(args.name, timeout=10.0)
+        if device is None:
+            sys.exit('%s not found' % args.name)
+        address = device
+    async with BleakClient(address) as client:
+        transactions, lost = await run(client, args)
+
+    print('%d transactions, %d without reply, in ms:' % (len(transactions), lost))
+    print('%-5s %9s %9s %9s %9s %9s %9s' % ('', 'min', 'mean', 'p50', 'p90', 'p99', 'max'))
+    for index, name in enumerate(('rtt', 'rsp', 'app', 'link'), 1):
+        print_distribution(name, [t[index] for t in transactions])
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(['seq', 'rtt_ms', 'rsp_ms', 'app_ms', 'link_ms'])
+            writer.writerows(transactions)
+    return 1 if lost else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('-a', '--address', help='address of the device, else found by name')
+    parser.add_argument('--name', default='BLE PRIVACY', help='advertised name')
+    parser.add_argument('-n', '--count', type=int, default=100, help='transactions')
+    parser.add_argument('--length', type=int, default=4, choices=range(4, PAYLOAD_MAX + 1),
+                        metavar='4..%d' % PAYLOAD_MAX, help='bytes per request')
+    parser.add_argument('--interval', type=float, default=0.0, help='pause between transactions, in s')
+    parser.add_argument('--timeout', type=float, default=2.0, help='wait for a reply, in s')
+    parser.add_argument('--csv', help='write every transaction to this file')
+    args = parser.parse_args()
+    if BleakClient is None:
+        sys.exit('bleak is needed: pip install bleak')
+    return asyncio.run(main_async(args))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+ATT throughput benchmark of the Peripheral_Privacy example.
+
+Drives the Throughput GATT service (app_throughput.c) from a PC over
+Bluetooth LE:
+
+  sink    writes commands without response to the Sink for --time seconds,
+          the device counts what it received
+  source  asks the device for --count notifications of --length bytes and
+          counts what arrives, with the sequence numbers missing
+
+Both report the rate seen by the PC and by the device, which times the run
+from the first write to the last, or from the start to the last notification
+transmitted. Run it against the same build before and after a change; the
+connection interval and the ATT MTU, chosen by the PC, bound the result.
+
+Usage:
+  att_throughput.py sink -t 10
+  att_throughput.py source -n 2000 --length 100
+  att_throughput.py -a 00:A0:50:12:34:56 sink source
+"""
+
+import argparse
+import asyncio
+import struct
+import sys
+import time
+
+try:
+    from bleak import BleakClient, BleakScanner
+except ImportError:
+    BleakClient = BleakScanner = None
+
+SINK = 'bf3c05d7-4450-4f97-bd57-bb639cf14a00'
+SOURCE = 'f883f5fb-6b47-4116-9b29-4f14776d8e91'
+CONTROL = '3d0467b2-29c0-48dd-a5ac-146b9bfdb02a'
+
+CMD_STOP, CMD_SINK, CMD_SOURCE = 0x00, 0x01, 0x02
+
+# Results read from the Control point (app_throughput_refresh())
+RESULTS = struct.Struct('<BBH7I')
+RESULT_NAMES = ('state', 'in_flight', 'length', 'sink_bytes', 'sink_writes', 'sink_us',
+                'source_bytes', 'source_notifications', 'source_us', 'source_stalls')
+
+
+def rate(nbytes, seconds):
+    return '%8.1f kbit/s' % (nbytes * 8 / 1000.0 / seconds) if seconds > 0 else '       - kbit/s'
+
+
+async def results(client):
+    return dict(zip(RESULT_NAMES, RESULTS.unpack(await client.read_gatt_char(CONTROL))))
+
+
+async def run_sink(client, args):
+    length = args.length or client.mtu_size - 3
+    payload = bytes(i & 0xFF for i in range(length))
+    await client.write_gatt_char(CONTROL, bytes([CMD_SINK]), response=True)
+    sent = 0
+    start = time.monotonic()
+    while time.monotonic() - start < args.time:
+        await client.write_gatt_char(SINK, payload, response=False)
+        sent += 1
+    elapsed = time.monotonic() - start
+    await client.write_gatt_char(CONTROL, bytes([CMD_STOP]), response=True)
+    r = await results(client)
+    print('sink   %d writes of %d bytes' % (sent, length))
+    print('  PC     %10d bytes in %7.3f s %s' % (sent * length, elapsed, rate(sent * length, elapsed)))
+    print('  device %10d bytes in %7.3f s %s, %d writes lost' %
+          (r['sink_bytes'], r['sink_us'] / 1e6, rate(r['sink_bytes'], r['sink_us'] / 1e6),
+           sent - r['sink_writes']))
+
+
+async def run_source(client, args):
+    received = []
+    done = asyncio.Event()
+
+    def on_notification(_, data):
+        received.append((time.monotonic(), bytes(data)))
+        if len(received) == args.count:
+            done.set()
+
+    await client.start_notify(SOURCE, on_notification)
+    start = time.monotonic()
+    await client.write_gatt_char(CONTROL, struct.pack('<BHI', CMD_SOURCE, args.length, args.count),
+                                 response=True)
+    try:
+        await asyncio.wait_for(done.wait(), args.timeout)
+    except asyncio.TimeoutError:
+        await client.write_gatt_char(CONTROL, bytes([CMD_STOP]), response=True)
+    await client.stop_notify(SOURCE)
+    r = await results(client)
+
+    nbytes = sum(len(data) for _, data in received)
+    elapsed = received[-1][0] - start if received else 0.0
+    sequence = sorted(set(struct.unpack_from('<I', data)[0] for _, data in received))
+    missing = (sequence[-1] + 1 - len(sequence)) if sequence else 0
+    print('source %d notifications of %d bytes' % (args.count, r['length']))
+    print('  PC     %10d bytes in %7.3f s %s, %d received, %d missing' %
+          (nbytes, elapsed, rate(nbytes, elapsed), len(received), missing))
+    print('  device %10d bytes in %7.3f s %s, %d refused by the stack' %
+          (r['source_bytes'], r['source_us'] / 1e6, rate(r['source_bytes'], r['source_us'] / 1e6),
+           r['source_stalls']))
+
+
+async def main_async(args):
+    address = args.address
+    if address is None:
+        device = await BleakScanner.find_device_by_name(args.name, timeout=10.0)
+        if device is None:
+            sys.exit('%s not found' % args.name)
+        address = device
+    async with BleakClient(address) as client:
+        print('connected, ATT MTU %d' % client.mtu_size)
+        for test in args.tests:
+            await {'sink': run_sink, 'source': run_source}[test](client, args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('tests', nargs='+', choices=('sink', 'source'))
+    parser.add_argument('-a', '--address', help='address of the device, else found by name')
+    parser.add_argument('--name', default='BLE PRIVACY', help='advertised name')
+    parser.add_argument('-t', '--time', type=float, default=10.0, help='sink run, in s')
+    parser.add_argument('-n', '--count', type=int, default=1000, help='notifications of the source run')
+    parser.add_argument('--length', type=int, default=0, help='bytes per write or notification, 0 fills the ATT MTU')
+    parser.add_argument('--timeout', type=float, default=60.0, help='longest source run, in s')
+    args = parser.parse_args()
+    if BleakClient is None:
+        sys.exit('bleak is needed: pip install bleak')
+    asyncio.run(main_async(args))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,433 @@
+#!/usr/bin/env python3
+"""
+Host client for the binary control protocol of the Peripheral_Privacy example.
+
+Frames share the debug UART with the terminal text, so the reader scans for
+the start byte and only accepts frames whose CRC matches (see app_ctrl.h):
+
+  SOF 0xA5 | LEN | OPCODE | SEQ | PAYLOAD[LEN] | CRC16-CCITT (LE, over LEN..PAYLOAD)
+
+Responses carry the opcode with bit 7 set, the sequence number of the request
+and a status byte. Event frames (opcode 0x40 and up) are queued and can be
+waited for. The device only sends events once a ping opened the session,
+which the client does when it connects. Requests are retried on timeout, so a
+frame garbled by terminal output is not fatal. Reads are sent again with a new
+sequence number. Requests that change the device are repeated with the same
+sequence number, and the device answers a repeat of its last such request
+with the cached response instead of running it twice. Events cannot be
+retried, a gap in their sequence numbers is counted in events_lost.
+
+Usage as a library:
+  from ctrl_client import CtrlClient
+  with CtrlClient('/dev/ttyACM0') as dev:
+      dev.bond_mode(True)
+      dev.wait_event('pairing')
+
+Usage from the command line:
+  ctrl_client.py -p /dev/ttyACM0 status
+  ctrl_client.py -p /dev/ttyACM0 list
+  ctrl_client.py -p /dev/ttyACM0 directed 2
+  ctrl_client.py -p /dev/ttyACM0 soak --cycles 200 --slot 1
+"""
+
+import argparse
+import collections
+import queue
+import struct
+import sys
+import threading
+import time
+
+try:
+    import serial
+except ImportError:
+    serial = None
+
+SOF = 0xA5
+PAYLOAD_MAX = 64
+RESPONSE_FLAG = 0x80
+
+OP_PING = 0x01
+OP_GET_STATUS = 0x02
+OP_LIST = 0x03
+OP_DELETE_BONDS = 0x04
+OP_BOND_MODE = 0x05
+OP_DIRECTED_ADV = 0x06
+OP_PRIVACY_TOGGLE = 0x07
+OP_KVSTORE_RESET = 0x08
+OP_NUMERIC_REPLY = 0x09
+OP_BUTTON_STATS = 0x0A
+
+# Requests that only read, safe to run again
+IDEMPOTENT = {OP_PING, OP_GET_STATUS, OP_LIST, OP_BUTTON_STATS}
+
+EVENTS = {
+    0x40: 'connection',
+    0x41: 'pairing',
+    0x42: 'encryption',
+    0x43: 'numeric',
+    0x44: 'adv_state',
+    0x45: 'log',
+}
+
+STATUS = {
+    0x00: 'success',
+    0x01: 'invalid state',
+    0x02: 'invalid slot',
+    0x03: 'flash error',
+    0x10: 'unknown opcode',
+    0x11: 'bad length',
+}
+
+STATES = ['IDLE_NO_DATA', 'IDLE_DATA', 'IDLE_PRIVACY_CHANGE', 'CONNECTED', 'BONDED']
+
+ADV_MODES = {0: 'off', 1: 'directed high', 2: 'directed low', 3: 'undirected high',
+             4: 'undirected low'}
+
+
+class CtrlError(Exception):
+    pass
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def encode(opcode, seq, payload=b''):
+    if len(payload) > PAYLOAD_MAX:
+        raise ValueError('payload too long')
+    body = bytes([len(payload), opcode, seq]) + bytes(payload)
+    return bytes([SOF]) + body + struct.pack('<H', crc16(body))
+
+
+def addr_str(raw):
+    return ':'.join('%02X' % b for b in raw)
+
+
+def decode_event(opcode, payload):
+    """Turn an event frame into a dict."""
+    name = EVENTS.get(opcode, 'event_0x%02X' % opcode)
+    evt = {'event': name}
+    if name == 'connection':
+        evt.update(connected=bool(payload[0]), reason=payload[1],
+                   conn_id=payload[2] | payload[3] << 8, addr=addr_str(payload[4:10]))
+    elif name == 'pairing':
+        evt.update(status=payload[0], addr=addr_str(payload[1:7]))
+    elif name == 'encryption':
+        evt.update(result=payload[0], slot=payload[1], addr=addr_str(payload[2:8]))
+    elif name == 'numeric':
+        evt.update(value=struct.unpack('<I', payload[0:4])[0], addr=addr_str(payload[4:10]))
+    elif name == 'adv_state':
+        evt.update(mode=ADV_MODES.get(payload[0], payload[0]))
+    else:
+        evt.update(raw=payload.hex())
+    return evt
+
+
+class FrameReader:
+    """Finds frames in the byte stream, everything else is terminal text."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.crc_errors = 0
+
+    def feed(self, data):
+        self.buf += data
+        frames = []
+        while True:
+            start = self.buf.find(bytes([SOF]))
+            if start < 0:
+                self.text += self.buf
+                self.buf.clear()
+                break
+            self.text += self.buf[:start]
+            del self.buf[:start]
+            if len(self.buf) < 2:
+                break
+            length = self.buf[1]
+            if length > PAYLOAD_MAX:
+                del self.buf[0]
+                continue
+            total = 4 + length + 2
+            if len(self.buf) < total:
+                break
+            frame = bytes(self.buf[:total])
+            if crc16(frame[1:total - 2]) != struct.unpack('<H', frame[total - 2:])[0]:
+                # Not a frame after all, skip this start byte
+                self.crc_errors += 1
+                del self.buf[0]
+                continue
+            del self.buf[:total]
+            frames.append((frame[2], frame[3], frame[4:4 + length]))
+        return frames
+
+
+class CtrlClient:
+    def __init__(self, port, baud=115200, timeout=1.0, retries=3, echo_text=False):
+        if serial is None:
+            raise CtrlError('pyserial is required: pip install pyserial')
+        self.ser = serial.Serial(port, baud, timeout=0.05)
+        self.timeout = timeout
+        self.retries = retries
+        self.echo_text = echo_text
+        self.reader = FrameReader()
+        self.seq = 0
+        self.responses = {}
+        self.cond = threading.Condition()
+        self.events = queue.Queue()
+        self.event_seq = None
+        self.events_lost = 0
+        self.running = True
+        self.thread = threading.Thread(target=self._rx_loop, daemon=True)
+        self.thread.start()
+        # Opens the session, the device sends no event before
+        self.ping()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def close(self):
+        self.running = False
+        self.thread.join()
+        self.ser.close()
+
+    def _rx_loop(self):
+        while self.running:
+            data = self.ser.read(256)
+            if not data:
+                continue
+            for opcode, seq, payload in self.reader.feed(data):
+                if opcode & RESPONSE_FLAG:
+                    with self.cond:
+                        self.responses[(opcode & ~RESPONSE_FLAG, seq)] = payload
+                        self.cond.notify_all()
+                else:
+                    if self.event_seq is not None:
+                        self.events_lost += (seq - self.event_seq - 1) & 0xFF
+                    self.event_seq = seq
+                    evt = decode_event(opcode, payload)
+                    evt['seq'] = seq
+                    evt['time'] = time.monotonic()
+                    self.events.put(evt)
+            if self.echo_text and self.reader.text:
+                sys.stdout.write(self.reader.text.decode('ascii', 'replace'))
+                sys.stdout.flush()
+            self.reader.text.clear()
+
+    def send(self, opcode, payload=b'', seq=None):
+        """Send a request without waiting, returns its sequence number. A
+        sequence number given repeats that request."""
+        if seq is None:
+            seq = self.seq
+            self.seq = (self.seq + 1) & 0xFF
+        with self.cond:
+            # A late answer to an earlier try is not this one's
+            self.responses.pop((opcode, seq), None)
+        self.ser.write(encode(opcode, seq, payload))
+        return seq
+
+    def collect(self, opcode, seq, timeout=None):
+        deadline = time.monotonic() + (timeout or self.timeout)
+        with self.cond:
+            while (opcode, seq) not in self.responses:
+                left = deadline - time.monotonic()
+                if left <= 0:
+                    return None
+                self.cond.wait(left)
+            return self.responses.pop((opcode, seq))
+
+    def request(self, opcode, payload=b'', check=True):
+        """Send a request and return the response payload after the status.
+        A request that changes the device is repeated with its sequence
+        number, so the device does not run it twice."""
+        seq = None
+        for _ in range(self.retries):
+            seq = self.send(opcode, payload, None if opcode in IDEMPOTENT else seq)
+            rsp = self.collect(opcode, seq)
+            if rsp is None:
+                continue
+            if check and rsp[0] != 0:
+                raise CtrlError('opcode 0x%02X: %s' % (opcode, STATUS.get(rsp[0], rsp[0])))
+            return rsp if not check else rsp[1:]
+        raise CtrlError('opcode 0x%02X: no response' % opcode)
+
+    def batch(self, requests):
+        """Send several (opcode, payload) requests back to back, then collect
+        the responses. Returns the raw responses, status byte included."""
+        pending = [(op, self.send(op, payload)) for op, payload in requests]
+        return [self.collect(op, seq) for op, seq in pending]
+
+    def wait_event(self, name=None, timeout=30.0, match=None):
+        """Wait for an event, other events received meanwhile are dropped."""
+        deadline = time.monotonic() + timeout
+        while True:
+            left = deadline - time.monotonic()
+            if left <= 0:
+                raise CtrlError('timeout waiting for %s' % (name or 'an event'))
+            try:
+                evt = self.events.get(timeout=left)
+            except queue.Empty:
+                continue
+            if (name is None or evt['event'] == name) and (match is None or match(evt)):
+                return evt
+
+    def ping(self):
+        version, bond_max = self.request(OP_PING)
+        return {'version': version, 'bond_max': bond_max}
+
+    def status(self):
+        state, bond_mode, adv_mode, bonded, next_free = self.request(OP_GET_STATUS)
+        return {'state': STATES[state] if state < len(STATES) else state,
+                'bond_mode': bool(bond_mode), 'adv_mode': ADV_MODES.get(adv_mode, adv_mode),
+                'bonded': bonded, 'next_free_slot': next_free}
+
+    def list(self):
+        bonds = []
+        first = 1
+        while True:
+            rsp = self.request(OP_LIST, bytes([first]))
+            total, count = rsp[0], rsp[1]
+            for i in range(count):
+                entry = rsp[2 + i * 9:2 + (i + 1) * 9]
+                bonds.append({'slot': entry[0], 'addr_type': entry[1],
+                              'privacy': 'device' if entry[2] else 'network',
+                              'addr': addr_str(entry[3:9])})
+            first += count
+            if count == 0 or first > total:
+                return bonds
+
+    def delete_bonds(self):
+        self.request(OP_DELETE_BONDS)
+
+    def bond_mode(self, enter):
+        self.request(OP_BOND_MODE, bytes([1 if enter else 0]))
+
+    def directed(self, slot):
+        self.request(OP_DIRECTED_ADV, bytes([slot]))
+
+    def privacy_toggle(self, slot):
+        self.request(OP_PRIVACY_TOGGLE, bytes([slot]))
+
+    def kvstore_reset(self):
+        self.request(OP_KVSTORE_RESET)
+
+    def numeric_reply(self, match):
+        self.request(OP_NUMERIC_REPLY, bytes([1 if match else 0]))
+
+    def button_stats(self):
+        values = struct.unpack('<8I', self.request(OP_BUTTON_STATS))
+        return dict(zip(('presses', 'bounces', 'lost', 'notified', 'last_us', 'min_us', 'max_us',
+                         'mean_us'), values))
+
+
+def soak(dev, args):
+    """Reconnect cycles with a central run by the rig: start directed
+    advertising to the slot, wait for the encrypted reconnection, then for
+    the disconnection the rig triggers."""
+    times = []
+    failures = collections.Counter()
+    start = time.monotonic()
+    for cycle in range(args.cycles):
+        result = 'failed'
+        try:
+            t0 = time.monotonic()
+            dev.directed(args.slot)
+            dev.wait_event('encryption', args.event_timeout, lambda e: e['slot'] == args.slot)
+            times.append(time.monotonic() - t0)
+            result = '%.0f ms' % (times[-1] * 1000)
+            dev.wait_event('connection', args.event_timeout, lambda e: not e['connected'])
+        except CtrlError as err:
+            failures[str(err)] += 1
+            try:
+                dev.wait_event('connection', 5.0, lambda e: not e['connected'])
+            except CtrlError:
+                pass
+        if not args.quiet:
+            print('cycle %d: %s' % (cycle + 1, result))
+    elapsed = time.monotonic() - start
+    print('%d cycles in %.0f s (%.0f per hour), %d failed' %
+          (args.cycles, elapsed, args.cycles * 3600.0 / elapsed, sum(failures.values())))
+    if times:
+        times.sort()
+        print('reconnect ms: mean %.0f  p50 %.0f  p95 %.0f  max %.0f' %
+              (1000 * sum(times) / len(times), 1000 * times[len(times) // 2],
+               1000 * times[min(len(times) - 1, int(0.95 * len(times)))], 1000 * times[-1]))
+    for err, count in failures.items():
+        print('  %4d x %s' % (count, err))
+    print('CRC errors on the host side: %d' % dev.reader.crc_errors)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('-p', '--port', required=True, help='serial port of the kit')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('--timeout', type=float, default=1.0, help='response timeout in s')
+    parser.add_argument('--text', action='store_true', help='print the terminal text of the device')
+    sub = parser.add_subparsers(dest='cmd', required=True)
+    sub.add_parser('ping')
+    sub.add_parser('status')
+    sub.add_parser('list')
+    sub.add_parser('delete')
+    sub.add_parser('kvreset')
+    p = sub.add_parser('bondmode')
+    p.add_argument('enter', type=int, choices=[0, 1])
+    p = sub.add_parser('directed')
+    p.add_argument('slot', type=int)
+    p = sub.add_parser('privacy')
+    p.add_argument('slot', type=int)
+    p = sub.add_parser('numeric')
+    p.add_argument('match', type=int, choices=[0, 1])
+    sub.add_parser('button', help='button press and button-to-notification latency statistics')
+    p = sub.add_parser('events', help='print events until interrupted')
+    p = sub.add_parser('soak', help='directed advertising / reconnect cycles')
+    p.add_argument('--cycles', type=int, default=100)
+    p.add_argument('--slot', type=int, default=1)
+    p.add_argument('--event-timeout', type=float, default=30.0)
+    p.add_argument('--quiet', action='store_true')
+    args = parser.parse_args()
+
+    with CtrlClient(args.port, args.baud, args.timeout, echo_text=args.text) as dev:
+        try:
+            if args.cmd == 'ping':
+                print(dev.ping())
+            elif args.cmd == 'status':
+                print(dev.status())
+            elif args.cmd == 'list':
+                for bond in dev.list():
+                    print('%(slot)3d  %(addr)s  type %(addr_type)d  %(privacy)s privacy' % bond)
+            elif args.cmd == 'delete':
+                dev.delete_bonds()
+            elif args.cmd == 'kvreset':
+                dev.kvstore_reset()
+            elif args.cmd == 'bondmode':
+                dev.bond_mode(args.enter)
+            elif args.cmd == 'directed':
+                dev.directed(args.slot)
+            elif args.cmd == 'privacy':
+                dev.privacy_toggle(args.slot)
+            elif args.cmd == 'numeric':
+                dev.numeric_reply(args.match)
+            elif args.cmd == 'button':
+                print(dev.button_stats())
+            elif args.cmd == 'events':
+                while True:
+                    print(dev.wait_event(timeout=3600.0))
+            elif args.cmd == 'soak':
+                soak(dev, args)
+        except CtrlError as err:
+            sys.exit('error: %s' % err)
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == '__main__':
+    main()
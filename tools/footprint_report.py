@@ -0,0 +1,386 @@
+#!/usr/bin/env python3
+"""
+Flash and RAM footprint report for the Peripheral_Privacy example.
+
+Reads the sections and symbols of one firmware image, or compares two images,
+e.g. a build with the default log level against one with LOG_LEVEL=1:
+
+  make build && cp build/APP_CYW955913EVK-01/Debug/*.elf /tmp/before.elf
+  make build LOG_LEVEL=1 LOG_LEVEL_UI=3
+  footprint_report.py /tmp/before.elf build/APP_CYW955913EVK-01/Debug/*.elf
+
+Flash is every allocated section holding data in the image (code, constants,
+format strings and the initial values of .data); RAM is every writable
+allocated section (.data and .bss). The symbols whose size changed most are
+listed, string literals have no symbol and only show in the section sizes.
+
+Uses readelf and nm of the GNU Arm toolchain (--prefix to use another one).
+
+With --map, the linker map file of the build is split per module (object
+file, or library for archive members): text (code and constants, flash), data
+(initial values in flash, copied to RAM) and bss (RAM), with the largest
+symbols and the module holding them. --budget compares the modules and
+symbols with a budget file (tools/footprint_budget.txt) and exits with 1 when
+one is over; the firmware build runs this after the link with
+FOOTPRINT_CHECK=1 (see the Makefile):
+
+  footprint_report.py --map build/APP_CYW955913EVK-01/Debug/*.map \
+                      --budget tools/footprint_budget.txt
+
+--update-budget writes the measured sizes into the budget file instead, for
+a change that grows the footprint on purpose (commit the new file with it).
+A budget file marked "status estimated" holds figures that were never
+measured on the target: the first check against a map file writes the
+measured sizes instead, marks the file "status measured" and passes, and
+every later check enforces them.
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+SECTION_LINE = re.compile(r'^\s*\[\s*\d+\]\s+(.*)$')
+
+Footprint = collections.namedtuple('Footprint', 'flash ram sections symbols')
+
+# Linker map file: the memory map follows this line
+MAP_START = 'Linker script and memory map'
+MAP_OUTPUT = re.compile(r'^(\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?')
+MAP_INPUT = re.compile(r'^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?$')
+MAP_INPUT_NEXT = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+MAP_SYMBOL = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)$')
+
+# Output sections not loaded on the device
+MAP_SKIPPED = ('.debug', '.comment', '.ARM.attributes', '.note', '.stab', '.symtab', '.strtab',
+               '.shstrtab', '.gnu.attributes', '/DISCARD/')
+
+KINDS = ('text', 'data', 'bss')
+
+MapSymbol = collections.namedtuple('MapSymbol', 'name module kind size')
+
+
+def run(tool, args):
+    try:
+        return subprocess.run([tool] + args, check=True, capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError) as err:
+        sys.exit('%s failed: %s' % (tool, err))
+
+
+def read_footprint(path, prefix):
+    sections = collections.OrderedDict()
+    symbols = {}
+    flash = ram = 0
+    for line in run(prefix + 'readelf', ['-SW', path]).splitlines():
+        match = SECTION_LINE.match(line)
+        if not match:
+            continue
+        # Name Type Address Off Size ES [Flg] Lk Inf Al
+        fields = match.group(1).split()
+        if len(fields) not in (9, 10):
+            continue
+        name, sh_type, size = fields[0], fields[1], int(fields[4], 16)
+        flags = fields[6] if len(fields) == 10 else ''
+        if 'A' not in flags or not size:
+            continue
+        sections[name] = size
+        if sh_type != 'NOBITS':
+            flash += size
+        if 'W' in flags:
+            ram += size
+    for line in run(prefix + 'nm', ['-S', '--size-sort', path]).splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'tTdDbBrRwWvV':
+            symbols[fields[3]] = symbols.get(fields[3], 0) + int(fields[1], 16)
+    return Footprint(flash, ram, sections, symbols)
+
+
+def map_module(path):
+    """Return the module of an input file: the object or the library."""
+    archive = re.match(r'^(.*?)\((.*)\)$', path)
+    if archive:
+        return os.path.basename(archive.group(1))
+    name = os.path.basename(path)
+    for suffix in ('.o', '.obj', '.c'):
+        if name.endswith(suffix):
+            name = name[:-len(suffix)]
+    return name
+
+
+def map_kind(output_section):
+    """Return text, data or bss for an output section, None if not loaded."""
+    if not output_section or output_section.startswith(MAP_SKIPPED):
+        return None
+    name = output_section.lower()
+    if any(word in name for word in ('bss', 'noinit', 'heap', 'stack')):
+        return 'bss'
+    if 'data' in name and 'rodata' not in name:
+        return 'data'
+    return 'text'
+
+
+def map_symbols(section, kind, module, address, size, names):
+    """Split an input section among the symbols listed in it, by address."""
+    names = sorted(n for n in names if address <= n[0] < address + size)
+    if not names:
+        # Sections of -ffunction-sections / -fdata-sections carry the name
+        # of a static symbol too, e.g. .bss.bondinfo
+        prefix = '.' + section.split('.')[1] + '.' if section.count('.') > 1 else None
+        name = section[len(prefix):] if prefix else section
+        if not name or '.str1.' in section or name.startswith('str1'):
+            name = '(strings)' if '.str' in section else section
+        return [MapSymbol(name, module, kind, size)]
+    symbols = []
+    if names[0][0] > address:
+        symbols.append(MapSymbol(section, module, kind, names[0][0] - address))
+    for i, (start, name) in enumerate(names):
+        end = names[i + 1][0] if i + 1 < len(names) else address + size
+        if end > start:
+            symbols.append(MapSymbol(name, module, kind, end - start))
+    return symbols
+
+
+def read_map(path):
+    """Return the symbols of the image, with their module, from a map file."""
+    symbols = []
+    output = None
+    pending = None      # Input section waiting for its address, size and file
+    current = None      # Input section whose symbols are being listed
+    started = False
+
+    def flush():
+        if current is not None and current['kind'] is not None and current['size']:
+            symbols.extend(map_symbols(current['section'], current['kind'], current['module'],
+                                       current['address'], current['size'], current['names']))
+
+    with open(path, errors='replace') as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not started:
+                started = line.startswith(MAP_START)
+                continue
+            if not line.strip():
+                continue
+            if not line[0].isspace():
+                flush()
+                current = pending = None
+                match = MAP_OUTPUT.match(line)
+                output = match.group(1) if match else None
+                continue
+            if pending is not None:
+                match = MAP_INPUT_NEXT.match(line)
+                if match:
+                    flush()
+                    current = dict(section=pending, kind=map_kind(output), module=map_module(match.group(3)),
+                                   address=int(match.group(1), 16), size=int(match.group(2), 16), names=[])
+                    pending = None
+                    continue
+                pending = None
+            match = MAP_SYMBOL.match(line)
+            if match:
+                if current is not None:
+                    current['names'].append((int(match.group(1), 16), match.group(2)))
+                continue
+            match = MAP_INPUT.match(line)
+            if match and not match.group(1).startswith('*'):
+                flush()
+                current = None
+                if match.group(4) is None:
+                    pending = match.group(1)
+                elif not match.group(4).startswith('load address'):
+                    current = dict(section=match.group(1), kind=map_kind(output),
+                                   module=map_module(match.group(4).strip()),
+                                   address=int(match.group(2), 16), size=int(match.group(3), 16), names=[])
+        flush()
+    if not started:
+        sys.exit('%s is not a GNU ld map file' % path)
+    return symbols
+
+
+def map_modules(symbols):
+    """Return the text, data and bss of every module."""
+    modules = collections.defaultdict(lambda: dict.fromkeys(KINDS, 0))
+    for sym in symbols:
+        modules[sym.module][sym.kind] += sym.size
+    return modules
+
+
+def report_modules(modules, symbols, top):
+    lines = ['%-32s %8s %8s %8s %8s %8s' % ('Module', 'Text', 'Data', 'Bss', 'Flash', 'RAM')]
+    total = dict.fromkeys(KINDS, 0)
+    for name, sizes in sorted(modules.items(), key=lambda m: -sum(m[1].values())):
+        lines.append('%-32s %8d %8d %8d %8d %8d' % (name, sizes['text'], sizes['data'], sizes['bss'],
+                                                     sizes['text'] + sizes['data'], sizes['data'] + sizes['bss']))
+        for kind in KINDS:
+            total[kind] += sizes[kind]
+    lines.append('%-32s %8d %8d %8d %8d %8d' % ('Total', total['text'], total['data'], total['bss'],
+                                                 total['text'] + total['data'], total['data'] + total['bss']))
+    lines.append('')
+    lines.append('Largest symbols')
+    merged = collections.Counter()
+    for sym in symbols:
+        merged[(sym.name, sym.module, sym.kind)] += sym.size
+    for (name, module, kind), size in merged.most_common(top):
+        lines.append('  %-40s %-24s %-4s %8d' % (name, module, kind, size))
+    return lines
+
+
+def read_budget(path):
+    """Return the lines of a budget file, the budgets by (kind, name), and
+    whether the budget is only an estimate."""
+    with open(path) as f:
+        lines = f.read().splitlines()
+    budgets = collections.OrderedDict()
+    estimated = False
+    for number, line in enumerate(lines, 1):
+        fields = line.split('#', 1)[0].split()
+        if not fields:
+            continue
+        if fields[0] == 'status' and len(fields) == 2 and fields[1] in ('estimated', 'measured'):
+            estimated = fields[1] == 'estimated'
+        elif fields[0] == 'module' and len(fields) == 5:
+            budgets[('module', fields[1])] = [None if v == '-' else int(v, 0) for v in fields[2:]]
+        elif fields[0] == 'symbol' and len(fields) == 3:
+            budgets[('symbol', fields[1])] = [None if fields[2] == '-' else int(fields[2], 0)]
+        else:
+            sys.exit('%s:%d: expected "status estimated|measured", "module NAME TEXT DATA BSS" or '
+                     '"symbol NAME SIZE"' % (path, number))
+    return lines, budgets, estimated
+
+
+def measured(modules, symbols, kind, name):
+    if kind == 'module':
+        sizes = modules.get(name)
+        return [sizes[k] for k in KINDS] if sizes else None
+    sizes = [sym.size for sym in symbols if sym.name == name]
+    return [sum(sizes)] if sizes else None
+
+
+def check_budget(budgets, modules, symbols):
+    """Return the report of the budget check, and whether it passed."""
+    lines = []
+    passed = True
+    for (kind, name), limits in budgets.items():
+        sizes = measured(modules, symbols, kind, name)
+        if sizes is None:
+            continue
+        columns = KINDS if kind == 'module' else ('size',)
+        for column, size, limit in zip(columns, sizes, limits):
+            if limit is not None and size > limit:
+                lines.append('OVER BUDGET: %s %s %s %d, budget %d (+%d)' % (kind, name, column, size, limit,
+                                                                            size - limit))
+                passed = False
+    unlisted = sorted(name for name in modules if ('module', name) not in budgets and not name.endswith('.a'))
+    if unlisted:
+        lines.append('No budget for: %s' % ', '.join(unlisted))
+    lines.append('Within budget' if passed else 'Footprint over budget: trim the change, or raise the budget '
+                 'with --update-budget and give the reason in the commit')
+    return lines, passed
+
+
+def update_budget(path, lines, budgets, modules, symbols):
+    """Write the measured sizes into the checked columns of the budget file,
+    which is then marked measured."""
+    out = []
+    for line in lines:
+        fields = line.split('#', 1)[0].split()
+        if fields and fields[0] == 'status':
+            out.append('status measured')
+            continue
+        key = (fields[0], fields[1]) if len(fields) > 1 else None
+        sizes = measured(modules, symbols, *key) if key in budgets else None
+        if sizes is None:
+            out.append(line)
+            continue
+        values = ['-' if limit is None else str(size) for size, limit in zip(sizes, budgets[key])]
+        if key[0] == 'module':
+            out.append('module %-26s %8s %8s %8s' % ((key[1],) + tuple(values)))
+        else:
+            out.append('symbol %-26s %8s' % (key[1], values[0]))
+    with open(path, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+def report_one(fp, top):
+    print('%-32s %10s' % ('Section', 'Size'))
+    for name, size in fp.sections.items():
+        print('%-32s %10d' % (name, size))
+    print('%-32s %10d' % ('Flash', fp.flash))
+    print('%-32s %10d' % ('RAM', fp.ram))
+    print()
+    print('Largest symbols')
+    for name, size in sorted(fp.symbols.items(), key=lambda s: -s[1])[:top]:
+        print('  %-40s %8d' % (name, size))
+
+
+def report_diff(before, after, top):
+    print('%-32s %10s %10s %10s' % ('Section', 'Before', 'After', 'Delta'))
+    for name in list(before.sections) + [n for n in after.sections if n not in before.sections]:
+        old = before.sections.get(name, 0)
+        new = after.sections.get(name, 0)
+        print('%-32s %10d %10d %+10d' % (name, old, new, new - old))
+    print('%-32s %10d %10d %+10d' % ('Flash', before.flash, after.flash, after.flash - before.flash))
+    print('%-32s %10d %10d %+10d' % ('RAM', before.ram, after.ram, after.ram - before.ram))
+    print()
+    deltas = []
+    for name in set(before.symbols) | set(after.symbols):
+        delta = after.symbols.get(name, 0) - before.symbols.get(name, 0)
+        if delta:
+            deltas.append((name, before.symbols.get(name, 0), after.symbols.get(name, 0), delta))
+    print('Symbols with the largest change')
+    for name, old, new, delta in sorted(deltas, key=lambda d: -abs(d[3]))[:top]:
+        print('  %-40s %8d %8d %+8d' % (name, old, new, delta))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('elf', nargs='*', help='firmware image, or the images before and after a change')
+    parser.add_argument('--top', type=int, default=20, help='number of symbols listed')
+    parser.add_argument('--prefix', default='arm-none-eabi-', help='prefix of the binutils tools')
+    parser.add_argument('--map', help='linker map file, for the footprint of every module')
+    parser.add_argument('--budget', help='budget file checked against the map file')
+    parser.add_argument('--update-budget', action='store_true', help='write the measured sizes into the budget file')
+    parser.add_argument('--output', help='also write the module report to this file')
+    args = parser.parse_args()
+
+    if args.map:
+        symbols = read_map(args.map)
+        modules = map_modules(symbols)
+        lines = report_modules(modules, symbols, args.top)
+        passed = True
+        if args.budget:
+            budget_lines, budgets, estimated = read_budget(args.budget)
+            if args.update_budget or estimated:
+                update_budget(args.budget, budget_lines, budgets, modules, symbols)
+                lines += ['', 'Budget written to %s' % args.budget]
+                if not args.update_budget:
+                    lines.append('The budget was an estimate, it now holds the sizes of %s: commit it, '
+                                 'the next builds are checked against it' % args.map)
+            else:
+                check, passed = check_budget(budgets, modules, symbols)
+                lines += [''] + check
+        print('\n'.join(lines))
+        if args.output:
+            with open(args.output, 'w') as f:
+                f.write('\n'.join(lines) + '\n')
+        if not args.elf:
+            sys.exit(0 if passed else 1)
+        print()
+        if not passed:
+            sys.exit(1)
+    elif args.budget or args.update_budget:
+        parser.error('--budget needs --map')
+
+    if len(args.elf) == 1:
+        report_one(read_footprint(args.elf[0], args.prefix), args.top)
+    elif len(args.elf) == 2:
+        report_diff(read_footprint(args.elf[0], args.prefix),
+                    read_footprint(args.elf[1], args.prefix), args.top)
+    else:
+        parser.error('give one or two images, or a map file')
+
+
+if __name__ == '__main__':
+    main()
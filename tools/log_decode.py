@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary log records of the Peripheral_Privacy example.
+
+With LOG_BINARY=1 the device sends each log record as a control protocol
+event frame (opcode 0x45, see app_ctrl.h) instead of formatting it:
+
+  TIMESTAMP_US (u32) | FMT (u16) | NARGS (u8) | RESERVED (u8) | ARGS (u32 x NARGS)
+
+All little endian. The format strings are read from app_log_fmt.h, so the
+decoder must be given the same source as the firmware (messages compiled out
+by the log levels keep their id). A %s argument is the address of a string in
+the firmware image; give the ELF file with --elf to print the string (needs
+pyelftools), otherwise the address is printed.
+
+Usage:
+  log_decode.py -p /dev/ttyACM0                 decode live from the kit
+  log_decode.py -f capture.bin                  decode a raw UART capture
+  log_decode.py -p /dev/ttyACM0 --elf build/APP_CYW955913EVK-01/Debug/mtb-example-btstack-threadx-peripheral-privacy.elf
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+from ctrl_client import FrameReader, addr_str
+
+try:
+    import serial
+except ImportError:
+    serial = None
+
+EVT_LOG = 0x45
+RECORD_HEADER = struct.Struct('<IHBB')
+
+DEFAULT_FMT_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'app_log_fmt.h')
+
+CONVERSION = re.compile(r'%([-+ 0#]*\d*)([duxXcsB%])')
+
+
+def load_formats(path):
+    """Return the format strings of app_log_fmt.h, indexed by message id."""
+    with open(path) as f:
+        text = f.read()
+    return [fmt.encode().decode('unicode_escape')
+            for fmt in re.findall(r'X\(\s*\w+\s*,\s*\w+\s*,\s*\w+\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', text)]
+
+
+class ElfStrings:
+    """Reads NUL terminated strings from the loadable sections of an ELF file."""
+
+    def __init__(self, path):
+        from elftools.elf.elffile import ELFFile
+        self.sections = []
+        with open(path, 'rb') as f:
+            for section in ELFFile(f).iter_sections():
+                if section['sh_addr'] and section['sh_type'] == 'SHT_PROGBITS':
+                    self.sections.append((section['sh_addr'], section.data()))
+
+    def get(self, addr):
+        for base, data in self.sections:
+            if base <= addr < base + len(data):
+                end = data.find(b'\0', addr - base)
+                return data[addr - base:end].decode(errors='replace')
+        return None
+
+
+def format_record(formats, strings, fmt_id, args):
+    if fmt_id >= len(formats):
+        return 'unknown log message %u %s' % (fmt_id, args)
+    args = list(args)
+
+    def convert(match):
+        flags, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if not args:
+            return '<missing>'
+        val = args.pop(0)
+        if conv == 'B':
+            low = args.pop(0) if args else 0
+            return addr_str(struct.pack('>IH', val, low))
+        if conv == 's':
+            text = strings.get(val) if strings else None
+            return text if text is not None else '<0x%08x>' % val
+        if conv == 'd':
+            val = struct.unpack('<i', struct.pack('<I', val))[0]
+        return ('%' + flags + conv) % val
+
+    return CONVERSION.sub(convert, formats[fmt_id])
+
+
+def decode(formats, strings, payload):
+    if len(payload) < RECORD_HEADER.size:
+        return None
+    timestamp, fmt_id, nargs, _ = RECORD_HEADER.unpack_from(payload)
+    args = struct.unpack_from('<%dI' % nargs, payload, RECORD_HEADER.size)
+    return '[%10.6f] %s' % (timestamp / 1e6, format_record(formats, strings, fmt_id, args))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    src = parser.add_mutually_exclusive_group(required=True)
+    src.add_argument('-p', '--port', help='serial port of the kit')
+    src.add_argument('-f', '--file', help='raw capture of the debug UART')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('--formats', default=DEFAULT_FMT_FILE, help='path of app_log_fmt.h')
+    parser.add_argument('--elf', help='firmware image, to print %%s arguments')
+    parser.add_argument('--text', action='store_true', help='also print the terminal text of the device')
+    args = parser.parse_args()
+
+    formats = load_formats(args.formats)
+    strings = ElfStrings(args.elf) if args.elf else None
+    reader = FrameReader()
+
+    if args.port:
+        if serial is None:
+            sys.exit('pyserial is required: pip install pyserial')
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)
+    else:
+        stream = open(args.file, 'rb')
+
+    try:
+        while True:
+            data = stream.read(256)
+            if not data and args.file:
+                break
+            for opcode, _, payload in reader.feed(data):
+                if opcode == EVT_LOG:
+                    line = decode(formats, strings, payload)
+                    if line:
+                        print(line, flush=True)
+            if args.text and reader.text:
+                sys.stdout.write(reader.text.decode(errors='replace'))
+                reader.text.clear()
+            elif not args.text:
+                reader.text.clear()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        stream.close()
+
+
+if __name__ == '__main__':
+    main()
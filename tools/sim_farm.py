@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""
+Simulation farm for the Peripheral_Privacy example.
+
+Runs many bond churn soaks of the host build (host/src/host_soak.c) in
+parallel, one process per instance, so that each owns its bond store, its
+kv-store file and its virtual clock. The instances are the product of:
+
+  --build NAME=v1,v2   build options of host/Makefile, e.g. BOND_INDEX_MAX or
+                       EXT_ADV; every combination is built once, in
+                       host/build/farm/<combination>
+  --sweep NAME=v1,v2   options of the soak, by name (see SWEEP_OPTIONS); a
+                       curve holds commas, give one per --sweep
+  --seeds N            runs of every combination with another seed
+
+The instances are spread over --jobs workers (every core by default). Each
+worker runs the instances of its own queue, longest first, and steals from
+the tail of the longest other queue once its own is empty. The results are
+merged per combination into one table: counts summed, maxima kept, and the
+log-linear histograms of the soak (16 buckets per power of two) added up, so
+the means and percentiles are those of all the runs together, within 1/16 of
+the value like in the soak. Every run can be written to --csv.
+
+The stack stand-in rotates the local RPA on the virtual clock with the timeout
+of design.cybt, which the stack takes at startup only, and the table counts the
+reconnections of bonded centrals that found the peripheral at a new address.
+Sweep idle to move the time between connections against that timeout.
+
+Usage:
+  sim_farm.py --build BOND_INDEX_MAX=4,8,16 --sweep idle=100,600000 --sweep loss=0,20
+  sim_farm.py --build EXT_ADV=0,1 --sweep curve=0:30,30:100,120:1280 \\
+              --sweep curve=0:20,10:1000 --sweep loss=50 --sweep idle=2000 \\
+              --seeds 4 -n 20000 --csv sweep.csv
+"""
+
+import argparse
+import collections
+import csv
+import itertools
+import os
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+HOST_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host')
+
+# Name used on the command line: option of peripheral_privacy_soak
+SWEEP_OPTIONS = collections.OrderedDict([
+    ('centrals', '-c'),
+    ('connections', '-n'),
+    ('cccd', '-t'),
+    ('loss', '-l'),
+    ('idle', '-i'),
+    ('curve', '-a'),
+    ('unbonded-curve', '-u'),
+    ('flash', '-f'),
+])
+
+# Values holding commas, one per --sweep
+WHOLE_VALUES = ('curve', 'unbonded-curve', 'flash')
+
+# Merged per combination: summed, averaged over the seeds, or the largest
+SUMMED = ('connections', 'reconnections', 'keys_lost', 'bonds', 'evictions', 'cccd_writes',
+          'link_losses', 'refused', 'rpa_rotations', 'rpa_changes', 'rpa_estimated', 'adv_events', 'gcs')
+LARGEST = ('find_ns_max', 'key_request_ns_max', 'eviction_ns_max', 'kv_writes_max', 'programmed_max')
+
+# Histograms of the soak: key of the report, <key>_hist holds its buckets
+HISTOGRAMS = ('find_ns', 'key_request_ns', 'eviction_ns', 'kv_writes', 'programmed')
+HIST_SUB_BITS = 4
+
+# Columns of the table: title, format, value of a merged result
+COLUMNS = [
+    ('runs', '%5d', lambda r: r['runs']),
+    ('conn', '%9d', lambda r: r['connections']),
+    ('resumed%', '%8.1f', lambda r: 100.0 * r['reconnections'] / max(1, r['connections'])),
+    ('evict/1k', '%8.1f', lambda r: 1000.0 * r['evictions'] / max(1, r['connections'])),
+    ('find p99', '%8.0f', lambda r: r['find_ns_p99']),
+    ('key p99', '%8.0f', lambda r: r['key_request_ns_p99']),
+    ('evict p99', '%9.0f', lambda r: r['eviction_ns_p99']),
+    ('newrpa%', '%7.1f', lambda r: 100.0 * r['rpa_changes'] / max(1, r['reconnections'])),
+    ('kv wr/c', '%7.2f', lambda r: r['kv_writes_mean']),
+    ('prog B/c', '%8.0f', lambda r: r['programmed_mean']),
+    ('adv/c', '%6.1f', lambda r: r['adv_events'] / max(1, r['connections'])),
+    ('adv%', '%5.1f', lambda r: 100.0 * r['adv_on_s'] / max(1e-9, r['virtual_s'])),
+    ('gcs', '%6d', lambda r: r['gcs']),
+]
+
+Job = collections.namedtuple('Job', 'build sweep seed cost')
+
+
+def parse_axes(specs, whole=()):
+    """Parse NAME=v1,v2 options into an ordered {name: [values]}."""
+    axes = collections.OrderedDict()
+    for spec in specs or []:
+        name, sep, values = spec.partition('=')
+        if not sep or not values:
+            sys.exit('expected NAME=values, got %r' % spec)
+        axes.setdefault(name, []).extend([values] if name in whole else values.split(','))
+    return axes
+
+
+def product(axes):
+    """Return every combination of the axes as a tuple of (name, value)."""
+    names = list(axes)
+    return [tuple(zip(names, values)) for values in itertools.product(*axes.values())]
+
+
+def label(combination):
+    return ' '.join('%s=%s' % item for item in combination) or 'default'
+
+
+def build(combination, jobs):
+    """Build the soak with the options, return its path."""
+    name = '_'.join('%s-%s' % item for item in combination) or 'default'
+    build_dir = os.path.join('build', 'farm', name)
+    target = os.path.join(build_dir, 'peripheral_privacy_soak')
+    cmd = ['make', '-C', HOST_DIR, '-j%d' % jobs, 'BUILD_DIR=' + build_dir]
+    cmd += ['%s=%s' % item for item in combination] + [target]
+    result = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    if result.returncode:
+        sys.exit('build of %s failed:\n%s' % (label(combination), result.stderr))
+    return os.path.join(HOST_DIR, target)
+
+
+def parse_hist(value):
+    """Parse the index:count buckets of a histogram of the soak."""
+    return collections.Counter({int(index): int(count) for index, _, count in
+                                (bucket.partition(':') for bucket in value.split(',') if bucket)})
+
+
+def hist_pct(buckets, pct):
+    """Percentile of a histogram, the low end of its bucket, as soak_hist_pct()."""
+    rank = (sum(buckets.values()) * pct + 99) // 100
+    seen = 0
+    for index in sorted(buckets):
+        seen += buckets[index]
+        if buckets[index] and seen >= rank:
+            shift = index >> HIST_SUB_BITS
+            if not shift:
+                return index
+            return ((1 << HIST_SUB_BITS) + (index & ((1 << HIST_SUB_BITS) - 1))) << (shift - 1)
+    return 0
+
+
+def csv_value(value):
+    """Value of a run in the CSV file, histograms as in the soak report."""
+    if isinstance(value, collections.Counter):
+        return ','.join('%d:%d' % bucket for bucket in sorted(value.items()))
+    return value
+
+
+def run(job, binary, kv_dir, default_connections):
+    """Run one soak, return its results by name."""
+    cmd = [binary, '-p', '-s', str(job.seed)]
+    for name, value in job.sweep:
+        cmd += [SWEEP_OPTIONS[name], value]
+    if not any(name == 'connections' for name, _ in job.sweep):
+        cmd += ['-n', str(default_connections)]
+    if kv_dir is not None:
+        fd, path = tempfile.mkstemp(suffix='.kv', dir=kv_dir)
+        os.close(fd)
+        os.unlink(path)
+        cmd += ['-k', path]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    values = {}
+    for line in result.stdout.splitlines():
+        if line.startswith('centrals='):
+            for field in line.split():
+                name, _, value = field.partition('=')
+                if name.endswith('_hist'):
+                    values[name] = parse_hist(value)
+                else:
+                    values[name] = float(value) if '.' in value else int(value)
+    if result.returncode or not values:
+        raise RuntimeError('%s exited with %d: %s' % (' '.join(cmd), result.returncode, result.stderr.strip()))
+    return values
+
+
+class Scheduler:
+    """Work-stealing scheduler: a queue per worker, longest jobs at the head."""
+
+    def __init__(self, jobs, workers):
+        self.lock = threading.Lock()
+        self.queues = [collections.deque() for _ in range(workers)]
+        for i, job in enumerate(sorted(jobs, key=lambda j: -j.cost)):
+            self.queues[i % workers].append(job)
+        self.steals = 0
+
+    def next(self, worker):
+        with self.lock:
+            if self.queues[worker]:
+                return self.queues[worker].popleft()
+            victim = max(self.queues, key=lambda q: sum(job.cost for job in q))
+            if victim:
+                self.steals += 1
+                return victim.pop()
+        return None
+
+
+def merge(runs):
+    """Merge the runs of one combination."""
+    merged = {'runs': len(runs)}
+    for name in runs[0]:
+        values = [r[name] for r in runs]
+        if name in SUMMED:
+            merged[name] = sum(values)
+        elif name in LARGEST:
+            merged[name] = max(values)
+        elif name.endswith('_hist'):
+            merged[name] = sum(values, collections.Counter())
+        else:
+            merged[name] = sum(values) / float(len(values))
+    # The distributions of all the runs together, the means weighted by the
+    # number of values of every run
+    for key in HISTOGRAMS:
+        counts = [sum(r[key + '_hist'].values()) for r in runs]
+        merged[key + '_mean'] = sum(r[key + '_mean'] * n for r, n in zip(runs, counts)) / max(1, sum(counts))
+        merged[key + '_p50'] = hist_pct(merged[key + '_hist'], 50)
+        merged[key + '_p99'] = hist_pct(merged[key + '_hist'], 99)
+    return merged
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--build', action='append', metavar='NAME=VALUES', help='build option of host/Makefile')
+    parser.add_argument('--sweep', action='append', metavar='NAME=VALUES',
+                        help='option of the soak: ' + ', '.join(SWEEP_OPTIONS))
+    parser.add_argument('--seeds', type=int, default=1, help='runs of every combination')
+    parser.add_argument('-n', '--connections', type=int, default=10000,
+                        help='connections of every run, unless swept')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1, help='parallel runs')
+    parser.add_argument('--no-kv-file', action='store_true',
+                        help='keep the kv-store of every run in RAM only, which is faster')
+    parser.add_argument('--csv', help='write every run to this file')
+    args = parser.parse_args()
+
+    builds = product(parse_axes(args.build))
+    sweep_axes = parse_axes(args.sweep, WHOLE_VALUES)
+    unknown = [name for name in sweep_axes if name not in SWEEP_OPTIONS]
+    if unknown:
+        parser.error('unknown sweep option %s, use one of %s' % (', '.join(unknown), ', '.join(SWEEP_OPTIONS)))
+    sweeps = product(sweep_axes)
+
+    binaries = collections.OrderedDict()
+    for combination in builds:
+        print('building %s' % label(combination), file=sys.stderr)
+        binaries[combination] = build(combination, args.jobs)
+
+    jobs = []
+    for combination, sweep, seed in itertools.product(builds, sweeps, range(1, args.seeds + 1)):
+        connections = int(dict(sweep).get('connections', args.connections))
+        jobs.append(Job(combination, sweep, seed, connections))
+    workers = max(1, min(args.jobs, len(jobs)))
+    scheduler = Scheduler(jobs, workers)
+    results = []
+    failures = []
+    done = [0]
+    lock = threading.Lock()
+    start = time.time()
+
+    def worker(index, kv_dir):
+        while True:
+            job = scheduler.next(index)
+            if job is None:
+                return
+            try:
+                values = run(job, binaries[job.build], kv_dir, args.connections)
+            except RuntimeError as err:
+                with lock:
+                    failures.append(str(err))
+                continue
+            with lock:
+                results.append((job, values))
+                done[0] += 1
+                print('\r%d/%d runs' % (done[0], len(jobs)), end='', file=sys.stderr)
+
+    with tempfile.TemporaryDirectory(prefix='sim_farm') as tmp:
+        kv_dir = None if args.no_kv_file else tmp
+        threads = [threading.Thread(target=worker, args=(i, kv_dir)) for i in range(workers)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+    print('\r%d runs on %d workers in %.1f s, %d steals\n' %
+          (len(results), workers, time.time() - start, scheduler.steals), file=sys.stderr)
+
+    groups = collections.OrderedDict()
+    for job, values in sorted(results, key=lambda r: (builds.index(r[0].build), sweeps.index(r[0].sweep))):
+        groups.setdefault((job.build, job.sweep), []).append(values)
+    width = max([len(label(b + s)) for b, s in groups] + [len('combination')])
+    print('%-*s %s' % (width, 'combination', ' '.join('%*s' % (len(fmt % 0), title)
+                                                       for title, fmt, _ in COLUMNS)))
+    for (combination, sweep), runs in groups.items():
+        merged = merge(runs)
+        print('%-*s %s' % (width, label(combination + sweep),
+                           ' '.join('%*s' % (len(fmt % 0), fmt % value(merged)) for title, fmt, value in COLUMNS)))
+
+    if args.csv and results:
+        names = sorted(set(itertools.chain.from_iterable(values for _, values in results)))
+        axes = [name for name, _ in builds[0]] + [name for name, _ in sweeps[0]]
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(axes + ['seed'] + names)
+            for job, values in results:
+                writer.writerow([value for _, value in job.build + job.sweep] + [job.seed] +
+                                [csv_value(values.get(name, '')) for name in names])
+
+    for failure in failures:
+        print(failure, file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
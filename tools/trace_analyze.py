@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+Latency analyzer for the event trace of the Peripheral_Privacy example.
+
+Build the firmware with TRACE=1. The 'x' command prints the trace ring as
+"timestamp_us,point,id,arg" lines between TRACE BEGIN and TRACE END (see
+app_trace.h). This tool reads the dump from a terminal capture, or sends 'x'
+to the kit itself, and prints the distribution of:
+
+  connect-to-encrypted       connection up to encryption success
+  encrypted-to-notification  encryption success to the first notification sent
+  button-to-notification     button interrupt to its notification sent
+  flash write / flash read   kv-store accesses, per key
+
+Usage:
+  trace_analyze.py -f terminal.log
+  trace_analyze.py -p /dev/ttyACM0
+  trace_analyze.py -p /dev/ttyACM0 --timeline
+"""
+
+import argparse
+import collections
+import sys
+import time
+
+try:
+    import serial
+except ImportError:
+    serial = None
+
+KV_KEYS = {1: 'bond data', 2: 'CCCD', 3: 'local IRK', 4: 'privacy'}
+
+NOTIFY_SENT = 0
+
+TraceRecord = collections.namedtuple('TraceRecord', 'time_us point id arg')
+
+
+def parse_dump(lines):
+    """Return the records of the last complete dump in the lines."""
+    records = None
+    last = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith('TRACE BEGIN'):
+            records = []
+        elif line.startswith('TRACE END'):
+            if records is not None:
+                last = records
+            records = None
+        elif records is not None:
+            fields = line.split(',')
+            if len(fields) == 4 and fields[0].isdigit():
+                records.append(TraceRecord(int(fields[0]), fields[1], int(fields[2]), int(fields[3])))
+    if last is None:
+        sys.exit('no complete trace dump found, was the firmware built with TRACE=1?')
+    # Timestamps wrap after about 71 minutes, unwrap them
+    unwrapped = []
+    offset = 0
+    prev = None
+    for rec in last:
+        if prev is not None and rec.time_us < prev:
+            offset += 1 << 32
+        prev = rec.time_us
+        unwrapped.append(rec._replace(time_us=rec.time_us + offset))
+    return unwrapped
+
+
+def read_from_kit(port, baud, timeout):
+    if serial is None:
+        sys.exit('pyserial is required: pip install pyserial')
+    lines = []
+    with serial.Serial(port, baud, timeout=0.5) as dev:
+        dev.reset_input_buffer()
+        dev.write(b'x\r')
+        deadline = time.time() + timeout
+        buf = b''
+        while time.time() < deadline:
+            buf += dev.read(4096)
+            *complete, buf = buf.split(b'\n')
+            lines += [line.decode(errors='replace') for line in complete]
+            if any(line.startswith('TRACE END') for line in lines):
+                break
+    return lines
+
+
+def measure(records):
+    """Return the durations of every measured interval, in ms, by name."""
+    durations = collections.OrderedDict((name, []) for name in
+                                        ('connect-to-encrypted', 'encrypted-to-notification',
+                                         'button-to-notification'))
+    connect_time = None
+    encrypted_time = None
+    buttons = collections.deque()
+    kv_start = {}
+
+    for rec in records:
+        if rec.point == 'CONNECT':
+            connect_time = rec.time_us
+            encrypted_time = None
+        elif rec.point == 'DISCONNECT':
+            connect_time = None
+            encrypted_time = None
+        elif rec.point == 'ENCRYPTED' and rec.id == 0:
+            if connect_time is not None:
+                durations['connect-to-encrypted'].append((rec.time_us - connect_time) / 1000.0)
+                connect_time = None
+            encrypted_time = rec.time_us
+        elif rec.point == 'BUTTON':
+            buttons.append(rec.time_us)
+        elif rec.point == 'NOTIFY':
+            # Every button press is handled once, sent or not
+            pressed = buttons.popleft() if buttons else None
+            if rec.id == NOTIFY_SENT:
+                if pressed is not None:
+                    durations['button-to-notification'].append((rec.time_us - pressed) / 1000.0)
+                if encrypted_time is not None:
+                    durations['encrypted-to-notification'].append((rec.time_us - encrypted_time) / 1000.0)
+                    encrypted_time = None
+        elif rec.point in ('KV_READ_START', 'KV_WRITE_START'):
+            kv_start[(rec.point[:-6], rec.arg)] = rec.time_us
+        elif rec.point in ('KV_READ_END', 'KV_WRITE_END'):
+            start = kv_start.pop((rec.point[:-4], rec.arg), None)
+            if start is not None:
+                kind = 'flash write' if rec.point == 'KV_WRITE_END' else 'flash read'
+                name = '%s (%s)' % (kind, KV_KEYS.get(rec.arg, 'key %d' % rec.arg))
+                durations.setdefault(name, []).append((rec.time_us - start) / 1000.0)
+    return durations
+
+
+def percentile(sorted_values, pct):
+    index = min(len(sorted_values) - 1, int(round(pct / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def histogram(values, width=40):
+    """Print the values in buckets doubling in size from 0.125 ms."""
+    edges = [0.125 * (1 << i) for i in range(18)]
+    counts = [0] * (len(edges) + 1)
+    for value in values:
+        i = 0
+        while i < len(edges) and value >= edges[i]:
+            i += 1
+        counts[i] += 1
+    first = next(i for i, c in enumerate(counts) if c)
+    last = max(i for i, c in enumerate(counts) if c)
+    peak = max(counts)
+    for i in range(first, last + 1):
+        low = edges[i - 1] if i > 0 else 0.0
+        high = '%g' % edges[i] if i < len(edges) else 'inf'
+        bar = '#' * int(round(counts[i] * width / float(peak)))
+        print('    %9g - %-7s ms %6d %s' % (low, high, counts[i], bar))
+
+
+def report(durations):
+    for name, values in durations.items():
+        if not values:
+            print('%s: no samples' % name)
+            continue
+        values = sorted(values)
+        print('%s: %d samples, min %.3f, median %.3f, p90 %.3f, p99 %.3f, max %.3f, mean %.3f ms' %
+              (name, len(values), values[0], percentile(values, 50), percentile(values, 90),
+               percentile(values, 99), values[-1], sum(values) / len(values)))
+        histogram(values)
+        print()
+
+
+def timeline(records):
+    start = records[0].time_us if records else 0
+    prev = start
+    for rec in records:
+        print('%12.3f ms %+10.3f  %-15s id %-3d arg %d' %
+              ((rec.time_us - start) / 1000.0, (rec.time_us - prev) / 1000.0, rec.point, rec.id, rec.arg))
+        prev = rec.time_us
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    src = parser.add_mutually_exclusive_group(required=True)
+    src.add_argument('-p', '--port', help='serial port of the kit, the dump is requested with x')
+    src.add_argument('-f', '--file', help='terminal capture holding a dump')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('--timeout', type=float, default=10.0, help='time to wait for the dump in s')
+    parser.add_argument('--timeline', action='store_true', help='also print every record')
+    args = parser.parse_args()
+
+    if args.port:
+        lines = read_from_kit(args.port, args.baud, args.timeout)
+    else:
+        with open(args.file, errors='replace') as f:
+            lines = f.readlines()
+
+    records = parse_dump(lines)
+    print('%d trace records over %.3f s\n' %
+          (len(records), (records[-1].time_us - records[0].time_us) / 1e6 if records else 0.0))
+    if args.timeline:
+        timeline(records)
+        print()
+    report(measure(records))
+
+
+if __name__ == '__main__':
+    main()